@@ -14,10 +14,14 @@
 #include "LRU.h"
 #include "utils/Log.h"
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace milvus {
 namespace cache {
@@ -72,6 +76,10 @@ class Cache {
     bool
     reserve(const int64_t size);
 
+    // keys of cached items with their hit counts, most hit first
+    void
+    hot_keys(std::vector<std::pair<std::string, int64_t>>& keys);
+
     void
     print();
 
@@ -95,6 +103,7 @@ class Cache {
     double freemem_percent_;
 
     LRU<std::string, ItemObj> lru_;
+    std::unordered_map<std::string, int64_t> hits_;
     mutable std::mutex mutex_;
 };
 
@@ -54,6 +54,7 @@ Cache<ItemObj>::get(const std::string& key) {
     if (!lru_.exists(key)) {
         return nullptr;
     }
+    hits_[key]++;
     return lru_.get(key);
 }
 
@@ -86,11 +87,28 @@ Cache<ItemObj>::reserve(const int64_t item_size) {
     return true;
 }
 
+template <typename ItemObj>
+void
+Cache<ItemObj>::hot_keys(std::vector<std::pair<std::string, int64_t>>& keys) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        keys.clear();
+        for (auto& pair : hits_) {
+            if (lru_.exists(pair.first)) {
+                keys.push_back(pair);
+            }
+        }
+    }
+    std::sort(keys.begin(), keys.end(), [](const std::pair<std::string, int64_t>& a,
+                                           const std::pair<std::string, int64_t>& b) { return a.second > b.second; });
+}
+
 template <typename ItemObj>
 void
 Cache<ItemObj>::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     lru_.clear();
+    hits_.clear();
     usage_ = 0;
     LOG_SERVER_DEBUG_ << header_ << " Clear cache !";
 }
@@ -135,6 +153,7 @@ Cache<ItemObj>::insert_internal(const std::string& key, const ItemObj& item) {
 
     // insert new item
     lru_.put(key, item);
+    hits_.emplace(key, 0);
     LOG_SERVER_DEBUG_ << header_ << " Insert " << key << " size: " << (item_size >> 20) << "MB into cache";
     LOG_SERVER_DEBUG_ << header_ << " Count: " << lru_.size() << ", Usage: " << (usage_ >> 20) << "MB, Capacity: "
                      << (capacity_ >> 20) << "MB";
@@ -151,6 +170,7 @@ Cache<ItemObj>::erase_internal(const std::string& key) {
     size_t item_size = item->Size();
 
     lru_.erase(key);
+    hits_.erase(key);
 
     usage_ -= item_size;
     LOG_SERVER_DEBUG_ << header_ << " Erase " << key << " size: " << (item_size >> 20) << "MB from cache";
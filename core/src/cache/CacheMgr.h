@@ -17,6 +17,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace milvus {
 namespace cache {
@@ -48,6 +50,9 @@ class CacheMgr {
     virtual void
     ClearCache();
 
+    void
+    HotKeys(std::vector<std::pair<std::string, int64_t>>& keys);
+
     int64_t
     CacheUsage() const;
 
@@ -103,6 +103,16 @@ CacheMgr<ItemObj>::ClearCache() {
     cache_->clear();
 }
 
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::HotKeys(std::vector<std::pair<std::string, int64_t>>& keys) {
+    if (cache_ == nullptr) {
+        LOG_SERVER_ERROR_ << "Cache doesn't exist";
+        return;
+    }
+    cache_->hot_keys(keys);
+}
+
 template <typename ItemObj>
 int64_t
 CacheMgr<ItemObj>::CacheUsage() const {
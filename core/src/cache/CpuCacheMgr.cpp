@@ -11,6 +11,8 @@
 
 #include "cache/CpuCacheMgr.h"
 
+#include <cstdio>
+#include <fstream>
 #include <utility>
 
 #include <fiu/fiu-local.h>
@@ -45,5 +47,50 @@ CpuCacheMgr::ConfigUpdate(const std::string& name) {
     SetCapacity(config.cache.cache_size());
 }
 
+Status
+CpuCacheMgr::SaveWarmSet(const std::string& path) {
+    std::vector<std::pair<std::string, int64_t>> keys;
+    HotKeys(keys);
+
+    // write a temp file and rename it, a crash while saving keeps the previous warm set
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::out | std::ios::trunc);
+        if (!file.is_open()) {
+            return Status(SERVER_CANNOT_CREATE_FILE, "Cannot create warm set file: " + temp_path);
+        }
+        for (auto& pair : keys) {
+            file << pair.second << " " << pair.first << "\n";
+        }
+        if (!file.good()) {
+            return Status(SERVER_WRITE_ERROR, "Failed to write warm set file: " + temp_path);
+        }
+    }
+
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        return Status(SERVER_WRITE_ERROR, "Failed to rename warm set file: " + temp_path);
+    }
+
+    LOG_SERVER_DEBUG_ << "Save " << keys.size() << " cache keys to warm set file: " << path;
+    return Status::OK();
+}
+
+Status
+CpuCacheMgr::LoadWarmSet(const std::string& path, std::vector<std::pair<std::string, int64_t>>& keys) {
+    keys.clear();
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return Status(SERVER_FILE_NOT_FOUND, "Cannot open warm set file: " + path);
+    }
+
+    int64_t hits = 0;
+    std::string key;
+    while (file >> hits && std::getline(file >> std::ws, key)) {
+        keys.emplace_back(key, hits);
+    }
+
+    return Status::OK();
+}
+
 }  // namespace cache
 }  // namespace milvus
@@ -13,10 +13,13 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "cache/CacheMgr.h"
 #include "cache/DataObj.h"
 #include "config/ConfigMgr.h"
+#include "utils/Status.h"
 
 namespace milvus {
 namespace cache {
@@ -31,6 +34,13 @@ class CpuCacheMgr : public CacheMgr<DataObjPtr>, public ConfigObserver {
     static CpuCacheMgr&
     GetInstance();
 
+    // persist keys of cached items with their hit counts, so that a restarted server can reload its working set
+    Status
+    SaveWarmSet(const std::string& path);
+
+    static Status
+    LoadWarmSet(const std::string& path, std::vector<std::pair<std::string, int64_t>>& keys);
+
  public:
     void
     ConfigUpdate(const std::string& name) override;
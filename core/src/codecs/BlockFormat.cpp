@@ -22,6 +22,7 @@
 #include <boost/filesystem.hpp>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "codecs/ExtraFileInfo.h"
 #include "db/Utils.h"
@@ -31,6 +32,11 @@
 namespace milvus {
 namespace codec {
 
+namespace {
+// two ranges are read by one call if the gap between them is no more than this value
+constexpr int64_t MAX_READ_GAP = 4096;
+}  // namespace
+
 Status
 BlockFormat::Read(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, engine::BinaryDataPtr& raw) {
     if (!fs_ptr->reader_ptr_->Open(file_path)) {
@@ -95,25 +101,57 @@ BlockFormat::Read(const storage::FSHandlerPtr& fs_ptr, const std::string& file_p
     CHECK_SUM_VALID(fs_ptr);
 
     HeaderMap map = ReadHeaderValues(fs_ptr);
-    size_t total_num_bytes = stol(map.at("size"));
+    int64_t total_num_bytes = stol(map.at("size"));
 
-    fs_ptr->reader_ptr_->Seekg(MAGIC_SIZE + HEADER_SIZE);
+    // output position of each range, the output keeps the order of input ranges
+    std::vector<int64_t> positions;
+    positions.reserve(read_ranges.size());
     int64_t total_bytes = 0;
     for (auto& range : read_ranges) {
-        if (range.offset_ > total_num_bytes) {
+        if (range.offset_ < 0 || range.num_bytes_ < 0 || range.offset_ + range.num_bytes_ > total_num_bytes) {
+            fs_ptr->reader_ptr_->Close();
             return Status(SERVER_INVALID_ARGUMENT, "Invalid argument to read: " + file_path);
         }
+        positions.push_back(total_bytes);
         total_bytes += range.num_bytes_;
     }
 
+    // read ranges in file order, the ranges close to each other are merged into one read
+    std::vector<size_t> order(read_ranges.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t l, size_t r) { return read_ranges[l].offset_ < read_ranges[r].offset_; });
+
     raw = std::make_shared<engine::BinaryData>();
     raw->data_.resize(total_bytes);
-    int64_t poz = 0;
-    for (auto& range : read_ranges) {
-        int64_t offset = MAGIC_SIZE + HEADER_SIZE + range.offset_;
-        fs_ptr->reader_ptr_->Seekg(offset);
-        fs_ptr->reader_ptr_->Read(raw->data_.data() + poz, range.num_bytes_);
-        poz += range.num_bytes_;
+    std::vector<uint8_t> buffer;
+    for (size_t i = 0; i < order.size();) {
+        int64_t begin = read_ranges[order[i]].offset_;
+        int64_t end = begin + read_ranges[order[i]].num_bytes_;
+        size_t j = i + 1;
+        for (; j < order.size(); ++j) {
+            auto& range = read_ranges[order[j]];
+            if (range.offset_ > end + MAX_READ_GAP) {
+                break;
+            }
+            end = std::max(end, range.offset_ + range.num_bytes_);
+        }
+
+        fs_ptr->reader_ptr_->Seekg(MAGIC_SIZE + HEADER_SIZE + begin);
+        if (j == i + 1) {
+            fs_ptr->reader_ptr_->Read(raw->data_.data() + positions[order[i]], end - begin);
+        } else {
+            buffer.resize(end - begin);
+            fs_ptr->reader_ptr_->Read(buffer.data(), end - begin);
+            for (size_t k = i; k < j; ++k) {
+                auto& range = read_ranges[order[k]];
+                memcpy(raw->data_.data() + positions[order[k]], buffer.data() + range.offset_ - begin,
+                       range.num_bytes_);
+            }
+        }
+        i = j;
     }
     fs_ptr->reader_ptr_->Close();
 
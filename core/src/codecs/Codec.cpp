@@ -39,6 +39,7 @@ Codec::Codec() {
     suffix_set_.insert(structured_index_format_ptr_->FilePostfix());
     vector_index_format_ptr_ = std::make_shared<VectorIndexFormat>();
     suffix_set_.insert(vector_index_format_ptr_->FilePostfix());
+    suffix_set_.insert(vector_index_format_ptr_->ListFilePostfix());
     deleted_docs_format_ptr_ = std::make_shared<DeletedDocsFormat>();
     suffix_set_.insert(deleted_docs_format_ptr_->FilePostfix());
     id_bloom_filter_format_ptr_ = std::make_shared<IdBloomFilterFormat>();
@@ -15,6 +15,8 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <unistd.h>
+#include <atomic>
 #include <boost/filesystem.hpp>
 #include <memory>
 
@@ -25,6 +27,7 @@
 #include "knowhere/common/BinarySet.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 #include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_offset_index/IndexIVF_NM.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
@@ -33,6 +36,7 @@ namespace milvus {
 namespace codec {
 
 const char* VECTOR_INDEX_POSTFIX = ".idx";
+const char* VECTOR_LIST_FILE_POSTFIX = ".ivfl";
 
 std::string
 VectorIndexFormat::FilePostfix() {
@@ -40,6 +44,12 @@ VectorIndexFormat::FilePostfix() {
     return str;
 }
 
+std::string
+VectorIndexFormat::ListFilePostfix() {
+    std::string str = VECTOR_LIST_FILE_POSTFIX;
+    return str;
+}
+
 Status
 VectorIndexFormat::ReadRaw(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
                            knowhere::BinaryPtr& data) {
@@ -179,6 +189,56 @@ VectorIndexFormat::ConstructIndex(const std::string& index_name, knowhere::Binar
     return Status::OK();
 }
 
+Status
+VectorIndexFormat::ConstructListFileIndex(const storage::FSHandlerPtr& fs_ptr, const std::string& index_name,
+                                          knowhere::BinarySet& index_data, knowhere::BinaryPtr& raw_data,
+                                          const std::string& list_file_path, knowhere::VecIndexPtr& index) {
+    knowhere::VecIndexFactory& vec_index_factory = knowhere::VecIndexFactory::GetInstance();
+    auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF_NM>(
+        vec_index_factory.CreateVecIndex(index_name, knowhere::IndexMode::MODE_CPU));
+    if (ivf_index == nullptr) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Index " + index_name + " doesn't support list file");
+    }
+
+    if (raw_data != nullptr) {
+        milvus::TimeRecorder recorder("VectorIndexFormat::WriteListFile");
+
+        // segments are loaded concurrently, each loader writes its own temp file and renames it,
+        // so a loader never sees a partial list file
+        static std::atomic<int64_t> s_temp_id(0);
+        std::string temp_path =
+            list_file_path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(s_temp_id++);
+        if (!fs_ptr->writer_ptr_->Open(temp_path)) {
+            return Status(SERVER_CANNOT_CREATE_FILE, "Fail to create list file: " + temp_path);
+        }
+
+        index_data.Append(RAW_DATA, raw_data);
+        try {
+            ivf_index->WriteListFile(index_data, [&](const uint8_t* data, size_t size) {
+                fs_ptr->writer_ptr_->Write(data, static_cast<int64_t>(size));
+            });
+            fs_ptr->writer_ptr_->Close();
+        } catch (std::exception& ex) {
+            fs_ptr->writer_ptr_->Close();
+            fs_ptr->operation_ptr_->DeleteFile(temp_path);
+            return Status(SERVER_WRITE_ERROR, "Fail to write list file: " + temp_path + ", " + ex.what());
+        }
+
+        if (!fs_ptr->operation_ptr_->Move(list_file_path, temp_path)) {
+            fs_ptr->operation_ptr_->DeleteFile(temp_path);
+            return Status(SERVER_WRITE_ERROR, "Fail to rename list file: " + temp_path);
+        }
+        LOG_ENGINE_DEBUG_ << "create list file " << list_file_path << " from " << RAW_DATA << " " << raw_data->size;
+    }
+
+    ivf_index->LoadWithListFile(index_data, list_file_path);
+    ivf_index->UpdateIndexSize();
+    LOG_ENGINE_DEBUG_ << "list file index size " << ivf_index->IndexSize();
+
+    index = ivf_index;
+    return Status::OK();
+}
+
 Status
 VectorIndexFormat::WriteIndex(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
                               const knowhere::VecIndexPtr& index) {
@@ -35,6 +35,9 @@ class VectorIndexFormat {
     static std::string
     FilePostfix();
 
+    static std::string
+    ListFilePostfix();
+
     Status
     ReadRaw(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, knowhere::BinaryPtr& data);
 
@@ -51,6 +54,13 @@ class VectorIndexFormat {
     ConstructIndex(const std::string& index_name, knowhere::BinarySet& index_data, knowhere::BinaryPtr& raw_data,
                    knowhere::BinaryPtr& compress_data, knowhere::VecIndexPtr& index);
 
+    // load an IVF_FLAT index with its raw vectors kept in a list file instead of memory,
+    // the list file is created from raw_data if it doesn't exist
+    Status
+    ConstructListFileIndex(const storage::FSHandlerPtr& fs_ptr, const std::string& index_name,
+                           knowhere::BinarySet& index_data, knowhere::BinaryPtr& raw_data,
+                           const std::string& list_file_path, knowhere::VecIndexPtr& index);
+
     Status
     WriteIndex(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, const knowhere::VecIndexPtr& index);
 
@@ -94,6 +94,10 @@ InitConfig() {
         {"network.http.enable", CreateBoolConfig("network.http.enable", &config.network.http.enable.value, true)},
         {"network.http.port",
          CreateIntegerConfig("network.http.port", 1025, 65534, &config.network.http.port.value, 19121)},
+        {"network.grpc_async.enable",
+         CreateBoolConfig("network.grpc_async.enable", &config.network.grpc_async.enable.value, false)},
+        {"network.grpc_async.threads",
+         CreateIntegerConfig("network.grpc_async.threads", 1, 64, &config.network.grpc_async.threads.value, 4)},
 
         /* storage */
         {"storage.path", CreateStringConfig("storage.path", &config.storage.path.value, "/var/lib/milvus")},
@@ -121,6 +125,13 @@ InitConfig() {
          CreateBoolConfig("cache.cache_insert_data", &config.cache.cache_insert_data.value, false)},
         {"cache.preload_collection",
          CreateStringConfig("cache.preload_collection", &config.cache.preload_collection.value, "")},
+        {"cache.preload_concurrency",
+         CreateIntegerConfig("cache.preload_concurrency", 1, 256, &config.cache.preload_concurrency.value, 4)},
+        {"cache.warm_set.enable",
+         CreateBoolConfig("cache.warm_set.enable", &config.cache.warm_set.enable.value, false)},
+        {"cache.warm_set.interval",
+         CreateIntegerConfig("cache.warm_set.interval", 1, std::numeric_limits<int64_t>::max(),
+                             &config.cache.warm_set.interval.value, 300)},
         {"cache.max_concurrent_insert_request_size",
          CreateSizeConfig("cache.max_concurrent_insert_request_size", 256 * MB, std::numeric_limits<int64_t>::max(),
                           &config.cache.max_concurrent_insert_request_size.value, 2 * GB)},
@@ -141,6 +152,11 @@ InitConfig() {
         /* log */
         {"logs.level", CreateStringConfig("logs.level", &config.logs.level.value, "debug")},
         {"logs.trace.enable", CreateBoolConfig("logs.trace.enable", &config.logs.trace.enable.value, true)},
+        {"logs.slow_query.enable",
+         CreateBoolConfig("logs.slow_query.enable", &config.logs.slow_query.enable.value, false)},
+        {"logs.slow_query.threshold",
+         CreateIntegerConfig("logs.slow_query.threshold", 0, std::numeric_limits<int64_t>::max(),
+                             &config.logs.slow_query.threshold.value, 1000)},
         {"logs.path", CreateStringConfig("logs.path", &config.logs.path.value, "/var/lib/milvus/logs")},
         {"logs.max_log_file_size", CreateSizeConfig("logs.max_log_file_size", 512 * MB, 4096 * MB,
                                                     &config.logs.max_log_file_size.value, 1024 * MB)},
@@ -172,10 +188,33 @@ InitConfig() {
                              &config.engine.use_blas_threshold.value, 1100)},
         {"engine.omp_thread_num", CreateIntegerConfig("engine.omp_thread_num", 0, std::numeric_limits<int64_t>::max(),
                                                       &config.engine.omp_thread_num.value, 0)},
+        {"engine.build_index_concurrency",
+         CreateIntegerConfig("engine.build_index_concurrency", 0, std::numeric_limits<int64_t>::max(),
+                             &config.engine.build_index_concurrency.value, 0)},
+        {"engine.build_suspend_search_num",
+         CreateIntegerConfig("engine.build_suspend_search_num", 0, std::numeric_limits<int64_t>::max(),
+                             &config.engine.build_suspend_search_num.value, 1)},
         {"engine.clustering_type", CreateEnumConfig("engine.clustering_type", &ClusteringMap,
                                                     &config.engine.clustering_type.value, ClusteringType::K_MEANS)},
         {"engine.simd_type",
          CreateEnumConfig("engine.simd_type", &SimdMap, &config.engine.simd_type.value, SimdType::AUTO)},
+        {"engine.ivf_disk_mode", CreateBoolConfig("engine.ivf_disk_mode", &config.engine.ivf_disk_mode.value, false)},
+        {"engine.ivf_disk_cache_size",
+         CreateSizeConfig("engine.ivf_disk_cache_size", 0, std::numeric_limits<int64_t>::max(),
+                          &config.engine.ivf_disk_cache_size.value, 256 * MB)},
+        {"engine.batch_lane_cost_threshold",
+         CreateIntegerConfig("engine.batch_lane_cost_threshold", 0, std::numeric_limits<int64_t>::max(),
+                             &config.engine.batch_lane_cost_threshold.value, 1000000)},
+        {"engine.latency_lane_weight", CreateIntegerConfig("engine.latency_lane_weight", 1, 100,
+                                                           &config.engine.latency_lane_weight.value, 4)},
+        {"engine.max_queue_wait", CreateIntegerConfig("engine.max_queue_wait", 0, 3600000,
+                                                      &config.engine.max_queue_wait.value, 0)},
+        {"engine.snapshot_memory_limit",
+         CreateSizeConfig("engine.snapshot_memory_limit", 0, std::numeric_limits<int64_t>::max(),
+                          &config.engine.snapshot_memory_limit.value, 1 * GB)},
+        {"engine.snapshot_operation_threads",
+         CreateIntegerConfig("engine.snapshot_operation_threads", 1, 64,
+                             &config.engine.snapshot_operation_threads.value, 4)},
 
         {"system.lock.enable", CreateBoolConfig("system.lock.enable", &config.system.lock.enable.value, true)},
 
@@ -236,11 +275,20 @@ general:
 # http.port            | Port that Milvus HTTP server monitors.                     | Integer    | 19121           |
 #                      | Port range (1024, 65535)                                   |            |                 |
 #----------------------+------------------------------------------------------------+------------+-----------------+
+# grpc_async.enable    | Serve Insert, GetEntityByID, Search and SearchPB from gRPC | Boolean    | false           |
+#                      | completion queues, responses are sent by the request       |            |                 |
+#                      | scheduler instead of threads waiting for the requests.     |            |                 |
+#----------------------+------------------------------------------------------------+------------+-----------------+
+# grpc_async.threads   | Number of completion queues and threads polling them.      | Integer    | 4               |
+#                      | Range [1, 64]                                              |            |                 |
+#----------------------+------------------------------------------------------------+------------+-----------------+
 network:
   bind.address: @network.bind.address@
   bind.port: @network.bind.port@
   http.enable: @network.http.enable@
   http.port: @network.http.port@
+  grpc_async.enable: @network.grpc_async.enable@
+  grpc_async.threads: @network.grpc_async.threads@
 
 #----------------------+------------------------------------------------------------+------------+-----------------+
 # Storage Config       | Description                                                | Type       | Default         |
@@ -285,12 +333,23 @@ wal:
 #                                    | '*' means preload all existing tables (single-quote or     |            |           |
 #                                    | double-quote required).                                    |            |           |
 #------------------------------------+------------------------------------------------------------+------------+-----------+
+# preload_concurrency                | Number of segments loaded at the same time when preloading | Integer    | 4         |
+#                                    | collections, range [1, 256].                               |            |           |
+#------------------------------------+------------------------------------------------------------+------------+-----------+
+# warm_set.enable                    | Whether to save the keys of cached data periodically and   | Boolean    | false     |
+#                                    | reload the most accessed ones after restart.               |            |           |
+#------------------------------------+------------------------------------------------------------+------------+-----------+
+# warm_set.interval                  | Interval of saving the keys of cached data, in seconds.    | Integer    | 300       |
+#------------------------------------+------------------------------------------------------------+------------+-----------+
 # max_concurrent_insert_request_size | A limitation of processing insert request size concurrent. | String     | 2GB       |
 #------------------------------------+------------------------------------------------------------+------------+-----------+
 cache:
   cache_size: @cache.cache_size@
   insert_buffer_size: @cache.insert_buffer_size@
   preload_collection: @cache.preload_collection@
+  preload_concurrency: @cache.preload_concurrency@
+  warm_set.enable: @cache.warm_set.enable@
+  warm_set.interval: @cache.warm_set.interval@
   max_concurrent_insert_request_size: @cache.max_concurrent_insert_request_size@
 
 #----------------------+------------------------------------------------------------+------------+-----------------+
@@ -329,6 +388,11 @@ gpu:
 #----------------------+------------------------------------------------------------+------------+-----------------+
 # trace.enable         | Whether to enable trace level logging in Milvus.           | Boolean    | true            |
 #----------------------+------------------------------------------------------------+------------+-----------------+
+# slow_query.enable    | Whether to log searches slower than slow_query.threshold,  | Boolean    | false           |
+#                      | with the time spent in each search stage.                  |            |                 |
+#----------------------+------------------------------------------------------------+------------+-----------------+
+# slow_query.threshold | Slow query threshold in milliseconds.                      | Integer    | 1000            |
+#----------------------+------------------------------------------------------------+------------+-----------------+
 # path                 | Absolute path to the folder holding the log files.         | String     |                 |
 #----------------------+------------------------------------------------------------+------------+-----------------+
 # max_log_file_size    | The maximum size of each log file, size range              | String     | 1024MB          |
@@ -340,6 +404,8 @@ gpu:
 logs:
   level: @logs.level@
   trace.enable: @logs.trace.enable@
+  slow_query.enable: @logs.slow_query.enable@
+  slow_query.threshold: @logs.slow_query.threshold@
   path: @logs.path@
   max_log_file_size: @logs.max_log_file_size@
   log_rotate_num: @logs.log_rotate_num@
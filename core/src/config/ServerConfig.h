@@ -100,6 +100,10 @@ struct ServerConfig {
             Bool enable{false};
             Integer port{0};
         } http;
+        struct GrpcAsync {
+            Bool enable{false};
+            Integer threads{0};
+        } grpc_async;
     } network;
 
     struct Storage {
@@ -113,6 +117,11 @@ struct ServerConfig {
         Integer insert_buffer_size{0};
         Bool cache_insert_data{false};
         String preload_collection{"unknown"};
+        Integer preload_concurrency{0};
+        struct WarmSet {
+            Bool enable{false};
+            Integer interval{0};
+        } warm_set;
         Integer max_concurrent_insert_request_size{0};
     } cache;
 
@@ -128,8 +137,17 @@ struct ServerConfig {
         Integer search_combine_nq{0};
         Integer use_blas_threshold{0};
         Integer omp_thread_num{0};
+        Integer build_index_concurrency{0};
+        Integer build_suspend_search_num{1};
         Integer clustering_type{0};
         Integer simd_type{0};
+        Bool ivf_disk_mode{false};
+        Integer ivf_disk_cache_size{0};
+        Integer batch_lane_cost_threshold{0};
+        Integer latency_lane_weight{0};
+        Integer max_queue_wait{0};
+        Integer snapshot_memory_limit{0};
+        Integer snapshot_operation_threads{0};
     } engine;
 
     struct GPU {
@@ -157,6 +175,10 @@ struct ServerConfig {
         struct Trace {
             Bool enable{false};
         } trace;
+        struct SlowQuery {
+            Bool enable{false};
+            Integer threshold{0};
+        } slow_query;
         String path{"unknown"};
         Integer max_log_file_size{0};
         Integer log_rotate_num{0};
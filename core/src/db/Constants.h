@@ -34,6 +34,7 @@ constexpr int64_t MAX_SCRIPT_FILE_SIZE = 256 * MB;          // max file size of
 constexpr int64_t BUILD_INEDX_RETRY_TIMES = 3;  // retry times if build index failed
 
 constexpr const char* DB_FOLDER = "/db";
+constexpr const char* WARM_SET_FILE = "/cache_warm_set";  // keys of cached items, reloaded at startup
 
 }  // namespace engine
 }  // namespace milvus
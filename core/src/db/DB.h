@@ -115,6 +115,13 @@ class DB {
     LoadCollection(const server::ContextPtr& context, const std::string& collection_name,
                    const std::vector<std::string>& field_names, bool force = false) = 0;
 
+    // load segments of the collections into cache in parallel, stop loading once the cache is full
+    virtual Status
+    PreloadCollections(const server::ContextPtr& context, const std::vector<std::string>& collection_names) = 0;
+
+    virtual void
+    GetPreloadProgress(PreloadProgress& progress) = 0;
+
     virtual Status
     Flush(const std::string& collection_name) = 0;
 
@@ -124,6 +131,10 @@ class DB {
     virtual Status
     Compact(const server::ContextPtr& context, const std::string& collection_name, double threshold = 0.0) = 0;
 
+    virtual Status
+    BulkImport(const server::ContextPtr& context, const std::string& collection_name, const std::string& partition_name,
+               const std::string& path, int64_t& row_count) = 0;
+
     virtual bool
     IsBuildingIndex() = 0;
 };  // DB
@@ -13,6 +13,7 @@
 #include "cache/CpuCacheMgr.h"
 #include "codecs/Codec.h"
 #include "config/ServerConfig.h"
+#include "db/Constants.h"
 #include "db/IDGenerator.h"
 #include "db/SnapshotUtils.h"
 #include "db/SnapshotVisitor.h"
@@ -25,8 +26,8 @@
 #include "db/snapshot/ResourceHelper.h"
 #include "db/snapshot/ResourceTypes.h"
 #include "db/snapshot/Snapshots.h"
+#include "insert/BulkImporter.h"
 #include "insert/MemManagerFactory.h"
-#include "knowhere/index/vector_index/helpers/BuilderSuspend.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
 #include "metrics/Metrics.h"
 #include "metrics/SystemInfo.h"
@@ -45,6 +46,9 @@
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <map>
+#include <regex>
+#include <set>
 #include <unordered_set>
 #include <utility>
 
@@ -105,10 +109,20 @@ DBImpl::Start() {
 
     // for distribute version, some nodes are read only
     if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
+        // segments left unindexed before restart are checked once
+        snapshot::IDS_TYPE collection_ids;
+        snapshot::Snapshots::GetInstance().GetCollectionIds(collection_ids);
+        MarkIndexPending(std::set<int64_t>(collection_ids.begin(), collection_ids.end()));
+
         // background build index thread
         bg_index_thread_ = std::thread(&DBImpl::TimingIndexThread, this);
     }
 
+    // background cache warm set thread
+    if (options_.warm_set_enable_) {
+        bg_warm_set_thread_ = std::thread(&DBImpl::TimingWarmSetThread, this);
+    }
+
     // background metric thread
     fiu_do_on("options_metric_enable", options_.metric_enable_ = true);
     if (options_.metric_enable_) {
@@ -140,6 +154,12 @@ DBImpl::Stop() {
         bg_index_thread_.join();
     }
 
+    // wait warm set thread exit, it saves the warm set before exit
+    if (options_.warm_set_enable_) {
+        swn_warm_set_.Notify();
+        bg_warm_set_thread_.join();
+    }
+
     // wait metric thread exit
     if (options_.metric_enable_) {
         swn_metric_.Notify();
@@ -201,6 +221,9 @@ DBImpl::DropCollection(const std::string& collection_name) {
     // erase insert buffer of this collection
     mem_mgr_->EraseMem(ss->GetCollectionId());
 
+    // cancel build index tasks of this collection
+    CancelBuildIndexJobs(ss->GetCollectionId());
+
     // erase cache
     ClearCollectionCache(ss, options_.meta_.path_);
 
@@ -417,6 +440,9 @@ DBImpl::DropIndex(const std::string& collection_name, const std::string& field_n
     snapshot::ScopedSnapshotT ss;
     STATUS_CHECK(snapshot::Snapshots::GetInstance().GetSnapshot(ss, collection_name));
 
+    // cancel build index tasks of this collection, segments of other fields will be picked up again later
+    CancelBuildIndexJobs(ss->GetCollectionId());
+
     ClearIndexCache(ss, options_.meta_.path_, field_name);
 
     std::set<int64_t> collection_ids = {ss->GetCollectionId()};
@@ -521,8 +547,8 @@ DBImpl::Insert(const std::string& collection_name, const std::string& partition_
         IDNumbers ids;
         STATUS_CHECK(id_generator.GetNextIDNumbers(consume_chunk->count_, ids));
         BinaryDataPtr id_data = std::make_shared<BinaryData>();
-        id_data->data_.resize(ids.size() * sizeof(int64_t));
-        memcpy(id_data->data_.data(), ids.data(), ids.size() * sizeof(int64_t));
+        auto src = reinterpret_cast<const uint8_t*>(ids.data());
+        id_data->data_.assign(src, src + ids.size() * sizeof(int64_t));
         consume_chunk->fixed_fields_[engine::FIELD_UID] = id_data;
         data_chunk->fixed_fields_[engine::FIELD_UID] = id_data;  // return generated id to customer;
     } else {
@@ -664,17 +690,18 @@ DBImpl::Query(const server::ContextPtr& context, const query::QueryPtr& query_pt
     }
 
     scheduler::SearchJobPtr job = std::make_shared<scheduler::SearchJob>(nullptr, ss, options_, query_ptr, segment_ids);
+    server::QueryTracePtr query_trace = context != nullptr ? context->GetQueryTrace() : nullptr;
+    job->SetQueryTrace(query_trace);
 
     cache::CpuCacheMgr::GetInstance().PrintInfo();  // print cache info before query
 
-    SuspendIfFirst();
-
     /* put search job to scheduler and wait job finish */
+    if (query_trace != nullptr) {
+        query_trace->BeginStage(server::QueryStage::DISPATCH);
+    }
     scheduler::JobMgrInst::GetInstance()->Put(job);
     job->WaitFinish();
 
-    ResumeIfLast();
-
     cache::CpuCacheMgr::GetInstance().PrintInfo();  // print cache info after query
 
     if (!job->status().ok()) {
@@ -685,11 +712,17 @@ DBImpl::Query(const server::ContextPtr& context, const query::QueryPtr& query_pt
         result = job->query_result();
     }
 
-    // step 4: get entities by result ids
+    // step 4: get entities by result locations, fall back to look up by result ids
     std::vector<bool> valid_row;
     if (!query_ptr->field_names.empty()) {
-        STATUS_CHECK(GetEntityByID(query_ptr->collection_id, result->result_ids_, query_ptr->field_names, valid_row,
-                                   result->data_chunk_));
+        server::QueryStageTimer fetch_timer(query_trace, server::QueryStage::FIELD_FETCH);
+        if (result->result_locations_.size() == result->result_ids_.size()) {
+            STATUS_CHECK(GetEntityByLocation(ss, result->result_locations_, query_ptr->field_names, valid_row,
+                                             result->data_chunk_));
+        } else {
+            STATUS_CHECK(GetEntityByID(query_ptr->collection_id, result->result_ids_, query_ptr->field_names,
+                                       valid_row, result->data_chunk_));
+        }
     }
 
     // step 5: filter entities by field names
@@ -762,6 +795,211 @@ DBImpl::LoadCollection(const server::ContextPtr& context, const std::string& col
     return Status::OK();
 }
 
+Status
+DBImpl::PreloadCollections(const server::ContextPtr& context, const std::vector<std::string>& collection_names) {
+    CHECK_INITIALIZED;
+
+    TimeRecorder rc("DBImpl::PreloadCollections");
+    std::lock_guard<std::mutex> run_lock(preload_run_mutex_);
+
+    std::vector<PreloadItem> items;
+    STATUS_CHECK(CollectPreloadItems(context, collection_names, items));
+
+    /* large segments first, they are the most expensive ones to load by the first search */
+    std::stable_sort(items.begin(), items.end(),
+                     [](const PreloadItem& a, const PreloadItem& b) { return a.size_ > b.size_; });
+
+    LoadPreloadItems(items);
+    rc.ElapseFromBegin("Preload collections totally cost");
+
+    return Status::OK();
+}
+
+Status
+DBImpl::CollectPreloadItems(const server::ContextPtr& context, const std::vector<std::string>& collection_names,
+                            std::vector<PreloadItem>& items) {
+    /* collect segments of all collections, so that they share the loading threads and the cache budget */
+    for (auto& name : collection_names) {
+        snapshot::ScopedSnapshotT ss;
+        STATUS_CHECK(snapshot::Snapshots::GetInstance().GetSnapshot(ss, name));
+
+        std::vector<std::string> field_names;  // input empty field names will load all fileds
+        auto handler = std::make_shared<LoadCollectionHandler>(context, ss, options_.meta_.path_, field_names, false);
+        auto exec = [&](const snapshot::Segment::Ptr& segment, snapshot::SegmentIterator* iterator) -> Status {
+            auto segment_commit = ss->GetSegmentCommitBySegmentId(segment->GetID());
+            int64_t size = (segment_commit != nullptr) ? segment_commit->GetSize() : 0;
+            items.push_back(PreloadItem{handler, segment, size});
+            return Status::OK();
+        };
+
+        auto segment_iter = std::make_shared<snapshot::SegmentIterator>(ss, exec);
+        segment_iter->Iterate();
+        STATUS_CHECK(segment_iter->GetStatus());
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::CollectWarmSetItems(const std::string& warm_set_path, std::vector<PreloadItem>& items) {
+    std::vector<std::pair<std::string, int64_t>> keys;
+    STATUS_CHECK(cache::CpuCacheMgr::LoadWarmSet(warm_set_path, keys));
+
+    /* cache keys are segment file paths, group the fields by segment and sum up their hits */
+    struct WarmSegment {
+        snapshot::ScopedSnapshotT ss_;
+        snapshot::SegmentPtr segment_;
+        std::set<std::string> field_names_;
+        int64_t hits_ = 0;
+    };
+    std::map<snapshot::ID_TYPE, WarmSegment> segments;
+    std::unordered_map<snapshot::ID_TYPE, snapshot::ScopedSnapshotT> snapshots;
+
+    static const std::regex key_regex(std::string(snapshot::COLLECTION_PREFIX) + "(\\d+)/" + snapshot::PARTITION_PREFIX +
+                                      "\\d+/" + snapshot::SEGMENT_PREFIX + "(\\d+)/" +
+                                      snapshot::SEGMENT_FILE_PREFIX + "(\\d+)$");
+    for (auto& pair : keys) {
+        std::smatch match;
+        if (!std::regex_search(pair.first, match, key_regex)) {
+            continue;  // not a segment file, such as a temp index
+        }
+        snapshot::ID_TYPE collection_id = std::stoll(match[1]);
+        snapshot::ID_TYPE segment_id = std::stoll(match[2]);
+        snapshot::ID_TYPE file_id = std::stoll(match[3]);
+
+        auto ss_iter = snapshots.find(collection_id);
+        if (ss_iter == snapshots.end()) {
+            snapshot::ScopedSnapshotT ss;
+            if (!snapshot::Snapshots::GetInstance().GetSnapshot(ss, collection_id).ok()) {
+                ss = snapshot::ScopedSnapshotT();  // collection is dropped
+            }
+            ss_iter = snapshots.emplace(collection_id, ss).first;
+        }
+        auto& ss = ss_iter->second;
+        if (!ss) {
+            continue;
+        }
+
+        /* the file is gone if its segment is merged or its index is rebuilt since last run */
+        auto segment_file = ss->GetResource<snapshot::SegmentFile>(file_id);
+        auto segment = ss->GetResource<snapshot::Segment>(segment_id);
+        if (segment_file == nullptr || segment == nullptr) {
+            continue;
+        }
+        auto element = ss->GetResource<snapshot::FieldElement>(segment_file->GetFieldElementId());
+        auto field = (element != nullptr) ? ss->GetResource<snapshot::Field>(element->GetFieldId()) : nullptr;
+        if (field == nullptr) {
+            continue;
+        }
+
+        auto& warm_segment = segments[segment_id];
+        warm_segment.ss_ = ss;
+        warm_segment.segment_ = segment;
+        warm_segment.field_names_.insert(field->GetName());
+        warm_segment.hits_ += pair.second;
+    }
+
+    std::vector<std::pair<int64_t, PreloadItem>> hot_items;
+    for (auto& kv : segments) {
+        auto& warm_segment = kv.second;
+        std::vector<std::string> field_names(warm_segment.field_names_.begin(), warm_segment.field_names_.end());
+        auto handler = std::make_shared<LoadCollectionHandler>(nullptr, warm_segment.ss_, options_.meta_.path_,
+                                                               field_names, false);
+        auto segment_commit = warm_segment.ss_->GetSegmentCommitBySegmentId(kv.first);
+        int64_t size = (segment_commit != nullptr) ? segment_commit->GetSize() : 0;
+        hot_items.emplace_back(warm_segment.hits_, PreloadItem{handler, warm_segment.segment_, size});
+    }
+
+    /* most accessed segments first */
+    std::stable_sort(hot_items.begin(), hot_items.end(),
+                     [](const std::pair<int64_t, PreloadItem>& a, const std::pair<int64_t, PreloadItem>& b) {
+                         return a.first > b.first;
+                     });
+    for (auto& pair : hot_items) {
+        items.push_back(pair.second);
+    }
+
+    return Status::OK();
+}
+
+void
+DBImpl::LoadPreloadItems(const std::vector<PreloadItem>& items) {
+    int64_t total_bytes = 0;
+    for (auto& item : items) {
+        total_bytes += item.size_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(preload_mutex_);
+        preload_progress_ = PreloadProgress();
+        preload_progress_.running_ = true;
+        preload_progress_.total_segments_ = items.size();
+        preload_progress_.total_bytes_ = total_bytes;
+    }
+    LOG_ENGINE_DEBUG_ << LogOut("Preload %ld segments, %ld bytes in total", items.size(), total_bytes);
+
+    /* a segment is only loaded while it fits into the cache, loading more would evict warm data,
+     * its size on disk is an upper bound of its size in cache */
+    auto& cache_mgr = cache::CpuCacheMgr::GetInstance();
+    std::atomic<int64_t> loading_bytes(0);
+    auto load = [&](const PreloadItem& item) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        int64_t reserved = loading_bytes.fetch_add(item.size_) + item.size_;
+        bool fit = cache_mgr.CacheUsage() + reserved <= cache_mgr.CacheCapacity();
+        if (fit) {
+            try {
+                item.handler_->Handle(item.segment_);
+            } catch (std::exception& ex) {
+                LOG_ENGINE_ERROR_ << LogOut("Failed to preload segment %ld: %s", item.segment_->GetID(), ex.what());
+                fit = false;
+            }
+        }
+        loading_bytes.fetch_sub(item.size_);
+
+        std::lock_guard<std::mutex> lock(preload_mutex_);
+        if (fit) {
+            preload_progress_.loaded_segments_++;
+            preload_progress_.loaded_bytes_ += item.size_;
+        } else {
+            preload_progress_.skipped_segments_++;
+        }
+        auto done = preload_progress_.loaded_segments_ + preload_progress_.skipped_segments_;
+        server::Metrics::GetInstance().CachePreloadProgressGaugeSet(100.0 * done / preload_progress_.total_segments_);
+    };
+
+    {
+        ThreadPool pool(options_.preload_concurrency_, options_.preload_concurrency_);
+        std::vector<std::future<void>> results;
+        results.reserve(items.size());
+        for (auto& item : items) {
+            results.emplace_back(pool.enqueue(load, std::cref(item)));
+        }
+        for (auto& result : results) {
+            result.wait();
+        }
+    }
+
+    PreloadProgress progress;
+    {
+        std::lock_guard<std::mutex> lock(preload_mutex_);
+        preload_progress_.running_ = false;
+        progress = preload_progress_;
+    }
+    if (progress.skipped_segments_ > 0) {
+        LOG_ENGINE_WARNING_ << LogOut("Cache is full, %ld of %ld segments are not preloaded", progress.skipped_segments_,
+                                      progress.total_segments_);
+    }
+}
+
+void
+DBImpl::GetPreloadProgress(PreloadProgress& progress) {
+    std::lock_guard<std::mutex> lock(preload_mutex_);
+    progress = preload_progress_;
+}
+
 Status
 DBImpl::Flush(const std::string& collection_name) {
     if (!initialized_.load(std::memory_order_acquire)) {
@@ -799,6 +1037,29 @@ DBImpl::Flush() {
     return Status::OK();
 }
 
+Status
+DBImpl::BulkImport(const server::ContextPtr& context, const std::string& collection_name,
+                   const std::string& partition_name, const std::string& path, int64_t& row_count) {
+    CHECK_INITIALIZED;
+
+    snapshot::ScopedSnapshotT ss;
+    STATUS_CHECK(snapshot::Snapshots::GetInstance().GetSnapshot(ss, collection_name));
+
+    auto partition = ss->GetPartition(partition_name);
+    if (partition == nullptr) {
+        return Status(DB_NOT_FOUND, "Fail to get partition " + partition_name);
+    }
+
+    LOG_ENGINE_DEBUG_ << "Bulk import " << path << " into collection " << collection_name;
+    BulkImporter importer(ss, partition->GetID(), path, options_);
+    STATUS_CHECK(importer.Import(row_count));
+
+    // the imported segments are full size, build their index right away instead of waiting for the timer
+    StartBuildIndexTask({collection_name}, false);
+
+    return Status::OK();
+}
+
 Status
 DBImpl::Compact(const std::shared_ptr<server::Context>& context, const std::string& collection_name, double threshold) {
     if (!initialized_.load(std::memory_order_acquire)) {
@@ -881,6 +1142,76 @@ DBImpl::Compact(const std::shared_ptr<server::Context>& context, const std::stri
 ////////////////////////////////////////////////////////////////////////////////
 // Internal APIs
 ////////////////////////////////////////////////////////////////////////////////
+Status
+DBImpl::GetEntityByLocation(const snapshot::ScopedSnapshotT& ss, const ResultLocations& locations,
+                            const std::vector<std::string>& field_names, std::vector<bool>& valid_row,
+                            DataChunkPtr& data_chunk) {
+    TimeRecorder rc("DBImpl::GetEntityByLocation");
+
+    // group result positions by segment, entities of a segment are read in one batch
+    std::map<snapshot::ID_TYPE, std::vector<int64_t>> segment_positions;
+    for (int64_t i = 0; i < locations.size(); ++i) {
+        if (locations[i].segment_id_ >= 0 && locations[i].offset_ >= 0) {
+            segment_positions[locations[i].segment_id_].push_back(i);
+        }
+    }
+
+    // record each position in which chunk, and its row within the chunk
+    std::vector<std::pair<DataChunkPtr, int64_t>> position_map(locations.size());
+    for (auto& pair : segment_positions) {
+        auto visitor = SegmentVisitor::Build(ss, pair.first);
+        if (visitor == nullptr) {
+            return Status(DB_ERROR, "Fail to build segment visitor with id " + std::to_string(pair.first));
+        }
+        segment::SegmentReader segment_reader(options_.meta_.path_, visitor);
+
+        auto& positions = pair.second;
+        std::vector<int64_t> offsets;
+        offsets.reserve(positions.size());
+        for (auto pos : positions) {
+            offsets.push_back(locations[pos].offset_);
+        }
+
+        DataChunkPtr chunk;
+        STATUS_CHECK(segment_reader.LoadFieldsEntities(field_names, offsets, chunk));
+        for (int64_t i = 0; i < positions.size(); ++i) {
+            position_map[positions[i]] = std::make_pair(chunk, i);
+        }
+    }
+    rc.RecordSection("load entities from " + std::to_string(segment_positions.size()) + " segments");
+
+    // combine entities into one chunk by result sequence
+    Segment temp_segment;
+    auto& fields = ss->GetResources<snapshot::Field>();
+    for (auto& kv : fields) {
+        STATUS_CHECK(temp_segment.AddField(kv.second.Get()));
+    }
+
+    valid_row.clear();
+    valid_row.resize(locations.size(), false);
+    int64_t valid_count = 0;
+    for (auto& pair : position_map) {
+        valid_count += (pair.first != nullptr) ? 1 : 0;
+    }
+    if (valid_count > 0) {
+        temp_segment.Reserve(field_names, valid_count);
+    }
+    for (int64_t i = 0; i < position_map.size(); ++i) {
+        auto& pair = position_map[i];
+        if (pair.first != nullptr) {
+            valid_row[i] = true;
+            temp_segment.AppendChunk(pair.first, pair.second, pair.second);
+        }
+    }
+
+    data_chunk = std::make_shared<DataChunk>();
+    data_chunk->count_ = temp_segment.GetRowCount();
+    data_chunk->fixed_fields_.swap(temp_segment.GetFixedFields());
+    data_chunk->variable_fields_.swap(temp_segment.GetVariableFields());
+
+    return Status::OK();
+}
+
 void
 DBImpl::InternalFlush(const std::string& collection_name, bool merge) {
     Status status;
@@ -913,6 +1244,7 @@ DBImpl::InternalFlush(const std::string& collection_name, bool merge) {
             }
         }
     }
+    MarkIndexPending(flushed_collection_ids);
 
     if (merge) {
         StartMergeTask(flushed_collection_ids, false);
@@ -984,6 +1316,50 @@ DBImpl::TimingMetricThread() {
     }
 }
 
+Status
+DBImpl::ReloadWarmSet(const std::string& warm_set_path) {
+    TimeRecorder rc("DBImpl::ReloadWarmSet");
+    std::lock_guard<std::mutex> run_lock(preload_run_mutex_);
+
+    std::vector<PreloadItem> items;
+    STATUS_CHECK(CollectWarmSetItems(warm_set_path, items));
+
+    LoadPreloadItems(items);
+    rc.ElapseFromBegin("Reload warm set totally cost");
+
+    return Status::OK();
+}
+
+void
+DBImpl::TimingWarmSetThread() {
+    SetThreadName("timing_warmset");
+    std::string warm_set_path = options_.meta_.path_ + WARM_SET_FILE;
+
+    // reload what was hot before last shutdown, then keep the warm set up to date for next restart
+    auto status = ReloadWarmSet(warm_set_path);
+    if (!status.ok()) {
+        LOG_ENGINE_DEBUG_ << "Skip reloading cache warm set: " << status.message();
+    }
+
+    while (true) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            LOG_ENGINE_DEBUG_ << "DB background warm set thread exit";
+            break;
+        }
+
+        swn_warm_set_.Wait_For(std::chrono::seconds(options_.warm_set_interval_));
+
+        // an empty cache, such as right after a restart, must not overwrite the last warm set
+        auto& cache_mgr = cache::CpuCacheMgr::GetInstance();
+        if (cache_mgr.ItemCount() > 0) {
+            status = cache_mgr.SaveWarmSet(warm_set_path);
+            if (!status.ok()) {
+                LOG_ENGINE_WARNING_ << "Failed to save cache warm set: " << status.message();
+            }
+        }
+    }
+}
+
 void
 DBImpl::StartBuildIndexTask(const std::vector<std::string>& collection_names, bool force_build) {
     if (collection_names.empty()) {
@@ -1017,46 +1393,60 @@ DBImpl::BackgroundBuildIndexTask(std::vector<std::string> collection_names, bool
 
     std::unique_lock<std::mutex> lock(build_index_mutex_);
 
+    // put build index jobs of all collections into scheduler together, so that the builder pool
+    // could run them concurrently and pick the largest segments first
+    std::vector<std::pair<std::string, scheduler::BuildIndexJobPtr>> jobs;
     for (const auto& collection_name : collection_names) {
         snapshot::ScopedSnapshotT latest_ss;
         auto status = snapshot::Snapshots::GetInstance().GetSnapshot(latest_ss, collection_name);
         if (!status.ok()) {
-            return;
+            continue;
         }
         SnapshotVisitor ss_visitor(latest_ss);
 
         snapshot::IDS_TYPE segment_ids;
         ss_visitor.SegmentsToIndex("", segment_ids, force_build);
-        if (segment_ids.empty()) {
-            continue;
-        }
 
         // check index retry times
-        IgnoreIndexFailedSegments(collection_name, segment_ids);
+        if (!segment_ids.empty()) {
+            IgnoreIndexFailedSegments(collection_name, segment_ids);
+        }
         if (segment_ids.empty()) {
+            std::lock_guard<std::mutex> lck(index_pending_mutex_);
+            index_pending_ids_.erase(latest_ss->GetCollectionId());
             continue;
         }
 
         // start build index job
         LOG_ENGINE_DEBUG_ << "Create BuildIndexJob for " << segment_ids.size() << " segments of " << collection_name;
-        cache::CpuCacheMgr::GetInstance().PrintInfo();  // print cache info before build index
         scheduler::BuildIndexJobPtr job = std::make_shared<scheduler::BuildIndexJob>(latest_ss, options_, segment_ids);
+        jobs.emplace_back(collection_name, job);
+    }
 
-        IncreaseLiveBuildTaskNum();
-        scheduler::JobMgrInst::GetInstance()->Put(job);
-        job->WaitFinish();
-        DecreaseLiveBuildTaskNum();
+    if (jobs.empty()) {
+        return;
+    }
 
-        cache::CpuCacheMgr::GetInstance().PrintInfo();  // print cache info after build index
+    cache::CpuCacheMgr::GetInstance().PrintInfo();  // print cache info before build index
+    for (auto& pair : jobs) {
+        AddLiveBuildJob(pair.second);
+        scheduler::JobMgrInst::GetInstance()->Put(pair.second);
+    }
+
+    for (auto& pair : jobs) {
+        auto& job = pair.second;
+        job->WaitFinish();
+        RemoveLiveBuildJob(job);
 
         // record failed segments, avoid build index hang
-        snapshot::IDS_TYPE& failed_ids = job->FailedSegments();
-        MarkIndexFailedSegments(collection_name, failed_ids);
+        const snapshot::IDS_TYPE& failed_ids = job->FailedSegments();
+        MarkIndexFailedSegments(pair.first, failed_ids);
 
         if (!job->status().ok()) {
             LOG_ENGINE_ERROR_ << job->status().message();
         }
     }
+    cache::CpuCacheMgr::GetInstance().PrintInfo();  // print cache info after build index
 }
 
 void
@@ -1074,13 +1464,38 @@ DBImpl::TimingIndexThread() {
 
         swn_index_.Wait_For(std::chrono::seconds(BACKGROUND_INDEX_INTERVAL));
 
+        // loaded collections and those flushed or merged since their last build round, an evicted collection
+        // with pending segments is loaded again here
         std::vector<std::string> collection_names;
-        snapshot::Snapshots::GetInstance().GetCollectionNames(collection_names);
+        snapshot::Snapshots::GetInstance().GetLoadedCollectionNames(collection_names);
+        std::set<int64_t> pending_ids;
+        {
+            std::lock_guard<std::mutex> lck(index_pending_mutex_);
+            pending_ids = index_pending_ids_;
+        }
+        for (auto collection_id : pending_ids) {
+            snapshot::ScopedSnapshotT ss;
+            auto status = snapshot::Snapshots::GetInstance().GetSnapshot(ss, collection_id);
+            if (!status.ok()) {
+                std::lock_guard<std::mutex> lck(index_pending_mutex_);
+                index_pending_ids_.erase(collection_id);  // dropped
+                continue;
+            }
+            if (std::find(collection_names.begin(), collection_names.end(), ss->GetName()) == collection_names.end()) {
+                collection_names.push_back(ss->GetName());
+            }
+        }
         WaitMergeFileFinish();
         StartBuildIndexTask(collection_names, false);
     }
 }
 
+void
+DBImpl::MarkIndexPending(const std::set<int64_t>& collection_ids) {
+    std::lock_guard<std::mutex> lck(index_pending_mutex_);
+    index_pending_ids_.insert(collection_ids.begin(), collection_ids.end());
+}
+
 void
 DBImpl::WaitBuildIndexFinish() {
     //    LOG_ENGINE_DEBUG_ << "Begin WaitBuildIndexFinish";
@@ -1132,6 +1547,7 @@ DBImpl::BackgroundMerge(std::set<int64_t> collection_ids, bool force_merge_all)
             LOG_ENGINE_ERROR_ << "Failed to get merge files for collection id: " << collection_id
                               << " reason:" << status.message();
         }
+        MarkIndexPending({collection_id});
 
         if (!initialized_.load(std::memory_order_acquire)) {
             LOG_ENGINE_DEBUG_ << "Server will shutdown, skip merge action for collection id: " << collection_id;
@@ -1151,39 +1567,37 @@ DBImpl::WaitMergeFileFinish() {
 }
 
 void
-DBImpl::SuspendIfFirst() {
-    std::lock_guard<std::mutex> lock(suspend_build_mutex_);
-    if (++live_search_num_ == 1) {
-        LOG_ENGINE_TRACE_ << "live_search_num_: " << live_search_num_;
-        knowhere::BuilderSuspend();
-    }
-}
-
-void
-DBImpl::ResumeIfLast() {
-    std::lock_guard<std::mutex> lock(suspend_build_mutex_);
-    if (--live_search_num_ == 0) {
-        LOG_ENGINE_TRACE_ << "live_search_num_: " << live_search_num_;
-        knowhere::BuildResume();
-    }
+DBImpl::AddLiveBuildJob(const scheduler::BuildIndexJobPtr& job) {
+    std::lock_guard<std::mutex> lock(live_build_count_mutex_);
+    live_build_jobs_.insert(std::make_pair(job->collection_id(), job));
 }
 
 void
-DBImpl::IncreaseLiveBuildTaskNum() {
+DBImpl::RemoveLiveBuildJob(const scheduler::BuildIndexJobPtr& job) {
     std::lock_guard<std::mutex> lock(live_build_count_mutex_);
-    ++live_build_num_;
+    auto range = live_build_jobs_.equal_range(job->collection_id());
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        if (iter->second == job) {
+            live_build_jobs_.erase(iter);
+            break;
+        }
+    }
 }
 
 void
-DBImpl::DecreaseLiveBuildTaskNum() {
+DBImpl::CancelBuildIndexJobs(snapshot::ID_TYPE collection_id) {
     std::lock_guard<std::mutex> lock(live_build_count_mutex_);
-    --live_build_num_;
+    auto range = live_build_jobs_.equal_range(collection_id);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        LOG_ENGINE_DEBUG_ << "Cancel build index job " << iter->second->id() << " of collection " << collection_id;
+        iter->second->Cancel();
+    }
 }
 
 bool
 DBImpl::IsBuildingIndex() {
     std::lock_guard<std::mutex> lock(live_build_count_mutex_);
-    return live_build_num_ > 0;
+    return !live_build_jobs_.empty();
 }
 
 void
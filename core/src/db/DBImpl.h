@@ -24,6 +24,7 @@
 #include "db/DB.h"
 
 #include "config/ConfigMgr.h"
+#include "scheduler/job/BuildIndexJob.h"
 #include "utils/ThreadPool.h"
 
 namespace milvus {
@@ -109,6 +110,12 @@ class DBImpl : public DB, public ConfigObserver {
     LoadCollection(const server::ContextPtr& context, const std::string& collection_name,
                    const std::vector<std::string>& field_names, bool force) override;
 
+    Status
+    PreloadCollections(const server::ContextPtr& context, const std::vector<std::string>& collection_names) override;
+
+    void
+    GetPreloadProgress(PreloadProgress& progress) override;
+
     Status
     Flush(const std::string& collection_name) override;
 
@@ -120,16 +127,39 @@ class DBImpl : public DB, public ConfigObserver {
     Status
     Compact(const server::ContextPtr& context, const std::string& collection_name, double threshold) override;
 
+    // Note: the imported entities skip wal and insert buffer, see BulkImporter for the layout of the path
+    Status
+    BulkImport(const server::ContextPtr& context, const std::string& collection_name, const std::string& partition_name,
+               const std::string& path, int64_t& row_count) override;
+
     void
     ConfigUpdate(const std::string& name) override;
 
     bool
     IsBuildingIndex() override;
 
+    struct PreloadItem {
+        std::shared_ptr<LoadCollectionHandler> handler_;
+        snapshot::SegmentPtr segment_;
+        int64_t size_;
+    };
+
+    // segments of the saved warm set which still exist, the most accessed first
+    Status
+    CollectWarmSetItems(const std::string& warm_set_path, std::vector<PreloadItem>& items);
+
+    Status
+    ReloadWarmSet(const std::string& warm_set_path);
+
  private:
     void
     InternalFlush(const std::string& collection_name = "", bool merge = true);
 
+    Status
+    GetEntityByLocation(const snapshot::ScopedSnapshotT& ss, const ResultLocations& locations,
+                        const std::vector<std::string>& field_names, std::vector<bool>& valid_row,
+                        DataChunkPtr& data_chunk);
+
     void
     TimingFlushThread();
 
@@ -139,6 +169,9 @@ class DBImpl : public DB, public ConfigObserver {
     void
     TimingMetricThread();
 
+    void
+    TimingWarmSetThread();
+
     void
     StartBuildIndexTask(const std::vector<std::string>& collection_names, bool force_build);
 
@@ -161,19 +194,26 @@ class DBImpl : public DB, public ConfigObserver {
     WaitMergeFileFinish();
 
     void
-    SuspendIfFirst();
+    AddLiveBuildJob(const scheduler::BuildIndexJobPtr& job);
 
     void
-    ResumeIfLast();
+    RemoveLiveBuildJob(const scheduler::BuildIndexJobPtr& job);
 
     void
-    IncreaseLiveBuildTaskNum();
+    CancelBuildIndexJobs(snapshot::ID_TYPE collection_id);
 
     void
-    DecreaseLiveBuildTaskNum();
+    MarkIndexFailedSegments(const std::string& collection_name, const snapshot::IDS_TYPE& failed_ids);
 
     void
-    MarkIndexFailedSegments(const std::string& collection_name, const snapshot::IDS_TYPE& failed_ids);
+    MarkIndexPending(const std::set<int64_t>& collection_ids);
+
+    Status
+    CollectPreloadItems(const server::ContextPtr& context, const std::vector<std::string>& collection_names,
+                        std::vector<PreloadItem>& items);
+
+    void
+    LoadPreloadItems(const std::vector<PreloadItem>& items);
 
     void
     IgnoreIndexFailedSegments(const std::string& collection_name, snapshot::IDS_TYPE& segment_ids);
@@ -191,10 +231,12 @@ class DBImpl : public DB, public ConfigObserver {
     std::thread bg_flush_thread_;
     std::thread bg_metric_thread_;
     std::thread bg_index_thread_;
+    std::thread bg_warm_set_thread_;
 
     SimpleWaitNotify swn_flush_;
     SimpleWaitNotify swn_metric_;
     SimpleWaitNotify swn_index_;
+    SimpleWaitNotify swn_warm_set_;
 
     SimpleWaitNotify flush_req_swn_;
     SimpleWaitNotify index_req_swn_;
@@ -214,13 +256,18 @@ class DBImpl : public DB, public ConfigObserver {
 
     std::mutex build_index_mutex_;
 
-    std::mutex flush_merge_compact_mutex_;
+    // collections which may have segments to index, kept until a build round finds nothing to do
+    std::set<int64_t> index_pending_ids_;
+    std::mutex index_pending_mutex_;
 
-    int64_t live_search_num_ = 0;
-    std::mutex suspend_build_mutex_;
+    std::mutex flush_merge_compact_mutex_;
 
-    int64_t live_build_num_ = 0;
+    std::unordered_multimap<snapshot::ID_TYPE, scheduler::BuildIndexJobPtr> live_build_jobs_;
     std::mutex live_build_count_mutex_;
+
+    PreloadProgress preload_progress_;
+    std::mutex preload_mutex_;
+    std::mutex preload_run_mutex_;  // one preload or warm set reload at a time
 };  // SSDBImpl
 
 using DBImplPtr = std::shared_ptr<DBImpl>;
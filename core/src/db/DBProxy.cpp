@@ -160,6 +160,19 @@ DBProxy::LoadCollection(const server::ContextPtr& context, const std::string& co
     return db_->LoadCollection(context, collection_name, field_names, force);
 }
 
+Status
+DBProxy::PreloadCollections(const server::ContextPtr& context, const std::vector<std::string>& collection_names) {
+    DB_CHECK
+    return db_->PreloadCollections(context, collection_names);
+}
+
+void
+DBProxy::GetPreloadProgress(PreloadProgress& progress) {
+    if (db_ != nullptr) {
+        db_->GetPreloadProgress(progress);
+    }
+}
+
 Status
 DBProxy::Flush(const std::string& collection_name) {
     DB_CHECK
@@ -178,6 +191,13 @@ DBProxy::Compact(const server::ContextPtr& context, const std::string& collectio
     return db_->Compact(context, collection_name, threshold);
 }
 
+Status
+DBProxy::BulkImport(const server::ContextPtr& context, const std::string& collection_name,
+                    const std::string& partition_name, const std::string& path, int64_t& row_count) {
+    DB_CHECK
+    return db_->BulkImport(context, collection_name, partition_name, path, row_count);
+}
+
 bool
 DBProxy::IsBuildingIndex() {
     return db_ != nullptr && db_->IsBuildingIndex();
@@ -96,6 +96,12 @@ class DBProxy : public DB {
     LoadCollection(const server::ContextPtr& context, const std::string& collection_name,
                    const std::vector<std::string>& field_names, bool force) override;
 
+    Status
+    PreloadCollections(const server::ContextPtr& context, const std::vector<std::string>& collection_names) override;
+
+    void
+    GetPreloadProgress(PreloadProgress& progress) override;
+
     Status
     Flush(const std::string& collection_name) override;
 
@@ -105,6 +111,10 @@ class DBProxy : public DB {
     Status
     Compact(const server::ContextPtr& context, const std::string& collection_name, double threshold) override;
 
+    Status
+    BulkImport(const server::ContextPtr& context, const std::string& collection_name, const std::string& partition_name,
+               const std::string& path, int64_t& row_count) override;
+
     bool
     IsBuildingIndex() override;
 
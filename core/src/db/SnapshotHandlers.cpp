@@ -14,6 +14,7 @@
 #include "db/SnapshotUtils.h"
 #include "db/SnapshotVisitor.h"
 #include "db/Types.h"
+#include "db/Utils.h"
 #include "db/snapshot/ResourceHelper.h"
 #include "db/snapshot/Resources.h"
 #include "db/snapshot/Snapshot.h"
@@ -21,6 +22,7 @@
 #include "segment/SegmentReader.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 namespace milvus {
@@ -83,13 +85,15 @@ SegmentsToMergeCollector::Handle(const snapshot::SegmentCommitPtr& segment_commi
         return Status::OK();
     }
 
-    // if any field has build index, don't merge this segment
+    // if any field has build index, don't merge this segment,
+    // except the index could be extended incrementally, the merge task reuses it
     auto segment_visitor = engine::SegmentVisitor::Build(ss_, segment_commit->GetSegmentId());
     auto field_visitors = segment_visitor->GetFieldVisitors();
     bool has_index = false;
     for (auto& kv : field_visitors) {
         auto element_visitor = kv.second->GetElementVisitor(engine::FieldElementType::FET_INDEX);
-        if (element_visitor != nullptr && element_visitor->GetFile() != nullptr) {
+        if (element_visitor != nullptr && element_visitor->GetFile() != nullptr &&
+            !utils::SupportIncrementalIndex(element_visitor->GetElement()->GetTypeName())) {
             has_index = true;
             break;
         }
@@ -109,12 +113,23 @@ GetEntityByIdSegmentHandler::GetEntityByIdSegmentHandler(const std::shared_ptr<m
                                                          const std::vector<std::string>& field_names,
                                                          std::vector<bool>& valid_row)
     : BaseT(ss), context_(context), dir_root_(dir_root), ids_(ids), field_names_(field_names), valid_row_(valid_row) {
-    ids_left_ = ids_;
+    // search results may contain duplicated ids and -1 for empty slots, each id only need to be fetched once
+    std::unordered_set<idx_t> unique_ids;
+    ids_left_.reserve(ids_.size());
+    for (auto id : ids_) {
+        if (id >= 0 && unique_ids.insert(id).second) {
+            ids_left_.push_back(id);
+        }
+    }
     data_chunk_ = std::make_shared<engine::DataChunk>();
 }
 
 Status
 GetEntityByIdSegmentHandler::Handle(const snapshot::SegmentPtr& segment) {
+    if (ids_left_.empty()) {
+        return Status::OK();  // all ids have been found
+    }
+
     LOG_ENGINE_DEBUG_ << "Get entity by id in segment " << segment->GetID();
 
     auto segment_visitor = SegmentVisitor::Build(ss_, segment->GetID());
@@ -132,38 +147,47 @@ GetEntityByIdSegmentHandler::Handle(const snapshot::SegmentPtr& segment) {
     segment::DeletedDocsPtr deleted_docs_ptr;
     segment_reader.LoadDeletedDocs(deleted_docs_ptr);
 
+    // uid to offset map and deleted offsets are built only if any id pass the bloom filter
+    std::unordered_map<idx_t, int64_t> uid_offsets;
+    std::unordered_set<offset_t> deleted_offsets;
+    bool lookup_ready = false;
+    auto prepare_lookup = [&]() {
+        uid_offsets.reserve(uids.size());
+        for (int64_t i = 0; i < uids.size(); ++i) {
+            uid_offsets.insert(std::make_pair(uids[i], i));
+        }
+        if (deleted_docs_ptr) {
+            auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
+            deleted_offsets.insert(deleted_docs.begin(), deleted_docs.end());
+        }
+        lookup_ready = true;
+    };
+
     std::vector<idx_t> ids_in_this_segment;
     std::vector<int64_t> offsets;
-    for (auto it = ids_left_.begin(); it != ids_left_.end();) {
-        idx_t id = *it;
+    IDNumbers ids_not_found;
+    for (auto id : ids_left_) {
         // fast check using bloom filter
         if (!id_bloom_filter_ptr->Check(id)) {
-            ++it;
+            ids_not_found.push_back(id);
             continue;
         }
 
-        // check if id really exists in uids
-        auto found = std::find(uids.begin(), uids.end(), id);
-        if (found == uids.end()) {
-            ++it;
-            continue;
+        if (!lookup_ready) {
+            prepare_lookup();
         }
 
-        // check if this id is deleted
-        auto offset = std::distance(uids.begin(), found);
-        if (deleted_docs_ptr) {
-            auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
-            auto deleted = std::find(deleted_docs.begin(), deleted_docs.end(), offset);
-            if (deleted != deleted_docs.end()) {
-                ++it;
-                continue;
-            }
+        // check if id really exists in uids, and not deleted
+        auto found = uid_offsets.find(id);
+        if (found == uid_offsets.end() || deleted_offsets.find(found->second) != deleted_offsets.end()) {
+            ids_not_found.push_back(id);
+            continue;
         }
 
         ids_in_this_segment.push_back(id);
-        offsets.push_back(offset);
-        ids_left_.erase(it);
+        offsets.push_back(found->second);
     }
+    ids_left_.swap(ids_not_found);
 
     if (offsets.empty()) {
         return Status::OK();
@@ -226,6 +250,10 @@ LoadCollectionHandler::LoadCollectionHandler(const server::ContextPtr& context,
                                              const std::string& dir_root, const std::vector<std::string>& field_names,
                                              bool force)
     : BaseT(ss), context_(context), dir_root_(dir_root), field_names_(field_names), force_(force) {
+    // if the input field_names is empty, will load all fields of this collection
+    if (field_names_.empty()) {
+        field_names_ = ss_->GetFieldNames();
+    }
 }
 
 Status
@@ -236,11 +264,6 @@ LoadCollectionHandler::Handle(const snapshot::SegmentPtr& segment) {
     SegmentPtr segment_ptr;
     segment_reader->GetSegment(segment_ptr);
 
-    // if the input field_names is empty, will load all fields of this collection
-    if (field_names_.empty()) {
-        field_names_ = ss_->GetFieldNames();
-    }
-
     // SegmentReader will load data into cache
     for (auto& field_name : field_names_) {
         DataType ftype = DataType::NONE;
@@ -163,7 +163,8 @@ IsVectorField(const engine::snapshot::FieldPtr& field) {
 
 bool
 IsVectorField(engine::DataType type) {
-    return type == engine::DataType::VECTOR_FLOAT || type == engine::DataType::VECTOR_BINARY;
+    return type == engine::DataType::VECTOR_FLOAT || type == engine::DataType::VECTOR_BINARY ||
+           type == engine::DataType::VECTOR_FLOAT16;
 }
 
 Status
@@ -60,6 +60,13 @@ using VectorDistances = std::vector<VectorDistance>;
 using ResultIds = std::vector<faiss::Index::idx_t>;
 using ResultDistances = std::vector<faiss::Index::distance_t>;
 
+// where a search hit comes from, entity fields could be read by offset directly
+struct ResultLocation {
+    int64_t segment_id_ = -1;
+    int64_t offset_ = -1;
+};
+using ResultLocations = std::vector<ResultLocation>;
+
 using ConCurrentBitset = faiss::ConcurrentBitset;
 using ConCurrentBitsetPtr = faiss::ConcurrentBitsetPtr;
 
@@ -79,6 +86,7 @@ enum class DataType {
 
     VECTOR_BINARY = 100,
     VECTOR_FLOAT = 101,
+    VECTOR_FLOAT16 = 102,
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -163,10 +171,23 @@ struct QueryResult {
     uint64_t row_num_;
     engine::ResultIds result_ids_;
     engine::ResultDistances result_distances_;
+    engine::ResultLocations result_locations_;
+    // range search only: row_num_ + 1 offsets, results of query i are [result_lims_[i], result_lims_[i + 1])
+    std::vector<int64_t> result_lims_;
     engine::DataChunkPtr data_chunk_;
 };
 using QueryResultPtr = std::shared_ptr<QueryResult>;
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct PreloadProgress {
+    bool running_ = false;
+    int64_t total_segments_ = 0;
+    int64_t loaded_segments_ = 0;
+    int64_t skipped_segments_ = 0;  // not loaded since the cache is full
+    int64_t total_bytes_ = 0;
+    int64_t loaded_bytes_ = 0;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 struct DBMetaOptions {
     std::string path_;
@@ -186,6 +207,12 @@ struct DBOptions {
 
     bool metric_enable_ = false;
 
+    int64_t preload_concurrency_ = 4;
+
+    // cache warm set configurations
+    bool warm_set_enable_ = false;
+    int64_t warm_set_interval_ = 300;  // seconds
+
     // wal relative configurations
     bool wal_enable_ = false;
     std::string wal_path_;
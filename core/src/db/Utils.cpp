@@ -11,6 +11,7 @@
 
 #include "db/Utils.h"
 
+#include <faiss/FaissHook.h>
 #include <fiu/fiu-local.h>
 
 #include <unistd.h>
@@ -232,8 +233,8 @@ SplitChunk(const DataChunkPtr& chunk, int64_t segment_row_count, std::vector<Dat
             BinaryDataPtr data = std::make_shared<BinaryData>();
             int64_t data_length = field_width * count_to_copy;
             int64_t offset = field_width * copied_count;
-            data->data_.resize(data_length);
-            memcpy(data->data_.data(), pair.second->data_.data() + offset, data_length);
+            const uint8_t* src = pair.second->data_.data() + offset;
+            data->data_.assign(src, src + data_length);
             new_chunk->fixed_fields_.insert(std::make_pair(pair.first, data));
         }
 
@@ -252,6 +253,29 @@ SplitChunk(const DataChunkPtr& chunk, int64_t segment_row_count, std::vector<Dat
     return Status::OK();
 }
 
+Status
+FloatToFloat16(std::vector<uint8_t>& data) {
+    if (data.size() % sizeof(float) != 0) {
+        return Status(DB_ERROR, "Invalid float vector data size");
+    }
+
+    size_t n = data.size() / sizeof(float);
+    std::vector<uint8_t> converted(n * sizeof(uint16_t));
+    faiss::fvec_to_fp16(reinterpret_cast<const float*>(data.data()), reinterpret_cast<uint16_t*>(converted.data()),
+                        n);
+    data.swap(converted);
+    return Status::OK();
+}
+
+void
+Float16ToFloat(std::vector<uint8_t>& data) {
+    size_t n = data.size() / sizeof(uint16_t);
+    std::vector<uint8_t> converted(n * sizeof(float));
+    faiss::fp16_to_fvec(reinterpret_cast<const uint16_t*>(data.data()), reinterpret_cast<float*>(converted.data()),
+                        n);
+    data.swap(converted);
+}
+
 bool
 RequireRawFile(const std::string& index_type) {
     return index_type == knowhere::IndexEnum::INDEX_FAISS_IVFFLAT || index_type == knowhere::IndexEnum::INDEX_NSG ||
@@ -263,6 +287,11 @@ RequireCompressFile(const std::string& index_type) {
     return index_type == knowhere::IndexEnum::INDEX_RHNSWSQ || index_type == knowhere::IndexEnum::INDEX_RHNSWPQ;
 }
 
+bool
+SupportIncrementalIndex(const std::string& index_type) {
+    return index_type == knowhere::IndexEnum::INDEX_HNSW;
+}
+
 void
 ListFiles(const std::string& root_path, const std::string& prefix) {
     std::experimental::filesystem::recursive_directory_iterator iter(root_path);
@@ -62,12 +62,23 @@ GetSizeOfChunk(const engine::DataChunkPtr& chunk);
 Status
 SplitChunk(const DataChunkPtr& chunk, int64_t segment_row_count, std::vector<DataChunkPtr>& chunks);
 
+// convert float vector data to half precision in place, clients always send float vectors
+Status
+FloatToFloat16(std::vector<uint8_t>& data);
+
+void
+Float16ToFloat(std::vector<uint8_t>& data);
+
 bool
 RequireRawFile(const std::string& index_type);
 
 bool
 RequireCompressFile(const std::string& index_type);
 
+// the index could be extended by adding vectors into an existing index, no need to rebuild it from scratch
+bool
+SupportIncrementalIndex(const std::string& index_type);
+
 void
 ListFiles(const std::string& root_path, const std::string& prefix);
 
@@ -20,6 +20,7 @@
 
 #include "db/Types.h"
 #include "query/GeneralQuery.h"
+#include "server/context/QueryTrace.h"
 #include "utils/Status.h"
 
 namespace milvus {
@@ -31,6 +32,7 @@ struct ExecutionEngineContext {
     query::QueryPtr query_ptr_;
     QueryResultPtr query_result_;
     TargetFields target_fields_;  // for build index task, which field should be build
+    server::QueryTracePtr query_trace_;
 };
 using ExecutionEngineContextPtr = std::shared_ptr<ExecutionEngineContext>;
 
@@ -11,6 +11,9 @@
 
 #include "db/engine/ExecutionEngineImpl.h"
 
+#include <faiss/FaissHook.h>
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 #include <unordered_map>
 #include <utility>
@@ -34,6 +37,7 @@
 #include "knowhere/index/vector_index/ConfAdapterMgr.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIDMAP_FP16.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 #include "knowhere/index/vector_index/VecIndexFactory.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -132,7 +136,7 @@ ExecutionEngineImpl::Load(const TargetFields& field_names) {
         segment_ptr->GetFieldType(name, field_type);
 
         bool index_exist = false;
-        if (field_type == DataType::VECTOR_FLOAT || field_type == DataType::VECTOR_BINARY) {
+        if (IsVectorField(field_type)) {
             bool valid_metric_type = false;
             if (!context_.query_ptr_) {
                 valid_metric_type = true;
@@ -223,26 +227,16 @@ ExecutionEngineImpl::CopyToGpu(uint64_t device_id) {
 }
 
 void
-MapAndCopyResult(const knowhere::DatasetPtr& dataset, const std::vector<idx_t>& uids, int64_t nq, int64_t k,
-                 float* distances, int64_t* labels) {
-    auto res_ids = dataset->Get<int64_t*>(knowhere::meta::IDS);
-    auto res_dist = dataset->Get<float*>(knowhere::meta::DISTANCE);
-
-    memcpy(distances, res_dist, sizeof(float) * nq * k);
-
-    /* map offsets to ids */
-    int64_t num = nq * k;
+MapResult(const std::vector<idx_t>& uids, int64_t segment_id, int64_t num, int64_t* labels, ResultLocation* locations) {
+    /* labels hold the offsets written by the index, keep them as locations and map to ids in place */
     for (int64_t i = 0; i < num; ++i) {
-        int64_t offset = res_ids[i];
+        int64_t offset = labels[i];
         if (offset != -1) {
             labels[i] = uids[offset];
-        } else {
-            labels[i] = -1;
+            locations[i].segment_id_ = segment_id;
+            locations[i].offset_ = offset;
         }
     }
-
-    free(res_ids);
-    free(res_dist);
 }
 
 Status
@@ -261,8 +255,6 @@ ExecutionEngineImpl::VecSearch(milvus::engine::ExecutionEngineContext& context,
     uint64_t topk = vector_param->topk;
 
     context.query_result_ = std::make_shared<QueryResult>();
-    context.query_result_->result_ids_.resize(topk * nq);
-    context.query_result_->result_distances_.resize(topk * nq);
 
     milvus::json conf = vector_param->extra_params;
     conf[knowhere::meta::TOPK] = topk;
@@ -273,6 +265,15 @@ ExecutionEngineImpl::VecSearch(milvus::engine::ExecutionEngineContext& context,
         throw Exception(DB_ERROR, "Illegal search params");
     }
 
+    // search refine_k candidates and rerank them with exact distances from raw vectors
+    int64_t refine_k = topk;
+    if (conf.contains(knowhere::IndexParams::refine_k)) {
+        refine_k = conf[knowhere::IndexParams::refine_k].get<int64_t>();
+    }
+    bool refine = !vector_param->range_search && refine_k > (int64_t)topk && !query_vector.float_data.empty() &&
+                  (vector_param->metric_type == knowhere::Metric::L2 ||
+                   vector_param->metric_type == knowhere::Metric::IP);
+
     if (hybrid) {
         //        HybridLoad();
     }
@@ -284,10 +285,50 @@ ExecutionEngineImpl::VecSearch(milvus::engine::ExecutionEngineContext& context,
     } else {
         dataset = knowhere::GenDataset(nq, vec_index->Dim(), query_vector.binary_data.data());
     }
-    auto result = vec_index->Query(dataset, conf);
+    auto& query_result = context.query_result_;
+    if (vector_param->range_search) {
+        // results are variable length, result_lims_ tells where the results of each query start
+        conf[knowhere::meta::RADIUS] = vector_param->radius;
+        knowhere::DatasetPtr result;
+        try {
+            result = vec_index->QueryByRange(dataset, conf);
+        } catch (knowhere::KnowhereException& e) {
+            LOG_ENGINE_ERROR_ << LogOut("[%s][%ld] Range search failed: %s", "search", 0, e.what());
+            return Status(DB_ERROR, e.what());
+        }
+        auto lims = result->Get<int64_t*>(knowhere::meta::LIMS);
+        auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        auto distances = result->Get<float*>(knowhere::meta::DISTANCE);
+        query_result->result_lims_.assign(lims, lims + nq + 1);
+        query_result->result_ids_.assign(ids, ids + lims[nq]);
+        query_result->result_distances_.assign(distances, distances + lims[nq]);
+        free(lims);
+        free(ids);
+        free(distances);
+        rc.RecordSection("range search");
+    } else if (refine) {
+        query_result->result_ids_.resize(topk * nq);
+        query_result->result_distances_.resize(topk * nq);
+        conf[knowhere::meta::TOPK] = refine_k;
+        std::vector<int64_t> candidates(nq * refine_k);
+        std::vector<float> candidate_distances(nq * refine_k);
+        vec_index->QueryInto(dataset, conf, candidates.data(), candidate_distances.data(), nullptr);
+        rc.RecordSection("search " + std::to_string(refine_k) + " candidates");
+
+        STATUS_CHECK(RefineResult(vector_param, candidates, refine_k, query_result->result_ids_.data(),
+                                  query_result->result_distances_.data()));
+        rc.RecordSection("refine");
+    } else {
+        query_result->result_ids_.resize(topk * nq);
+        query_result->result_distances_.resize(topk * nq);
+        vec_index->QueryInto(dataset, conf, query_result->result_ids_.data(), query_result->result_distances_.data(),
+                             nullptr);
+    }
 
-    MapAndCopyResult(result, vec_index->GetUids(), nq, topk, context.query_result_->result_distances_.data(),
-                     context.query_result_->result_ids_.data());
+    auto& segment = segment_reader_->GetSegmentVisitor()->GetSegment();
+    query_result->result_locations_.resize(query_result->result_ids_.size());
+    MapResult(vec_index->GetUids(), segment->GetID(), query_result->result_ids_.size(),
+              query_result->result_ids_.data(), query_result->result_locations_.data());
 
     if (hybrid) {
         //        HybridUnset();
@@ -297,6 +338,81 @@ ExecutionEngineImpl::VecSearch(milvus::engine::ExecutionEngineContext& context,
     return Status::OK();
 }
 
+Status
+ExecutionEngineImpl::RefineResult(const query::VectorQueryPtr& vector_param, const std::vector<int64_t>& candidates,
+                                  int64_t refine_k, int64_t* offsets, float* distances) {
+    int64_t nq = vector_param->nq;
+    int64_t topk = vector_param->topk;
+    auto& float_data = vector_param->query_vector.float_data;
+    int64_t dim = float_data.size() / nq;
+    bool is_ip = (vector_param->metric_type == knowhere::Metric::IP);
+
+    // read each candidate once, candidates of different queries overlap
+    std::vector<int64_t> entity_offsets;
+    entity_offsets.reserve(candidates.size());
+    for (auto offset : candidates) {
+        if (offset != -1) {
+            entity_offsets.push_back(offset);
+        }
+    }
+    std::sort(entity_offsets.begin(), entity_offsets.end());
+    entity_offsets.erase(std::unique(entity_offsets.begin(), entity_offsets.end()), entity_offsets.end());
+
+    BinaryDataPtr raw;
+    std::vector<float> decoded;
+    const float* vectors = nullptr;
+    if (!entity_offsets.empty()) {
+        STATUS_CHECK(segment_reader_->LoadEntities(vector_param->field_name, entity_offsets, raw));
+        vectors = reinterpret_cast<const float*>(raw->data_.data());
+
+        SegmentPtr segment_ptr;
+        segment_reader_->GetSegment(segment_ptr);
+        DataType field_type = DataType::NONE;
+        segment_ptr->GetFieldType(vector_param->field_name, field_type);
+        if (field_type == DataType::VECTOR_FLOAT16) {
+            decoded.resize(entity_offsets.size() * dim);
+            faiss::fp16_to_fvec(reinterpret_cast<const uint16_t*>(raw->data_.data()), decoded.data(), decoded.size());
+            vectors = decoded.data();
+        }
+    }
+
+    using Candidate = std::pair<float, int64_t>;
+    auto compare = [is_ip](const Candidate& a, const Candidate& b) {
+        return is_ip ? (a.first > b.first || (a.first == b.first && a.second < b.second))
+                     : (a.first < b.first || (a.first == b.first && a.second < b.second));
+    };
+    std::vector<Candidate> scored(refine_k);
+    for (int64_t i = 0; i < nq; ++i) {
+        const float* query = float_data.data() + i * dim;
+        int64_t num = 0;
+        for (int64_t j = 0; j < refine_k; ++j) {
+            int64_t offset = candidates[i * refine_k + j];
+            if (offset == -1) {
+                continue;
+            }
+            auto pos = std::lower_bound(entity_offsets.begin(), entity_offsets.end(), offset) - entity_offsets.begin();
+            auto vector = vectors + pos * dim;
+            float dist = is_ip ? faiss::fvec_inner_product(query, vector, dim) : faiss::fvec_L2sqr(query, vector, dim);
+            scored[num++] = std::make_pair(dist, offset);
+        }
+
+        int64_t keep = std::min(num, topk);
+        std::partial_sort(scored.begin(), scored.begin() + keep, scored.begin() + num, compare);
+        for (int64_t j = 0; j < topk; ++j) {
+            if (j < keep) {
+                offsets[i * topk + j] = scored[j].second;
+                distances[i * topk + j] = scored[j].first;
+            } else {
+                offsets[i * topk + j] = -1;
+                distances[i * topk + j] =
+                    is_ip ? -std::numeric_limits<float>::max() : std::numeric_limits<float>::max();
+            }
+        }
+    }
+
+    return Status::OK();
+}
+
 Status
 ExecutionEngineImpl::Search(ExecutionEngineContext& context) {
     TimeRecorder rc(LogOut("[%s][%ld] ExecutionEngineImpl::Search", "search", 0));
@@ -318,8 +434,7 @@ ExecutionEngineImpl::Search(ExecutionEngineContext& context) {
                 return Status(SERVER_INVALID_DSL_PARAMETER, "Field: " + name + " is not existed");
             }
             auto field = field_visitor->GetField();
-            if (field->GetFtype() == static_cast<snapshot::FTYPE_TYPE>(engine::DataType::VECTOR_FLOAT) ||
-                field->GetFtype() == static_cast<snapshot::FTYPE_TYPE>(engine::DataType::VECTOR_BINARY)) {
+            if (IsVectorField(field)) {
                 STATUS_CHECK(segment_ptr->GetVectorIndex(name, vec_index));
             } else {
                 attr_type.insert(std::make_pair(name, static_cast<engine::DataType>(field->GetFtype())));
@@ -329,7 +444,11 @@ ExecutionEngineImpl::Search(ExecutionEngineContext& context) {
         list = vec_index->GetBlacklist();
         entity_count_ = list->capacity();
         // Parse general query
-        auto status = ExecBinaryQuery(context.query_ptr_->root, bitset, attr_type, vector_placeholder);
+        Status status;
+        {
+            server::QueryStageTimer filter_timer(context.query_trace_, server::QueryStage::SCALAR_FILTER);
+            status = ExecBinaryQuery(context.query_ptr_->root, bitset, attr_type, vector_placeholder);
+        }
         if (!status.ok()) {
             return status;
         }
@@ -350,7 +469,10 @@ ExecutionEngineImpl::Search(ExecutionEngineContext& context) {
             vector_param->nq = vector_param->query_vector.binary_data.size() * 8 / vec_index->Dim();
         }
 
-        status = VecSearch(context, context.query_ptr_->vectors.at(vector_placeholder), vec_index);
+        {
+            server::QueryStageTimer search_timer(context.query_trace_, server::QueryStage::VECTOR_SEARCH);
+            status = VecSearch(context, context.query_ptr_->vectors.at(vector_placeholder), vec_index);
+        }
         if (!status.ok()) {
             return status;
         }
@@ -812,7 +934,14 @@ ExecutionEngineImpl::BuildKnowhereIndex(const std::string& field_name, const Col
     std::vector<idx_t> uids;
     ConCurrentBitsetPtr blacklist;
     knowhere::DatasetPtr dataset;
-    if (from_index) {
+    std::vector<float> decoded;
+    if (auto fp16_from_index = std::dynamic_pointer_cast<knowhere::IDMAP_FP16>(index_raw)) {
+        // indexes are built from float vectors, decode the half precision raw data
+        fp16_from_index->DecodeRawVectors(decoded);
+        dataset = knowhere::GenDatasetWithIds(row_count, dimension, decoded.data(), fp16_from_index->GetRawIds());
+        uids = fp16_from_index->GetUids();
+        blacklist = fp16_from_index->GetBlacklist();
+    } else if (from_index) {
         dataset =
             knowhere::GenDatasetWithIds(row_count, dimension, from_index->GetRawVectors(), from_index->GetRawIds());
         uids = from_index->GetUids();
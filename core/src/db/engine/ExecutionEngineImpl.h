@@ -45,6 +45,10 @@ class ExecutionEngineImpl : public ExecutionEngine {
     VecSearch(ExecutionEngineContext& context, const query::VectorQueryPtr& vector_param,
               knowhere::VecIndexPtr& vec_index, bool hybrid = false);
 
+    Status
+    RefineResult(const query::VectorQueryPtr& vector_param, const std::vector<int64_t>& candidates, int64_t refine_k,
+                 int64_t* offsets, float* distances);
+
     knowhere::VecIndexPtr
     CreateVecIndex(const std::string& index_name, knowhere::IndexMode mode);
 
@@ -0,0 +1,300 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/insert/BulkImporter.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "codecs/BlockFormat.h"
+#include "codecs/Codec.h"
+#include "codecs/ExtraFileInfo.h"
+#include "db/IDGenerator.h"
+#include "db/SnapshotUtils.h"
+#include "db/Utils.h"
+#include "db/insert/MemSegment.h"
+#include "segment/Segment.h"
+#include "storage/disk/DiskIOReader.h"
+#include "storage/disk/DiskIOWriter.h"
+#include "storage/disk/DiskOperation.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr int64_t VECS_HEADER_SIZE = sizeof(int32_t);
+
+storage::FSHandlerPtr
+CreateFSHandler(const std::string& directory) {
+    storage::IOReaderPtr reader_ptr = std::make_shared<storage::DiskIOReader>();
+    storage::IOWriterPtr writer_ptr = std::make_shared<storage::DiskIOWriter>();
+    storage::OperationPtr operation_ptr = std::make_shared<storage::DiskOperation>(directory);
+    return std::make_shared<storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+}
+
+}  // namespace
+
+BulkImporter::BulkImporter(const snapshot::ScopedSnapshotT& ss, int64_t partition_id, const std::string& path,
+                           const DBOptions& options)
+    : ss_(ss), partition_id_(partition_id), path_(path), options_(options) {
+}
+
+Status
+BulkImporter::Import(int64_t& row_count) {
+    TimeRecorder recorder("BulkImporter::Import " + path_);
+
+    row_count = 0;
+    STATUS_CHECK(PrepareColumns(row_count));
+    if (row_count == 0) {
+        return Status(DB_ERROR, "No entity to import in " + path_);
+    }
+
+    int64_t segment_row_count = 0;
+    GetSegmentRowCount(ss_->GetCollection(), segment_row_count);
+    segment_row_count = std::max<int64_t>(segment_row_count, 1);
+
+    snapshot::OperationContext context;
+    auto operation = std::make_shared<snapshot::MultiSegmentsOperation>(context, ss_);
+    operation->SetContextLsn(ss_->GetMaxLsn());  // keep the wal position of the collection
+
+    for (int64_t from = 0; from < row_count; from += segment_row_count) {
+        auto to = std::min(from + segment_row_count, row_count);
+        STATUS_CHECK(ImportRows(from, to, operation));
+        recorder.RecordSection("import rows [" + std::to_string(from) + ", " + std::to_string(to) + ")");
+    }
+
+    STATUS_CHECK(operation->Push());
+    LOG_ENGINE_DEBUG_ << "Imported " << row_count << " entities into " << operation->GetContext().new_segments.size()
+                      << " segments of collection " << ss_->GetName();
+
+    return Status::OK();
+}
+
+Status
+BulkImporter::PrepareColumns(int64_t& row_count) {
+    if (!boost::filesystem::is_directory(path_)) {
+        return Status(DB_ERROR, "Import path is not a directory: " + path_);
+    }
+
+    auto& params = ss_->GetCollection()->GetParams();
+    auto_genid_ = true;
+    if (params.find(PARAM_UID_AUTOGEN) != params.end()) {
+        auto_genid_ = params[PARAM_UID_AUTOGEN];
+    }
+
+    // widths of fields are the same as the segment stores them
+    Segment schema;
+    auto& fields = ss_->GetResources<snapshot::Field>();
+    for (auto& kv : fields) {
+        const snapshot::FieldPtr& field = kv.second.Get();
+        STATUS_CHECK(schema.AddField(field));
+    }
+
+    columns_.clear();
+    for (auto& kv : fields) {
+        const snapshot::FieldPtr& field = kv.second.Get();
+        Column column;
+        column.name_ = field->GetName();
+        STATUS_CHECK(schema.GetFieldType(column.name_, column.type_));
+        STATUS_CHECK(schema.GetFixedFieldWidth(column.name_, column.width_));
+
+        auto status = PrepareColumn(column);
+        if (!status.ok()) {
+            if (column.name_ == FIELD_UID && auto_genid_) {
+                continue;  // ids are generated
+            }
+            return status;
+        }
+
+        if (column.name_ == FIELD_UID && auto_genid_) {
+            return Status(DB_ERROR, "Field '_id' is auto increment, no need to import id column");
+        }
+        columns_.emplace_back(column);
+    }
+
+    // every column must have the same row count
+    row_count = columns_.empty() ? 0 : columns_.front().row_count_;
+    for (auto& column : columns_) {
+        if (column.row_count_ != row_count) {
+            std::string msg = "Row count mismatch, column " + column.name_ + " has " +
+                              std::to_string(column.row_count_) + " rows while column " + columns_.front().name_ +
+                              " has " + std::to_string(row_count) + " rows";
+            return Status(DB_ERROR, msg);
+        }
+    }
+
+    return Status::OK();
+}
+
+Status
+BulkImporter::PrepareColumn(Column& column) {
+    boost::filesystem::path dir(path_);
+    auto exists = [&](const std::string& ext) {
+        column.file_path_ = (dir / (column.name_ + ext)).string();
+        return boost::filesystem::is_regular_file(column.file_path_);
+    };
+
+    column.file_width_ = column.width_;
+    if (column.type_ == DataType::VECTOR_FLOAT16) {
+        column.file_width_ = column.width_ / sizeof(uint16_t) * sizeof(float);
+    }
+
+    if ((column.type_ == DataType::VECTOR_FLOAT || column.type_ == DataType::VECTOR_FLOAT16) && exists(".fvecs")) {
+        column.format_ = ColumnFormat::VECS;
+    } else if (column.type_ == DataType::VECTOR_BINARY && exists(".bvecs")) {
+        column.format_ = ColumnFormat::VECS;
+    } else if (exists(".bin")) {
+        column.format_ = ColumnFormat::BIN;
+        column.file_width_ = column.width_;
+    } else if (exists(".blk")) {
+        column.format_ = ColumnFormat::BLOCK;
+        column.file_width_ = column.width_;
+    } else {
+        return Status(DB_ERROR, "No column file of field " + column.name_ + " in " + path_);
+    }
+
+    if (column.file_width_ <= 0) {
+        return Status(DB_ERROR, "Field " + column.name_ + " cannot be imported");
+    }
+
+    int64_t num_bytes = 0;
+    if (column.format_ == ColumnFormat::BLOCK) {
+        try {
+            auto fs_ptr = CreateFSHandler(path_);
+            if (!fs_ptr->reader_ptr_->Open(column.file_path_)) {
+                return Status(SERVER_CANNOT_OPEN_FILE, "Fail to open file: " + column.file_path_);
+            }
+            bool valid = codec::CheckMagic(fs_ptr);
+            if (valid) {
+                num_bytes = std::stol(codec::ReadHeaderValue(fs_ptr, "size"));
+            }
+            fs_ptr->reader_ptr_->Close();
+            if (!valid) {
+                return Status(SERVER_FILE_MAGIC_BYTES_ERROR, "Wrong magic bytes: " + column.file_path_);
+            }
+        } catch (std::exception& ex) {
+            return Status(DB_ERROR, "Invalid block file " + column.file_path_ + ": " + ex.what());
+        }
+    } else {
+        num_bytes = boost::filesystem::file_size(column.file_path_);
+    }
+
+    int64_t row_width = column.file_width_;
+    if (column.format_ == ColumnFormat::VECS) {
+        row_width += VECS_HEADER_SIZE;
+    }
+    if (num_bytes % row_width != 0) {
+        return Status(DB_ERROR, "Size of " + column.file_path_ + " is not a multiple of the row size " +
+                                    std::to_string(row_width) + ", the dimension may not match");
+    }
+    column.row_count_ = num_bytes / row_width;
+
+    return Status::OK();
+}
+
+Status
+BulkImporter::ReadColumn(const Column& column, int64_t from, int64_t to, BinaryDataPtr& data) {
+    int64_t rows = to - from;
+    data = std::make_shared<BinaryData>();
+
+    if (column.format_ == ColumnFormat::BLOCK) {
+        try {
+            auto block_format = codec::Codec::instance().GetBlockFormat();
+            auto fs_ptr = CreateFSHandler(path_);
+            STATUS_CHECK(
+                block_format->Read(fs_ptr, column.file_path_, from * column.width_, rows * column.width_, data));
+        } catch (std::exception& ex) {
+            return Status(DB_ERROR, "Failed to read block file " + column.file_path_ + ": " + ex.what());
+        }
+        return Status::OK();
+    }
+
+    std::ifstream file(column.file_path_, std::ios::binary);
+    if (!file.is_open()) {
+        return Status(SERVER_CANNOT_OPEN_FILE, "Fail to open file: " + column.file_path_);
+    }
+
+    if (column.format_ == ColumnFormat::BIN) {
+        data->data_.resize(rows * column.width_);
+        file.seekg(from * column.width_);
+        file.read(reinterpret_cast<char*>(data->data_.data()), data->data_.size());
+        if (!file) {
+            return Status(DB_ERROR, "Failed to read file: " + column.file_path_);
+        }
+        return Status::OK();
+    }
+
+    // vecs file, strip the dimension header of each row
+    int64_t row_width = VECS_HEADER_SIZE + column.file_width_;
+    std::vector<uint8_t> buffer(rows * row_width);
+    file.seekg(from * row_width);
+    file.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+    if (!file) {
+        return Status(DB_ERROR, "Failed to read file: " + column.file_path_);
+    }
+
+    // fvecs rows are prefixed by the dimension, bvecs rows by the byte count
+    int32_t expected = (column.type_ == DataType::VECTOR_BINARY) ? column.file_width_
+                                                                  : column.file_width_ / sizeof(float);
+    data->data_.resize(rows * column.file_width_);
+    for (int64_t i = 0; i < rows; ++i) {
+        const uint8_t* row = buffer.data() + i * row_width;
+        int32_t dim = *reinterpret_cast<const int32_t*>(row);
+        if (dim != expected) {
+            return Status(DB_ERROR, "Dimension " + std::to_string(dim) + " of row " + std::to_string(from + i) +
+                                        " in " + column.file_path_ + " doesn't match " + std::to_string(expected));
+        }
+        memcpy(data->data_.data() + i * column.file_width_, row + VECS_HEADER_SIZE, column.file_width_);
+    }
+
+    if (column.type_ == DataType::VECTOR_FLOAT16) {
+        STATUS_CHECK(utils::FloatToFloat16(data->data_));
+    }
+
+    return Status::OK();
+}
+
+Status
+BulkImporter::ImportRows(int64_t from, int64_t to, const std::shared_ptr<snapshot::MultiSegmentsOperation>& operation) {
+    auto chunk = std::make_shared<DataChunk>();
+    chunk->count_ = to - from;
+    for (auto& column : columns_) {
+        BinaryDataPtr data;
+        STATUS_CHECK(ReadColumn(column, from, to, data));
+        chunk->fixed_fields_[column.name_] = data;
+    }
+
+    if (auto_genid_) {
+        IDNumbers ids;
+        STATUS_CHECK(SafeIDGenerator::GetInstance().GetNextIDNumbers(chunk->count_, ids));
+        auto id_data = std::make_shared<BinaryData>();
+        auto src = reinterpret_cast<const uint8_t*>(ids.data());
+        id_data->data_.assign(src, src + ids.size() * sizeof(idx_t));
+        chunk->fixed_fields_[FIELD_UID] = id_data;
+    }
+
+    // the rows of one segment are written by a standalone mem segment, it never enters the insert buffer
+    std::shared_ptr<snapshot::MultiSegmentsOperation> op = operation;
+    MemSegment segment(ss_->GetCollectionId(), partition_id_, options_);
+    STATUS_CHECK(segment.Add(chunk, 0));
+    return segment.Serialize(ss_, op);
+}
+
+}  // namespace engine
+}  // namespace milvus
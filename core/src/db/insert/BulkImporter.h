@@ -0,0 +1,83 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "db/Types.h"
+#include "db/snapshot/CompoundOperations.h"
+#include "db/snapshot/Snapshot.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+// Imports a local directory of column files into a partition, bypassing wal and the insert buffer.
+// Each field of the collection has one file in the directory, named by the field name:
+//   <field>.fvecs    float vectors, each row is an int32 dimension followed by the floats
+//   <field>.bvecs    binary vectors, each row is an int32 byte count followed by the bytes
+//   <field>.bin      values of the field packed without header, little endian
+//   <field>.blk      a block file written by BlockFormat, e.g. the raw file of an existing segment
+// The _id column is required if ids are user defined, otherwise ids are generated.
+// Files are read one segment at a time, every segment is written full size by a segment writer, and all of them
+// are committed by one snapshot operation, so nothing is visible until the whole import succeeds.
+class BulkImporter {
+ public:
+    BulkImporter(const snapshot::ScopedSnapshotT& ss, int64_t partition_id, const std::string& path,
+                 const DBOptions& options);
+
+    Status
+    Import(int64_t& row_count);
+
+ private:
+    enum class ColumnFormat {
+        VECS,
+        BIN,
+        BLOCK,
+    };
+
+    struct Column {
+        std::string name_;
+        std::string file_path_;
+        ColumnFormat format_ = ColumnFormat::BIN;
+        DataType type_ = DataType::NONE;
+        int64_t width_ = 0;       // bytes of one value in segment
+        int64_t file_width_ = 0;  // bytes of one value in file, a float16 field is imported from float vectors
+        int64_t row_count_ = 0;
+    };
+
+    Status
+    PrepareColumns(int64_t& row_count);
+
+    Status
+    PrepareColumn(Column& column);
+
+    Status
+    ReadColumn(const Column& column, int64_t from, int64_t to, BinaryDataPtr& data);
+
+    Status
+    ImportRows(int64_t from, int64_t to, const std::shared_ptr<snapshot::MultiSegmentsOperation>& operation);
+
+ private:
+    snapshot::ScopedSnapshotT ss_;
+    int64_t partition_id_;
+    std::string path_;
+    DBOptions options_;
+
+    std::vector<Column> columns_;
+    bool auto_genid_ = true;
+};
+
+}  // namespace engine
+}  // namespace milvus
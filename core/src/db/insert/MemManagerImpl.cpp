@@ -114,6 +114,7 @@ MemManagerImpl::ValidateChunk(int64_t collection_id, const DataChunkPtr& chunk)
                 }
                 break;
             case DataType::VECTOR_FLOAT:
+            case DataType::VECTOR_FLOAT16:
             case DataType::VECTOR_BINARY: {
                 json params = field->GetParams();
                 if (params.find(knowhere::meta::DIM) == params.end()) {
@@ -123,7 +124,12 @@ MemManagerImpl::ValidateChunk(int64_t collection_id, const DataChunkPtr& chunk)
                 }
 
                 int64_t dimension = params[knowhere::meta::DIM];
-                int64_t row_size = (ftype == DataType::VECTOR_BINARY) ? dimension / 8 : dimension * sizeof(float);
+                int64_t row_size = dimension * sizeof(float);
+                if (ftype == DataType::VECTOR_BINARY) {
+                    row_size = dimension / 8;
+                } else if (ftype == DataType::VECTOR_FLOAT16) {
+                    row_size = dimension * sizeof(uint16_t);
+                }
                 if (data_size != chunk->count_ * row_size) {
                     return Status(DB_ERROR, err_msg + name);
                 }
@@ -290,6 +290,17 @@ MemSegment::PutChunksToWriter(const segment::SegmentWriterPtr& writer) {
         return Status(DB_ERROR, "Segment writer is null pointer");
     }
 
+    // reserve capacity by total row count, so that each chunk is copied only once
+    int64_t total_count = 0;
+    for (auto& action : actions_) {
+        if (action.insert_data_ != nullptr) {
+            total_count += action.insert_data_->count_;
+        }
+    }
+    if (total_count > 0) {
+        STATUS_CHECK(writer->Reserve(writer->RowCount() + total_count));
+    }
+
     for (auto& action : actions_) {
         DataChunkPtr chunk = action.insert_data_;
         if (chunk == nullptr || chunk->count_ == 0) {
@@ -10,17 +10,20 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/merge/MergeTask.h"
+#include "db/SnapshotUtils.h"
 #include "db/Utils.h"
-#include "db/snapshot/CompoundOperations.h"
 #include "db/snapshot/Operations.h"
 #include "db/snapshot/Snapshots.h"
+#include "knowhere/index/vector_index/IndexHNSW.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "metrics/Metrics.h"
-#include "segment/SegmentReader.h"
-#include "segment/SegmentWriter.h"
 #include "utils/Log.h"
+#include "utils/TimeRecorder.h"
 
+#include <faiss/FaissHook.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace engine {
@@ -104,18 +107,32 @@ MergeTask::Execute() {
     segment::SegmentWriterPtr segment_writer = std::make_shared<segment::SegmentWriter>(options_.meta_.path_, visitor);
 
     // merge
+    // base_offsets records where the entities of each source segment start in the new segment
+    std::vector<segment::SegmentReaderPtr> segment_readers;
+    std::vector<int64_t> base_offsets;
+    int64_t total_rows = 0;
     for (auto& id : segments_) {
-        auto seg = snapshot_->GetResource<snapshot::Segment>(id);
+        auto segment_commit = snapshot_->GetSegmentCommitBySegmentId(id);
+        if (segment_commit != nullptr) {
+            total_rows += segment_commit->GetRowCount();
+        }
+    }
+    if (total_rows > 0) {
+        segment_writer->Reserve(total_rows);
+    }
 
+    for (auto& id : segments_) {
         auto read_visitor = SegmentVisitor::Build(snapshot_, id);
         segment::SegmentReaderPtr segment_reader =
             std::make_shared<segment::SegmentReader>(options_.meta_.path_, read_visitor);
+        base_offsets.push_back(segment_writer->RowCount());
         status = segment_writer->Merge(segment_reader);
         if (!status.ok()) {
             std::string err_msg = "MergeTask merge failed: " + status.ToString();
             LOG_ENGINE_ERROR_ << err_msg;
             return status;
         }
+        segment_readers.push_back(segment_reader);
     }
 
     status = segment_writer->Serialize();
@@ -124,10 +141,168 @@ MergeTask::Execute() {
         return status;
     }
 
+    status = ExtendVectorIndex(op, segment_writer, segment_readers, base_offsets);
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << "Failed to extend index for segment: " << new_seg->GetID();
+        return status;
+    }
+
     status = op->Push();
 
     return status;
 }
 
+Status
+MergeTask::ExtendVectorIndex(const std::shared_ptr<snapshot::MergeOperation>& op,
+                             const segment::SegmentWriterPtr& segment_writer,
+                             const std::vector<segment::SegmentReaderPtr>& segment_readers,
+                             const std::vector<int64_t>& base_offsets) {
+    if (segment_readers.empty()) {
+        return Status::OK();
+    }
+
+    // pick the source segment which contributes most entities, its graph is reused
+    int64_t total_rows = segment_writer->RowCount();
+    size_t largest = 0;
+    int64_t largest_rows = 0;
+    for (size_t i = 0; i < base_offsets.size(); ++i) {
+        int64_t end = (i + 1 < base_offsets.size()) ? base_offsets[i + 1] : total_rows;
+        if (end - base_offsets[i] > largest_rows) {
+            largest_rows = end - base_offsets[i];
+            largest = i;
+        }
+    }
+    if (largest_rows <= 0) {
+        return Status::OK();
+    }
+
+    auto& src_reader = segment_readers[largest];
+    auto src_visitor = src_reader->GetSegmentVisitor();
+    auto& src_segment = src_visitor->GetSegment();
+    int64_t base = base_offsets[largest];
+
+    engine::SegmentPtr merged_segment;
+    STATUS_CHECK(segment_writer->GetSegment(merged_segment));
+
+    auto field_names = snapshot_->GetFieldNames();
+    for (auto& field_name : field_names) {
+        auto field_visitor = src_visitor->GetFieldVisitor(field_name);
+        if (field_visitor == nullptr || !IsVectorField(field_visitor->GetField())) {
+            continue;
+        }
+        auto index_visitor = field_visitor->GetElementVisitor(engine::FieldElementType::FET_INDEX);
+        if (index_visitor == nullptr || index_visitor->GetFile() == nullptr) {
+            continue;  // the source segment has no index, let build index task do it
+        }
+        auto& index_element = index_visitor->GetElement();
+        if (!utils::SupportIncrementalIndex(index_element->GetTypeName())) {
+            continue;
+        }
+
+        TimeRecorder rc("MergeTask::ExtendVectorIndex: " + field_name);
+
+        knowhere::VecIndexPtr index;
+        auto status = src_reader->ReadVectorIndex(field_name, index);
+        auto hnsw_index = std::dynamic_pointer_cast<knowhere::IndexHNSW>(index);
+        if (!status.ok() || hnsw_index == nullptr) {
+            LOG_ENGINE_WARNING_ << "Failed to read index of segment " << src_segment->GetID()
+                                << ", merged segment will be indexed from scratch";
+            continue;
+        }
+
+        // labels are physical offsets of the source segment, deleted entities included
+        int64_t src_rows = hnsw_index->Count();
+
+        // deleted entities are dropped from graph, others are re-labeled to their offsets in the merged segment
+        std::vector<bool> deleted(src_rows, false);
+        segment::DeletedDocsPtr deleted_docs;
+        src_reader->LoadDeletedDocs(deleted_docs);
+        if (deleted_docs != nullptr) {
+            for (auto offset : deleted_docs->GetDeletedDocs()) {
+                if (offset >= 0 && offset < src_rows) {
+                    deleted[offset] = true;
+                }
+            }
+        }
+        std::vector<int64_t> label_map(src_rows, -1);
+        int64_t new_offset = base;
+        for (int64_t i = 0; i < src_rows; ++i) {
+            if (!deleted[i]) {
+                label_map[i] = new_offset++;
+            }
+        }
+        if (new_offset - base != largest_rows) {
+            LOG_ENGINE_WARNING_ << "Index of segment " << src_segment->GetID() << " has " << new_offset - base
+                                << " live entities, " << largest_rows << " merged, merged segment will be "
+                                << "indexed from scratch";
+            continue;
+        }
+
+        engine::BinaryDataPtr raw_data;
+        STATUS_CHECK(merged_segment->GetFixedFieldData(field_name, raw_data));
+        auto& field_json = field_visitor->GetField()->GetParams();
+        int64_t dimension = field_json[knowhere::meta::DIM];
+        bool is_fp16 = field_visitor->GetField()->GetFtype() == engine::DataType::VECTOR_FLOAT16;
+
+        try {
+            hnsw_index->Compact(label_map, total_rows);
+            rc.RecordSection("compact graph of segment " + std::to_string(src_segment->GetID()));
+
+            // insert vectors of other segments, they are placed before and after the reused range
+            auto add_range = [&](int64_t from, int64_t to) {
+                if (to <= from) {
+                    return;
+                }
+                std::vector<int64_t> offsets(to - from);
+                for (int64_t i = from; i < to; ++i) {
+                    offsets[i - from] = i;
+                }
+                // the index is built on float vectors, half precision raw data is decoded range by range
+                std::vector<float> decoded;
+                const float* vectors = nullptr;
+                if (is_fp16) {
+                    decoded.resize((to - from) * dimension);
+                    auto src = reinterpret_cast<const uint16_t*>(raw_data->data_.data()) + from * dimension;
+                    faiss::fp16_to_fvec(src, decoded.data(), decoded.size());
+                    vectors = decoded.data();
+                } else {
+                    vectors = reinterpret_cast<const float*>(raw_data->data_.data()) + from * dimension;
+                }
+                auto dataset = knowhere::GenDatasetWithIds(to - from, dimension, vectors, offsets.data());
+                hnsw_index->Add(dataset, knowhere::Config());
+            };
+            add_range(0, base);
+            add_range(base + largest_rows, total_rows);
+            rc.RecordSection("add " + std::to_string(total_rows - largest_rows) + " vectors");
+        } catch (std::exception& ex) {
+            LOG_ENGINE_WARNING_ << "Failed to extend index: " << ex.what()
+                                << ", merged segment will be indexed from scratch";
+            continue;
+        }
+
+        // create index file in the same merge operation
+        auto new_segment = op->GetContext().new_segment;
+        snapshot::SegmentFileContext sf_context;
+        sf_context.collection_id = new_segment->GetCollectionId();
+        sf_context.partition_id = new_segment->GetPartitionId();
+        sf_context.segment_id = new_segment->GetID();
+        sf_context.field_name = field_name;
+        sf_context.field_element_name = index_element->GetName();
+
+        snapshot::SegmentFilePtr index_file;
+        STATUS_CHECK(op->CommitNewSegmentFile(sf_context, index_file));
+
+        auto ctx = op->GetContext();
+        auto visitor = SegmentVisitor::Build(snapshot_, ctx.new_segment, ctx.new_segment_files);
+        auto index_writer = std::make_shared<segment::SegmentWriter>(options_.meta_.path_, visitor);
+        index_writer->SetVectorIndex(field_name, hnsw_index);
+        STATUS_CHECK(index_writer->WriteVectorIndex(field_name));
+
+        rc.ElapseFromBegin("done");
+    }
+
+    return Status::OK();
+}
+
 }  // namespace engine
 }  // namespace milvus
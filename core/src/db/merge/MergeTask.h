@@ -11,12 +11,17 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "db/Types.h"
 #include "db/merge/MergeManager.h"
+#include "db/snapshot/CompoundOperations.h"
 #include "db/snapshot/ResourceTypes.h"
 #include "db/snapshot/Snapshot.h"
+#include "segment/SegmentReader.h"
+#include "segment/SegmentWriter.h"
 #include "utils/Status.h"
 
 namespace milvus {
@@ -29,6 +34,15 @@ class MergeTask {
     Status
     Execute();
 
+ private:
+    // extend the index of the largest source segment with the vectors of the other segments,
+    // only for index types which support incremental building, other indexes are built by build index task
+    Status
+    ExtendVectorIndex(const std::shared_ptr<snapshot::MergeOperation>& op,
+                      const segment::SegmentWriterPtr& segment_writer,
+                      const std::vector<segment::SegmentReaderPtr>& segment_readers,
+                      const std::vector<int64_t>& base_offsets);
+
  private:
     DBOptions options_;
     snapshot::ScopedSnapshotT snapshot_;
@@ -11,6 +11,8 @@
 
 #include "db/meta/backend/MetaHelper.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "utils/StringHelpFunctions.h"
@@ -94,4 +96,98 @@ MetaHelper::MetaApplyContextToSql(const MetaApplyContext& context, std::string&
     return Status::OK();
 }
 
+Status
+MetaHelper::MetaQueryContextToStatement(const MetaQueryContext& context, std::string& sql,
+                                        std::vector<std::string>& params) {
+    params.clear();
+    if (context.all_required_) {
+        sql = "SELECT * FROM ";
+    } else {
+        std::string query_fields;
+        StringHelpFunctions::MergeStringWithDelimeter(context.query_fields_, ",", query_fields);
+        sql = "SELECT " + query_fields + " FROM ";
+    }
+    sql += context.table_;
+
+    std::vector<std::pair<std::string, std::vector<std::string>>> filter_attrs(context.filter_attrs_.begin(),
+                                                                                context.filter_attrs_.end());
+    std::sort(filter_attrs.begin(), filter_attrs.end());
+
+    std::vector<std::string> filter_conditions;
+    for (auto& attr : filter_attrs) {
+        if (attr.second.empty()) {
+            return Status(SERVER_UNEXPECTED_ERROR, "Invalid filter attrs. ");
+        } else if (attr.second.size() == 1) {
+            filter_conditions.emplace_back(attr.first + "=?");
+        } else {
+            std::vector<std::string> placeholders(attr.second.size(), "?");
+            std::string in_condition;
+            StringHelpFunctions::MergeStringWithDelimeter(placeholders, ",", in_condition);
+            filter_conditions.emplace_back(attr.first + " IN (" + in_condition + ")");
+        }
+        params.insert(params.end(), attr.second.begin(), attr.second.end());
+    }
+
+    if (!filter_conditions.empty()) {
+        std::string filter_str;
+        StringHelpFunctions::MergeStringWithDelimeter(filter_conditions, " AND ", filter_str);
+        sql += " WHERE " + filter_str;
+    }
+
+    sql += ";";
+
+    return Status::OK();
+}
+
+Status
+MetaHelper::MetaApplyContextToStatement(const MetaApplyContext& context, std::string& sql,
+                                        std::vector<std::string>& params) {
+    params.clear();
+    if (!context.sql_.empty()) {
+        sql = context.sql_;
+        return Status::OK();
+    }
+
+    std::vector<std::pair<std::string, std::string>> attrs(context.attrs_.begin(), context.attrs_.end());
+    std::sort(attrs.begin(), attrs.end());
+
+    switch (context.op_) {
+        case oAdd: {
+            std::string field_names, values;
+            std::vector<std::string> field_list, value_list;
+            for (auto& kv : attrs) {
+                field_list.push_back(kv.first);
+                value_list.emplace_back("?");
+                params.push_back(kv.second);
+            }
+            StringHelpFunctions::MergeStringWithDelimeter(field_list, ",", field_names);
+            StringHelpFunctions::MergeStringWithDelimeter(value_list, ",", values);
+            sql = "INSERT INTO " + context.table_ + "(" + field_names + ") " + "VALUES(" + values + ")";
+            break;
+        }
+        case oUpdate: {
+            std::string field_pairs;
+            std::vector<std::string> updated_attrs;
+            for (auto& kv : attrs) {
+                updated_attrs.emplace_back(kv.first + "=?");
+                params.push_back(kv.second);
+            }
+
+            StringHelpFunctions::MergeStringWithDelimeter(updated_attrs, ",", field_pairs);
+            sql = "UPDATE " + context.table_ + " SET " + field_pairs + " WHERE id = ?";
+            params.push_back(std::to_string(context.id_));
+            break;
+        }
+        case oDelete: {
+            sql = "DELETE FROM " + context.table_ + " WHERE id = ?";
+            params.push_back(std::to_string(context.id_));
+            break;
+        }
+        default:
+            return Status(SERVER_UNEXPECTED_ERROR, "Unknown context operation");
+    }
+
+    return Status::OK();
+}
+
 }  // namespace milvus::engine::meta
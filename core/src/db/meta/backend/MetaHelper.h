@@ -12,6 +12,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "db/meta/backend/MetaContext.h"
 #include "utils/Status.h"
@@ -28,6 +29,14 @@ class MetaHelper {
 
     static Status
     MetaApplyContextToSql(const MetaApplyContext& context, std::string& sql);
+
+    // same as above, but values are replaced by '?' placeholders and returned in order as sql literals, so
+    // contexts of the same shape render the same statement
+    static Status
+    MetaQueryContextToStatement(const MetaQueryContext& context, std::string& sql, std::vector<std::string>& params);
+
+    static Status
+    MetaApplyContextToStatement(const MetaApplyContext& context, std::string& sql, std::vector<std::string>& params);
 };
 
 }  // namespace milvus::engine::meta
@@ -11,6 +11,8 @@
 
 #include "db/meta/backend/SqliteEngine.h"
 
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <unordered_map>
@@ -122,24 +124,24 @@ static const MetaSchema FIELDELEMENT_SCHEMA(TABLE_FIELD_ELEMENT,
                                              MetaStateField, MetaCreatedOnField, MetaUpdatedOnField});
 
 /////////////////////////////////////////////////////
-static AttrsMapList* QueryData = nullptr;
-
-static int
-QueryCallback(void* data, int argc, char** argv, char** azColName) {
-    AttrsMap raw;
-    for (size_t i = 0; i < argc; i++) {
-        // TODO: here check argv[i]. Refer to 'https://www.tutorialspoint.com/sqlite/sqlite_c_cpp.htm'
-        raw.insert(std::make_pair(azColName[i], argv[i]));
+// statements for all query and apply shapes of the resources fit easily, other sql is prepared for each use
+constexpr size_t MAX_CACHED_STATEMENTS = 512;
+
+// params are sql literals, strings are single quoted and the others are integers
+int
+BindParam(sqlite3_stmt* stmt, int index, const std::string& value) {
+    if (value.size() >= 2 && value.front() == '\'' && value.back() == '\'') {
+        return sqlite3_bind_text(stmt, index, value.data() + 1, value.size() - 2, SQLITE_TRANSIENT);
     }
 
-    if (!QueryData) {
-        // TODO: check return value -1 or 1
-        return -1;
+    errno = 0;
+    char* end = nullptr;
+    int64_t ival = std::strtoll(value.c_str(), &end, 10);
+    if (!value.empty() && errno == 0 && *end == '\0') {
+        return sqlite3_bind_int64(stmt, index, ival);
     }
 
-    QueryData->push_back(raw);
-
-    return 0;
+    return sqlite3_bind_text(stmt, index, value.c_str(), value.size(), SQLITE_TRANSIENT);
 }
 
 std::string
@@ -172,6 +174,10 @@ SqliteEngine::SqliteEngine(const DBMetaOptions& options) : options_(options) {
 }
 
 SqliteEngine::~SqliteEngine() {
+    for (auto& kv : statements_) {
+        sqlite3_finalize(kv.second);
+    }
+    statements_.clear();
     sqlite3_close(db_);
 }
 
@@ -202,32 +208,96 @@ SqliteEngine::Initialize() {
     return Status::OK();
 }
 
+Status
+SqliteEngine::PrepareStatement(const std::string& sql, const std::vector<std::string>& params, sqlite3_stmt*& stmt) {
+    auto iter = statements_.find(sql);
+    if (iter != statements_.end()) {
+        stmt = iter->second;
+    } else {
+        if (SQLITE_OK != sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr)) {
+            return Status(DB_ERROR, "Prepare statement fail:" + ErrorMsg(db_));
+        }
+        if (statements_.size() < MAX_CACHED_STATEMENTS) {
+            statements_.insert(std::make_pair(sql, stmt));
+        }
+    }
+
+    for (size_t i = 0; i < params.size(); i++) {
+        if (SQLITE_OK != BindParam(stmt, i + 1, params[i])) {
+            std::string err = "Bind parameter fail:" + ErrorMsg(db_);
+            ReleaseStatement(sql, stmt);
+            return Status(DB_ERROR, err);
+        }
+    }
+
+    return Status::OK();
+}
+
+void
+SqliteEngine::ReleaseStatement(const std::string& sql, sqlite3_stmt* stmt) {
+    auto iter = statements_.find(sql);
+    if (iter != statements_.end() && iter->second == stmt) {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    } else {
+        sqlite3_finalize(stmt);
+    }
+}
+
+Status
+SqliteEngine::ExecuteStatement(const std::string& sql, const std::vector<std::string>& params) {
+    sqlite3_stmt* stmt = nullptr;
+    STATUS_CHECK(PrepareStatement(sql, params, stmt));
+
+    auto rc = sqlite3_step(stmt);
+    std::string err = (rc == SQLITE_DONE) ? "" : "Execute Fail:" + ErrorMsg(db_);
+    ReleaseStatement(sql, stmt);
+
+    return err.empty() ? Status::OK() : Status(DB_ERROR, err);
+}
+
 Status
 SqliteEngine::Query(const MetaQueryContext& context, AttrsMapList& attrs) {
     std::string sql;
+    std::vector<std::string> params;
+    STATUS_CHECK(MetaHelper::MetaQueryContextToStatement(context, sql, params));
 
-    STATUS_CHECK(MetaHelper::MetaQueryContextToSql(context, sql));
     std::lock_guard<std::mutex> lock(meta_mutex_);
+    sqlite3_stmt* stmt = nullptr;
+    auto status = PrepareStatement(sql, params, stmt);
+    if (!status.ok()) {
+        return Status(DB_META_QUERY_FAILED, "Query fail:" + status.message());
+    }
 
-    QueryData = &attrs;
-    if (SQLITE_OK != sqlite3_exec(db_, sql.c_str(), QueryCallback, nullptr, nullptr)) {
-        std::string err = "Query fail:" + ErrorMsg(db_);
-        return Status(DB_META_QUERY_FAILED, err);
+    // rows are collected by the caller's list, so concurrent queries never share result state
+    int rc = SQLITE_OK;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        AttrsMap raw;
+        int column_count = sqlite3_column_count(stmt);
+        for (int i = 0; i < column_count; i++) {
+            auto value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+            if (value != nullptr) {
+                raw.insert(std::make_pair(sqlite3_column_name(stmt, i), value));
+            }
+        }
+        attrs.push_back(std::move(raw));
     }
 
-    QueryData = nullptr;
+    std::string err = (rc == SQLITE_DONE) ? "" : "Query fail:" + ErrorMsg(db_);
+    ReleaseStatement(sql, stmt);
+    if (!err.empty()) {
+        return Status(DB_META_QUERY_FAILED, err);
+    }
 
     return Status::OK();
 }
 
 Status
 SqliteEngine::ExecuteTransaction(const std::vector<MetaApplyContext>& sql_contexts, std::vector<int64_t>& result_ids) {
-    std::vector<std::string> sqls;
-
-    std::string sql;
-    for (const auto& context : sql_contexts) {
-        STATUS_CHECK(MetaHelper::MetaApplyContextToSql(context, sql));
-        sqls.push_back(sql);
+    std::vector<std::string> sqls(sql_contexts.size());
+    std::vector<std::vector<std::string>> params(sql_contexts.size());
+    for (size_t i = 0; i < sql_contexts.size(); i++) {
+        STATUS_CHECK(MetaHelper::MetaApplyContextToStatement(sql_contexts[i], sqls[i], params[i]));
     }
 
     std::lock_guard<std::mutex> lock(meta_mutex_);
@@ -236,10 +306,10 @@ SqliteEngine::ExecuteTransaction(const std::vector<MetaApplyContext>& sql_contex
         return Status(DB_ERROR, sql_err);
     }
 
-    int rc = SQLITE_OK;
+    Status status;
     for (size_t i = 0; i < sql_contexts.size(); i++) {
-        rc = sqlite3_exec(db_, sqls[i].c_str(), nullptr, nullptr, nullptr);
-        if (rc != SQLITE_OK) {
+        status = ExecuteStatement(sqls[i], params[i]);
+        if (!status.ok()) {
             break;
         }
 
@@ -258,7 +328,11 @@ SqliteEngine::ExecuteTransaction(const std::vector<MetaApplyContext>& sql_contex
             return Status(DB_ERROR, "Unknown Op");
         }
     }
-    if (SQLITE_OK != rc || SQLITE_OK != sqlite3_exec(db_, "COMMIT", nullptr, nullptr, nullptr)) {
+    if (!status.ok()) {
+        sqlite3_exec(db_, "ROLLBACK", nullptr, nullptr, nullptr);
+        return status;
+    }
+    if (SQLITE_OK != sqlite3_exec(db_, "COMMIT", nullptr, nullptr, nullptr)) {
         std::string err = "Execute Fail:" + ErrorMsg(db_);
         sqlite3_exec(db_, "ROLLBACK", nullptr, nullptr, nullptr);
         return Status(DB_ERROR, err);
@@ -12,6 +12,8 @@
 #pragma once
 
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <sqlite3.h>
@@ -21,6 +23,8 @@
 
 namespace milvus::engine::meta {
 
+// Statements are prepared once and cached by their sql text, values are bound as parameters. Contexts of the same
+// table and operation render the same text, so the cache stays small.
 class SqliteEngine : public MetaEngine {
  public:
     explicit SqliteEngine(const DBMetaOptions& options);
@@ -40,10 +44,22 @@ class SqliteEngine : public MetaEngine {
     Status
     Initialize();
 
+    // get the cached statement of the sql or prepare a new one, and bind the params, called with meta_mutex_ held
+    Status
+    PrepareStatement(const std::string& sql, const std::vector<std::string>& params, sqlite3_stmt*& stmt);
+
+    // reset a cached statement for the next use, or finalize it if it is not cached
+    void
+    ReleaseStatement(const std::string& sql, sqlite3_stmt* stmt);
+
+    Status
+    ExecuteStatement(const std::string& sql, const std::vector<std::string>& params);
+
  private:
     DBMetaOptions options_;
     sqlite3* db_;
     std::mutex meta_mutex_;
+    std::unordered_map<std::string, sqlite3_stmt*> statements_;
 };
 
 }  // namespace milvus::engine::meta
@@ -11,18 +11,32 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 #include "Operations.h"
 #include "Store.h"
+#include "metrics/Metrics.h"
 #include "utils/BlockingQueue.h"
 
 namespace milvus::engine::snapshot {
 
 using ThreadPtr = std::shared_ptr<std::thread>;
-using OperationQueue = BlockingQueue<OperationsPtr>;
 
+struct QueuedOperation {
+    OperationsPtr operation_;
+    std::chrono::steady_clock::time_point enqueue_time_;
+};
+
+using OperationQueue = BlockingQueue<QueuedOperation>;
+
+// Operations are executed by several shards, each has its own queue and thread. An operation goes to the shard of
+// the collection it starts from, so operations of one collection are applied in order while different collections
+// commit in parallel. Operations not started from a snapshot, e.g. create collection, go to the first shard.
 class OperationExecutor {
  public:
     ~OperationExecutor() {
@@ -30,12 +44,15 @@ class OperationExecutor {
     }
 
     static void
-    Init(StorePtr store) {
+    Init(StorePtr store, int64_t shard_num = 4) {
         auto& instance = GetInstanceImpl();
         if (instance.initialized_) {
             return;
         }
         instance.store_ = store;
+        for (int64_t i = 0; i < std::max<int64_t>(shard_num, 1); ++i) {
+            instance.shards_.emplace_back(std::make_shared<Shard>());
+        }
         instance.initialized_ = true;
     }
 
@@ -60,24 +77,43 @@ class OperationExecutor {
         return Status::OK();
     }
 
+    size_t
+    ShardNum() const {
+        return shards_.size();
+    }
+
     void
     Start() {
-        if (thread_ptr_ == nullptr) {
-            thread_ptr_ = std::make_shared<std::thread>(&OperationExecutor::ThreadMain, this);
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            if (shards_[i]->thread_ptr_ == nullptr) {
+                shards_[i]->thread_ptr_ = std::make_shared<std::thread>(&OperationExecutor::ThreadMain, this, i);
+            }
         }
     }
 
     void
     Stop() {
-        if (thread_ptr_ != nullptr) {
-            Enqueue(nullptr);
-            thread_ptr_->join();
-            thread_ptr_ = nullptr;
+        bool stopped = false;
+        for (auto& shard : shards_) {
+            if (shard->thread_ptr_ != nullptr) {
+                shard->queue_.Put(QueuedOperation{nullptr, std::chrono::steady_clock::now()});
+                shard->thread_ptr_->join();
+                shard->thread_ptr_ = nullptr;
+                stopped = true;
+            }
+        }
+        if (stopped) {
             LOG_ENGINE_INFO_ << "OperationExecutor Stopped";
         }
     }
 
  private:
+    struct Shard {
+        ThreadPtr thread_ptr_ = nullptr;
+        OperationQueue queue_;
+    };
+    using ShardPtr = std::shared_ptr<Shard>;
+
     OperationExecutor() = default;
     OperationExecutor(const OperationExecutor&) = delete;
 
@@ -88,24 +124,39 @@ class OperationExecutor {
     }
 
     void
-    ThreadMain() {
+    ThreadMain(size_t shard_id) {
+        SetThreadName("ss_op_" + std::to_string(shard_id));
+        auto& queue = shards_[shard_id]->queue_;
+        auto shard_name = std::to_string(shard_id);
         while (true) {
-            OperationsPtr operation = queue_.Take();
-            if (!operation) {
+            auto queued = queue.Take();
+            if (!queued.operation_) {
                 break;
             }
-            store_->Apply(*operation);
+            auto wait_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                                 queued.enqueue_time_)
+                               .count();
+            server::Metrics::GetInstance().SnapshotOperationQueueWaitHistogramObserve(shard_name, wait_us);
+            store_->Apply(*queued.operation_);
+        }
+    }
+
+    size_t
+    ShardOf(const OperationsPtr& operation) const {
+        auto& ss = operation->GetStartedSS();
+        if (!ss) {
+            return 0;
         }
+        return static_cast<size_t>(ss->GetCollectionId()) % shards_.size();
     }
 
     void
     Enqueue(const OperationsPtr& operation) {
-        queue_.Put(operation);
+        shards_[ShardOf(operation)]->queue_.Put(QueuedOperation{operation, std::chrono::steady_clock::now()});
     }
 
  private:
-    ThreadPtr thread_ptr_ = nullptr;
-    OperationQueue queue_;
+    std::vector<ShardPtr> shards_;
     std::atomic_bool initialized_ = false;
     StorePtr store_;
 };
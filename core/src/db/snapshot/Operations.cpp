@@ -23,7 +23,7 @@
 
 namespace milvus::engine::snapshot {
 
-static ID_TYPE UID = 1;
+static std::atomic<ID_TYPE> UID = {1};
 
 std::ostream&
 operator<<(std::ostream& out, const Operations& operation) {
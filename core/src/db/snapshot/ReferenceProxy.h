@@ -62,6 +62,11 @@ class ReferenceProxy {
         on_no_ref_cbs_.emplace_back(cb);
     }
 
+    void
+    ClearOnNoRefCBs() {
+        on_no_ref_cbs_.clear();
+    }
+
  protected:
     std::atomic<int64_t> ref_count_ = {0};
     std::vector<OnNoRefCBF> on_no_ref_cbs_;
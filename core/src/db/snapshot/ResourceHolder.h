@@ -17,6 +17,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "config/ServerConfig.h"
 #include "db/snapshot/EventExecutor.h"
@@ -97,6 +98,65 @@ class ResourceHolder {
         return ScopedT(ret, scoped);
     }
 
+    // same as Load, but the resources not held yet are read from meta in one batch
+    std::vector<ResourcePtr>
+    LoadBatch(StorePtr store, const IDS_TYPE& ids) {
+        std::vector<ResourcePtr> resources;
+        IDS_TYPE to_load;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (auto id : ids) {
+                auto cit = id_map_.find(id);
+                if (cit == id_map_.end()) {
+                    to_load.push_back(id);
+                } else if (cit->second->IsActive()) {
+                    resources.push_back(cit->second);
+                }
+            }
+        }
+        if (to_load.empty()) {
+            return resources;
+        }
+
+        std::vector<ResourcePtr> loaded;
+        auto status = store->GetResources<ResourceT>(to_load, loaded);
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << "Fail to load " << ResourceT::Name << " in batch: " << status.message();
+            return resources;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto& res : loaded) {
+            if (!res->IsActive()) {
+                continue;
+            }
+            // loaded by others meanwhile, keep the held one
+            if (!AddNoLock(res)) {
+                res = id_map_[res->GetID()];
+            }
+            resources.push_back(res);
+        }
+        return resources;
+    }
+
+    // forget a resource of an evicted snapshot without collecting it, it is loaded again on next access
+    virtual bool
+    Evict(ID_TYPE id) {
+        ResourcePtr resource;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            auto it = id_map_.find(id);
+            if (it == id_map_.end()) {
+                return false;
+            }
+            resource = it->second;
+            id_map_.erase(it);
+        }
+        resource->ResetCnt();
+        resource->ClearOnNoRefCBs();  // the callback refers to the resource itself
+        return true;
+    }
+
     virtual void
     Reset() {
         id_map_.clear();
@@ -14,10 +14,84 @@
 #include "db/snapshot/ResourceHolders.h"
 #include "db/snapshot/Store.h"
 
+#include <type_traits>
+
 namespace milvus {
 namespace engine {
 namespace snapshot {
 
+namespace {
+
+constexpr int64_t RESOURCE_OVERHEAD = 128;  // holder and snapshot map nodes, strings and params of a resource
+constexpr int64_t MAPPING_ENTRY_SIZE = 48;  // node of a std::set<ID_TYPE>
+
+template <typename MapT>
+int64_t
+EstimateSize(const MapT& resources) {
+    int64_t size = 0;
+    for (auto& kv : resources) {
+        auto& res = kv.second.Get();
+        using ResourceT = typename std::decay_t<decltype(*res)>;
+        size += sizeof(ResourceT) + RESOURCE_OVERHEAD;
+        if constexpr (std::is_base_of<MappingsField, ResourceT>::value) {
+            size += res->GetMappings().size() * MAPPING_ENTRY_SIZE;
+        }
+    }
+    return size;
+}
+
+template <typename ResourcesT>
+IDS_TYPE
+CollectMappings(const ResourcesT& resources) {
+    IDS_TYPE ids;
+    for (auto& res : resources) {
+        auto& mappings = res->GetMappings();
+        ids.insert(ids.end(), mappings.begin(), mappings.end());
+    }
+    return ids;
+}
+
+// read the resources of a snapshot level by level with one batched meta read for each level, the constructor
+// then finds all of them in the resource holders instead of reading them one by one
+void
+PreloadResources(StorePtr store, const CollectionCommitPtr& collection_commit, const SchemaCommitPtr& schema_commit) {
+    auto& mappings = collection_commit->GetMappings();
+    auto partition_commits = PartitionCommitsHolder::GetInstance().LoadBatch(store, {mappings.begin(), mappings.end()});
+
+    IDS_TYPE partition_ids;
+    for (auto& partition_commit : partition_commits) {
+        partition_ids.push_back(partition_commit->GetPartitionId());
+    }
+    PartitionsHolder::GetInstance().LoadBatch(store, partition_ids);
+    auto segment_commits = SegmentCommitsHolder::GetInstance().LoadBatch(store, CollectMappings(partition_commits));
+
+    IDS_TYPE segment_ids, schema_ids;
+    for (auto& segment_commit : segment_commits) {
+        segment_ids.push_back(segment_commit->GetSegmentId());
+        schema_ids.push_back(segment_commit->GetSchemaId());
+    }
+    SegmentsHolder::GetInstance().LoadBatch(store, segment_ids);
+    SchemaCommitsHolder::GetInstance().LoadBatch(store, schema_ids);
+    auto segment_files = SegmentFilesHolder::GetInstance().LoadBatch(store, CollectMappings(segment_commits));
+
+    auto& schema_mappings = schema_commit->GetMappings();
+    auto field_commits =
+        FieldCommitsHolder::GetInstance().LoadBatch(store, {schema_mappings.begin(), schema_mappings.end()});
+    IDS_TYPE field_ids;
+    for (auto& field_commit : field_commits) {
+        field_ids.push_back(field_commit->GetFieldId());
+    }
+    FieldsHolder::GetInstance().LoadBatch(store, field_ids);
+
+    auto field_element_ids = CollectMappings(field_commits);
+    for (auto& segment_file : segment_files) {
+        field_element_ids.push_back(segment_file->GetFieldElementId());
+    }
+    FieldElementsHolder::GetInstance().LoadBatch(store, field_element_ids);
+}
+
+}  // namespace
+
 void
 Snapshot::RefAll() {
     std::apply([this](auto&... resource) { ((DoRef(resource)), ...); }, resources_);
@@ -52,6 +126,8 @@ Snapshot::Snapshot(StorePtr store, ID_TYPE ss_id) {
     auto collection = collections_holder.GetResource(store, collection_commit->GetCollectionId(), false);
     AddResource<Collection>(collection);
 
+    PreloadResources(store, collection_commit.Get(), schema_commit.Get());
+
     auto base_path = GetResPath<Collection>(store->GetRootPath(), std::make_shared<Collection>(*collection));
     collection_commit->LoadIds(base_path);
     auto& collection_commit_mappings = collection_commit->GetMappings();
@@ -131,6 +207,44 @@ Snapshot::Snapshot(StorePtr store, ID_TYPE ss_id) {
     }
 
     RefAll();
+    std::apply([this](auto&... resource) { ((size_estimate_ += EstimateSize(resource)), ...); }, resources_);
+}
+
+bool
+Snapshot::IsEvictable() const {
+    if (ref_count() != 1) {
+        return false;
+    }
+
+    bool evictable = true;
+    auto check = [&](auto& resources) {
+        for (auto& kv : resources) {
+            evictable = evictable && (kv.second->ref_count() == 1);
+        }
+    };
+    std::apply([&](auto&... resource) { (check(resource), ...); }, resources_);
+    return evictable;
+}
+
+void
+Snapshot::Evict() {
+    ResetCnt();
+    auto evict = [](auto& resources, auto& holder) {
+        for (auto& kv : resources) {
+            holder.Evict(kv.first);
+        }
+    };
+    evict(GetResources<CollectionCommit>(), CollectionCommitsHolder::GetInstance());
+    evict(GetResources<Collection>(), CollectionsHolder::GetInstance());
+    evict(GetResources<SchemaCommit>(), SchemaCommitsHolder::GetInstance());
+    evict(GetResources<FieldCommit>(), FieldCommitsHolder::GetInstance());
+    evict(GetResources<Field>(), FieldsHolder::GetInstance());
+    evict(GetResources<FieldElement>(), FieldElementsHolder::GetInstance());
+    evict(GetResources<PartitionCommit>(), PartitionCommitsHolder::GetInstance());
+    evict(GetResources<Partition>(), PartitionsHolder::GetInstance());
+    evict(GetResources<SegmentCommit>(), SegmentCommitsHolder::GetInstance());
+    evict(GetResources<Segment>(), SegmentsHolder::GetInstance());
+    evict(GetResources<SegmentFile>(), SegmentFilesHolder::GetInstance());
 }
 
 Status
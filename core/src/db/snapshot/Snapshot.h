@@ -268,6 +268,20 @@ class Snapshot : public ReferenceProxy {
     void
     UnRefAll();
 
+    // rough bytes held by the resources of the snapshot
+    int64_t
+    EstimatedSize() const {
+        return size_estimate_;
+    }
+
+    // only the holder refers to the snapshot and no other snapshot shares its resources
+    bool
+    IsEvictable() const;
+
+    // drop the resources from the resource holders without collecting them, the snapshot must be evictable
+    void
+    Evict();
+
     void
     UnRef() override {
         ReferenceProxy::UnRef();
@@ -357,6 +371,7 @@ class Snapshot : public ReferenceProxy {
     std::map<ID_TYPE, NUM_TYPE> p_max_seg_num_;
     LSN_TYPE max_lsn_;
     std::set<ID_TYPE> empty_set_;
+    int64_t size_estimate_ = 0;
 };
 
 using GCHandler = std::function<void(Snapshot::Ptr)>;
@@ -44,6 +44,9 @@ SnapshotHolder::Load(StorePtr store, ScopedSnapshotT& ss, ID_TYPE id, bool scope
     }
 
     std::unique_lock<std::mutex> lock(mutex_);
+    if (evicted_) {
+        return EvictedStatus("Load");
+    }
     if (id == 0 || id == max_id_) {
         auto raw = active_.at(max_id_);
         ss = ScopedSnapshotT(raw, scoped);
@@ -81,6 +84,9 @@ SnapshotHolder::Get(ScopedSnapshotT& ss, ID_TYPE id, bool scoped) const {
     }
 
     std::unique_lock<std::mutex> lock(mutex_);
+    if (evicted_) {
+        return EvictedStatus("Get");
+    }
     if (id == 0 || id == max_id_) {
         auto raw = active_.at(max_id_);
         ss = ScopedSnapshotT(raw, scoped);
@@ -112,11 +118,47 @@ SnapshotHolder::IsActive(Snapshot::Ptr& ss) {
     return collection && collection->IsActive();
 }
 
+int64_t
+SnapshotHolder::EstimatedSize() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    int64_t size = 0;
+    for (auto& kv : active_) {
+        size += kv.second->EstimatedSize();
+    }
+    return size;
+}
+
+bool
+SnapshotHolder::Evict() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto& kv : active_) {
+        if (!kv.second->IsEvictable()) {
+            return false;
+        }
+    }
+
+    for (auto& kv : active_) {
+        kv.second->Evict();
+    }
+    evicted_ = true;
+    return true;
+}
+
+Status
+SnapshotHolder::EvictedStatus(const std::string& method) const {
+    std::stringstream emsg;
+    emsg << "SnapshotHolder::" << method << ": Holder of collection " << collection_id_ << " is evicted";
+    return Status(SS_HOLDER_EVICTED, emsg.str());
+}
+
 Status
 SnapshotHolder::Add(StorePtr store, ID_TYPE id) {
     Status status;
     {
         std::unique_lock<std::mutex> lock(mutex_);
+        if (evicted_) {
+            return EvictedStatus("Add");
+        }
         if (active_.size() > 0 && id < max_id_) {
             std::stringstream emsg;
             emsg << "SnapshotHolder::Add: Invalid snapshot " << id << ".";
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <limits>
 #include <map>
 #include <memory>
@@ -47,6 +48,24 @@ class SnapshotHolder {
     bool
     IsActive(Snapshot::Ptr& ss);
 
+    void
+    Touch(int64_t tick) {
+        last_access_ = tick;
+    }
+
+    int64_t
+    LastAccess() const {
+        return last_access_;
+    }
+
+    int64_t
+    EstimatedSize() const;
+
+    // evict the held snapshots if none of them is in use, Get, Load and Add of an evicted holder fail with
+    // SS_HOLDER_EVICTED and the caller loads the collection again
+    bool
+    Evict();
+
     ~SnapshotHolder();
 
  private:
@@ -55,6 +74,9 @@ class SnapshotHolder {
     Status
     LoadNoLock(ID_TYPE collection_commit_id, CollectionCommitPtr& cc, StorePtr store);
 
+    Status
+    EvictedStatus(const std::string& method) const;
+
     void
     ReadyForRelease(Snapshot::Ptr ss) {
         if (gc_handler_) {
@@ -70,6 +92,8 @@ class SnapshotHolder {
     std::vector<Snapshot::Ptr> to_release_;
     size_t num_versions_ = 1;
     GCHandler gc_handler_;
+    std::atomic<int64_t> last_access_ = {0};
+    bool evicted_ = false;
 };
 
 using SnapshotHolderPtr = std::shared_ptr<SnapshotHolder>;
@@ -19,6 +19,10 @@
 #include "db/snapshot/OperationExecutor.h"
 #include "utils/CommonUtil.h"
 
+#include <algorithm>
+#include <set>
+#include <utility>
+
 namespace milvus::engine::snapshot {
 
 /* Status */
@@ -72,31 +76,46 @@ Snapshots::DropPartition(const ID_TYPE& collection_id, const ID_TYPE& partition_
 
 Status
 Snapshots::LoadSnapshot(StorePtr store, ScopedSnapshotT& ss, ID_TYPE collection_id, ID_TYPE id, bool scoped) {
-    SnapshotHolderPtr holder;
-    STATUS_CHECK(LoadHolder(store, collection_id, holder));
-    return holder->Load(store, ss, id, scoped);
+    // the holder may be evicted once the lock is released, then the collection is loaded again
+    Status status;
+    do {
+        SnapshotHolderPtr holder;
+        STATUS_CHECK(LoadHolder(store, collection_id, holder));
+        status = holder->Load(store, ss, id, scoped);
+    } while (status.code() == SS_HOLDER_EVICTED);
+    return status;
 }
 
 Status
-Snapshots::GetSnapshot(ScopedSnapshotT& ss, ID_TYPE collection_id, ID_TYPE id, bool scoped) const {
-    SnapshotHolderPtr holder;
-    STATUS_CHECK(GetHolder(collection_id, holder));
-    return holder->Get(ss, id, scoped);
+Snapshots::GetSnapshot(ScopedSnapshotT& ss, ID_TYPE collection_id, ID_TYPE id, bool scoped) {
+    Status status;
+    do {
+        SnapshotHolderPtr holder;
+        STATUS_CHECK(GetHolder(collection_id, holder));
+        status = holder->Get(ss, id, scoped);
+    } while (status.code() == SS_HOLDER_EVICTED);
+    return status;
 }
 
 Status
-Snapshots::GetSnapshot(ScopedSnapshotT& ss, const std::string& name, ID_TYPE id, bool scoped) const {
-    SnapshotHolderPtr holder;
-    STATUS_CHECK(GetHolder(name, holder));
-    return holder->Get(ss, id, scoped);
+Snapshots::GetSnapshot(ScopedSnapshotT& ss, const std::string& name, ID_TYPE id, bool scoped) {
+    Status status;
+    do {
+        SnapshotHolderPtr holder;
+        STATUS_CHECK(GetHolder(name, holder));
+        status = holder->Get(ss, id, scoped);
+    } while (status.code() == SS_HOLDER_EVICTED);
+    return status;
 }
 
 Status
 Snapshots::GetCollectionIds(IDS_TYPE& ids) const {
     std::shared_lock<std::shared_timed_mutex> lock(mutex_);
-    for (auto& kv : holders_) {
-        ids.push_back(kv.first);
+    std::set<ID_TYPE> sorted_ids;
+    for (auto& kv : name_id_map_) {
+        sorted_ids.insert(kv.second);
     }
+    ids.insert(ids.end(), sorted_ids.begin(), sorted_ids.end());
     return Status::OK();
 }
 
@@ -109,6 +128,51 @@ Snapshots::GetCollectionNames(std::vector<std::string>& names) const {
     return Status::OK();
 }
 
+Status
+Snapshots::GetLoadedCollectionNames(std::vector<std::string>& names) const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    for (auto& kv : name_id_map_) {
+        if (holders_.find(kv.second) != holders_.end()) {
+            names.push_back(kv.first);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Snapshots::GetCollectionLsn(const std::string& name, LSN_TYPE& lsn) {
+    ID_TYPE collection_id = 0;
+    SnapshotHolderPtr holder;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        auto it = name_id_map_.find(name);
+        if (it == name_id_map_.end()) {
+            return Status(SS_NOT_FOUND_ERROR, "Collection " + name + " not found.");
+        }
+        collection_id = it->second;
+        GetHolderNoLock(collection_id, holder);
+    }
+
+    if (holder || store_ == nullptr) {
+        ScopedSnapshotT ss;
+        STATUS_CHECK(GetSnapshot(ss, collection_id));
+        lsn = ss->GetMaxLsn();
+        return Status::OK();
+    }
+
+    // the ids are not filtered by state, a pending or deactivated commit may be newer than the active one
+    auto commit_ids = store_->AllActiveCollectionCommitIds(collection_id, true);
+    for (auto commit_id : commit_ids) {
+        CollectionCommitPtr collection_commit;
+        STATUS_CHECK(store_->GetResource<CollectionCommit>(commit_id, collection_commit));
+        if (collection_commit->IsActive()) {
+            lsn = collection_commit->GetLsn();
+            return Status::OK();
+        }
+    }
+    return Status(SS_NOT_FOUND_ERROR, "No active collection commit is found for collection " + name);
+}
+
 Status
 Snapshots::LoadNoLock(StorePtr store, ID_TYPE collection_id, SnapshotHolderPtr& holder) {
     auto op = std::make_shared<GetSnapshotIDsOperation>(collection_id, false);
@@ -122,10 +186,24 @@ Snapshots::LoadNoLock(StorePtr store, ID_TYPE collection_id, SnapshotHolderPtr&
     }
     holder = std::make_shared<SnapshotHolder>(collection_id,
                                               std::bind(&Snapshots::SnapshotGCCallback, this, std::placeholders::_1));
+    Status status(SS_NOT_ACTIVE_ERROR, "Snapshots::LoadNoLock: No active collection commit is found");
+    bool added = false;
     for (auto c_c_id : collection_commit_ids) {
-        holder->Add(store, c_c_id);
+        // skip commits of operations that are still pending or were rolled back, read from the store so that a
+        // pending copy is never cached in the holder
+        CollectionCommitPtr collection_commit;
+        auto get_status = store->GetResource<CollectionCommit>(c_c_id, collection_commit);
+        if (!get_status.ok() || !collection_commit || !collection_commit->IsActive()) {
+            continue;
+        }
+        auto add_status = holder->Add(store, c_c_id);
+        if (add_status.ok()) {
+            added = true;
+        } else {
+            status = add_status;
+        }
     }
-    return Status::OK();
+    return added ? Status::OK() : status;
 }
 
 Status
@@ -136,15 +214,25 @@ Snapshots::Init(StorePtr store) {
     auto op = std::make_shared<GetCollectionIDsOperation>();
     STATUS_CHECK((*op)(store));
     auto& collection_ids = op->GetIDs();
-    SnapshotHolderPtr holder;
-    for (auto& collection_id : collection_ids) {
-        STATUS_CHECK(LoadHolder(store, collection_id, holder));
+
+    // only names are read here, snapshots are loaded when collections are accessed
+    std::vector<CollectionPtr> collections;
+    STATUS_CHECK(store->GetResources<Collection>(collection_ids, collections));
+
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    store_ = store;
+    memory_limit_ = config.engine.snapshot_memory_limit();
+    for (auto& collection : collections) {
+        if (collection->IsActive()) {
+            name_id_map_[collection->GetName()] = collection->GetID();
+        }
     }
+    LOG_ENGINE_DEBUG_ << "Snapshots::Init: " << name_id_map_.size() << " collections";
     return Status::OK();
 }
 
 Status
-Snapshots::GetHolder(const std::string& name, SnapshotHolderPtr& holder) const {
+Snapshots::GetHolder(const std::string& name, SnapshotHolderPtr& holder) {
     std::shared_lock<std::shared_timed_mutex> lock(mutex_);
     auto kv = name_id_map_.find(name);
     if (kv != name_id_map_.end()) {
@@ -160,12 +248,21 @@ Snapshots::GetHolder(const std::string& name, SnapshotHolderPtr& holder) const {
 }
 
 Status
-Snapshots::GetHolder(const ID_TYPE& collection_id, SnapshotHolderPtr& holder) const {
+Snapshots::GetHolder(const ID_TYPE& collection_id, SnapshotHolderPtr& holder) {
     Status status;
-    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
-    status = GetHolderNoLock(collection_id, holder);
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        status = GetHolderNoLock(collection_id, holder);
+        if (status.ok()) {
+            holder->Touch(++access_tick_);
+            return status;
+        }
+        if (store_ == nullptr || !IsKnownNoLock(collection_id)) {
+            return status;
+        }
+    }
 
-    return status;
+    return LoadHolder(store_, collection_id, holder);
 }
 
 Status
@@ -174,19 +271,85 @@ Snapshots::LoadHolder(StorePtr store, const ID_TYPE& collection_id, SnapshotHold
         std::shared_lock<std::shared_timed_mutex> lock(mutex_);
         auto status = GetHolderNoLock(collection_id, holder);
         if (status.ok() && holder) {
+            holder->Touch(++access_tick_);
+            return status;
+        }
+    }
+
+    // one collection is loaded at a time, so concurrent accesses never build two holders of it
+    std::lock_guard<std::mutex> load_lock(load_mutex_);
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        auto status = GetHolderNoLock(collection_id, holder);
+        if (status.ok() && holder) {
+            holder->Touch(++access_tick_);
             return status;
         }
     }
+
     STATUS_CHECK(LoadNoLock(store, collection_id, holder));
+    ScopedSnapshotT ss;
+    STATUS_CHECK(holder->Load(store, ss));
 
     std::unique_lock<std::shared_timed_mutex> lock(mutex_);
     holders_[collection_id] = holder;
-    ScopedSnapshotT ss;
-    STATUS_CHECK(holder->Load(store, ss));
     name_id_map_[ss->GetName()] = collection_id;
+    holder->Touch(++access_tick_);
+    EvictNoLock(collection_id);
     return Status::OK();
 }
 
+void
+Snapshots::SetMemoryLimit(int64_t limit) {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    memory_limit_ = limit;
+    EvictNoLock(0);
+}
+
+void
+Snapshots::EvictNoLock(ID_TYPE keep_id) {
+    if (memory_limit_ <= 0) {
+        return;
+    }
+
+    int64_t total_size = 0;
+    std::vector<std::pair<int64_t, ID_TYPE>> lru;
+    for (auto& kv : holders_) {
+        total_size += kv.second->EstimatedSize();
+        if (kv.first != keep_id) {
+            lru.emplace_back(kv.second->LastAccess(), kv.first);
+        }
+    }
+    if (total_size <= memory_limit_) {
+        return;
+    }
+
+    std::sort(lru.begin(), lru.end());
+    for (auto& item : lru) {
+        if (total_size <= memory_limit_) {
+            break;
+        }
+        auto& holder = holders_[item.second];
+        auto size = holder->EstimatedSize();
+        // collections in use are skipped, they are evicted later when they become idle
+        if (holder->Evict()) {
+            total_size -= size;
+            holders_.erase(item.second);
+            LOG_ENGINE_DEBUG_ << "Snapshots: evict snapshot of collection " << item.second << ", " << size << " bytes";
+        }
+    }
+}
+
+bool
+Snapshots::IsKnownNoLock(ID_TYPE collection_id) const {
+    for (auto& kv : name_id_map_) {
+        if (kv.second == collection_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
 Status
 Snapshots::GetHolderNoLock(ID_TYPE collection_id, SnapshotHolderPtr& holder) const {
     auto it = holders_.find(collection_id);
@@ -206,6 +369,7 @@ Snapshots::Reset() {
     holders_.clear();
     name_id_map_.clear();
     to_release_.clear();
+    store_ = nullptr;
     return Status::OK();
 }
 
@@ -229,7 +393,7 @@ Snapshots::StartService() {
     }
 
     auto store = snapshot::Store::Build(config.general.meta_uri(), meta_path, codec::Codec::instance().GetSuffixSet());
-    snapshot::OperationExecutor::Init(store);
+    snapshot::OperationExecutor::Init(store, config.engine.snapshot_operation_threads());
     snapshot::OperationExecutor::GetInstance().Start();
     snapshot::EventExecutor::Init(store);
     snapshot::EventExecutor::GetInstance().Start();
@@ -32,17 +32,18 @@ class Snapshots {
         static Snapshots sss;
         return sss;
     }
+    // holders are loaded on first access, Init only reads the names of the collections
     Status
-    GetHolder(const ID_TYPE& collection_id, SnapshotHolderPtr& holder) const;
+    GetHolder(const ID_TYPE& collection_id, SnapshotHolderPtr& holder);
     Status
-    GetHolder(const std::string& name, SnapshotHolderPtr& holder) const;
+    GetHolder(const std::string& name, SnapshotHolderPtr& holder);
     Status
     LoadHolder(StorePtr store, const ID_TYPE& collection_id, SnapshotHolderPtr& holder);
 
     Status
-    GetSnapshot(ScopedSnapshotT& ss, ID_TYPE collection_id, ID_TYPE id = 0, bool scoped = true) const;
+    GetSnapshot(ScopedSnapshotT& ss, ID_TYPE collection_id, ID_TYPE id = 0, bool scoped = true);
     Status
-    GetSnapshot(ScopedSnapshotT& ss, const std::string& name, ID_TYPE id = 0, bool scoped = true) const;
+    GetSnapshot(ScopedSnapshotT& ss, const std::string& name, ID_TYPE id = 0, bool scoped = true);
     Status
     LoadSnapshot(StorePtr store, ScopedSnapshotT& ss, ID_TYPE collection_id, ID_TYPE id, bool scoped = true);
 
@@ -50,6 +51,17 @@ class Snapshots {
     GetCollectionIds(IDS_TYPE& ids) const;
     Status
     GetCollectionNames(std::vector<std::string>& names) const;
+    Status
+    GetLoadedCollectionNames(std::vector<std::string>& names) const;
+
+    // max lsn of the collection, read from the latest collection commit if the collection is not loaded
+    Status
+    GetCollectionLsn(const std::string& name, LSN_TYPE& lsn);
+
+    // estimated bytes of loaded snapshots, idle collections are evicted in least recently used order when it is
+    // exceeded, 0 means no limit
+    void
+    SetMemoryLimit(int64_t limit);
 
     Status
     DropCollection(const std::string& name, const LSN_TYPE& lsn);
@@ -82,11 +94,19 @@ class Snapshots {
     LoadNoLock(StorePtr store, ID_TYPE collection_id, SnapshotHolderPtr& holder);
     Status
     GetHolderNoLock(ID_TYPE collection_id, SnapshotHolderPtr& holder) const;
+    bool
+    IsKnownNoLock(ID_TYPE collection_id) const;
+    void
+    EvictNoLock(ID_TYPE keep_id);
 
     mutable std::shared_timed_mutex mutex_;
+    std::mutex load_mutex_;
     std::map<ID_TYPE, SnapshotHolderPtr> holders_;
     std::map<std::string, ID_TYPE> name_id_map_;
     std::vector<Snapshot::Ptr> to_release_;
+    StorePtr store_;
+    int64_t memory_limit_ = 0;
+    std::atomic<int64_t> access_tick_ = {0};
 };
 
 }  // namespace milvus::engine::snapshot
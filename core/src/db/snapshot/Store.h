@@ -27,6 +27,7 @@
 #include <fiu/fiu-local.h>
 #include <stdlib.h>
 #include <time.h>
+#include <algorithm>
 #include <any>
 #include <functional>
 #include <iomanip>
@@ -152,6 +153,29 @@ class Store : public std::enable_shared_from_this<Store> {
         return Status::OK();
     }
 
+    // select resources by id with a few IN queries, ids are split into chunks and each chunk is padded to a power
+    // of two by repeating the last id, so the meta backend only sees a handful of statement shapes
+    template <typename ResourceT>
+    Status
+    GetResources(const IDS_TYPE& ids, std::vector<typename ResourceT::Ptr>& return_vs) {
+        constexpr size_t MAX_BATCH_SIZE = 256;
+        for (size_t from = 0; from < ids.size(); from += MAX_BATCH_SIZE) {
+            auto to = std::min(from + MAX_BATCH_SIZE, ids.size());
+            IDS_TYPE batch(ids.begin() + from, ids.begin() + to);
+            size_t padded_size = 1;
+            while (padded_size < batch.size()) {
+                padded_size <<= 1;
+            }
+            batch.resize(padded_size, batch.back());
+
+            std::vector<typename ResourceT::Ptr> resources;
+            STATUS_CHECK(adapter_->SelectBy<ResourceT>(IdField::Name, batch, resources));
+            return_vs.insert(return_vs.end(), resources.begin(), resources.end());
+        }
+
+        return Status::OK();
+    }
+
     Status
     GetCollection(const std::string& name, CollectionPtr& return_v) {
         // TODO: Get active collection
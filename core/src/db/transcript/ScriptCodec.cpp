@@ -72,6 +72,7 @@ const char* J_KEY = "key";
 const char* J_VECTOR_QUERIES = "vector_queries";
 const char* J_TOPK = "topk";
 const char* J_NQ = "nq";
+const char* J_RADIUS = "radius";
 const char* J_BOOST = "boost";
 const char* J_FLOAT_DATA = "float_data";
 const char* J_BIN_DATA = "bin_data";
@@ -245,6 +246,9 @@ ScriptCodec::Encode(milvus::json& json_obj, const query::QueryPtr& query_ptr) {
         vector_query[J_PARAMS] = query->extra_params;
         vector_query[J_TOPK] = query->topk;
         vector_query[J_NQ] = query->nq;
+        if (query->range_search) {
+            vector_query[J_RADIUS] = query->radius;
+        }
         vector_query[J_METRIC_TYPE] = query->metric_type;
         vector_query[J_BOOST] = query->boost;
         vector_query[J_FLOAT_DATA] = query->query_vector.float_data;
@@ -510,6 +514,10 @@ ScriptCodec::Decode(milvus::json& json_obj, query::QueryPtr& query_ptr) {
             query->extra_params = vector_query[J_PARAMS];
             query->topk = vector_query[J_TOPK];
             query->nq = vector_query[J_NQ];
+            if (vector_query.find(J_RADIUS) != vector_query.end()) {
+                query->range_search = true;
+                query->radius = vector_query[J_RADIUS];
+            }
             query->metric_type = vector_query[J_METRIC_TYPE];
             query->boost = vector_query[J_BOOST];
             query->query_vector.float_data = vector_query[J_FLOAT_DATA].get<std::vector<float>>();
@@ -30,10 +30,11 @@ CollectMaxOpIDFromMeta(CollectionMaxOpIDMap& max_op_ids) {
     std::vector<std::string> collection_names;
     snapshot::Snapshots::GetInstance().GetCollectionNames(collection_names);
     for (auto& collection_name : collection_names) {
-        snapshot::ScopedSnapshotT ss;
-        auto status = snapshot::Snapshots::GetInstance().GetSnapshot(ss, collection_name);
+        // read from the latest collection commit, the collection snapshot is not loaded for it
+        snapshot::LSN_TYPE lsn = 0;
+        auto status = snapshot::Snapshots::GetInstance().GetCollectionLsn(collection_name, lsn);
         if (status.ok()) {
-            max_op_ids.insert(std::make_pair(collection_name, ss->GetMaxLsn()));
+            max_op_ids.insert(std::make_pair(collection_name, lsn));
         }
     }
 
@@ -18,6 +18,7 @@
 
 #include "config/ServerConfig.h"
 #include "faiss/FaissHook.h"
+#include "knowhere/index/vector_offset_index/IVFListFile.h"
 #include "scheduler/Utils.h"
 #include "utils/ConfigUtils.h"
 #include "utils/Error.h"
@@ -92,6 +93,9 @@ KnowhereResource::Initialize() {
             break;
     }
 
+    // one list cache budget for all indexes loaded in ivf disk mode
+    knowhere::IVFListCache::GetInstance().SetCapacity(config.engine.ivf_disk_cache_size());
+
 #ifdef MILVUS_GPU_VERSION
     bool enable_gpu = config.gpu.enable();
     fiu_do_on("KnowhereResource.Initialize.disable_gpu", enable_gpu = false);
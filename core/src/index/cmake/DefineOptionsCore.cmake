@@ -97,6 +97,8 @@ else ()
     define_option(KNOWHERE_BUILD_TESTS "Build the KNOWHERE googletest unit tests" OFF)
 endif (BUILD_UNIT_TEST)
 
+define_option(KNOWHERE_BUILD_BENCHMARK "Build the KNOWHERE ANN benchmark milvus_ann_bench" OFF)
+
 #----------------------------------------------------------------------
 macro(config_summary)
     message(STATUS "---------------------------------------------------------------------")
@@ -39,6 +39,8 @@ static const int64_t HNSW_MAX_EFCONSTRUCTION = 512;
 static const int64_t HNSW_MIN_M = 4;
 static const int64_t HNSW_MAX_M = 64;
 static const int64_t HNSW_MAX_EF = 32768;
+static const int64_t MIN_BUILD_THREADS = 1;
+static const int64_t MAX_BUILD_THREADS = 1024;
 static const std::vector<std::string> METRICS{knowhere::Metric::L2, knowhere::Metric::IP};
 
 #define CheckIntByRange(key, min, max)                                                                   \
@@ -79,6 +81,10 @@ ConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMode m
     const int64_t DEFAULT_MIN_K = 1;
     const int64_t DEFAULT_MAX_K = 16384;
     CheckIntByRange(knowhere::meta::TOPK, DEFAULT_MIN_K - 1, DEFAULT_MAX_K);
+    if (oricfg.contains(knowhere::IndexParams::refine_k)) {
+        // optional, number of candidates to rerank with raw vectors
+        CheckIntByRange(knowhere::IndexParams::refine_k, oricfg[knowhere::meta::TOPK].get<int64_t>(), DEFAULT_MAX_K);
+    }
     return true;
 }
 
@@ -357,6 +363,9 @@ ANNOYConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t MAX_NTREES = 1024;
 
     CheckIntByRange(knowhere::IndexParams::n_trees, MIN_NTREES, MAX_NTREES);
+    if (oricfg.contains(knowhere::IndexParams::build_threads)) {
+        CheckIntByRange(knowhere::IndexParams::build_threads, MIN_BUILD_THREADS, MAX_BUILD_THREADS);
+    }
 
     return ConfAdapter::CheckTrain(oricfg, mode);
 }
@@ -368,6 +377,15 @@ ANNOYConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexM
     return ConfAdapter::CheckSearch(oricfg, type, mode);
 }
 
+bool
+SPTAGConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    if (oricfg.contains(knowhere::IndexParams::build_threads)) {
+        CheckIntByRange(knowhere::IndexParams::build_threads, MIN_BUILD_THREADS, MAX_BUILD_THREADS);
+    }
+
+    return ConfAdapter::CheckTrain(oricfg, mode);
+}
+
 bool
 NGTPANNGConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static std::vector<std::string> METRICS{knowhere::Metric::L2, knowhere::Metric::HAMMING, knowhere::Metric::JACCARD};
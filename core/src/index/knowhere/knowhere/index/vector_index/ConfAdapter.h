@@ -100,6 +100,12 @@ class ANNOYConfAdapter : public ConfAdapter {
     CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) override;
 };
 
+class SPTAGConfAdapter : public ConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+};
+
 class RHNSWFlatConfAdapter : public ConfAdapter {
  public:
     bool
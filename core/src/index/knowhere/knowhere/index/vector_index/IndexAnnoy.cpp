@@ -11,6 +11,7 @@
 
 #include "knowhere/index/vector_index/IndexAnnoy.h"
 
+#include <omp.h>
 #include <algorithm>
 #include <cassert>
 #include <iterator>
@@ -101,11 +102,36 @@ IndexAnnoy::BuildAll(const DatasetPtr& dataset_ptr, const Config& config) {
         index_->add_item(p_ids[i], static_cast<const float*>(p_data) + dim * i);
     }
 
-    index_->build(config[IndexParams::n_trees].get<int64_t>());
+    int64_t build_threads = omp_get_max_threads();
+    if (config.contains(IndexParams::build_threads)) {
+        build_threads = config[IndexParams::build_threads].get<int64_t>();
+    }
+    index_->build(config[IndexParams::n_trees].get<int64_t>(), build_threads);
 }
 
 DatasetPtr
 IndexAnnoy::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    auto all_num = dataset_ptr->Get<int64_t>(meta::ROWS) * config[meta::TOPK].get<int64_t>();
+    auto p_id = static_cast<int64_t*>(malloc(all_num * sizeof(int64_t)));
+    auto p_dist = static_cast<float*>(malloc(all_num * sizeof(float)));
+
+    try {
+        QueryInto(dataset_ptr, config, p_id, p_dist, nullptr);
+    } catch (...) {
+        free(p_id);
+        free(p_dist);
+        throw;
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+IndexAnnoy::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances,
+                      const std::vector<IDType>* uids) {
     if (!index_) {
         KNOWHERE_THROW_MSG("index not initialize or trained");
     }
@@ -113,35 +139,36 @@ IndexAnnoy::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     GET_TENSOR_DATA_DIM(dataset_ptr)
     auto k = config[meta::TOPK].get<int64_t>();
     auto search_k = config[IndexParams::search_k].get<int64_t>();
-    auto all_num = rows * k;
-    auto p_id = static_cast<int64_t*>(malloc(all_num * sizeof(int64_t)));
-    auto p_dist = static_cast<float*>(malloc(all_num * sizeof(float)));
     faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
 
-#pragma omp parallel for
-    for (unsigned int i = 0; i < rows; ++i) {
+#pragma omp parallel
+    {
+        // annoy appends to the output vectors, reuse them across the queries of this thread
         std::vector<int64_t> result;
         result.reserve(k);
-        std::vector<float> distances;
-        distances.reserve(k);
-        index_->get_nns_by_vector(static_cast<const float*>(p_data) + i * dim, k, search_k, &result, &distances,
-                                  blacklist);
-
-        int64_t result_num = result.size();
-        auto local_p_id = p_id + k * i;
-        auto local_p_dist = p_dist + k * i;
-        memcpy(local_p_id, result.data(), result_num * sizeof(int64_t));
-        memcpy(local_p_dist, distances.data(), result_num * sizeof(float));
-        for (; result_num < k; result_num++) {
-            local_p_id[result_num] = -1;
-            local_p_dist[result_num] = 1.0 / 0.0;
+        std::vector<float> result_dist;
+        result_dist.reserve(k);
+
+#pragma omp for
+        for (unsigned int i = 0; i < rows; ++i) {
+            result.clear();
+            result_dist.clear();
+            index_->get_nns_by_vector(static_cast<const float*>(p_data) + i * dim, k, search_k, &result,
+                                      &result_dist, blacklist);
+
+            int64_t result_num = result.size();
+            auto local_p_id = ids + k * i;
+            auto local_p_dist = distances + k * i;
+            for (int64_t j = 0; j < result_num; ++j) {
+                local_p_id[j] = uids != nullptr ? (*uids)[result[j]] : result[j];
+                local_p_dist[j] = result_dist[j];
+            }
+            for (; result_num < k; result_num++) {
+                local_p_id[result_num] = -1;
+                local_p_dist[result_num] = 1.0 / 0.0;
+            }
         }
     }
-
-    auto ret_ds = std::make_shared<Dataset>();
-    ret_ds->Set(meta::IDS, p_id);
-    ret_ds->Set(meta::DISTANCE, p_dist);
-    return ret_ds;
 }
 
 int64_t
@@ -56,6 +56,10 @@ class IndexAnnoy : public VecIndex {
     DatasetPtr
     Query(const DatasetPtr& dataset_ptr, const Config& config) override;
 
+    void
+    QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances,
+              const std::vector<IDType>* uids) override;
+
     int64_t
     Count() override;
 
@@ -41,27 +41,38 @@ BinaryIDMAP::Load(const BinarySet& index_binary) {
 
 DatasetPtr
 BinaryIDMAP::Query(const DatasetPtr& dataset_ptr, const Config& config) {
-    if (!index_) {
-        KNOWHERE_THROW_MSG("index not initialize");
-    }
-    GET_TENSOR_DATA(dataset_ptr)
-
-    auto k = config[meta::TOPK].get<int64_t>();
-    auto elems = rows * k;
-    size_t p_id_size = sizeof(int64_t) * elems;
-    size_t p_dist_size = sizeof(float) * elems;
-    auto p_id = static_cast<int64_t*>(malloc(p_id_size));
-    auto p_dist = static_cast<float*>(malloc(p_dist_size));
+    auto elems = dataset_ptr->Get<int64_t>(meta::ROWS) * config[meta::TOPK].get<int64_t>();
+    auto p_id = static_cast<int64_t*>(malloc(sizeof(int64_t) * elems));
+    auto p_dist = static_cast<float*>(malloc(sizeof(float) * elems));
 
-    QueryImpl(rows, reinterpret_cast<const uint8_t*>(p_data), k, p_dist, p_id, config);
+    try {
+        QueryInto(dataset_ptr, config, p_id, p_dist, nullptr);
+    } catch (...) {
+        free(p_id);
+        free(p_dist);
+        throw;
+    }
 
     auto ret_ds = std::make_shared<Dataset>();
     ret_ds->Set(meta::IDS, p_id);
     ret_ds->Set(meta::DISTANCE, p_dist);
-
     return ret_ds;
 }
 
+void
+BinaryIDMAP::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances,
+                       const std::vector<IDType>* uids) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    GET_TENSOR_DATA(dataset_ptr)
+
+    auto k = config[meta::TOPK].get<int64_t>();
+    QueryImpl(rows, reinterpret_cast<const uint8_t*>(p_data), k, distances, ids, config);
+    MapOffsetsToUids(ids, rows * k, uids);
+}
+
 int64_t
 BinaryIDMAP::Count() {
     if (!index_) {
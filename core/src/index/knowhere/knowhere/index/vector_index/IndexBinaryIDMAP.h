@@ -50,6 +50,9 @@ class BinaryIDMAP : public VecIndex, public FaissBaseBinaryIndex {
     DatasetPtr
     Query(const DatasetPtr&, const Config&) override;
 
+    void
+    QueryInto(const DatasetPtr&, const Config&, int64_t*, float*, const std::vector<IDType>*) override;
+
     int64_t
     Count() override;
 
@@ -44,6 +44,27 @@ BinaryIVF::Load(const BinarySet& index_binary) {
 
 DatasetPtr
 BinaryIVF::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    auto elems = dataset_ptr->Get<int64_t>(meta::ROWS) * config[meta::TOPK].get<int64_t>();
+    auto p_id = static_cast<int64_t*>(malloc(sizeof(int64_t) * elems));
+    auto p_dist = static_cast<float*>(malloc(sizeof(float) * elems));
+
+    try {
+        QueryInto(dataset_ptr, config, p_id, p_dist, nullptr);
+    } catch (...) {
+        free(p_id);
+        free(p_dist);
+        throw;
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+BinaryIVF::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances,
+                     const std::vector<IDType>* uids) {
     if (!index_ || !index_->is_trained) {
         KNOWHERE_THROW_MSG("index not initialize or trained");
     }
@@ -52,21 +73,8 @@ BinaryIVF::Query(const DatasetPtr& dataset_ptr, const Config& config) {
 
     try {
         auto k = config[meta::TOPK].get<int64_t>();
-        auto elems = rows * k;
-
-        size_t p_id_size = sizeof(int64_t) * elems;
-        size_t p_dist_size = sizeof(float) * elems;
-        auto p_id = static_cast<int64_t*>(malloc(p_id_size));
-        auto p_dist = static_cast<float*>(malloc(p_dist_size));
-
-        QueryImpl(rows, reinterpret_cast<const uint8_t*>(p_data), k, p_dist, p_id, config);
-
-        auto ret_ds = std::make_shared<Dataset>();
-
-        ret_ds->Set(meta::IDS, p_id);
-        ret_ds->Set(meta::DISTANCE, p_dist);
-
-        return ret_ds;
+        QueryImpl(rows, reinterpret_cast<const uint8_t*>(p_data), k, distances, ids, config);
+        MapOffsetsToUids(ids, rows * k, uids);
     } catch (faiss::FaissException& e) {
         KNOWHERE_THROW_MSG(e.what());
     } catch (std::exception& e) {
@@ -137,61 +137,104 @@ IndexHNSW::Add(const DatasetPtr& dataset_ptr, const Config& config) {
 
 DatasetPtr
 IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    auto elems = dataset_ptr->Get<int64_t>(meta::ROWS) * config[meta::TOPK].get<int64_t>();
+    auto p_id = static_cast<int64_t*>(malloc(sizeof(int64_t) * elems));
+    auto p_dist = static_cast<float*>(malloc(sizeof(float) * elems));
+
+    try {
+        QueryInto(dataset_ptr, config, p_id, p_dist, nullptr);
+    } catch (...) {
+        free(p_id);
+        free(p_dist);
+        throw;
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+IndexHNSW::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances,
+                     const std::vector<IDType>* uids) {
     if (!index_) {
         KNOWHERE_THROW_MSG("index not initialize or trained");
     }
     GET_TENSOR_DATA(dataset_ptr)
 
     size_t k = config[meta::TOPK].get<int64_t>();
-    size_t id_size = sizeof(int64_t) * k;
-    size_t dist_size = sizeof(float) * k;
-    auto p_id = static_cast<int64_t*>(malloc(id_size * rows));
-    auto p_dist = static_cast<float*>(malloc(dist_size * rows));
 
     index_->setEf(config[IndexParams::ef]);
 
-    using P = std::pair<float, int64_t>;
-    auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
+    faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
+    auto dim = Dim();
+#pragma omp parallel
+    {
+        // one search buffer per thread for all its queries, reused by the following calls
+        auto buffer = search_buffers_.Acquire();
+#pragma omp for
+        for (unsigned int i = 0; i < rows; ++i) {
+            const float* single_query = reinterpret_cast<const float*>(p_data) + i * dim;
+            index_->searchKnn(single_query, k, blacklist, *buffer);
+            auto& ret = buffer->result;
+
+            auto local_id = ids + i * k;
+            auto local_dist = distances + i * k;
+            size_t j = 0;
+            for (; j < ret.size(); ++j) {
+                local_id[j] = uids != nullptr ? (*uids)[ret[j].second] : ret[j].second;
+                local_dist[j] = normalize ? float(1 - ret[j].first) : ret[j].first;
+            }
+            for (; j < k; ++j) {
+                local_id[j] = -1;
+                local_dist[j] = normalize ? 2.0f : -1.0f;
+            }
+        }
+    }
+}
+
+DatasetPtr
+IndexHNSW::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+    GET_TENSOR_DATA(dataset_ptr)
 
+    index_->setEf(config[IndexParams::ef]);
+
+    // inner product is stored as 1 - ip in the graph
+    auto radius = config[meta::RADIUS].get<float>();
+    float graph_radius = normalize ? 1 - radius : radius;
+
+    std::vector<RangeResult> results(rows);
     faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
 #pragma omp parallel for
     for (unsigned int i = 0; i < rows; ++i) {
-        std::vector<P> ret;
         const float* single_query = reinterpret_cast<const float*>(p_data) + i * Dim();
-
-        // if (normalize) {
-        //     std::vector<float> norm_vector(Dim());
-        //     normalize_vector((float*)(single_query), norm_vector.data(), Dim());
-        //     ret = index_->searchKnn((float*)(norm_vector.data()), config[meta::TOPK].get<int64_t>(), compare);
-        // } else {
-        //     ret = index_->searchKnn((float*)single_query, config[meta::TOPK].get<int64_t>(), compare);
-        // }
-        ret = index_->searchKnn(single_query, k, compare, blacklist);
-
-        while (ret.size() < k) {
-            ret.emplace_back(std::make_pair(-1, -1));
+        auto ret = index_->searchRange(single_query, graph_radius, blacklist);
+        auto& result = results[i];
+        result.reserve(ret.size());
+        for (auto& pair : ret) {
+            result.emplace_back(normalize ? float(1 - pair.first) : pair.first, pair.second);
         }
-        std::vector<float> dist;
-        std::vector<int64_t> ids;
+    }
 
-        if (normalize) {
-            std::transform(ret.begin(), ret.end(), std::back_inserter(dist),
-                           [](const std::pair<float, int64_t>& e) { return float(1 - e.first); });
-        } else {
-            std::transform(ret.begin(), ret.end(), std::back_inserter(dist),
-                           [](const std::pair<float, int64_t>& e) { return e.first; });
-        }
-        std::transform(ret.begin(), ret.end(), std::back_inserter(ids),
-                       [](const std::pair<float, int64_t>& e) { return e.second; });
+    return GenRangeResultDataset(results, config[meta::TOPK].get<int64_t>(), normalize);
+}
 
-        memcpy(p_dist + i * k, dist.data(), dist_size);
-        memcpy(p_id + i * k, ids.data(), id_size);
+void
+IndexHNSW::Compact(const std::vector<int64_t>& label_map, int64_t capacity) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
     }
 
-    auto ret_ds = std::make_shared<Dataset>();
-    ret_ds->Set(meta::IDS, p_id);
-    ret_ds->Set(meta::DISTANCE, p_dist);
-    return ret_ds;
+    std::lock_guard<std::mutex> lk(mutex_);
+    try {
+        index_->relabelAndCompact(label_map, capacity);
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
 }
 
 int64_t
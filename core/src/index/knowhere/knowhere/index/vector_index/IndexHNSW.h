@@ -13,11 +13,13 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "hnswlib/hnswlib.h"
 
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/VecIndex.h"
+#include "knowhere/index/vector_index/helpers/BufferPool.h"
 
 namespace milvus {
 namespace knowhere {
@@ -48,6 +50,19 @@ class IndexHNSW : public VecIndex {
     DatasetPtr
     Query(const DatasetPtr& dataset_ptr, const Config& config) override;
 
+    void
+    QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances,
+              const std::vector<IDType>* uids) override;
+
+    DatasetPtr
+    QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    // Drop the nodes which are not kept and re-label the others, so that the graph can be extended by Add()
+    // instead of being rebuilt. label_map[old_label] is the new label of a node, -1 means the node is dropped.
+    // capacity is the total number of rows the index could hold after extending.
+    void
+    Compact(const std::vector<int64_t>& label_map, int64_t capacity);
+
     int64_t
     Count() override;
 
@@ -61,6 +76,7 @@ class IndexHNSW : public VecIndex {
     bool normalize = false;
     std::mutex mutex_;
     std::shared_ptr<hnswlib::HierarchicalNSW<float>> index_;
+    BufferPool<hnswlib::HierarchicalNSW<float>::SearchBuffer> search_buffers_;
 };
 
 }  // namespace knowhere
@@ -15,6 +15,7 @@
 #include <faiss/IndexFlat.h>
 #include <faiss/MetaIndexes.h>
 #include <faiss/clone_index.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
 #ifdef MILVUS_GPU_VERSION
@@ -96,24 +97,46 @@ IDMAP::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
 
 DatasetPtr
 IDMAP::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    auto elems = dataset_ptr->Get<int64_t>(meta::ROWS) * config[meta::TOPK].get<int64_t>();
+    auto p_id = static_cast<int64_t*>(malloc(sizeof(int64_t) * elems));
+    auto p_dist = static_cast<float*>(malloc(sizeof(float) * elems));
+
+    try {
+        QueryInto(dataset_ptr, config, p_id, p_dist, nullptr);
+    } catch (...) {
+        free(p_id);
+        free(p_dist);
+        throw;
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+IDMAP::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances,
+                 const std::vector<IDType>* uids) {
     if (!index_) {
         KNOWHERE_THROW_MSG("index not initialize");
     }
+
     GET_TENSOR_DATA(dataset_ptr)
 
     auto k = config[meta::TOPK].get<int64_t>();
-    auto elems = rows * k;
-    size_t p_id_size = sizeof(int64_t) * elems;
-    size_t p_dist_size = sizeof(float) * elems;
-    auto p_id = static_cast<int64_t*>(malloc(p_id_size));
-    auto p_dist = static_cast<float*>(malloc(p_dist_size));
+    QueryImpl(rows, reinterpret_cast<const float*>(p_data), k, distances, ids, config);
+    MapOffsetsToUids(ids, rows * k, uids);
+}
 
-    QueryImpl(rows, reinterpret_cast<const float*>(p_data), k, p_dist, p_id, config);
+DatasetPtr
+IDMAP::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
 
-    auto ret_ds = std::make_shared<Dataset>();
-    ret_ds->Set(meta::IDS, p_id);
-    ret_ds->Set(meta::DISTANCE, p_dist);
-    return ret_ds;
+    GET_TENSOR_DATA(dataset_ptr)
+    return QueryByRangeImpl(rows, reinterpret_cast<const float*>(p_data), config);
 }
 
 #if 0
@@ -230,5 +253,16 @@ IDMAP::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int6
     index_->search(n, data, k, distances, labels, bitset_);
 }
 
+DatasetPtr
+IDMAP::QueryByRangeImpl(int64_t n, const float* data, const Config& config) {
+    auto flat_index = dynamic_cast<faiss::IndexIDMap*>(index_.get())->index;
+    flat_index->metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+
+    faiss::RangeSearchResult res(n);
+    index_->range_search(n, data, config[meta::RADIUS].get<float>(), &res, bitset_);
+    return GenRangeResultDataset(res, config[meta::TOPK].get<int64_t>(),
+                                 flat_index->metric_type == faiss::METRIC_INNER_PRODUCT);
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -48,6 +48,12 @@ class IDMAP : public VecIndex, public FaissBaseIndex {
     DatasetPtr
     Query(const DatasetPtr&, const Config&) override;
 
+    void
+    QueryInto(const DatasetPtr&, const Config&, int64_t*, float*, const std::vector<IDType>*) override;
+
+    DatasetPtr
+    QueryByRange(const DatasetPtr&, const Config&) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) override;
@@ -82,6 +88,9 @@ class IDMAP : public VecIndex, public FaissBaseIndex {
     virtual void
     QueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&);
 
+    virtual DatasetPtr
+    QueryByRangeImpl(int64_t, const float*, const Config&);
+
  protected:
     std::mutex mutex_;
 };
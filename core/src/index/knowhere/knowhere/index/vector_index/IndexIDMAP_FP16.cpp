@@ -0,0 +1,208 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "knowhere/index/vector_index/IndexIDMAP_FP16.h"
+
+#include <faiss/FaissHook.h>
+#include <faiss/IndexScalarQuantizer.h>
+#include <faiss/MetaIndexes.h>
+#include <faiss/index_factory.h>
+#include <faiss/utils/Heap.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus {
+namespace knowhere {
+
+namespace {
+
+faiss::IndexScalarQuantizer*
+GetCodesIndex(faiss::Index* index) {
+    auto id_map = dynamic_cast<faiss::IndexIDMap*>(index);
+    if (id_map == nullptr) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return dynamic_cast<faiss::IndexScalarQuantizer*>(id_map->index);
+}
+
+template <class C>
+void
+ScanCodes(faiss::SQDistanceComputer* dc, size_t ntotal, const faiss::ConcurrentBitsetPtr& bitset, int64_t k,
+          float* distances, int64_t* labels) {
+    faiss::heap_heapify<C>(k, distances, labels);
+    for (size_t j = 0; j < ntotal; ++j) {
+        if (bitset != nullptr && bitset->test(j)) {
+            continue;
+        }
+        float dis = (*dc)(j);
+        if (C::cmp(distances[0], dis)) {
+            faiss::heap_swap_top<C>(k, distances, labels, dis, j);
+        }
+    }
+    faiss::heap_reorder<C>(k, distances, labels);
+}
+
+}  // namespace
+
+void
+IDMAP_FP16::Train(const DatasetPtr& dataset_ptr, const Config& config) {
+    // users will assign the metric type when querying
+    // so we let L2 be the default type
+    constexpr faiss::MetricType metric_type = faiss::METRIC_L2;
+
+    const char* desc = "IDMap,SQfp16";
+    auto dim = config[meta::DIM].get<int64_t>();
+    auto index = faiss::index_factory(dim, desc, metric_type);
+    index_.reset(index);
+}
+
+void
+IDMAP_FP16::Add(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    GET_TENSOR_DATA_ID(dataset_ptr)
+    AddCodes(rows, p_data, p_ids);
+}
+
+void
+IDMAP_FP16::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    GET_TENSOR_DATA(dataset_ptr)
+
+    std::vector<int64_t> new_ids(rows);
+    for (int64_t i = 0; i < rows; ++i) {
+        new_ids[i] = index_->ntotal + i;
+    }
+    AddCodes(rows, p_data, new_ids.data());
+}
+
+void
+IDMAP_FP16::AddCodes(int64_t rows, const void* data, const int64_t* ids) {
+    // fp16 vectors are already in the SQfp16 code layout, append them without encoding
+    auto id_map = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto sq_index = GetCodesIndex(index_.get());
+    auto bytes = static_cast<const uint8_t*>(data);
+    sq_index->codes.insert(sq_index->codes.end(), bytes, bytes + rows * sq_index->code_size);
+    sq_index->ntotal += rows;
+    id_map->id_map.insert(id_map->id_map.end(), ids, ids + rows);
+    id_map->ntotal = sq_index->ntotal;
+}
+
+const float*
+IDMAP_FP16::GetRawVectors() {
+    KNOWHERE_THROW_MSG("IDMAP_FP16 stores half precision vectors, use DecodeRawVectors");
+}
+
+void
+IDMAP_FP16::DecodeRawVectors(std::vector<float>& vectors) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    auto sq_index = GetCodesIndex(index_.get());
+    vectors.resize(sq_index->ntotal * sq_index->d);
+    faiss::fp16_to_fvec(reinterpret_cast<const uint16_t*>(sq_index->codes.data()), vectors.data(), vectors.size());
+}
+
+void
+IDMAP_FP16::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                      const Config& config) {
+    auto id_map = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto sq_index = GetCodesIndex(index_.get());
+    auto metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+    if (metric_type != faiss::METRIC_L2 && metric_type != faiss::METRIC_INNER_PRODUCT) {
+        KNOWHERE_THROW_MSG("IDMAP_FP16 only supports L2 and IP metric");
+    }
+
+    // the bitset marks offsets, unlike IndexScalarQuantizer::search the scan here honors it
+    auto bitset = bitset_;
+    size_t ntotal = sq_index->ntotal;
+    size_t dim = sq_index->d;
+#pragma omp parallel
+    {
+        std::unique_ptr<faiss::SQDistanceComputer> dc(sq_index->sq.get_distance_computer(metric_type));
+        dc->codes = sq_index->codes.data();
+        dc->code_size = sq_index->code_size;
+
+#pragma omp for
+        for (int64_t i = 0; i < n; ++i) {
+            dc->set_query(data + i * dim);
+            if (metric_type == faiss::METRIC_L2) {
+                ScanCodes<faiss::CMax<float, int64_t>>(dc.get(), ntotal, bitset, k, distances + i * k,
+                                                       labels + i * k);
+            } else {
+                ScanCodes<faiss::CMin<float, int64_t>>(dc.get(), ntotal, bitset, k, distances + i * k,
+                                                       labels + i * k);
+            }
+        }
+    }
+
+    for (int64_t i = 0; i < n * k; ++i) {
+        if (labels[i] >= 0) {
+            labels[i] = id_map->id_map[labels[i]];
+        }
+    }
+}
+
+DatasetPtr
+IDMAP_FP16::QueryByRangeImpl(int64_t n, const float* data, const Config& config) {
+    auto id_map = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto sq_index = GetCodesIndex(index_.get());
+    auto metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+    if (metric_type != faiss::METRIC_L2 && metric_type != faiss::METRIC_INNER_PRODUCT) {
+        KNOWHERE_THROW_MSG("IDMAP_FP16 only supports L2 and IP metric");
+    }
+
+    auto bitset = bitset_;
+    auto radius = config[meta::RADIUS].get<float>();
+    size_t ntotal = sq_index->ntotal;
+    size_t dim = sq_index->d;
+    std::vector<RangeResult> results(n);
+    bool is_ip = (metric_type == faiss::METRIC_INNER_PRODUCT);
+#pragma omp parallel
+    {
+        std::unique_ptr<faiss::SQDistanceComputer> dc(sq_index->sq.get_distance_computer(metric_type));
+        dc->codes = sq_index->codes.data();
+        dc->code_size = sq_index->code_size;
+
+#pragma omp for
+        for (int64_t i = 0; i < n; ++i) {
+            dc->set_query(data + i * dim);
+            for (size_t j = 0; j < ntotal; ++j) {
+                if (bitset != nullptr && bitset->test(j)) {
+                    continue;
+                }
+                float dis = (*dc)(j);
+                if (is_ip ? dis > radius : dis < radius) {
+                    results[i].emplace_back(dis, id_map->id_map[j]);
+                }
+            }
+        }
+    }
+
+    return GenRangeResultDataset(results, config[meta::TOPK].get<int64_t>(), is_ip);
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,66 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "knowhere/index/vector_index/IndexIDMAP.h"
+
+namespace milvus {
+namespace knowhere {
+
+/*
+ * Brute force index over half precision vectors. The tensor passed to Add/AddWithoutIds holds IEEE fp16 values
+ * (2 bytes per dimension), which are kept as they are as faiss SQfp16 codes, queries are float vectors.
+ */
+class IDMAP_FP16 : public IDMAP {
+ public:
+    IDMAP_FP16() = default;
+
+    void
+    Train(const DatasetPtr&, const Config&) override;
+
+    void
+    Add(const DatasetPtr&, const Config&) override;
+
+    void
+    AddWithoutIds(const DatasetPtr&, const Config&) override;
+
+    int64_t
+    IndexSize() override {
+        return Count() * Dim() * sizeof(uint16_t);
+    }
+
+    const float*
+    GetRawVectors() override;
+
+    // decode the stored vectors to float, in offset order
+    void
+    DecodeRawVectors(std::vector<float>& vectors);
+
+ protected:
+    void
+    QueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&) override;
+
+    DatasetPtr
+    QueryByRangeImpl(int64_t, const float*, const Config&) override;
+
+ private:
+    void
+    AddCodes(int64_t rows, const void* data, const int64_t* ids);
+};
+
+using IDMAP_FP16Ptr = std::shared_ptr<IDMAP_FP16>;
+
+}  // namespace knowhere
+}  // namespace milvus
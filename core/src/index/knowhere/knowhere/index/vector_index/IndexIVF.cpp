@@ -16,6 +16,7 @@
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/clone_index.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
 #ifdef MILVUS_GPU_VERSION
@@ -98,6 +99,27 @@ IVF::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
 
 DatasetPtr
 IVF::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    auto elems = dataset_ptr->Get<int64_t>(meta::ROWS) * config[meta::TOPK].get<int64_t>();
+    auto p_id = static_cast<int64_t*>(malloc(sizeof(int64_t) * elems));
+    auto p_dist = static_cast<float*>(malloc(sizeof(float) * elems));
+
+    try {
+        QueryInto(dataset_ptr, config, p_id, p_dist, nullptr);
+    } catch (...) {
+        free(p_id);
+        free(p_dist);
+        throw;
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+IVF::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances,
+               const std::vector<IDType>* uids) {
     if (!index_ || !index_->is_trained) {
         KNOWHERE_THROW_MSG("index not initialize or trained");
     }
@@ -108,32 +130,33 @@ IVF::Query(const DatasetPtr& dataset_ptr, const Config& config) {
         fiu_do_on("IVF.Search.throw_std_exception", throw std::exception());
         fiu_do_on("IVF.Search.throw_faiss_exception", throw faiss::FaissException(""));
         auto k = config[meta::TOPK].get<int64_t>();
-        auto elems = rows * k;
-
-        size_t p_id_size = sizeof(int64_t) * elems;
-        size_t p_dist_size = sizeof(float) * elems;
-        auto p_id = static_cast<int64_t*>(malloc(p_id_size));
-        auto p_dist = static_cast<float*>(malloc(p_dist_size));
+        QueryImpl(rows, reinterpret_cast<const float*>(p_data), k, distances, ids, config);
+        MapOffsetsToUids(ids, rows * k, uids);
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
 
-        QueryImpl(rows, reinterpret_cast<const float*>(p_data), k, p_dist, p_id, config);
+DatasetPtr
+IVF::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
 
-        //    std::stringstream ss_res_id, ss_res_dist;
-        //    for (int i = 0; i < 10; ++i) {
-        //        printf("%llu", p_id[i]);
-        //        printf("\n");
-        //        printf("%.6f", p_dist[i]);
-        //        printf("\n");
-        //        ss_res_id << p_id[i] << " ";
-        //        ss_res_dist << p_dist[i] << " ";
-        //    }
-        //    std::cout << std::endl << "after search: " << std::endl;
-        //    std::cout << ss_res_id.str() << std::endl;
-        //    std::cout << ss_res_dist.str() << std::endl << std::endl;
+    GET_TENSOR_DATA(dataset_ptr)
 
-        auto ret_ds = std::make_shared<Dataset>();
-        ret_ds->Set(meta::IDS, p_id);
-        ret_ds->Set(meta::DISTANCE, p_dist);
-        return ret_ds;
+    try {
+        auto params = GenParams(config);
+        auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+        ivf_index->nprobe = std::min(params->nprobe, ivf_index->invlists->nlist);
+
+        faiss::RangeSearchResult res(rows);
+        ivf_index->range_search(rows, reinterpret_cast<const float*>(p_data), config[meta::RADIUS].get<float>(),
+                                &res, bitset_);
+        return GenRangeResultDataset(res, config[meta::TOPK].get<int64_t>(),
+                                     ivf_index->metric_type == faiss::METRIC_INNER_PRODUCT);
     } catch (faiss::FaissException& e) {
         KNOWHERE_THROW_MSG(e.what());
     } catch (std::exception& e) {
@@ -53,6 +53,12 @@ class IVF : public VecIndex, public FaissBaseIndex {
     DatasetPtr
     Query(const DatasetPtr&, const Config&) override;
 
+    void
+    QueryInto(const DatasetPtr&, const Config&, int64_t*, float*, const std::vector<IDType>*) override;
+
+    DatasetPtr
+    QueryByRange(const DatasetPtr&, const Config&) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) override;
@@ -13,6 +13,7 @@
 #include <SPTAG/AnnService/inc/Core/VectorSet.h>
 #include <SPTAG/AnnService/inc/Server/QueryParser.h>
 
+#include <omp.h>
 #include <array>
 #include <sstream>
 #include <vector>
@@ -123,7 +124,11 @@ CPUSPTAGRNG::Train(const DatasetPtr& origin, const Config& train_config) {
 
     auto vectorset = ConvertToVectorSet(dataset);
     auto metaset = ConvertToMetadataSet(dataset);
+
+    // SPTAG sets the omp threads of the calling thread to NumberOfThreads, restore them after the build
+    int omp_threads = omp_get_max_threads();
     index_ptr_->BuildIndex(vectorset, metaset);
+    omp_set_num_threads(omp_threads);
 }
 
 void
@@ -133,6 +138,7 @@ CPUSPTAGRNG::SetParameters(const Config& config) {
 
     if (index_type_ == IndexEnum::INDEX_SPTAG_KDT_RNT) {
         auto build_cfg = SPTAGParameterMgr::GetInstance().GetKDTParameters();
+        build_cfg["numofthreads"] = SPTAGParameterMgr::GetInstance().GetBuildThreads(config);
 
         Assign("kdtnumber", "KDTNumber");
         Assign("numtopdimensionkdtsplit", "NumTopDimensionKDTSplit");
@@ -153,6 +159,7 @@ CPUSPTAGRNG::SetParameters(const Config& config) {
         Assign("numberofotherdynamicpivots", "NumberOfOtherDynamicPivots");
     } else {
         auto build_cfg = SPTAGParameterMgr::GetInstance().GetBKTParameters();
+        build_cfg["numofthreads"] = SPTAGParameterMgr::GetInstance().GetBuildThreads(config);
 
         Assign("bktnumber", "BKTNumber");
         Assign("bktkmeansk", "BKTKMeansK");
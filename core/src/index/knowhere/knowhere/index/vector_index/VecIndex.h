@@ -12,6 +12,8 @@
 #pragma once
 
 #include <faiss/utils/ConcurrentBitset.h>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -21,6 +23,7 @@
 #include "knowhere/common/Typedef.h"
 #include "knowhere/index/Index.h"
 #include "knowhere/index/IndexType.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 namespace milvus {
 namespace knowhere {
@@ -48,6 +51,28 @@ class VecIndex : public Index {
     virtual DatasetPtr
     Query(const DatasetPtr& dataset, const Config& config) = 0;
 
+    /*
+     * Search into caller supplied buffers of rows * topk elements. If uids is given, result offsets are
+     * mapped to uids in place. Indexes on the search hot path override this to write results directly,
+     * this default copies the result of Query.
+     */
+    virtual void
+    QueryInto(const DatasetPtr& dataset, const Config& config, int64_t* ids, float* distances,
+              const std::vector<IDType>* uids) {
+        auto rows = dataset->Get<int64_t>(meta::ROWS);
+        auto elems = rows * config[meta::TOPK].get<int64_t>();
+
+        auto result = Query(dataset, config);
+        auto res_ids = result->Get<int64_t*>(meta::IDS);
+        auto res_dist = result->Get<float*>(meta::DISTANCE);
+        memcpy(ids, res_ids, sizeof(int64_t) * elems);
+        memcpy(distances, res_dist, sizeof(float) * elems);
+        free(res_ids);
+        free(res_dist);
+
+        MapOffsetsToUids(ids, elems, uids);
+    }
+
 #if 0
     virtual DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) {
@@ -55,9 +80,16 @@ class VecIndex : public Index {
     }
 #endif
 
-    // virtual DatasetPtr
-    // QueryByRange(const DatasetPtr&, const Config&) = 0;
-    //
+    /*
+     * Search all vectors within meta::RADIUS of each query, at most meta::TOPK of them per query, ordered by
+     * distance. Results are offsets as in Query, returned in IDS and DISTANCE with LIMS holding rows + 1 offsets,
+     * the results of query i are [lims[i], lims[i + 1]).
+     */
+    virtual DatasetPtr
+    QueryByRange(const DatasetPtr& dataset, const Config& config) {
+        KNOWHERE_THROW_MSG("Range search is not supported by index type " + index_type_);
+    }
+
     // virtual MetricType
     // metric_type() = 0;
 
@@ -141,6 +173,19 @@ class VecIndex : public Index {
         return BlacklistSize() + UidsSize() + IndexSize();
     }
 
+ protected:
+    static void
+    MapOffsetsToUids(int64_t* ids, int64_t elems, const std::vector<IDType>* uids) {
+        if (uids == nullptr) {
+            return;
+        }
+        for (int64_t i = 0; i < elems; ++i) {
+            if (ids[i] != -1) {
+                ids[i] = (*uids)[ids[i]];
+            }
+        }
+    }
+
  protected:
     IndexType index_type_ = "";
     IndexMode index_mode_ = IndexMode::MODE_CPU;
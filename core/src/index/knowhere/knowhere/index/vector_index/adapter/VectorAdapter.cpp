@@ -9,7 +9,12 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <faiss/impl/AuxIndexStructures.h>
+
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include "knowhere/common/Dataset.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -37,5 +42,56 @@ GenDataset(const int64_t nb, const int64_t dim, const void* xb) {
     return ret_ds;
 }
 
+DatasetPtr
+GenRangeResultDataset(std::vector<RangeResult>& results, int64_t max_results, bool descending) {
+    int64_t rows = results.size();
+    auto p_lims = static_cast<int64_t*>(malloc(sizeof(int64_t) * (rows + 1)));
+    p_lims[0] = 0;
+    for (int64_t i = 0; i < rows; ++i) {
+        auto& result = results[i];
+        auto keep = std::min<int64_t>(result.size(), max_results);
+        auto compare = [descending](const std::pair<float, int64_t>& a, const std::pair<float, int64_t>& b) {
+            if (a.first != b.first) {
+                return descending ? a.first > b.first : a.first < b.first;
+            }
+            return a.second < b.second;
+        };
+        std::partial_sort(result.begin(), result.begin() + keep, result.end(), compare);
+        result.resize(keep);
+        p_lims[i + 1] = p_lims[i] + keep;
+    }
+
+    // malloc(0) may return nullptr, always allocate at least one element
+    auto total = p_lims[rows];
+    auto p_id = static_cast<int64_t*>(malloc(sizeof(int64_t) * std::max<int64_t>(total, 1)));
+    auto p_dist = static_cast<float*>(malloc(sizeof(float) * std::max<int64_t>(total, 1)));
+    for (int64_t i = 0; i < rows; ++i) {
+        int64_t pos = p_lims[i];
+        for (auto& pair : results[i]) {
+            p_dist[pos] = pair.first;
+            p_id[pos] = pair.second;
+            ++pos;
+        }
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::ROWS, rows);
+    ret_ds->Set(meta::LIMS, p_lims);
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+DatasetPtr
+GenRangeResultDataset(const faiss::RangeSearchResult& res, int64_t max_results, bool descending) {
+    std::vector<RangeResult> results(res.nq);
+    for (size_t i = 0; i < res.nq; ++i) {
+        for (size_t j = res.lims[i]; j < res.lims[i + 1]; ++j) {
+            results[i].emplace_back(res.distances[j], res.labels[j]);
+        }
+    }
+    return GenRangeResultDataset(results, max_results, descending);
+}
+
 }  // namespace knowhere
 }  // namespace milvus
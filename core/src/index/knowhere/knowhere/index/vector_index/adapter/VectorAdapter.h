@@ -12,9 +12,16 @@
 #pragma once
 
 #include <string>
+#include <utility>
+#include <vector>
+
 #include "knowhere/common/Dataset.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
+namespace faiss {
+struct RangeSearchResult;
+}
+
 namespace milvus {
 namespace knowhere {
 
@@ -41,5 +48,16 @@ GenDatasetWithIds(const int64_t nb, const int64_t dim, const void* xb, const int
 extern DatasetPtr
 GenDataset(const int64_t nb, const int64_t dim, const void* xb);
 
+// (distance, id) pairs found by a range search for one query
+using RangeResult = std::vector<std::pair<float, int64_t>>;
+
+// Order the results of each query by distance, descending for similarity metrics, keep at most max_results of
+// them and pack them into LIMS, IDS and DISTANCE of the returned dataset.
+extern DatasetPtr
+GenRangeResultDataset(std::vector<RangeResult>& results, int64_t max_results, bool descending);
+
+extern DatasetPtr
+GenRangeResultDataset(const faiss::RangeSearchResult& res, int64_t max_results, bool descending);
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -0,0 +1,79 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace knowhere {
+
+// Pool of search scratch buffers, a search thread takes one for the whole query batch and gives it back at the end.
+// The pool grows to the number of concurrent search threads, after that buffers are only recycled.
+template <typename T>
+class BufferPool {
+ public:
+    class Handle {
+     public:
+        Handle(BufferPool* pool, std::unique_ptr<T> buffer) : pool_(pool), buffer_(std::move(buffer)) {
+        }
+
+        Handle(const Handle&) = delete;
+        Handle&
+        operator=(const Handle&) = delete;
+
+        ~Handle() {
+            pool_->Release(std::move(buffer_));
+        }
+
+        T&
+        operator*() {
+            return *buffer_;
+        }
+
+        T*
+        operator->() {
+            return buffer_.get();
+        }
+
+     private:
+        BufferPool* pool_;
+        std::unique_ptr<T> buffer_;
+    };
+
+    Handle
+    Acquire() {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (buffers_.empty()) {
+            return Handle(this, std::make_unique<T>());
+        }
+        auto buffer = std::move(buffers_.back());
+        buffers_.pop_back();
+        return Handle(this, std::move(buffer));
+    }
+
+ private:
+    void
+    Release(std::unique_ptr<T> buffer) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        buffers_.push_back(std::move(buffer));
+    }
+
+ private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> buffers_;
+};
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -13,6 +13,7 @@
 #include "knowhere/index/vector_index/helpers/Cloner.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIDMAP_FP16.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
@@ -60,6 +61,8 @@ CopyCpuToGpu(const VecIndexPtr& index, const int64_t device_id, const Config& co
         result = cpu_index->CopyCpuToGpu(device_id, config);
     } else if (auto cpu_index = std::dynamic_pointer_cast<IVF>(index)) {
         result = cpu_index->CopyCpuToGpu(device_id, config);
+    } else if (std::dynamic_pointer_cast<IDMAP_FP16>(index)) {
+        // no gpu counterpart of the fp16 flat index, it stays on cpu
     } else if (auto cpu_index = std::dynamic_pointer_cast<IDMAP>(index)) {
         result = cpu_index->CopyCpuToGpu(device_id, config);
     } else {
@@ -24,6 +24,8 @@ constexpr const char* ROWS = "rows";
 constexpr const char* IDS = "ids";
 constexpr const char* DISTANCE = "distance";
 constexpr const char* TOPK = "k";
+constexpr const char* RADIUS = "radius";
+constexpr const char* LIMS = "lims";
 constexpr const char* DEVICEID = "gpu_id";
 };  // namespace meta
 
@@ -49,6 +51,9 @@ constexpr const char* ef = "ef";
 constexpr const char* n_trees = "n_trees";
 constexpr const char* search_k = "search_k";
 
+// Annoy and SPTAG build Params, the omp threads of the caller by default
+constexpr const char* build_threads = "build_threads";
+
 // PQ Params
 constexpr const char* PQM = "PQM";
 
@@ -60,6 +65,9 @@ constexpr const char* selectively_pruned_edge_size = "selectively_pruned_edge_si
 // NGT_ONNG Params
 constexpr const char* outgoing_edge_size = "outgoing_edge_size";
 constexpr const char* incoming_edge_size = "incoming_edge_size";
+
+// Rerank Params
+constexpr const char* refine_k = "refine_k";
 }  // namespace IndexParams
 
 namespace Metric {
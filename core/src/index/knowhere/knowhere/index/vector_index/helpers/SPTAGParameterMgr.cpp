@@ -9,6 +9,7 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <omp.h>
 #include <mutex>
 
 #include "knowhere/index/vector_index/helpers/SPTAGParameterMgr.h"
@@ -26,6 +27,14 @@ SPTAGParameterMgr::GetBKTParameters() {
     return bkt_config_;
 }
 
+int64_t
+SPTAGParameterMgr::GetBuildThreads(const Config& config) {
+    if (config.contains(IndexParams::build_threads)) {
+        return config[IndexParams::build_threads].get<int64_t>();
+    }
+    return omp_get_max_threads();
+}
+
 SPTAGParameterMgr::SPTAGParameterMgr() {
     kdt_config_["kdtnumber"] = 1;
     kdt_config_["numtopdimensionkdtsplit"] = 5;
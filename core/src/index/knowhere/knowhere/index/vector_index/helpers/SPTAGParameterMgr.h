@@ -31,6 +31,10 @@ class SPTAGParameterMgr {
     const Config&
     GetBKTParameters();
 
+    /* IndexParams::build_threads of the config, or the omp threads of the calling thread */
+    int64_t
+    GetBuildThreads(const Config& config);
+
  public:
     static SPTAGParameterMgr&
     GetInstance() {
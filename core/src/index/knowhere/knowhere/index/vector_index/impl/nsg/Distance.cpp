@@ -242,6 +242,133 @@ DistanceIP::Compare(const float* a, const float* b, unsigned size) const {
 
 #endif
 
+namespace {
+
+__attribute__((target("avx2"))) inline float
+ReduceAVX2(__m256 sum) {
+    __m128 v = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    v = _mm_hadd_ps(v, v);
+    v = _mm_hadd_ps(v, v);
+    return _mm_cvtss_f32(v);
+}
+
+// Kernels for fixed dimensions, every specialized dimension is a multiple of 32 so there is no tail to handle.
+struct L2Kernel {
+    template <size_t DIM>
+    __attribute__((target("avx2,fma"))) static float
+    AVX2(const float* a, const float* b, size_t) {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        for (size_t i = 0; i < DIM; i += 16) {
+            __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+            __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+            sum0 = _mm256_fmadd_ps(d0, d0, sum0);
+            sum1 = _mm256_fmadd_ps(d1, d1, sum1);
+        }
+        return ReduceAVX2(_mm256_add_ps(sum0, sum1));
+    }
+
+    template <size_t DIM>
+    __attribute__((target("avx512f"))) static float
+    AVX512(const float* a, const float* b, size_t) {
+        __m512 sum0 = _mm512_setzero_ps();
+        __m512 sum1 = _mm512_setzero_ps();
+        for (size_t i = 0; i < DIM; i += 32) {
+            __m512 d0 = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+            __m512 d1 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16));
+            sum0 = _mm512_fmadd_ps(d0, d0, sum0);
+            sum1 = _mm512_fmadd_ps(d1, d1, sum1);
+        }
+        return _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1));
+    }
+
+    // read the hook on every call, it is replaced by faiss::hook_init at startup
+    static float
+    Hook(const float* a, const float* b, size_t size) {
+        return faiss::fvec_L2sqr(a, b, size);
+    }
+};
+
+struct IPKernel {
+    template <size_t DIM>
+    __attribute__((target("avx2,fma"))) static float
+    AVX2(const float* a, const float* b, size_t) {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        for (size_t i = 0; i < DIM; i += 16) {
+            sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+            sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), sum1);
+        }
+        return ReduceAVX2(_mm256_add_ps(sum0, sum1));
+    }
+
+    template <size_t DIM>
+    __attribute__((target("avx512f"))) static float
+    AVX512(const float* a, const float* b, size_t) {
+        __m512 sum0 = _mm512_setzero_ps();
+        __m512 sum1 = _mm512_setzero_ps();
+        for (size_t i = 0; i < DIM; i += 32) {
+            sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), sum0);
+            sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), sum1);
+        }
+        return _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1));
+    }
+
+    static float
+    Hook(const float* a, const float* b, size_t size) {
+        return faiss::fvec_inner_product(a, b, size);
+    }
+};
+
+template <typename Kernel>
+DistanceFunc
+SelectKernel(size_t dim) {
+    if (faiss::support_avx512()) {
+        switch (dim) {
+            case 128:
+                return Kernel::template AVX512<128>;
+            case 256:
+                return Kernel::template AVX512<256>;
+            case 512:
+                return Kernel::template AVX512<512>;
+            case 768:
+                return Kernel::template AVX512<768>;
+            case 960:
+                return Kernel::template AVX512<960>;
+            default:
+                break;
+        }
+    } else if (faiss::support_avx2()) {
+        switch (dim) {
+            case 128:
+                return Kernel::template AVX2<128>;
+            case 256:
+                return Kernel::template AVX2<256>;
+            case 512:
+                return Kernel::template AVX2<512>;
+            case 768:
+                return Kernel::template AVX2<768>;
+            case 960:
+                return Kernel::template AVX2<960>;
+            default:
+                break;
+        }
+    }
+    return Kernel::Hook;
+}
+
+}  // namespace
+
+DistanceFunc
+GetL2DistanceFunc(size_t dim) {
+    return SelectKernel<L2Kernel>(dim);
+}
+
+DistanceFunc
+GetIPDistanceFunc(size_t dim) {
+    return SelectKernel<IPKernel>(dim);
+}
+
 }  // namespace impl
 }  // namespace knowhere
 }  // namespace milvus
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace milvus {
 namespace knowhere {
 namespace impl {
@@ -31,6 +33,42 @@ struct DistanceIP : public Distance {
     Compare(const float* a, const float* b, unsigned size) const override;
 };
 
+using DistanceFunc = float (*)(const float* a, const float* b, size_t size);
+
+// Pick the kernel once per index instead of once per edge: dimension-specialized AVX2/AVX512 kernels for the
+// common dimensions (128/256/512/768/960), the faiss hooks otherwise.
+DistanceFunc
+GetL2DistanceFunc(size_t dim);
+
+DistanceFunc
+GetIPDistanceFunc(size_t dim);
+
+// Non-virtual distance functors, the search and build loops of NsgIndex are templated on them.
+struct L2DistanceFunctor {
+    explicit L2DistanceFunctor(size_t dim) : func_(GetL2DistanceFunc(dim)) {
+    }
+
+    inline float
+    operator()(const float* a, const float* b, size_t size) const {
+        return func_(a, b, size);
+    }
+
+    DistanceFunc func_;
+};
+
+// negative inner product, so that smaller is closer for both metrics
+struct IPDistanceFunctor {
+    explicit IPDistanceFunctor(size_t dim) : func_(GetIPDistanceFunc(dim)) {
+    }
+
+    inline float
+    operator()(const float* a, const float* b, size_t size) const {
+        return -func_(a, b, size);
+    }
+
+    DistanceFunc func_;
+};
+
 }  // namespace impl
 }  // namespace knowhere
 }  // namespace milvus
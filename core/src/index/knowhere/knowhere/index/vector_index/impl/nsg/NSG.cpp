@@ -31,19 +31,61 @@ namespace impl {
 
 unsigned int seed = 100;
 
+namespace {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr size_t PREFETCH_SIZE = 256;
+
+// fetch the head of the next neighbor's vector while the distance of the current one is computed
+inline void
+PrefetchVector(const float* vector, size_t dimension) {
+    auto addr = reinterpret_cast<const char*>(vector);
+    size_t size = std::min(dimension * sizeof(float), PREFETCH_SIZE);
+    for (size_t offset = 0; offset < size; offset += CACHE_LINE_SIZE) {
+        __builtin_prefetch(addr + offset, 0, 3);
+    }
+}
+
+inline bool
+IsVisited(const hnswlib::VisitedList* visited, node_t id) {
+    return visited->mass[id] == visited->curV;
+}
+
+inline void
+SetVisited(hnswlib::VisitedList* visited, node_t id) {
+    visited->mass[id] = visited->curV;
+}
+
+// borrow a visited list from the pool, give it back even if the search throws
+class VisitedListHolder {
+ public:
+    explicit VisitedListHolder(hnswlib::VisitedListPool* pool) : pool_(pool), list_(pool->getFreeVisitedList()) {
+    }
+
+    ~VisitedListHolder() {
+        pool_->releaseVisitedList(list_);
+    }
+
+    hnswlib::VisitedList*
+    get() const {
+        return list_;
+    }
+
+ private:
+    hnswlib::VisitedListPool* pool_;
+    hnswlib::VisitedList* list_;
+};
+
+}  // namespace
+
 NsgIndex::NsgIndex(const size_t& dimension, const size_t& n, Metric_Type metric)
     : dimension(dimension), ntotal(n), metric_type(metric) {
-    if (metric == Metric_Type::Metric_Type_L2) {
-        distance_ = new DistanceL2;
-    } else if (metric == Metric_Type::Metric_Type_IP) {
-        distance_ = new DistanceIP;
-    }
+    visited_list_pool_ = std::make_shared<hnswlib::VisitedListPool>(1, ntotal);
 }
 
 NsgIndex::~NsgIndex() {
     // delete[] ori_data_;
     delete[] ids_;
-    delete distance_;
 }
 
 void
@@ -58,16 +100,12 @@ NsgIndex::Build_with_ids(size_t nb, float* data, const int64_t* ids, const Build
     out_degree = parameters.out_degree;
     candidate_pool_size = parameters.candidate_pool_size;
 
-    TimeRecorder rc("NSG", 1);
-    InitNavigationPoint(data);
-    rc.RecordSection("init");
-
-    Link(data);
-    rc.RecordSection("Link");
-
-    CheckConnectivity(data);
-    rc.RecordSection("Connect");
-    rc.ElapseFromBegin("finish");
+    visited_list_pool_ = std::make_shared<hnswlib::VisitedListPool>(1, ntotal);
+    if (metric_type == Metric_Type::Metric_Type_IP) {
+        BuildGraph(data, IPDistanceFunctor(dimension));
+    } else {
+        BuildGraph(data, L2DistanceFunctor(dimension));
+    }
 
     is_trained = true;
 
@@ -88,8 +126,24 @@ NsgIndex::Build_with_ids(size_t nb, float* data, const int64_t* ids, const Build
     // }
 }
 
+template <typename DistFunc>
+void
+NsgIndex::BuildGraph(float* data, const DistFunc& distance) {
+    TimeRecorder rc("NSG", 1);
+    InitNavigationPoint(data, distance);
+    rc.RecordSection("init");
+
+    Link(data, distance);
+    rc.RecordSection("Link");
+
+    CheckConnectivity(data, distance);
+    rc.RecordSection("Connect");
+    rc.ElapseFromBegin("finish");
+}
+
+template <typename DistFunc>
 void
-NsgIndex::InitNavigationPoint(float* data) {
+NsgIndex::InitNavigationPoint(float* data, const DistFunc& distance) {
     // calculate the center of vectors
     auto center = new float[dimension];
     memset(center, 0, sizeof(float) * dimension);
@@ -106,8 +160,9 @@ NsgIndex::InitNavigationPoint(float* data) {
     // select navigation point
     std::vector<Neighbor> resset;
     navigation_point = rand_r(&seed) % ntotal;  // random initialize navigating point
-    GetNeighbors(center, data, resset, knng);
+    GetNeighbors(center, data, resset, knng, distance);
     navigation_point = resset[0].id;
+    delete[] center;
 
     // Debug code
     // std::cout << "ep: " << navigation_point << std::endl;
@@ -118,14 +173,15 @@ NsgIndex::InitNavigationPoint(float* data) {
     //
     // std::cout << "ep: " << navigation_point << std::endl;
     //
-    // float r1 = distance_->Compare(center, ori_data_ + navigation_point * dimension, dimension);
+    // float r1 = distance(center, ori_data_ + navigation_point * dimension, dimension);
     // assert(r1 == resset[0].distance);
 }
 
 // Specify Link
+template <typename DistFunc>
 void
 NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, std::vector<Neighbor>& fullset,
-                       boost::dynamic_bitset<>& has_calculated_dist) {
+                       hnswlib::VisitedList* has_calculated_dist, const DistFunc& distance) {
     auto& graph = knng;
     size_t buffer_size = search_length;
 
@@ -148,18 +204,18 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
             // for (size_t i = 0; i < graph[navigation_point].size(); ++i) {
             // init_ids.push_back(graph[navigation_point][i]);
             init_ids[i] = graph[navigation_point][i];
-            has_calculated_dist[init_ids[i]] = true;
+            SetVisited(has_calculated_dist, init_ids[i]);
             ++count;
         }
         while (count < buffer_size) {
             node_t id = rand_r(&seed) % ntotal;
-            if (has_calculated_dist[id]) {
+            if (IsVisited(has_calculated_dist, id)) {
                 continue;  // duplicate id
             }
             // init_ids.push_back(id);
             init_ids[count] = id;
             ++count;
-            has_calculated_dist[id] = true;
+            SetVisited(has_calculated_dist, id);
         }
     }
 
@@ -175,7 +231,7 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
                 continue;
             }
 
-            float dist = distance_->Compare(data + dimension * id, query, dimension);
+            float dist = distance(data + dimension * id, query, dimension);
             resset[i] = Neighbor(id, dist, false);
 
             //// difference from other GetNeighbors
@@ -194,13 +250,17 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
 
                 node_t start_pos = resset[cursor].id;
                 auto& wait_for_search_node_vec = graph[start_pos];
-                for (node_t id : wait_for_search_node_vec) {
-                    if (has_calculated_dist[id]) {
+                for (size_t j = 0; j < wait_for_search_node_vec.size(); ++j) {
+                    node_t id = wait_for_search_node_vec[j];
+                    if (j + 1 < wait_for_search_node_vec.size()) {
+                        PrefetchVector(data + dimension * wait_for_search_node_vec[j + 1], dimension);
+                    }
+                    if (IsVisited(has_calculated_dist, id)) {
                         continue;
                     }
-                    has_calculated_dist[id] = true;
+                    SetVisited(has_calculated_dist, id);
 
-                    float dist = distance_->Compare(query, data + dimension * id, dimension);
+                    float dist = distance(query, data + dimension * id, dimension);
                     Neighbor nn(id, dist, false);
                     fullset.push_back(nn);
 
@@ -229,8 +289,10 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
 }
 
 // FindUnconnectedNode
+template <typename DistFunc>
 void
-NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, std::vector<Neighbor>& fullset) {
+NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, std::vector<Neighbor>& fullset,
+                       const DistFunc& distance) {
     auto& graph = nsg;
     size_t buffer_size = search_length;
 
@@ -241,7 +303,8 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
     // std::vector<node_t> init_ids;
     std::vector<node_t> init_ids(buffer_size);
     resset.resize(buffer_size);
-    boost::dynamic_bitset<> has_calculated_dist{ntotal, 0};
+    VisitedListHolder visited_holder(visited_list_pool_.get());
+    auto has_calculated_dist = visited_holder.get();
 
     {
         /*
@@ -254,18 +317,18 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
             // for (size_t i = 0; i < graph[navigation_point].size(); ++i) {
             // init_ids.push_back(graph[navigation_point][i]);
             init_ids[i] = graph[navigation_point][i];
-            has_calculated_dist[init_ids[i]] = true;
+            SetVisited(has_calculated_dist, init_ids[i]);
             ++count;
         }
         while (count < buffer_size) {
             node_t id = rand_r(&seed) % ntotal;
-            if (has_calculated_dist[id]) {
+            if (IsVisited(has_calculated_dist, id)) {
                 continue;  // duplicate id
             }
             // init_ids.push_back(id);
             init_ids[count] = id;
             ++count;
-            has_calculated_dist[id] = true;
+            SetVisited(has_calculated_dist, id);
         }
     }
 
@@ -281,7 +344,7 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
                 continue;
             }
 
-            float dist = distance_->Compare(data + id * dimension, query, dimension);
+            float dist = distance(data + id * dimension, query, dimension);
             resset[i] = Neighbor(id, dist, false);
         }
         std::sort(resset.begin(), resset.end());  // sort by distance
@@ -296,13 +359,17 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
 
                 node_t start_pos = resset[cursor].id;
                 auto& wait_for_search_node_vec = graph[start_pos];
-                for (node_t id : wait_for_search_node_vec) {
-                    if (has_calculated_dist[id]) {
+                for (size_t j = 0; j < wait_for_search_node_vec.size(); ++j) {
+                    node_t id = wait_for_search_node_vec[j];
+                    if (j + 1 < wait_for_search_node_vec.size()) {
+                        PrefetchVector(data + dimension * wait_for_search_node_vec[j + 1], dimension);
+                    }
+                    if (IsVisited(has_calculated_dist, id)) {
                         continue;
                     }
-                    has_calculated_dist[id] = true;
+                    SetVisited(has_calculated_dist, id);
 
-                    float dist = distance_->Compare(data + dimension * id, query, dimension);
+                    float dist = distance(data + dimension * id, query, dimension);
                     Neighbor nn(id, dist, false);
                     fullset.push_back(nn);
 
@@ -330,9 +397,10 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
     }
 }
 
+template <typename DistFunc>
 void
 NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, Graph& graph,
-                       SearchParams* params) {
+                       const DistFunc& distance, SearchParams* params) {
     size_t buffer_size = params ? params->search_length : search_length;
 
     if (buffer_size > ntotal) {
@@ -341,7 +409,8 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
 
     std::vector<node_t> init_ids(buffer_size);
     resset.resize(buffer_size);
-    boost::dynamic_bitset<> has_calculated_dist{ntotal, 0};
+    VisitedListHolder visited_holder(visited_list_pool_.get());
+    auto has_calculated_dist = visited_holder.get();
 
     {
         /*
@@ -352,17 +421,17 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
         // Get all neighbors
         for (size_t i = 0; i < init_ids.size() && i < graph[navigation_point].size(); ++i) {
             init_ids[i] = graph[navigation_point][i];
-            has_calculated_dist[init_ids[i]] = true;
+            SetVisited(has_calculated_dist, init_ids[i]);
             ++count;
         }
         while (count < buffer_size) {
             node_t id = rand_r(&seed) % ntotal;
-            if (has_calculated_dist[id]) {
+            if (IsVisited(has_calculated_dist, id)) {
                 continue;  // duplicate id
             }
             init_ids[count] = id;
             ++count;
-            has_calculated_dist[id] = true;
+            SetVisited(has_calculated_dist, id);
         }
     }
 
@@ -377,7 +446,7 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
                 KNOWHERE_THROW_MSG("Build Index Error, id > ntotal");
             }
 
-            float dist = distance_->Compare(data + id * dimension, query, dimension);
+            float dist = distance(data + id * dimension, query, dimension);
             resset[i] = Neighbor(id, dist, false);
         }
         std::sort(resset.begin(), resset.end());  // sort by distance
@@ -392,13 +461,17 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
 
                 node_t start_pos = resset[cursor].id;
                 auto& wait_for_search_node_vec = graph[start_pos];
-                for (node_t id : wait_for_search_node_vec) {
-                    if (has_calculated_dist[id]) {
+                for (size_t j = 0; j < wait_for_search_node_vec.size(); ++j) {
+                    node_t id = wait_for_search_node_vec[j];
+                    if (j + 1 < wait_for_search_node_vec.size()) {
+                        PrefetchVector(data + dimension * wait_for_search_node_vec[j + 1], dimension);
+                    }
+                    if (IsVisited(has_calculated_dist, id)) {
                         continue;
                     }
-                    has_calculated_dist[id] = true;
+                    SetVisited(has_calculated_dist, id);
 
-                    float dist = distance_->Compare(query, data + dimension * id, dimension);
+                    float dist = distance(query, data + dimension * id, dimension);
 
                     if (dist >= resset[buffer_size - 1].distance) {
                         continue;
@@ -433,8 +506,9 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
     }
 }
 
+template <typename DistFunc>
 void
-NsgIndex::Link(float* data) {
+NsgIndex::Link(float* data, const DistFunc& distance) {
     auto cut_graph_dist = new float[ntotal * out_degree];
     nsg.resize(ntotal);
 
@@ -442,15 +516,16 @@ NsgIndex::Link(float* data) {
     {
         std::vector<Neighbor> fullset;
         std::vector<Neighbor> temp;
-        boost::dynamic_bitset<> flags{ntotal, 0};
+        VisitedListHolder visited_holder(visited_list_pool_.get());
+        auto flags = visited_holder.get();
 #pragma omp for schedule(dynamic, 100)
         for (size_t n = 0; n < ntotal; ++n) {
             faiss::BuilderSuspend::check_wait();
             fullset.clear();
             temp.clear();
-            flags.reset();
-            GetNeighbors(data + dimension * n, data, temp, fullset, flags);
-            SyncPrune(data, n, fullset, flags, cut_graph_dist);
+            flags->reset();
+            GetNeighbors(data + dimension * n, data, temp, fullset, flags, distance);
+            SyncPrune(data, n, fullset, flags, cut_graph_dist, distance);
         }
 
         // Debug code
@@ -476,21 +551,22 @@ NsgIndex::Link(float* data) {
 #pragma omp for schedule(dynamic, 100)
     for (unsigned n = 0; n < ntotal; ++n) {
         faiss::BuilderSuspend::check_wait();
-        InterInsert(data, n, mutex_vec, cut_graph_dist);
+        InterInsert(data, n, mutex_vec, cut_graph_dist, distance);
     }
     delete[] cut_graph_dist;
 }
 
+template <typename DistFunc>
 void
-NsgIndex::SyncPrune(float* data, size_t n, std::vector<Neighbor>& pool, boost::dynamic_bitset<>& has_calculated,
-                    float* cut_graph_dist) {
+NsgIndex::SyncPrune(float* data, size_t n, std::vector<Neighbor>& pool, hnswlib::VisitedList* has_calculated,
+                    float* cut_graph_dist, const DistFunc& distance) {
     // avoid lose nearest neighbor in knng
     for (size_t i = 0; i < knng[n].size(); ++i) {
         auto id = knng[n][i];
-        if (has_calculated[id]) {
+        if (IsVisited(has_calculated, id)) {
             continue;
         }
-        float dist = distance_->Compare(data + dimension * n, data + dimension * id, dimension);
+        float dist = distance(data + dimension * n, data + dimension * id, dimension);
         pool.emplace_back(Neighbor(id, dist, true));
     }
 
@@ -503,7 +579,7 @@ NsgIndex::SyncPrune(float* data, size_t n, std::vector<Neighbor>& pool, boost::d
     }
     result.push_back(pool[cursor]);  // init result with nearest neighbor
 
-    SelectEdge(data, cursor, pool, result, true);
+    SelectEdge(data, cursor, pool, result, distance, true);
 
     // filling the cut_graph
     auto& des_id_pool = nsg[n];
@@ -519,8 +595,10 @@ NsgIndex::SyncPrune(float* data, size_t n, std::vector<Neighbor>& pool, boost::d
 }
 
 //>> Optimize: remove read-lock
+template <typename DistFunc>
 void
-NsgIndex::InterInsert(float* data, unsigned n, std::vector<std::mutex>& mutex_vec, float* cut_graph_dist) {
+NsgIndex::InterInsert(float* data, unsigned n, std::vector<std::mutex>& mutex_vec, float* cut_graph_dist,
+                      const DistFunc& distance) {
     auto& current = n;
 
     auto& neighbor_id_pool = nsg[current];
@@ -571,7 +649,7 @@ NsgIndex::InterInsert(float* data, unsigned n, std::vector<std::mutex>& mutex_ve
             std::sort(wait_for_link_pool.begin(), wait_for_link_pool.end());
             result.push_back(wait_for_link_pool[start]);
 
-            SelectEdge(data, start, wait_for_link_pool, result);
+            SelectEdge(data, start, wait_for_link_pool, result, distance);
 
             {
                 LockGuard lk(mutex_vec[current_neighbor]);
@@ -596,9 +674,10 @@ NsgIndex::InterInsert(float* data, unsigned n, std::vector<std::mutex>& mutex_ve
     }
 }
 
+template <typename DistFunc>
 void
 NsgIndex::SelectEdge(float* data, unsigned& cursor, std::vector<Neighbor>& sort_pool, std::vector<Neighbor>& result,
-                     bool limit) {
+                     const DistFunc& distance, bool limit) {
     auto& pool = sort_pool;
 
     /*
@@ -612,7 +691,7 @@ NsgIndex::SelectEdge(float* data, unsigned& cursor, std::vector<Neighbor>& sort_
         auto& p = pool[cursor];
         bool should_link = true;
         for (auto& t : result) {
-            float dist = distance_->Compare(data + dimension * t.id, data + dimension * p.id, dimension);
+            float dist = distance(data + dimension * t.id, data + dimension * p.id, dimension);
             if (dist < p.distance) {
                 should_link = false;
                 break;
@@ -624,8 +703,9 @@ NsgIndex::SelectEdge(float* data, unsigned& cursor, std::vector<Neighbor>& sort_
     }
 }
 
+template <typename DistFunc>
 void
-NsgIndex::CheckConnectivity(float* data) {
+NsgIndex::CheckConnectivity(float* data, const DistFunc& distance) {
     auto root = navigation_point;
     boost::dynamic_bitset<> has_linked{ntotal, 0};
     int64_t linked_count = 0;
@@ -636,7 +716,7 @@ NsgIndex::CheckConnectivity(float* data) {
         if (linked_count >= static_cast<int64_t>(ntotal)) {
             break;
         }
-        FindUnconnectedNode(data, has_linked, root);
+        FindUnconnectedNode(data, has_linked, root, distance);
     }
 }
 
@@ -674,8 +754,10 @@ NsgIndex::DFS(size_t root, boost::dynamic_bitset<>& has_linked, int64_t& linked_
     }
 }
 
+template <typename DistFunc>
 void
-NsgIndex::FindUnconnectedNode(float* data, boost::dynamic_bitset<>& has_linked, int64_t& root) {
+NsgIndex::FindUnconnectedNode(float* data, boost::dynamic_bitset<>& has_linked, int64_t& root,
+                              const DistFunc& distance) {
     // find any of unlinked-node
     size_t id = ntotal;
     for (size_t i = 0; i < ntotal; i++) {  // find not link
@@ -691,7 +773,7 @@ NsgIndex::FindUnconnectedNode(float* data, boost::dynamic_bitset<>& has_linked,
 
     // search unlinked-node's neighbor
     std::vector<Neighbor> tmp, pool;
-    GetNeighbors(data + dimension * id, data, tmp, pool);
+    GetNeighbors(data + dimension * id, data, tmp, pool, distance);
     std::sort(pool.begin(), pool.end());
 
     size_t found = 0;
@@ -849,21 +931,32 @@ NsgIndex::FindUnconnectedNode(float* data, boost::dynamic_bitset<>& has_linked,
 //     rc.ElapseFromBegin("seach finish");
 // }
 
+template <typename DistFunc>
 void
-NsgIndex::Search(const float* query, float* data, const unsigned& nq, const unsigned& dim, const unsigned& k,
-                 float* dist, int64_t* ids, SearchParams& params, faiss::ConcurrentBitsetPtr bitset) {
-    std::vector<std::vector<Neighbor>> resset(nq);
-
-    TimeRecorder rc("NsgIndex::search", 1);
+NsgIndex::SearchGraph(const float* query, float* data, const unsigned& nq, const unsigned& dim,
+                      std::vector<std::vector<Neighbor>>& resset, SearchParams& params, const DistFunc& distance) {
     if (nq == 1) {
-        GetNeighbors(query, data, resset[0], nsg, &params);
+        GetNeighbors(query, data, resset[0], nsg, distance, &params);
     } else {
 #pragma omp parallel for
         for (unsigned int i = 0; i < nq; ++i) {
             const float* single_query = query + i * dim;
-            GetNeighbors(single_query, data, resset[i], nsg, &params);
+            GetNeighbors(single_query, data, resset[i], nsg, distance, &params);
         }
     }
+}
+
+void
+NsgIndex::Search(const float* query, float* data, const unsigned& nq, const unsigned& dim, const unsigned& k,
+                 float* dist, int64_t* ids, SearchParams& params, faiss::ConcurrentBitsetPtr bitset) {
+    std::vector<std::vector<Neighbor>> resset(nq);
+
+    TimeRecorder rc("NsgIndex::search", 1);
+    if (metric_type == Metric_Type::Metric_Type_IP) {
+        SearchGraph(query, data, nq, dim, resset, params, IPDistanceFunctor(dimension));
+    } else {
+        SearchGraph(query, data, nq, dim, resset, params, L2DistanceFunctor(dimension));
+    }
     rc.RecordSection("search");
 
     bool is_ip = (metric_type == Metric_Type::Metric_Type_IP);
@@ -899,7 +992,7 @@ NsgIndex::GetSize() {
     ret += sizeof(*this);
     ret += ntotal * dimension * sizeof(float);
     ret += ntotal * sizeof(int64_t);
-    ret += sizeof(*distance_);
+    ret += ntotal * sizeof(hnswlib::vl_type);  // one visited list in the pool
     for (auto& v : nsg) {
         ret += v.size() * sizeof(node_t);
     }
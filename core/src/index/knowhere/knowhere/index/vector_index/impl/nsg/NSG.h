@@ -13,12 +13,14 @@
 
 #include <boost/dynamic_bitset.hpp>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "Distance.h"
 #include "Neighbor.h"
+#include "hnswlib/visited_list_pool.h"
 #include "knowhere/common/Config.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
@@ -51,7 +53,6 @@ class NsgIndex {
     size_t dimension;
     size_t ntotal;        // totabl nb of indexed vectors
     int32_t metric_type;  // enum Metric_Type
-    Distance* distance_;
 
     // float* ori_data_;
     int64_t* ids_;
@@ -103,49 +104,73 @@ class NsgIndex {
     //                   const BuildParam &parameters);
 
  protected:
+    /*
+     * the build and search loops are templated on the distance functor (L2DistanceFunctor or IPDistanceFunctor),
+     * so that the distance of every edge is computed without a virtual call
+     */
+    template <typename DistFunc>
     void
-    InitNavigationPoint(float* data);
+    BuildGraph(float* data, const DistFunc& distance);
+
+    template <typename DistFunc>
+    void
+    SearchGraph(const float* query, float* data, const unsigned& nq, const unsigned& dim,
+                std::vector<std::vector<Neighbor>>& resset, SearchParams& params, const DistFunc& distance);
+
+    template <typename DistFunc>
+    void
+    InitNavigationPoint(float* data, const DistFunc& distance);
 
     // link specify
+    template <typename DistFunc>
     void
     GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, std::vector<Neighbor>& fullset,
-                 boost::dynamic_bitset<>& has_calculated_dist);
+                 hnswlib::VisitedList* has_calculated_dist, const DistFunc& distance);
 
     // FindUnconnectedNode
+    template <typename DistFunc>
     void
-    GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, std::vector<Neighbor>& fullset);
+    GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, std::vector<Neighbor>& fullset,
+                 const DistFunc& distance);
 
     // navigation-point
+    template <typename DistFunc>
     void
     GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, Graph& graph,
-                 SearchParams* param = nullptr);
-
-    // only for search
-    // void
-    // GetNeighbors(const float* query, node_t* I, float* D, SearchParams* params);
+                 const DistFunc& distance, SearchParams* param = nullptr);
 
+    template <typename DistFunc>
     void
-    Link(float* data);
+    Link(float* data, const DistFunc& distance);
 
+    template <typename DistFunc>
     void
-    SyncPrune(float* data, size_t q, std::vector<Neighbor>& pool, boost::dynamic_bitset<>& has_calculated,
-              float* cut_graph_dist);
+    SyncPrune(float* data, size_t q, std::vector<Neighbor>& pool, hnswlib::VisitedList* has_calculated,
+              float* cut_graph_dist, const DistFunc& distance);
 
+    template <typename DistFunc>
     void
     SelectEdge(float* data, unsigned& cursor, std::vector<Neighbor>& sort_pool, std::vector<Neighbor>& result,
-               bool limit = false);
+               const DistFunc& distance, bool limit = false);
 
+    template <typename DistFunc>
     void
-    InterInsert(float* data, unsigned n, std::vector<std::mutex>& mutex_vec, float* dist);
+    InterInsert(float* data, unsigned n, std::vector<std::mutex>& mutex_vec, float* dist, const DistFunc& distance);
 
+    template <typename DistFunc>
     void
-    CheckConnectivity(float* data);
+    CheckConnectivity(float* data, const DistFunc& distance);
 
     void
     DFS(size_t root, boost::dynamic_bitset<>& flags, int64_t& count);
 
+    template <typename DistFunc>
     void
-    FindUnconnectedNode(float* data, boost::dynamic_bitset<>& flags, int64_t& root);
+    FindUnconnectedNode(float* data, boost::dynamic_bitset<>& flags, int64_t& root, const DistFunc& distance);
+
+ private:
+    // visited sets of ntotal marks, reused across queries instead of allocating a bitset per query
+    std::shared_ptr<hnswlib::VisitedListPool> visited_list_pool_ = nullptr;
 };
 
 }  // namespace impl
@@ -0,0 +1,180 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "knowhere/index/vector_offset_index/IVFListFile.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include "knowhere/common/Exception.h"
+
+namespace milvus {
+namespace knowhere {
+
+IVFListCache&
+IVFListCache::GetInstance() {
+    static IVFListCache s_cache;
+    return s_cache;
+}
+
+void
+IVFListCache::SetCapacity(int64_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    EvictNoLock(capacity_);
+}
+
+int64_t
+IVFListCache::Capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+int64_t
+IVFListCache::Usage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+}
+
+ListBlock
+IVFListCache::Get(int64_t file_id, size_t list_no) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = cache_.find(Key(file_id, list_no));
+    if (iter == cache_.end()) {
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, iter->second);
+    return iter->second->second;
+}
+
+void
+IVFListCache::Insert(int64_t file_id, size_t list_no, const ListBlock& block) {
+    auto block_size = static_cast<int64_t>(block->size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    Key key(file_id, list_no);
+    if (block_size > capacity_ || cache_.find(key) != cache_.end()) {
+        return;
+    }
+
+    EvictNoLock(capacity_ - block_size);
+    lru_.emplace_front(key, block);
+    cache_[key] = lru_.begin();
+    usage_ += block_size;
+}
+
+void
+IVFListCache::Erase(int64_t file_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = cache_.lower_bound(Key(file_id, 0));
+    while (iter != cache_.end() && iter->first.first == file_id) {
+        usage_ -= static_cast<int64_t>(iter->second->second->size());
+        lru_.erase(iter->second);
+        iter = cache_.erase(iter);
+    }
+}
+
+void
+IVFListCache::EvictNoLock(int64_t capacity) {
+    while (usage_ > capacity && !lru_.empty()) {
+        usage_ -= static_cast<int64_t>(lru_.back().second->size());
+        cache_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+}
+
+IVFListFile::IVFListFile(const std::string& path, const faiss::InvertedLists* invlists, size_t vector_size)
+    : path_(path), vector_size_(vector_size) {
+    // blocks are cached by file id, a reloaded file never hits the blocks of its previous instance
+    static std::atomic<int64_t> s_file_id(0);
+    file_id_ = s_file_id++;
+
+    size_t nlist = invlists->nlist;
+    prefix_sum_.resize(nlist);
+    list_sizes_.resize(nlist);
+    size_t total = 0;
+    for (size_t i = 0; i < nlist; ++i) {
+        prefix_sum_[i] = total;
+        list_sizes_[i] = invlists->list_size(i);
+        total += list_sizes_[i];
+    }
+
+    fd_ = open(path_.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        KNOWHERE_THROW_MSG("Fail to open ivf list file " + path_ + ": " + strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) != total * vector_size_) {
+        close(fd_);
+        fd_ = -1;
+        KNOWHERE_THROW_MSG("Ivf list file " + path_ + " doesn't match the index");
+    }
+}
+
+IVFListFile::~IVFListFile() {
+    IVFListCache::GetInstance().Erase(file_id_);
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+void
+IVFListFile::Arrange(const faiss::InvertedLists* invlists, const uint8_t* original_data, size_t vector_size,
+                     const BlockWriter& writer) {
+    std::vector<uint8_t> block;
+    for (size_t i = 0; i < invlists->nlist; ++i) {
+        size_t list_size = invlists->list_size(i);
+        faiss::InvertedLists::ScopedIds ids(invlists, i);
+        block.resize(list_size * vector_size);
+        for (size_t j = 0; j < list_size; ++j) {
+            memcpy(block.data() + j * vector_size, original_data + ids[j] * vector_size, vector_size);
+        }
+        writer(block.data(), block.size());
+    }
+}
+
+ListBlock
+IVFListFile::GetList(size_t list_no) {
+    auto& cache = IVFListCache::GetInstance();
+    auto block = cache.Get(file_id_, list_no);
+    if (block == nullptr) {
+        block = ReadList(list_no);
+        cache.Insert(file_id_, list_no, block);
+    }
+    return block;
+}
+
+ListBlock
+IVFListFile::ReadList(size_t list_no) {
+    size_t size = list_sizes_[list_no] * vector_size_;
+    off_t offset = prefix_sum_[list_no] * vector_size_;
+    auto block = std::make_shared<std::vector<uint8_t>>(size);
+
+    size_t done = 0;
+    while (done < size) {
+        auto ret = pread(fd_, block->data() + done, size - done, offset + done);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            KNOWHERE_THROW_MSG("Fail to read ivf list file " + path_ + ": " + strerror(errno));
+        }
+        done += ret;
+    }
+    return block;
+}
+
+}  // namespace knowhere
+}  // namespace milvus
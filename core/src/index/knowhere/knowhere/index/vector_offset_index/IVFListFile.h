@@ -0,0 +1,121 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <faiss/InvertedLists.h>
+
+namespace milvus {
+namespace knowhere {
+
+using ListBlock = std::shared_ptr<std::vector<uint8_t>>;
+
+/*
+ * LRU cache of list blocks read from ivf list files. One cache is shared by all list files of the process, so
+ * the capacity is a budget for all loaded indexes rather than for each of them.
+ */
+class IVFListCache {
+ public:
+    static IVFListCache&
+    GetInstance();
+
+    // evict the least recently used blocks until the usage fits in capacity
+    void
+    SetCapacity(int64_t capacity);
+
+    int64_t
+    Capacity() const;
+
+    int64_t
+    Usage() const;
+
+    ListBlock
+    Get(int64_t file_id, size_t list_no);
+
+    void
+    Insert(int64_t file_id, size_t list_no, const ListBlock& block);
+
+    // drop all blocks of a list file
+    void
+    Erase(int64_t file_id);
+
+ private:
+    IVFListCache() = default;
+
+    void
+    EvictNoLock(int64_t capacity);
+
+ private:
+    using Key = std::pair<int64_t, size_t>;
+    using LRUList = std::list<std::pair<Key, ListBlock>>;
+
+    mutable std::mutex mutex_;
+    LRUList lru_;
+    std::map<Key, LRUList::iterator> cache_;
+    int64_t capacity_ = 0;
+    int64_t usage_ = 0;
+};
+
+/*
+ * Raw vectors of an IVF_NM index stored in a file, arranged list by list so that each inverted list is one
+ * contiguous block. Blocks are read with pread when a list is probed and kept in the shared IVFListCache.
+ */
+class IVFListFile {
+ public:
+    using BlockWriter = std::function<void(const uint8_t* data, size_t size)>;
+
+    IVFListFile(const std::string& path, const faiss::InvertedLists* invlists, size_t vector_size);
+
+    ~IVFListFile();
+
+    // Arrange original_data (vectors in offset order) by inverted list, the blocks are handed to writer in list order
+    static void
+    Arrange(const faiss::InvertedLists* invlists, const uint8_t* original_data, size_t vector_size,
+            const BlockWriter& writer);
+
+    ListBlock
+    GetList(size_t list_no);
+
+    const std::vector<size_t>&
+    PrefixSum() const {
+        return prefix_sum_;
+    }
+
+    IVFListFile(const IVFListFile&) = delete;
+    IVFListFile&
+    operator=(const IVFListFile&) = delete;
+
+ private:
+    ListBlock
+    ReadList(size_t list_no);
+
+ private:
+    std::string path_;
+    int64_t file_id_;
+    int fd_ = -1;
+    size_t vector_size_;
+    std::vector<size_t> prefix_sum_;
+    std::vector<size_t> list_sizes_;
+};
+
+using IVFListFilePtr = std::shared_ptr<IVFListFile>;
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -16,14 +16,17 @@
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/clone_index.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
+#include <faiss/utils/Heap.h>
 #ifdef MILVUS_GPU_VERSION
 #include <faiss/gpu/GpuAutoTune.h>
 #include <faiss/gpu/GpuCloner.h>
 #endif
 
 #include <fiu/fiu-local.h>
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -60,6 +63,7 @@ void
 IVF_NM::Load(const BinarySet& binary_set) {
     std::lock_guard<std::mutex> lk(mutex_);
     LoadImpl(binary_set, index_type_);
+    list_file_ = nullptr;
 
     // Construct arranged data from original data
     auto binary = binary_set.GetByName(RAW_DATA);
@@ -104,6 +108,38 @@ IVF_NM::Load(const BinarySet& binary_set) {
 #endif
 }
 
+void
+IVF_NM::WriteListFile(const BinarySet& binary_set, const IVFListFile::BlockWriter& writer) {
+#ifndef MILVUS_GPU_VERSION
+    auto iter = binary_set.binary_map_.find(RAW_DATA);
+    if (iter == binary_set.binary_map_.end()) {
+        KNOWHERE_THROW_MSG("IVF_NM::WriteListFile requires " + std::string(RAW_DATA));
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    LoadImpl(binary_set, index_type_);
+    auto invlists = dynamic_cast<faiss::IndexIVF*>(index_.get())->invlists;
+    IVFListFile::Arrange(invlists, iter->second->data.get(), invlists->code_size, writer);
+#else
+    KNOWHERE_THROW_MSG("IVF_NM::WriteListFile is not supported in GPU version");
+#endif
+}
+
+void
+IVF_NM::LoadWithListFile(const BinarySet& binary_set, const std::string& list_file_path) {
+#ifndef MILVUS_GPU_VERSION
+    std::lock_guard<std::mutex> lk(mutex_);
+    LoadImpl(binary_set, index_type_);
+
+    auto invlists = dynamic_cast<faiss::IndexIVF*>(index_.get())->invlists;
+    list_file_ = std::make_shared<IVFListFile>(list_file_path, invlists, invlists->code_size);
+    prefix_sum = list_file_->PrefixSum();
+    data_ = nullptr;
+#else
+    KNOWHERE_THROW_MSG("IVF_NM::LoadWithListFile is not supported in GPU version");
+#endif
+}
+
 void
 IVF_NM::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     GET_TENSOR_DATA_DIM(dataset_ptr)
@@ -139,6 +175,27 @@ IVF_NM::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
 
 DatasetPtr
 IVF_NM::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    auto elems = dataset_ptr->Get<int64_t>(meta::ROWS) * config[meta::TOPK].get<int64_t>();
+    auto p_id = static_cast<int64_t*>(malloc(sizeof(int64_t) * elems));
+    auto p_dist = static_cast<float*>(malloc(sizeof(float) * elems));
+
+    try {
+        QueryInto(dataset_ptr, config, p_id, p_dist, nullptr);
+    } catch (...) {
+        free(p_id);
+        free(p_dist);
+        throw;
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+IVF_NM::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances,
+                  const std::vector<IDType>* uids) {
     if (!index_ || !index_->is_trained) {
         KNOWHERE_THROW_MSG("index not initialize or trained");
     }
@@ -149,19 +206,8 @@ IVF_NM::Query(const DatasetPtr& dataset_ptr, const Config& config) {
         fiu_do_on("IVF_NM.Search.throw_std_exception", throw std::exception());
         fiu_do_on("IVF_NM.Search.throw_faiss_exception", throw faiss::FaissException(""));
         auto k = config[meta::TOPK].get<int64_t>();
-        auto elems = rows * k;
-
-        size_t p_id_size = sizeof(int64_t) * elems;
-        size_t p_dist_size = sizeof(float) * elems;
-        auto p_id = static_cast<int64_t*>(malloc(p_id_size));
-        auto p_dist = static_cast<float*>(malloc(p_dist_size));
-
-        QueryImpl(rows, reinterpret_cast<const float*>(p_data), k, p_dist, p_id, config);
-
-        auto ret_ds = std::make_shared<Dataset>();
-        ret_ds->Set(meta::IDS, p_id);
-        ret_ds->Set(meta::DISTANCE, p_dist);
-        return ret_ds;
+        QueryImpl(rows, reinterpret_cast<const float*>(p_data), k, distances, ids, config);
+        MapOffsetsToUids(ids, rows * k, uids);
     } catch (faiss::FaissException& e) {
         KNOWHERE_THROW_MSG(e.what());
     } catch (std::exception& e) {
@@ -169,6 +215,75 @@ IVF_NM::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     }
 }
 
+DatasetPtr
+IVF_NM::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    GET_TENSOR_DATA(dataset_ptr)
+    auto query = reinterpret_cast<const float*>(p_data);
+    auto radius = config[meta::RADIUS].get<float>();
+    auto params = GenParams(config);
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    auto invlists = ivf_index->invlists;
+    int64_t nprobe = std::min<int64_t>(params->nprobe, ivf_index->nlist);
+
+    std::vector<faiss::Index::idx_t> keys(rows * nprobe);
+    std::vector<float> coarse_dis(rows * nprobe);
+    ivf_index->quantizer->search(rows, query, nprobe, coarse_dis.data(), keys.data());
+
+#ifndef MILVUS_GPU_VERSION
+    auto data = static_cast<const uint8_t*>(data_.get());
+#else
+    auto data = static_cast<const uint8_t*>(ro_codes->data);
+#endif
+
+    // the codes are not in the inverted lists, scan the arranged data (or the list file) list by list
+    faiss::RangeSearchResult res(rows);
+    std::string error;
+#pragma omp parallel
+    {
+        faiss::RangeSearchPartialResult pres(&res);
+        std::unique_ptr<faiss::InvertedListScanner> scanner(ivf_index->get_InvertedListScanner(false));
+
+#pragma omp for
+        for (int64_t i = 0; i < rows; ++i) {
+            faiss::RangeQueryResult& qres = pres.new_result(i);
+            try {
+                scanner->set_query(query + i * ivf_index->d);
+                for (int64_t j = 0; j < nprobe; ++j) {
+                    auto key = keys[i * nprobe + j];
+                    if (key < 0 || invlists->list_size(key) == 0) {
+                        continue;
+                    }
+                    ListBlock block;
+                    const uint8_t* codes = nullptr;
+                    if (list_file_ != nullptr) {
+                        block = list_file_->GetList(key);
+                        codes = block->data();
+                    } else {
+                        codes = data + prefix_sum[key] * invlists->code_size;
+                    }
+                    scanner->set_list(key, coarse_dis[i * nprobe + j]);
+                    scanner->scan_codes_range(invlists->list_size(key), codes, invlists->get_ids(key), radius, qres,
+                                              bitset_);
+                }
+            } catch (std::exception& e) {
+#pragma omp critical
+                error = e.what();
+            }
+        }
+        pres.finalize();
+    }
+
+    if (!error.empty()) {
+        KNOWHERE_THROW_MSG(error);
+    }
+    return GenRangeResultDataset(res, config[meta::TOPK].get<int64_t>(),
+                                 ivf_index->metric_type == faiss::METRIC_INNER_PRODUCT);
+}
+
 #if 0
 DatasetPtr
 IVF_NM::QueryById(const DatasetPtr& dataset_ptr, const Config& config) {
@@ -317,6 +432,13 @@ IVF_NM::QueryImpl(int64_t n, const float* query, int64_t k, float* distances, in
     }
     bool is_sq8 = (index_type_ == IndexEnum::INDEX_FAISS_IVFSQ8) ? true : false;
 
+    if (list_file_ != nullptr) {
+        QueryListFile(n, query, k, distances, labels, *params);
+        LOG_KNOWHERE_DEBUG_ << "IVF_NM list file search cost: "
+                            << std::chrono::duration<double, std::micro>(stdclock::now() - before).count();
+        return;
+    }
+
 #ifndef MILVUS_GPU_VERSION
     auto data = static_cast<const uint8_t*>(data_.get());
 #else
@@ -334,6 +456,65 @@ IVF_NM::QueryImpl(int64_t n, const float* query, int64_t k, float* distances, in
     faiss::indexIVF_stats.search_time = 0;
 }
 
+void
+IVF_NM::QueryListFile(int64_t n, const float* query, int64_t k, float* distances, int64_t* labels,
+                      const faiss::IVFSearchParameters& params) {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    auto invlists = ivf_index->invlists;
+    int64_t nprobe = std::min<int64_t>(params.nprobe, ivf_index->nlist);
+
+    std::vector<faiss::Index::idx_t> keys(n * nprobe);
+    std::vector<float> coarse_dis(n * nprobe);
+    ivf_index->quantizer->search(n, query, nprobe, coarse_dis.data(), keys.data());
+
+    bool is_ip = (ivf_index->metric_type == faiss::METRIC_INNER_PRODUCT);
+    std::string error;
+
+#pragma omp parallel
+    {
+        std::unique_ptr<faiss::InvertedListScanner> scanner(ivf_index->get_InvertedListScanner(false));
+
+#pragma omp for
+        for (int64_t i = 0; i < n; ++i) {
+            float* simi = distances + i * k;
+            int64_t* idxi = labels + i * k;
+            if (is_ip) {
+                faiss::heap_heapify<faiss::CMin<float, int64_t>>(k, simi, idxi);
+            } else {
+                faiss::heap_heapify<faiss::CMax<float, int64_t>>(k, simi, idxi);
+            }
+
+            try {
+                scanner->set_query(query + i * ivf_index->d);
+                for (int64_t j = 0; j < nprobe; ++j) {
+                    auto key = keys[i * nprobe + j];
+                    if (key < 0 || invlists->list_size(key) == 0) {
+                        continue;
+                    }
+                    // the block stays valid while scanning even if the cache evicts it
+                    auto block = list_file_->GetList(key);
+                    scanner->set_list(key, coarse_dis[i * nprobe + j]);
+                    scanner->scan_codes(invlists->list_size(key), block->data(), invlists->get_ids(key), simi,
+                                        idxi, k, bitset_);
+                }
+            } catch (std::exception& e) {
+#pragma omp critical
+                error = e.what();
+            }
+
+            if (is_ip) {
+                faiss::heap_reorder<faiss::CMin<float, int64_t>>(k, simi, idxi);
+            } else {
+                faiss::heap_reorder<faiss::CMax<float, int64_t>>(k, simi, idxi);
+            }
+        }
+    }
+
+    if (!error.empty()) {
+        KNOWHERE_THROW_MSG(error);
+    }
+}
+
 void
 IVF_NM::SealImpl() {
 #ifdef MILVUS_GPU_VERSION
@@ -370,6 +551,11 @@ IVF_NM::UpdateIndexSize() {
     auto nb = ivf_index->invlists->compute_ntotal();
     auto nlist = ivf_index->nlist;
     auto code_size = ivf_index->code_size;
+    if (list_file_ != nullptr) {
+        // ivf ids and quantizer, the codes stay on disk and the shared list cache has its own budget
+        index_size_ = nb * sizeof(int64_t) + nlist * code_size;
+        return;
+    }
     // ivf codes, ivf ids and quantizer
     index_size_ = nb * code_size + nb * sizeof(int64_t) + nlist * code_size;
 }
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <mutex>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -20,6 +21,7 @@
 
 #include "knowhere/common/Typedef.h"
 #include "knowhere/index/vector_index/VecIndex.h"
+#include "knowhere/index/vector_offset_index/IVFListFile.h"
 #include "knowhere/index/vector_offset_index/OffsetBaseIndex.h"
 
 namespace milvus {
@@ -41,6 +43,16 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     void
     Load(const BinarySet&) override;
 
+    // Arrange RAW_DATA by inverted list, the blocks are handed to writer in list order to make the list file.
+    // CPU only.
+    void
+    WriteListFile(const BinarySet&, const IVFListFile::BlockWriter& writer);
+
+    // Load with raw vectors kept in the list file made by WriteListFile. Search reads the probed lists only,
+    // through the list cache shared by all list files. CPU only.
+    void
+    LoadWithListFile(const BinarySet&, const std::string& list_file_path);
+
     void
     Train(const DatasetPtr&, const Config&) override;
 
@@ -53,6 +65,12 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     DatasetPtr
     Query(const DatasetPtr&, const Config&) override;
 
+    void
+    QueryInto(const DatasetPtr&, const Config&, int64_t*, float*, const std::vector<IDType>*) override;
+
+    DatasetPtr
+    QueryByRange(const DatasetPtr&, const Config&) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) override;
@@ -88,6 +106,9 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     virtual void
     QueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&);
 
+    void
+    QueryListFile(int64_t, const float*, int64_t, float*, int64_t*, const faiss::IVFSearchParameters&);
+
     void
     SealImpl() override;
 
@@ -100,6 +121,9 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     //            destruction won't be done twice
     std::shared_ptr<uint8_t[]> data_ = nullptr;
     faiss::PageLockMemoryPtr ro_codes = nullptr;
+
+    // list_file_: if disk mode, raw vectors are read from it instead of data_
+    IVFListFilePtr list_file_ = nullptr;
 };
 
 using IVFNMPtr = std::shared_ptr<IVF_NM>;
@@ -830,7 +830,7 @@ class AnnoyIndexInterface {
   // Note that the methods with an **error argument will allocate memory and write the pointer to that string if error is non-nullptr
   virtual ~AnnoyIndexInterface() {};
   virtual bool add_item(S item, const T* w, char** error=nullptr) = 0;
-  virtual bool build(int q, char** error=nullptr) = 0;
+  virtual bool build(int q, int n_threads=1, char** error=nullptr) = 0;
   virtual bool unbuild(char** error=nullptr) = 0;
   virtual bool save(const char* filename, bool prefault=false, char** error=nullptr) = 0;
   virtual void unload() = 0;
@@ -871,6 +871,7 @@ protected:
   size_t _s;
   S _n_items;
   Random _random;
+  uint32_t _seed;
   void* _nodes; // Could either be mmapped, or point to a memory buffer that we reallocate
   S _n_nodes;
   S _nodes_size;
@@ -883,7 +884,7 @@ protected:
   bool _built;
 public:
 
-   AnnoyIndex(int f) : _f(f), _random() {
+   AnnoyIndex(int f) : _f(f), _random(), _seed(0) {
     _s = offsetof(Node, v) + _f * sizeof(T); // Size of each node
     _verbose = false;
     _built = false;
@@ -949,7 +950,7 @@ public:
     return true;
   }
     
-  bool build(int q, char** error=nullptr) {
+  bool build(int q, int n_threads=1, char** error=nullptr) {
     if (_loaded) {
       set_error_from_string(error, "You can't build a loaded index");
       return false;
@@ -963,20 +964,20 @@ public:
     D::template preprocess<T, S, Node>(_nodes, _s, _n_items, _f);
 
     _n_nodes = _n_items;
-    while (1) {
-      if (q == -1 && _n_nodes >= _n_items * 2)
-        break;
-      if (q != -1 && _roots.size() >= (size_t)q)
-        break;
-      if (_verbose) showUpdate("pass %zd...\n", _roots.size());
+    if (q == -1) {
+      while (_n_nodes < _n_items * 2) {
+        if (_verbose) showUpdate("pass %zd...\n", _roots.size());
+
+        vector<S> indices;
+        for (S i = 0; i < _n_items; i++) {
+          if (_get(i)->n_descendants >= 1) // Issue #223
+            indices.push_back(i);
+        }
 
-      vector<S> indices;
-      for (S i = 0; i < _n_items; i++) {
-        if (_get(i)->n_descendants >= 1) // Issue #223
-          indices.push_back(i);
+        _roots.push_back(_make_tree(indices, true, _random, nullptr));
       }
-
-      _roots.push_back(_make_tree(indices, true));
+    } else {
+      _build_trees(q, std::max(n_threads, 1));
     }
 
     // Also, copy the roots into the last segment of the array
@@ -1220,6 +1221,7 @@ public:
 
   void set_seed(int seed) {
     _random.set_seed(seed);
+    _seed = seed;
   }
 
 protected:
@@ -1247,7 +1249,77 @@ protected:
     return get_node_ptr<S, Node>(_nodes, _s, i);
   }
 
-  S _make_tree(const vector<S >& indices, bool is_root) {
+  // Nodes of a single tree, numbered from _n_items on as if they were appended to _nodes.
+  // Trees are built into their own buffer so that several of them can be built at once.
+  struct TreeBuffer {
+    vector<char> data;
+    S n_nodes = 0;
+  };
+
+  S _new_node(TreeBuffer* buffer) {
+    if (buffer == nullptr) {
+      _allocate_size(_n_nodes + 1);
+      return _n_nodes++;
+    }
+    buffer->data.resize(buffer->data.size() + _s);
+    return _n_items + buffer->n_nodes++;
+  }
+
+  inline Node* _get_node(TreeBuffer* buffer, const S i) {
+    if (buffer == nullptr || i < _n_items)
+      return _get(i);
+    return get_node_ptr<S, Node>(buffer->data.data(), _s, i - _n_items);
+  }
+
+  void _build_trees(int q, int n_threads) {
+    vector<S> indices;
+    for (S i = 0; i < _n_items; i++) {
+      if (_get(i)->n_descendants >= 1) // Issue #223
+        indices.push_back(i);
+    }
+
+    // Every tree draws from its own generator seeded by its number, and the trees are appended
+    // in that order, so the index does not depend on the number of threads building it.
+    // Only n_threads trees are kept aside at a time to bound the extra memory.
+    for (int begin = 0; begin < q; begin += n_threads) {
+      int end = std::min(q, begin + n_threads);
+      if (_verbose) showUpdate("pass %d...\n", begin);
+
+      vector<TreeBuffer> buffers(end - begin);
+      vector<S> roots(end - begin);
+#pragma omp parallel for num_threads(n_threads) schedule(dynamic)
+      for (int t = begin; t < end; t++) {
+        Random random;
+        random.set_seed(_seed + t + 1);
+        roots[t - begin] = _make_tree(indices, true, random, &buffers[t - begin]);
+      }
+
+      for (size_t i = 0; i < buffers.size(); i++) {
+        _roots.push_back(_merge_tree(buffers[i], roots[i]));
+      }
+    }
+  }
+
+  // Appends the nodes of a tree buffer to _nodes, shifting the ids of its split nodes' children.
+  // Leaf nodes and children below _n_items only refer to items and are copied as they are.
+  S _merge_tree(const TreeBuffer& buffer, S root) {
+    S delta = _n_nodes - _n_items;
+    _allocate_size(_n_nodes + buffer.n_nodes);
+    memcpy(_get(_n_nodes), buffer.data.data(), _s * buffer.n_nodes);
+    for (S i = _n_nodes; i < _n_nodes + buffer.n_nodes; i++) {
+      Node* n = _get(i);
+      if (n->n_descendants > _K) {
+        for (int side = 0; side < 2; side++) {
+          if (n->children[side] >= _n_items)
+            n->children[side] += delta;
+        }
+      }
+    }
+    _n_nodes += buffer.n_nodes;
+    return root + delta;
+  }
+
+  S _make_tree(const vector<S >& indices, bool is_root, Random& random, TreeBuffer* buffer) {
     // The basic rule is that if we have <= _K items, then it's a leaf node, otherwise it's a split node.
     // There's some regrettable complications caused by the problem that root nodes have to be "special":
     // 1. We identify root nodes by the arguable logic that _n_items == n->n_descendants, regardless of how many descendants they actually have
@@ -1257,9 +1329,8 @@ protected:
       return indices[0];
 
     if (indices.size() <= (size_t)_K && (!is_root || (size_t)_n_items <= (size_t)_K || indices.size() == 1)) {
-      _allocate_size(_n_nodes + 1);
-      S item = _n_nodes++;
-      Node* m = _get(item);
+      S item = _new_node(buffer);
+      Node* m = _get_node(buffer, item);
       m->n_descendants = is_root ? _n_items : (S)indices.size();
 
       // Using std::copy instead of a loop seems to resolve issues #3 and #13,
@@ -1281,14 +1352,15 @@ protected:
 
     vector<S> children_indices[2];
     Node* m = (Node*)alloca(_s);
-    D::create_split(children, _f, _s, _random, m);
+    memset(m, 0, _s); // keep the padding of split nodes deterministic
+    D::create_split(children, _f, _s, random, m);
     faiss::BuilderSuspend::check_wait();
 
     for (size_t i = 0; i < indices.size(); i++) {
       S j = indices[i];
       Node* n = _get(j);
       if (n) {
-        bool side = D::side(m, n->v, _f, _random);
+        bool side = D::side(m, n->v, _f, random);
         children_indices[side].push_back(j);
       } else {
         showUpdate("No node for index %ld?\n", j);
@@ -1313,7 +1385,7 @@ protected:
       for (size_t i = 0; i < indices.size(); i++) {
         S j = indices[i];
         // Just randomize...
-        children_indices[_random.flip()].push_back(j);
+        children_indices[random.flip()].push_back(j);
       }
     }
 
@@ -1323,12 +1395,11 @@ protected:
     for (int side = 0; side < 2; side++) {
       // run _make_tree for the smallest child first (for cache locality)
       faiss::BuilderSuspend::check_wait();
-      m->children[side^flip] = _make_tree(children_indices[side^flip], false);
+      m->children[side^flip] = _make_tree(children_indices[side^flip], false, random, buffer);
     }
 
-    _allocate_size(_n_nodes + 1);
-    S item = _n_nodes++;
-    memcpy(_get(item), m, _s);
+    S item = _new_node(buffer);
+    memcpy(_get_node(buffer, item), m, _s);
 
     return item;
   }
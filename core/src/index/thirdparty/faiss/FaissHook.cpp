@@ -9,6 +9,9 @@
 #include <faiss/impl/ScalarQuantizerDC.h>
 #include <faiss/impl/ScalarQuantizerDC_avx.h>
 #include <faiss/impl/ScalarQuantizerDC_avx512.h>
+#include <faiss/utils/BinaryDistance.h>
+#include <faiss/utils/binary_distances_avx.h>
+#include <faiss/utils/binary_distances_avx512.h>
 #include <faiss/utils/distances.h>
 #include <faiss/utils/distances_avx.h>
 #include <faiss/utils/distances_avx512.h>
@@ -26,6 +29,12 @@ fvec_func_ptr fvec_L2sqr = fvec_L2sqr_avx;
 fvec_func_ptr fvec_L1 = fvec_L1_avx;
 fvec_func_ptr fvec_Linf = fvec_Linf_avx;
 
+fvec_to_fp16_func_ptr fvec_to_fp16 = fvec_to_fp16_avx;
+fp16_to_fvec_func_ptr fp16_to_fvec = fp16_to_fvec_avx;
+
+bvec_hamming_batch_func_ptr bvec_hamming_batch = bvec_hamming_batch_avx;
+bvec_jaccard_batch_func_ptr bvec_jaccard_batch = bvec_jaccard_batch_avx;
+
 sq_get_distance_computer_func_ptr sq_get_distance_computer = sq_get_distance_computer_avx;
 sq_sel_quantizer_func_ptr sq_sel_quantizer = sq_select_quantizer_avx;
 sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
@@ -41,6 +50,13 @@ bool support_avx512() {
             instruction_set_inst.AVX512BW());
 }
 
+bool support_avx512_vpopcntdq() {
+    if (!support_avx512()) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.AVX512_VPOPCNTDQ());
+}
+
 bool support_avx2() {
     if (!faiss_use_avx2) return false;
 
@@ -66,6 +82,19 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L1 = fvec_L1_avx512;
         fvec_Linf = fvec_Linf_avx512;
 
+        /* for FP16 vectors */
+        fvec_to_fp16 = fvec_to_fp16_avx512;
+        fp16_to_fvec = fp16_to_fvec_avx512;
+
+        /* for binary vectors, VPOPCNTDQ is not part of every AVX512 cpu */
+        if (support_avx512_vpopcntdq()) {
+            bvec_hamming_batch = bvec_hamming_batch_avx512;
+            bvec_jaccard_batch = bvec_jaccard_batch_avx512;
+        } else {
+            bvec_hamming_batch = bvec_hamming_batch_avx;
+            bvec_jaccard_batch = bvec_jaccard_batch_avx;
+        }
+
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_avx512;
         sq_sel_quantizer = sq_select_quantizer_avx512;
@@ -79,6 +108,14 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L1 = fvec_L1_avx;
         fvec_Linf = fvec_Linf_avx;
 
+        /* for FP16 vectors */
+        fvec_to_fp16 = fvec_to_fp16_avx;
+        fp16_to_fvec = fp16_to_fvec_avx;
+
+        /* for binary vectors */
+        bvec_hamming_batch = bvec_hamming_batch_avx;
+        bvec_jaccard_batch = bvec_jaccard_batch_avx;
+
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_avx;
         sq_sel_quantizer = sq_select_quantizer_avx;
@@ -92,6 +129,14 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L1 = fvec_L1_sse;
         fvec_Linf = fvec_Linf_sse;
 
+        /* for FP16 vectors */
+        fvec_to_fp16 = fvec_to_fp16_ref;
+        fp16_to_fvec = fp16_to_fvec_ref;
+
+        /* for binary vectors */
+        bvec_hamming_batch = bvec_hamming_batch_ref;
+        bvec_jaccard_batch = bvec_jaccard_batch_ref;
+
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_ref;
         sq_sel_quantizer = sq_select_quantizer_ref;
@@ -13,6 +13,11 @@
 namespace faiss {
 
 typedef float (*fvec_func_ptr)(const float*, const float*, size_t);
+typedef void (*fvec_to_fp16_func_ptr)(const float*, uint16_t*, size_t);
+typedef void (*fp16_to_fvec_func_ptr)(const uint16_t*, float*, size_t);
+
+typedef void (*bvec_hamming_batch_func_ptr)(const uint8_t*, const uint8_t*, size_t, size_t, int32_t*);
+typedef void (*bvec_jaccard_batch_func_ptr)(const uint8_t*, const uint8_t*, size_t, size_t, float*);
 
 typedef SQDistanceComputer* (*sq_get_distance_computer_func_ptr)(MetricType, QuantizerType, size_t, const std::vector<float>&);
 typedef Quantizer* (*sq_sel_quantizer_func_ptr)(QuantizerType, size_t, const std::vector<float>&);
@@ -27,11 +32,18 @@ extern fvec_func_ptr fvec_L2sqr;
 extern fvec_func_ptr fvec_L1;
 extern fvec_func_ptr fvec_Linf;
 
+extern fvec_to_fp16_func_ptr fvec_to_fp16;
+extern fp16_to_fvec_func_ptr fp16_to_fvec;
+
+extern bvec_hamming_batch_func_ptr bvec_hamming_batch;
+extern bvec_jaccard_batch_func_ptr bvec_jaccard_batch;
+
 extern sq_get_distance_computer_func_ptr sq_get_distance_computer;
 extern sq_sel_quantizer_func_ptr sq_sel_quantizer;
 extern sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner;
 
 extern bool support_avx512();
+extern bool support_avx512_vpopcntdq();
 extern bool support_avx2();
 extern bool support_sse();
 
@@ -16,8 +16,12 @@
 #include <cstdio>
 #include <omp.h>
 
+#include <algorithm>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
+#include <faiss/FaissHook.h>
 #include <faiss/utils/BinaryDistance.h>
 #include <faiss/utils/hamming.h>
 #include <faiss/utils/utils.h>
@@ -462,8 +466,95 @@ struct IVFBinaryScannerJaccard: BinaryInvertedListScanner {
     }
 };
 
+/* Scanner for long codes, the distances to the codes of a list are computed tile by tile
+ * with the batch kernels hooked in FaissHook. */
+template<class C>
+struct IVFBinaryScannerBatch: BinaryInvertedListScanner {
+    using T = typename C::T;
+
+    const uint8_t *query = nullptr;
+    size_t code_size;
+    bool store_pairs;
+    mutable std::vector<T> dis;
+
+    IVFBinaryScannerBatch (size_t code_size, bool store_pairs):
+        code_size (code_size), store_pairs (store_pairs), dis (binary_batch_tile_size)
+    {}
+
+    void set_query (const uint8_t *query_vector) override {
+        query = query_vector;
+    }
+
+    idx_t list_no;
+    void set_list (idx_t list_no, uint8_t /* coarse_dis */) override {
+        this->list_no = list_no;
+    }
+
+    void compute (const uint8_t *codes, size_t n, int32_t *out) const {
+        bvec_hamming_batch (query, codes, code_size, n, out);
+    }
+
+    void compute (const uint8_t *codes, size_t n, float *out) const {
+        bvec_jaccard_batch (query, codes, code_size, n, out);
+    }
+
+    uint32_t distance_to_code (const uint8_t *code) const override {
+        T d;
+        compute (code, 1, &d);
+        return d;
+    }
+
+    size_t scan_codes (size_t n,
+                       const uint8_t *codes,
+                       const idx_t *ids,
+                       int32_t *simi, idx_t *idxi,
+                       size_t k,
+                       ConcurrentBitsetPtr bitset) const override
+    {
+        T* psimi = (T*)simi;
+        size_t nup = 0;
+        for (size_t j0 = 0; j0 < n; j0 += dis.size()) {
+            size_t j1 = std::min(j0 + dis.size(), n);
+            compute (codes + j0 * code_size, j1 - j0, dis.data());
+            for (size_t j = j0; j < j1; j++) {
+                if (C::cmp (psimi[0], dis[j - j0]) && (!bitset || !bitset->test(ids[j]))) {
+                    idx_t id = store_pairs ? (list_no << 32 | j) : ids[j];
+                    heap_swap_top<C> (k, psimi, idxi, dis[j - j0], id);
+                    nup++;
+                }
+            }
+        }
+        return nup;
+    }
+
+    void scan_codes_range (size_t n,
+                           const uint8_t *codes,
+                           const idx_t *ids,
+                           int radius,
+                           RangeQueryResult &result) const override
+    {
+        // only hamming supports range search
+        if (std::is_same<T, float>::value) {
+            return;
+        }
+        for (size_t j0 = 0; j0 < n; j0 += dis.size()) {
+            size_t j1 = std::min(j0 + dis.size(), n);
+            compute (codes + j0 * code_size, j1 - j0, dis.data());
+            for (size_t j = j0; j < j1; j++) {
+                if (dis[j - j0] < radius) {
+                    int64_t id = store_pairs ? lo_build (list_no, j) : ids[j];
+                    result.add (dis[j - j0], id);
+                }
+            }
+        }
+    }
+};
+
 template <bool store_pairs>
 BinaryInvertedListScanner *select_IVFBinaryScannerL2 (size_t code_size) {
+    if (code_size >= binary_batch_min_code_size) {
+        return new IVFBinaryScannerBatch<CMax<int32_t, idx_t>> (code_size, store_pairs);
+    }
 #define HC(name) return new IVFBinaryScannerL2<name> (code_size, store_pairs)
     switch (code_size) {
         case 4: HC(HammingComputer4);
@@ -486,6 +577,9 @@ BinaryInvertedListScanner *select_IVFBinaryScannerL2 (size_t code_size) {
 
 template <bool store_pairs>
 BinaryInvertedListScanner *select_IVFBinaryScannerJaccard (size_t code_size) {
+    if (code_size >= binary_batch_min_code_size) {
+        return new IVFBinaryScannerBatch<CMax<float, idx_t>> (code_size, store_pairs);
+    }
     switch (code_size) {
 #define HANDLE_CS(cs)                                                  \
     case cs:                                                            \
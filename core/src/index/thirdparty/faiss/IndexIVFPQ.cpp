@@ -825,6 +825,8 @@ struct RangeSearchResults {
     inline void add (idx_t j, float dis, faiss::ConcurrentBitsetPtr bitset = nullptr) {
         if (C::cmp (radius, dis)) {
             idx_t id = ids ? ids[j] : lo_build (key, j);
+            if (bitset != nullptr && bitset->test((faiss::ConcurrentBitset::id_type_t)id))
+                return;
             rres.add (dis, id);
         }
     }
@@ -33,6 +33,7 @@ RHNSW::RHNSW(int M) : M(M), rng(12345) {
   linkLists = nullptr;
   level_constant = 1 / log(1.0 * M);
   visited_list_pool = nullptr;
+  search_queues_pool = new SearchQueuesPool();
 }
 
 void RHNSW::init(int ntotal) {
@@ -50,6 +51,7 @@ RHNSW::~RHNSW() {
   }
   free(linkLists);
   delete visited_list_pool;
+  delete search_queues_pool;
 }
 
 void RHNSW::reset() {
@@ -247,13 +249,24 @@ RHNSW::search_base_layer(DistanceComputer& ptdis,
                          storage_idx_t ef,
                          float d_nearest,
                          ConcurrentBitsetPtr bitset) const {
+  CandidateQueue top_candidates;
+  CandidateQueue candidate_set;
+  search_base_layer(ptdis, nearest, ef, d_nearest, bitset, top_candidates, candidate_set);
+  return top_candidates;
+}
+
+void
+RHNSW::search_base_layer(DistanceComputer& ptdis,
+                         storage_idx_t nearest,
+                         storage_idx_t ef,
+                         float d_nearest,
+                         const ConcurrentBitsetPtr& bitset,
+                         CandidateQueue& top_candidates,
+                         CandidateQueue& candidate_set) const {
   VisitedList *vl = visited_list_pool->getFreeVisitedList();
   vl_type *visited_array = vl->mass;
   vl_type visited_array_tag = vl->curV;
 
-  std::priority_queue<Node, std::vector<Node>, CompareByFirst> top_candidates;
-  std::priority_queue<Node, std::vector<Node>, CompareByFirst> candidate_set;
-
   float lb;
   if (bitset == nullptr || !bitset->test((faiss::ConcurrentBitset::id_type_t)(nearest))) {
     lb = d_nearest;
@@ -291,7 +304,6 @@ RHNSW::search_base_layer(DistanceComputer& ptdis,
     }
   }
   visited_list_pool->releaseVisitedList(vl);
-  return top_candidates;
 }
 
 void
@@ -412,7 +424,9 @@ void RHNSW::searchKnn(DistanceComputer& qdis, int k,
       }
     }
   }
-  std::priority_queue<Node, std::vector<Node>, CompareByFirst> top_candidates = search_base_layer(qdis, ep, std::max(efSearch, k), dist, bitset);
+  SearchQueues *queues = search_queues_pool->getFreeSearchQueues();
+  auto &top_candidates = queues->top_candidates;
+  search_base_layer(qdis, ep, std::max(efSearch, k), dist, bitset, top_candidates, queues->candidate_set);
   while (top_candidates.size() > k)
     top_candidates.pop();
   int i = 0;
@@ -422,6 +436,7 @@ void RHNSW::searchKnn(DistanceComputer& qdis, int k,
     i ++;
     top_candidates.pop();
   }
+  search_queues_pool->releaseSearchQueues(queues);
 }
 
 size_t RHNSW::cal_size() {
@@ -44,6 +44,7 @@ namespace faiss {
 
 struct DistanceComputer; // from AuxIndexStructures
 class VisitedListPool;
+class SearchQueuesPool;
 
 struct RHNSW {
   /// internal storage of vectors (32 bits: this is expensive)
@@ -150,6 +151,18 @@ struct RHNSW {
       }
   };
 
+  typedef std::priority_queue<Node, std::vector<Node>, CompareByFirst> CandidateQueue;
+
+  /// candidate queues of a base layer search, they keep their storage
+  /// when cleared so that searches reuse them without allocating
+  struct SearchQueues {
+    struct Queue : CandidateQueue {
+      void clear() { c.clear(); }
+    };
+    Queue top_candidates;
+    Queue candidate_set;
+  };
+
 
   /// level of each vector (base level = 1), size = ntotal
   std::vector<int> levels;
@@ -172,6 +185,7 @@ struct RHNSW {
   size_t link_size;
   double level_constant;
   VisitedListPool *visited_list_pool;
+  SearchQueuesPool *search_queues_pool;
   std::vector<std::mutex> link_list_locks;
   std::mutex global;
 
@@ -226,6 +240,15 @@ struct RHNSW {
                      float d_nearest,
                      ConcurrentBitsetPtr bitset = nullptr) const;
 
+  /// same as above, into the given queues which are expected to be empty
+  void search_base_layer (DistanceComputer& ptdis,
+                          storage_idx_t nearest,
+                          storage_idx_t ef,
+                          float d_nearest,
+                          const ConcurrentBitsetPtr& bitset,
+                          CandidateQueue& top_candidates,
+                          CandidateQueue& candidate_set) const;
+
   void make_connection(DistanceComputer& ptdis,
                        storage_idx_t pt_id,
                        std::priority_queue<Node, std::vector<Node>, CompareByFirst> &cand,
@@ -296,7 +319,7 @@ class VisitedList {
 /////////////////////////////////////////////////////////
 
 class VisitedListPool {
-    std::deque<VisitedList *> pool;
+    std::vector<VisitedList *> pool;  // a deque would free and allocate blocks as it empties and refills
     std::mutex poolguard;
     int numelements;
 
@@ -304,7 +327,7 @@ class VisitedListPool {
     VisitedListPool(int initmaxpools, int numelements1) {
         numelements = numelements1;
         for (int i = 0; i < initmaxpools; i++)
-            pool.push_front(new VisitedList(numelements));
+            pool.push_back(new VisitedList(numelements));
     }
 
     VisitedList *getFreeVisitedList() {
@@ -312,8 +335,8 @@ class VisitedListPool {
         {
             std::unique_lock <std::mutex> lock(poolguard);
             if (pool.size() > 0) {
-                rez = pool.front();
-                pool.pop_front();
+                rez = pool.back();
+                pool.pop_back();
             } else {
                 rez = new VisitedList(numelements);
             }
@@ -324,13 +347,13 @@ class VisitedListPool {
 
     void releaseVisitedList(VisitedList *vl) {
         std::unique_lock <std::mutex> lock(poolguard);
-        pool.push_front(vl);
+        pool.push_back(vl);
     };
 
     ~VisitedListPool() {
         while (pool.size()) {
-            VisitedList *rez = pool.front();
-            pool.pop_front();
+            VisitedList *rez = pool.back();
+            pool.pop_back();
             delete rez;
         }
     };
@@ -342,6 +365,47 @@ class VisitedListPool {
     }
 };
 
+///////////////////////////////////////////////////////////
+//
+// Class for multi-threaded pool-management of SearchQueues
+//
+/////////////////////////////////////////////////////////
+
+class SearchQueuesPool {
+    std::vector<RHNSW::SearchQueues *> pool;
+    std::mutex poolguard;
+
+ public:
+    RHNSW::SearchQueues *getFreeSearchQueues() {
+        RHNSW::SearchQueues *rez;
+        {
+            std::unique_lock <std::mutex> lock(poolguard);
+            if (pool.size() > 0) {
+                rez = pool.back();
+                pool.pop_back();
+            } else {
+                rez = new RHNSW::SearchQueues();
+            }
+        }
+        rez->top_candidates.clear();
+        rez->candidate_set.clear();
+        return rez;
+    };
+
+    void releaseSearchQueues(RHNSW::SearchQueues *sq) {
+        std::unique_lock <std::mutex> lock(poolguard);
+        pool.push_back(sq);
+    };
+
+    ~SearchQueuesPool() {
+        while (pool.size()) {
+            RHNSW::SearchQueues *rez = pool.back();
+            pool.pop_back();
+            delete rez;
+        }
+    };
+};
+
 struct RHNSWStats {
   size_t n1, n2, n3;
   size_t ndis;
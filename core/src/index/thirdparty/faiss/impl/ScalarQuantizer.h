@@ -142,6 +142,10 @@ struct IVFSQScannerIP: InvertedListScanner {
                            ConcurrentBitsetPtr bitset = nullptr) const override
     {
         for (size_t j = 0; j < list_size; j++) {
+            if (bitset && bitset->test(ids[j])) {
+                codes += code_size;
+                continue;
+            }
             float accu = accu0 + dc.query_to_code (codes);
             if (accu > radius) {
                 int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
@@ -229,6 +233,10 @@ struct IVFSQScannerL2: InvertedListScanner {
                            ConcurrentBitsetPtr bitset = nullptr) const override
     {
         for (size_t j = 0; j < list_size; j++) {
+            if (bitset && bitset->test(ids[j])) {
+                codes += code_size;
+                continue;
+            }
             float dis = dc.query_to_code (codes);
             if (dis < radius) {
                 int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <cstring>
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
@@ -9,6 +11,7 @@
 #include <limits.h>
 #include <omp.h>
 
+#include <faiss/FaissHook.h>
 #include <faiss/utils/Heap.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/utils.h>
@@ -18,6 +21,181 @@ namespace faiss {
 static const size_t size_1M = 1 * 1024 * 1024;
 static const size_t batch_size = 65536;
 
+size_t binary_batch_min_code_size = 64;
+size_t binary_batch_tile_size = 256;
+
+/* number of queries sharing a database tile when the queries are split among the threads */
+static const size_t batch_query_group = 8;
+
+template <class Op>
+static inline uint64_t
+bvec_popcount_ref (const uint8_t * x, const uint8_t * y, size_t n)
+{
+    const uint64_t * a = (const uint64_t *)x;
+    const uint64_t * b = (const uint64_t *)y;
+    size_t nwords = n / 8;
+    int count = 0;
+    for (size_t w = 0; w < nwords; w++) {
+        count += popcount64 (Op::apply (a[w], b[w]));
+    }
+    for (size_t i = nwords * 8; i < n; i++) {
+        count += popcount64 (Op::apply (x[i], y[i]));
+    }
+    return count;
+}
+
+struct BitXor {
+    static inline uint64_t apply (uint64_t a, uint64_t b) { return a ^ b; }
+};
+
+struct BitAnd {
+    static inline uint64_t apply (uint64_t a, uint64_t b) { return a & b; }
+};
+
+struct BitOr {
+    static inline uint64_t apply (uint64_t a, uint64_t b) { return a | b; }
+};
+
+void bvec_hamming_batch_ref (
+        const uint8_t * x,
+        const uint8_t * y,
+        size_t code_size,
+        size_t ny,
+        int32_t * dis)
+{
+    for (size_t j = 0; j < ny; j++, y += code_size) {
+        dis[j] = bvec_popcount_ref<BitXor> (x, y, code_size);
+    }
+}
+
+void bvec_jaccard_batch_ref (
+        const uint8_t * x,
+        const uint8_t * y,
+        size_t code_size,
+        size_t ny,
+        float * dis)
+{
+    for (size_t j = 0; j < ny; j++, y += code_size) {
+        uint64_t accu_num = bvec_popcount_ref<BitAnd> (x, y, code_size);
+        if (accu_num == 0) {
+            dis[j] = 1.0;
+            continue;
+        }
+        uint64_t accu_den = bvec_popcount_ref<BitOr> (x, y, code_size);
+        dis[j] = 1.0 - (float)(accu_num) / (float)(accu_den);
+    }
+}
+
+/* The database is cut in tiles of binary_batch_tile_size codes, the distances of a query
+ * to a whole tile are computed by one call of the kernel while the tile stays in cache
+ * for the next queries. */
+template <class C, class Kernel>
+static
+void binary_knn_hc_batch (
+        size_t bytes_per_code,
+        HeapArray<C> * ha,
+        const uint8_t * bs1,
+        const uint8_t * bs2,
+        size_t n2,
+        Kernel kernel,
+        bool order,
+        ConcurrentBitsetPtr bitset)
+{
+    using T = typename C::T;
+    size_t k = ha->k;
+    size_t nh = ha->nh;
+    const size_t tile_size = binary_batch_tile_size;
+    size_t tile_num = (n2 + tile_size - 1) / tile_size;
+
+    ha->heapify ();
+
+    if ((bytes_per_code + k * (sizeof(T) + sizeof(int64_t))) * nh < size_1M) {
+        // few queries, split the database among the threads with a heap per thread
+        int thread_max_num = omp_get_max_threads();
+        size_t thread_heap_size = nh * k;
+        std::vector<T> value(thread_heap_size * thread_max_num);
+        std::vector<int64_t> labels(thread_heap_size * thread_max_num);
+        for (size_t i = 0; i < nh * thread_max_num; i++) {
+            heap_heapify<C> (k, value.data() + i * k, labels.data() + i * k);
+        }
+
+#pragma omp parallel
+        {
+            int thread_no = omp_get_thread_num();
+            std::vector<T> dis(tile_size);
+#pragma omp for
+            for (size_t t = 0; t < tile_num; t++) {
+                size_t j0 = t * tile_size;
+                size_t j1 = std::min(j0 + tile_size, n2);
+                for (size_t i = 0; i < nh; i++) {
+                    kernel (bs1 + i * bytes_per_code, bs2 + j0 * bytes_per_code, bytes_per_code, j1 - j0, dis.data());
+                    T * val_ = value.data() + thread_no * thread_heap_size + i * k;
+                    int64_t * ids_ = labels.data() + thread_no * thread_heap_size + i * k;
+                    for (size_t j = j0; j < j1; j++) {
+                        if (C::cmp (val_[0], dis[j - j0]) && (!bitset || !bitset->test(j))) {
+                            heap_swap_top<C> (k, val_, ids_, dis[j - j0], j);
+                        }
+                    }
+                }
+            }
+        }
+
+        // merge heap
+        for (size_t t = 0; t < thread_max_num; t++) {
+            for (size_t i = 0; i < nh; i++) {
+                T * val_ = ha->val + i * k;
+                int64_t * ids_ = ha->ids + i * k;
+                const T * val_t = value.data() + t * thread_heap_size + i * k;
+                const int64_t * ids_t = labels.data() + t * thread_heap_size + i * k;
+                for (size_t j = 0; j < k; j++) {
+                    if (ids_t[j] != -1 && C::cmp (val_[0], val_t[j])) {
+                        heap_swap_top<C> (k, val_, ids_, val_t[j], ids_t[j]);
+                    }
+                }
+            }
+        }
+
+    } else {
+        // many queries, split them among the threads in groups sharing the database tiles
+#pragma omp parallel
+        {
+            std::vector<T> dis(tile_size);
+#pragma omp for
+            for (size_t i0 = 0; i0 < nh; i0 += batch_query_group) {
+                size_t i1 = std::min(i0 + batch_query_group, nh);
+                for (size_t j0 = 0; j0 < n2; j0 += tile_size) {
+                    size_t j1 = std::min(j0 + tile_size, n2);
+                    for (size_t i = i0; i < i1; i++) {
+                        kernel (bs1 + i * bytes_per_code, bs2 + j0 * bytes_per_code, bytes_per_code, j1 - j0,
+                                dis.data());
+                        T * val_ = ha->val + i * k;
+                        int64_t * ids_ = ha->ids + i * k;
+                        for (size_t j = j0; j < j1; j++) {
+                            if (C::cmp (val_[0], dis[j - j0]) && (!bitset || !bitset->test(j))) {
+                                heap_swap_top<C> (k, val_, ids_, dis[j - j0], j);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (order) ha->reorder ();
+}
+
+void hammings_knn_hc_batch (
+        int_maxheap_array_t * ha,
+        const uint8_t * a,
+        const uint8_t * b,
+        size_t nb,
+        size_t ncodes,
+        int order,
+        ConcurrentBitsetPtr bitset)
+{
+    binary_knn_hc_batch (ncodes, ha, a, b, nb, bvec_hamming_batch, order, bitset);
+}
+
 template <class T>
 static
 void binary_distence_knn_hc(
@@ -134,6 +312,10 @@ void binary_distence_knn_hc (
     switch (metric_type) {
     case METRIC_Jaccard:
     case METRIC_Tanimoto:
+        if (ncodes >= binary_batch_min_code_size) {
+            binary_knn_hc_batch (ncodes, ha, a, b, nb, bvec_jaccard_batch, order, bitset);
+            break;
+        }
         switch (ncodes) {
 #define binary_distence_knn_hc_jaccard(ncodes) \
         case ncodes: \
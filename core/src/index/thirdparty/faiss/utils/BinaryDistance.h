@@ -53,6 +53,40 @@ namespace faiss {
             int64_t *labels,
             ConcurrentBitsetPtr bitset);
 
+/** Return the k smallest Hamming distances like hammings_knn_hc, the distances are
+ * computed with the batch kernel hooked in FaissHook, tile by tile of the database.
+ * Used for codes of at least binary_batch_min_code_size bytes. */
+    void hammings_knn_hc_batch (
+            int_maxheap_array_t * ha,
+            const uint8_t * a,
+            const uint8_t * b,
+            size_t nb,
+            size_t ncodes,
+            int ordered,
+            ConcurrentBitsetPtr bitset = nullptr);
+
+/// codes of at least this many bytes are compared with the hooked batch kernels
+    extern size_t binary_batch_min_code_size;
+
+/// number of database codes compared to a query by one call of a batch kernel
+    extern size_t binary_batch_tile_size;
+
+/// Hamming distances between the code x and ny consecutive codes of y
+    void bvec_hamming_batch_ref (
+            const uint8_t * x,
+            const uint8_t * y,
+            size_t code_size,
+            size_t ny,
+            int32_t * dis);
+
+/// Jaccard distances between the code x and ny consecutive codes of y
+    void bvec_jaccard_batch_ref (
+            const uint8_t * x,
+            const uint8_t * y,
+            size_t code_size,
+            size_t ny,
+            float * dis);
+
 } // namespace faiss
 
 #include <faiss/utils/jaccard-inl.h>
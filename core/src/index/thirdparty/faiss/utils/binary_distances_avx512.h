@@ -0,0 +1,21 @@
+// -*- c++ -*-
+
+/* Batched distance functions for binary codes, they need AVX512 VPOPCNTDQ.
+ * The actual functions are implemented in binary_distances_simd_avx512.cpp */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/// Hamming distances between the code x and ny consecutive codes of y
+void
+bvec_hamming_batch_avx512(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, int32_t* dis);
+
+/// Jaccard distances between the code x and ny consecutive codes of y
+void
+bvec_jaccard_batch_avx512(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, float* dis);
+
+} // namespace faiss
@@ -0,0 +1,137 @@
+// -*- c++ -*-
+
+#include <faiss/utils/binary_distances_avx.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <cstring>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __AVX2__
+
+namespace {
+
+struct OpXor {
+    static inline __m256i apply (__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+    static inline uint64_t apply (uint64_t a, uint64_t b) { return a ^ b; }
+};
+
+struct OpAnd {
+    static inline __m256i apply (__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+    static inline uint64_t apply (uint64_t a, uint64_t b) { return a & b; }
+};
+
+struct OpOr {
+    static inline __m256i apply (__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+    static inline uint64_t apply (uint64_t a, uint64_t b) { return a | b; }
+};
+
+/* popcount of every 64 bits lane, the bytes are counted by looking up their nibbles */
+inline __m256i popcount_lanes (__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+/* carry save adder, h:l = a + b + c */
+inline void csa (__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) {
+    __m256i u = _mm256_xor_si256(a, b);
+    h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    l = _mm256_xor_si256(u, c);
+}
+
+template <class Op>
+inline __m256i load_op (const uint8_t* x, const uint8_t* y) {
+    return Op::apply(_mm256_loadu_si256((const __m256i*)x), _mm256_loadu_si256((const __m256i*)y));
+}
+
+/* popcount of Op(x, y) over n bytes, Harley-Seal over blocks of 8 vectors for long codes */
+template <class Op>
+inline uint64_t popcount_op (const uint8_t* x, const uint8_t* y, size_t n) {
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+
+    if (n >= 256) {
+        __m256i ones = _mm256_setzero_si256();
+        __m256i twos = _mm256_setzero_si256();
+        __m256i fours = _mm256_setzero_si256();
+        __m256i twos_a, twos_b, fours_a, fours_b, eights;
+        for (; i + 256 <= n; i += 256) {
+            csa(twos_a, ones, ones, load_op<Op>(x + i, y + i), load_op<Op>(x + i + 32, y + i + 32));
+            csa(twos_b, ones, ones, load_op<Op>(x + i + 64, y + i + 64), load_op<Op>(x + i + 96, y + i + 96));
+            csa(fours_a, twos, twos, twos_a, twos_b);
+            csa(twos_a, ones, ones, load_op<Op>(x + i + 128, y + i + 128), load_op<Op>(x + i + 160, y + i + 160));
+            csa(twos_b, ones, ones, load_op<Op>(x + i + 192, y + i + 192), load_op<Op>(x + i + 224, y + i + 224));
+            csa(fours_b, twos, twos, twos_a, twos_b);
+            csa(eights, fours, fours, fours_a, fours_b);
+            total = _mm256_add_epi64(total, popcount_lanes(eights));
+        }
+        total = _mm256_slli_epi64(total, 3);
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_lanes(fours), 2));
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_lanes(twos), 1));
+        total = _mm256_add_epi64(total, popcount_lanes(ones));
+    }
+
+    for (; i + 32 <= n; i += 32) {
+        total = _mm256_add_epi64(total, popcount_lanes(load_op<Op>(x + i, y + i)));
+    }
+
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    uint64_t count = _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+
+    for (; i + 8 <= n; i += 8) {
+        uint64_t a, b;
+        memcpy(&a, x + i, 8);
+        memcpy(&b, y + i, 8);
+        count += __builtin_popcountll(Op::apply(a, b));
+    }
+    for (; i < n; i++) {
+        count += __builtin_popcountll(Op::apply((uint64_t)x[i], (uint64_t)y[i]));
+    }
+    return count;
+}
+
+} // namespace
+
+void
+bvec_hamming_batch_avx(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, int32_t* dis) {
+    for (size_t j = 0; j < ny; j++, y += code_size) {
+        dis[j] = popcount_op<OpXor>(x, y, code_size);
+    }
+}
+
+void
+bvec_jaccard_batch_avx(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, float* dis) {
+    for (size_t j = 0; j < ny; j++, y += code_size) {
+        uint64_t accu_num = popcount_op<OpAnd>(x, y, code_size);
+        if (accu_num == 0) {
+            dis[j] = 1.0;
+            continue;
+        }
+        uint64_t accu_den = popcount_op<OpOr>(x, y, code_size);
+        dis[j] = 1.0 - (float)(accu_num) / (float)(accu_den);
+    }
+}
+
+#else
+
+void
+bvec_hamming_batch_avx(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, int32_t* dis) {
+    FAISS_ASSERT(false);
+}
+
+void
+bvec_jaccard_batch_avx(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, float* dis) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
@@ -0,0 +1,94 @@
+// -*- c++ -*-
+
+#include <faiss/utils/binary_distances_avx512.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#if (defined(__AVX512F__) && defined(__AVX512BW__))
+
+/* VPOPCNTDQ is not part of the AVX512 flags this file is built with, only these functions may
+ * use it and the hook selects them only when the cpu reports it */
+#define FAISS_TARGET_VPOPCNTDQ __attribute__((target("avx512f,avx512bw,avx512vpopcntdq")))
+
+namespace {
+
+/* popcount of x ^ y over n bytes, the tail is read with a masked load */
+FAISS_TARGET_VPOPCNTDQ
+inline uint64_t popcount_xor (const uint8_t* x, const uint8_t* y, size_t n) {
+    __m512i total = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i v = _mm512_xor_si512(_mm512_loadu_si512(x + i), _mm512_loadu_si512(y + i));
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(v));
+    }
+    if (i < n) {
+        __mmask64 mask = (1ULL << (n - i)) - 1;
+        __m512i v = _mm512_xor_si512(_mm512_maskz_loadu_epi8(mask, x + i), _mm512_maskz_loadu_epi8(mask, y + i));
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(v));
+    }
+    return _mm512_reduce_add_epi64(total);
+}
+
+/* popcounts of x & y and x | y over n bytes in one pass */
+FAISS_TARGET_VPOPCNTDQ
+inline void popcount_and_or (const uint8_t* x, const uint8_t* y, size_t n, uint64_t& num, uint64_t& den) {
+    __m512i total_and = _mm512_setzero_si512();
+    __m512i total_or = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i a = _mm512_loadu_si512(x + i);
+        __m512i b = _mm512_loadu_si512(y + i);
+        total_and = _mm512_add_epi64(total_and, _mm512_popcnt_epi64(_mm512_and_si512(a, b)));
+        total_or = _mm512_add_epi64(total_or, _mm512_popcnt_epi64(_mm512_or_si512(a, b)));
+    }
+    if (i < n) {
+        __mmask64 mask = (1ULL << (n - i)) - 1;
+        __m512i a = _mm512_maskz_loadu_epi8(mask, x + i);
+        __m512i b = _mm512_maskz_loadu_epi8(mask, y + i);
+        total_and = _mm512_add_epi64(total_and, _mm512_popcnt_epi64(_mm512_and_si512(a, b)));
+        total_or = _mm512_add_epi64(total_or, _mm512_popcnt_epi64(_mm512_or_si512(a, b)));
+    }
+    num = _mm512_reduce_add_epi64(total_and);
+    den = _mm512_reduce_add_epi64(total_or);
+}
+
+} // namespace
+
+FAISS_TARGET_VPOPCNTDQ
+void
+bvec_hamming_batch_avx512(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, int32_t* dis) {
+    for (size_t j = 0; j < ny; j++, y += code_size) {
+        dis[j] = popcount_xor(x, y, code_size);
+    }
+}
+
+FAISS_TARGET_VPOPCNTDQ
+void
+bvec_jaccard_batch_avx512(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, float* dis) {
+    for (size_t j = 0; j < ny; j++, y += code_size) {
+        uint64_t accu_num, accu_den;
+        popcount_and_or(x, y, code_size, accu_num, accu_den);
+        dis[j] = (accu_num == 0) ? 1.0 : 1.0 - (float)(accu_num) / (float)(accu_den);
+    }
+}
+
+#undef FAISS_TARGET_VPOPCNTDQ
+
+#else
+
+void
+bvec_hamming_batch_avx512(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, int32_t* dis) {
+    FAISS_ASSERT(false);
+}
+
+void
+bvec_jaccard_batch_avx512(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, float* dis) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
@@ -813,7 +813,8 @@ static void range_search_blas (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *result)
+        RangeSearchResult *result,
+        ConcurrentBitsetPtr bitset)
 {
 
     // BLAS does not like empty matrices
@@ -867,6 +868,9 @@ static void range_search_blas (
 
                 for (size_t j = j0; j < j1; j++) {
                     float ip = *ip_line++;
+                    if (bitset && bitset->test(j)) {
+                        continue;
+                    }
                     if (compute_l2) {
                         float dis =  x_norms[i] + y_norms[j] - 2 * ip;
                         if (dis < radius) {
@@ -892,7 +896,8 @@ static void range_search_sse (const float * x,
                 const float * y,
                 size_t d, size_t nx, size_t ny,
                 float radius,
-                RangeSearchResult *res)
+                RangeSearchResult *res,
+                ConcurrentBitsetPtr bitset)
 {
 
 #pragma omp parallel
@@ -907,7 +912,10 @@ static void range_search_sse (const float * x,
 
             RangeQueryResult & qres = pres.new_result (i);
 
-            for (j = 0; j < ny; j++) {
+            for (j = 0; j < ny; j++, y_ += d) {
+                if (bitset && bitset->test(j)) {
+                    continue;
+                }
                 if (compute_l2) {
                     float disij = fvec_L2sqr (x_, y_, d);
                     if (disij < radius) {
@@ -919,7 +927,6 @@ static void range_search_sse (const float * x,
                         qres.add (ip, j);
                     }
                 }
-                y_ += d;
             }
 
         }
@@ -940,13 +947,14 @@ void range_search_L2sqr (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *res)
+        RangeSearchResult *res,
+        ConcurrentBitsetPtr bitset)
 {
 
     if (nx < distance_compute_blas_threshold) {
-        range_search_sse<true> (x, y, d, nx, ny, radius, res);
+        range_search_sse<true> (x, y, d, nx, ny, radius, res, bitset);
     } else {
-        range_search_blas<true> (x, y, d, nx, ny, radius, res);
+        range_search_blas<true> (x, y, d, nx, ny, radius, res, bitset);
     }
 }
 
@@ -955,13 +963,14 @@ void range_search_inner_product (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *res)
+        RangeSearchResult *res,
+        ConcurrentBitsetPtr bitset)
 {
 
     if (nx < distance_compute_blas_threshold) {
-        range_search_sse<false> (x, y, d, nx, ny, radius, res);
+        range_search_sse<false> (x, y, d, nx, ny, radius, res, bitset);
     } else {
-        range_search_blas<false> (x, y, d, nx, ny, radius, res);
+        range_search_blas<false> (x, y, d, nx, ny, radius, res, bitset);
     }
 }
 
@@ -51,6 +51,18 @@ float fvec_jaccard (
         const float * y,
         size_t d);
 
+/// convert n floats to IEEE half precision (round to nearest)
+void fvec_to_fp16_ref (
+        const float * x,
+        uint16_t * y,
+        size_t n);
+
+/// convert n IEEE half precision values to floats
+void fp16_to_fvec_ref (
+        const uint16_t * x,
+        float * y,
+        size_t n);
+
 /** Compute pairwise distances between sets of vectors
  *
  * @param d     dimension of the vectors
@@ -240,7 +252,8 @@ void range_search_L2sqr (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *result);
+        RangeSearchResult *result,
+        ConcurrentBitsetPtr bitset = nullptr);
 
 /// same as range_search_L2sqr for the inner product similarity
 void range_search_inner_product (
@@ -248,7 +261,8 @@ void range_search_inner_product (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *result);
+        RangeSearchResult *result,
+        ConcurrentBitsetPtr bitset = nullptr);
 
 
 /***************************************************************************
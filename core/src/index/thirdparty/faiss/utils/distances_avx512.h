@@ -7,6 +7,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace faiss {
 
@@ -29,4 +30,12 @@ fvec_L1_avx512(const float* x, const float* y, size_t d);
 float
 fvec_Linf_avx512(const float* x, const float* y, size_t d);
 
+/// convert n floats to IEEE half precision (round to nearest)
+void
+fvec_to_fp16_avx512(const float* x, uint16_t* y, size_t n);
+
+/// convert n IEEE half precision values to floats
+void
+fp16_to_fvec_avx512(const uint16_t* x, float* y, size_t n);
+
 } // namespace faiss
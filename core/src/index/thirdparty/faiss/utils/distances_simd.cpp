@@ -9,6 +9,7 @@
 
 #include <faiss/utils/distances.h>
 #include <faiss/FaissHook.h>
+#include <faiss/impl/ScalarQuantizerOp.h>
 
 #include <cstdio>
 #include <cassert>
@@ -124,6 +125,19 @@ void fvec_L2sqr_ny_ref (float * dis,
 }
 
 
+void fvec_to_fp16_ref (const float * x, uint16_t * y, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        y[i] = encode_fp16 (x[i]);
+}
+
+void fp16_to_fvec_ref (const uint16_t * x, float * y, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        y[i] = decode_fp16 (x[i]);
+}
+
+
 
 
 /*********************************************************
@@ -3,6 +3,7 @@
 
 #include <faiss/utils/distances_avx.h>
 #include <faiss/impl/FaissAssert.h>
+#include <faiss/impl/ScalarQuantizerOp.h>
 
 #include <cstdio>
 #include <cassert>
@@ -210,4 +211,33 @@ float fvec_Linf_avx (const float* x, const float* y, size_t d) {
 
 #endif
 
+/* fp16 conversions, tails go through the scalar codec */
+
+void fvec_to_fp16_avx (const float* x, uint16_t* y, size_t n) {
+    size_t i = 0;
+#ifdef __F16C__
+    for (; i + 8 <= n; i += 8) {
+        __m256 mx = _mm256_loadu_ps (x + i);
+        __m128i my = _mm256_cvtps_ph (mx, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128 ((__m128i*)(y + i), my);
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] = encode_fp16 (x[i]);
+    }
+}
+
+void fp16_to_fvec_avx (const uint16_t* x, float* y, size_t n) {
+    size_t i = 0;
+#ifdef __F16C__
+    for (; i + 8 <= n; i += 8) {
+        __m128i mx = _mm_loadu_si128 ((const __m128i*)(x + i));
+        _mm256_storeu_ps (y + i, _mm256_cvtph_ps (mx));
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] = decode_fp16 (x[i]);
+    }
+}
+
 } // namespace faiss
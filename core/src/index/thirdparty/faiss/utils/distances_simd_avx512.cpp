@@ -3,6 +3,7 @@
 
 #include <faiss/utils/distances_avx512.h>
 #include <faiss/impl/FaissAssert.h>
+#include <faiss/impl/ScalarQuantizerOp.h>
 
 #include <cstdio>
 #include <cassert>
@@ -247,4 +248,33 @@ fvec_Linf_avx512(const float* x, const float* y, size_t d) {
 
 #endif
 
+/* fp16 conversions, tails go through the scalar codec */
+
+void fvec_to_fp16_avx512 (const float* x, uint16_t* y, size_t n) {
+    size_t i = 0;
+#ifdef __AVX512F__
+    for (; i + 16 <= n; i += 16) {
+        __m512 mx = _mm512_loadu_ps (x + i);
+        __m256i my = _mm512_cvtps_ph (mx, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm256_storeu_si256 ((__m256i*)(y + i), my);
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] = encode_fp16 (x[i]);
+    }
+}
+
+void fp16_to_fvec_avx512 (const uint16_t* x, float* y, size_t n) {
+    size_t i = 0;
+#ifdef __AVX512F__
+    for (; i + 16 <= n; i += 16) {
+        __m256i mx = _mm256_loadu_si256 ((const __m256i*)(x + i));
+        _mm512_storeu_ps (y + i, _mm512_cvtph_ps (mx));
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] = decode_fp16 (x[i]);
+    }
+}
+
 } // namespace faiss
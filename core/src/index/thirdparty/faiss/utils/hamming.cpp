@@ -25,6 +25,7 @@
 */
 
 #include <faiss/utils/hamming.h>
+#include <faiss/utils/BinaryDistance.h>
 
 #include <vector>
 #include <memory>
@@ -687,7 +688,9 @@ void hammings_knn_hc (
             (32, ha, a, b, nb, order, true, bitset);
         break;
     default:
-        if(ncodes % 8 == 0) {
+        if (ncodes >= binary_batch_min_code_size) {
+            hammings_knn_hc_batch (ha, a, b, nb, ncodes, order, bitset);
+        } else if(ncodes % 8 == 0) {
             hammings_knn_hc<faiss::HammingComputerM8>
                 (ncodes, ha, a, b, nb, order, true, bitset);
         } else {
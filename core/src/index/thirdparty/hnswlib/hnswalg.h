@@ -2,6 +2,7 @@
 
 #include "visited_list_pool.h"
 #include "hnswlib.h"
+#include <algorithm>
 #include <random>
 #include <stdlib.h>
 #include <unordered_set>
@@ -85,6 +86,22 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         }
     };
 
+    typedef std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
+        CandidateQueue;
+
+    // A candidate queue which keeps its storage when cleared
+    class ReusableCandidateQueue : public CandidateQueue {
+     public:
+        void clear() { this->c.clear(); }
+    };
+
+    // Scratch space of searchKnn, kept by the caller to search without allocating once it has grown
+    struct SearchBuffer {
+        ReusableCandidateQueue top_candidates;
+        ReusableCandidateQueue candidate_set;
+        std::vector<std::pair<dist_t, labeltype>> result;
+    };
+
     ~HierarchicalNSW() {
 
         free(data_level0_memory_);
@@ -253,13 +270,21 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
     template <bool has_deletions>
     std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
     searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef, faiss::ConcurrentBitsetPtr bitset) const {
+        CandidateQueue top_candidates;
+        CandidateQueue candidate_set;
+        searchBaseLayerST<has_deletions>(ep_id, data_point, ef, bitset, top_candidates, candidate_set);
+        return top_candidates;
+    }
+
+    // top_candidates and candidate_set are expected to be empty
+    template <bool has_deletions>
+    void
+    searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef, const faiss::ConcurrentBitsetPtr& bitset,
+                      CandidateQueue &top_candidates, CandidateQueue &candidate_set) const {
         VisitedList *vl = visited_list_pool_->getFreeVisitedList();
         vl_type *visited_array = vl->mass;
         vl_type visited_array_tag = vl->curV;
 
-        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
-        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidate_set;
-
         dist_t lowerBound;
 //        if (!has_deletions || !isMarkedDeleted(ep_id)) {
           if (!has_deletions || !bitset->test((faiss::ConcurrentBitset::id_type_t)getExternalLabel(ep_id))) {
@@ -333,7 +358,6 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         }
 
         visited_list_pool_->releaseVisitedList(vl);
-        return top_candidates;
     }
 
     void getNeighborsByHeuristic2(
@@ -585,6 +609,108 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
     }
 
+    /**
+     * Re-label the graph and drop the nodes which are not kept, so that the graph can be extended by addPoint().
+     * new_labels[old_label] is the new label of the node, a negative value means the node is dropped.
+     * Links to dropped nodes are removed, the remaining links of the kept nodes are not repaired.
+     * @param new_labels
+     * @param new_max_elements capacity after compaction, must be no less than the number of kept nodes
+     */
+    void relabelAndCompact(const std::vector<int64_t>& new_labels, size_t new_max_elements) {
+        // map old internal id to new internal id, kept nodes preserve their relative order
+        std::vector<int64_t> new_internal(cur_element_count, -1);
+        size_t kept_count = 0;
+        for (tableint i = 0; i < cur_element_count; i++) {
+            labeltype label = getExternalLabel(i);
+            if (label < new_labels.size() && new_labels[label] >= 0) {
+                new_internal[i] = kept_count++;
+            }
+        }
+        if (new_max_elements < kept_count)
+            throw std::runtime_error("Cannot compact, max element is less than the number of kept elements");
+
+        // keep the old entry point if it survives, otherwise pick a node on the highest remaining level
+        int64_t enterpoint_new = -1;
+        int maxlevel_new = -1;
+        if (kept_count > 0 && new_internal[enterpoint_node_] >= 0) {
+            enterpoint_new = new_internal[enterpoint_node_];
+            maxlevel_new = maxlevel_;
+        } else {
+            for (tableint i = 0; i < cur_element_count; i++) {
+                if (new_internal[i] >= 0 && element_levels_[i] > maxlevel_new) {
+                    enterpoint_new = new_internal[i];
+                    maxlevel_new = element_levels_[i];
+                }
+            }
+        }
+
+        char *data_level0_memory_new = (char *) malloc(new_max_elements * size_data_per_element_);
+        if (data_level0_memory_new == nullptr)
+            throw std::runtime_error("Not enough memory: relabelAndCompact failed to allocate base layer");
+        char **linkLists_new = (char **) calloc(new_max_elements, sizeof(void *));
+        if (linkLists_new == nullptr) {
+            free(data_level0_memory_new);
+            throw std::runtime_error("Not enough memory: relabelAndCompact failed to allocate other layers");
+        }
+
+        auto remap_links = [&](linklistsizeint *ll) {
+            size_t size = getListCount(ll);
+            tableint *links = (tableint *) (ll + 1);
+            size_t count = 0;
+            for (size_t j = 0; j < size; j++) {
+                int64_t to = new_internal[links[j]];
+                if (to >= 0) {
+                    links[count++] = (tableint) to;
+                }
+            }
+            setListCount(ll, count);
+        };
+
+        std::vector<int> element_levels_new(new_max_elements, 0);
+        label_lookup_.clear();
+        for (tableint i = 0; i < cur_element_count; i++) {
+            int64_t to = new_internal[i];
+            if (to < 0) {
+                if (element_levels_[i] > 0)
+                    free(linkLists_[i]);
+                continue;
+            }
+
+            char *dst = data_level0_memory_new + to * size_data_per_element_;
+            memcpy(dst, data_level0_memory_ + i * size_data_per_element_, size_data_per_element_);
+            labeltype label = new_labels[getExternalLabel(i)];
+            memcpy(dst + label_offset_, &label, sizeof(labeltype));
+            label_lookup_[label] = to;
+
+            remap_links(get_linklist0(to, data_level0_memory_new));
+            for (int level = 1; level <= element_levels_[i]; level++) {
+                remap_links(get_linklist(i, level));
+            }
+            linkLists_new[to] = element_levels_[i] > 0 ? linkLists_[i] : nullptr;
+            element_levels_new[to] = element_levels_[i];
+        }
+
+        free(data_level0_memory_);
+        free(linkLists_);
+        data_level0_memory_ = data_level0_memory_new;
+        linkLists_ = linkLists_new;
+        element_levels_.swap(element_levels_new);
+        std::vector<std::mutex>(new_max_elements).swap(link_list_locks_);
+        delete visited_list_pool_;
+        visited_list_pool_ = new VisitedListPool(1, new_max_elements);
+
+        enterpoint_node_ = enterpoint_new;
+        maxlevel_ = maxlevel_new;
+        cur_element_count = kept_count;
+        max_elements_ = new_max_elements;
+
+        has_deletions_ = false;
+        for (size_t i = 0; i < cur_element_count; i++) {
+            if (isMarkedDeleted(i))
+                has_deletions_ = true;
+        }
+    }
+
     void saveIndex(milvus::knowhere::MemoryIOWriter& output) {
         // write l2/ip calculator
         writeBinaryPOD(output, metric_type_);
@@ -1059,11 +1185,8 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         return cur_c;
     };
 
-    std::priority_queue<std::pair<dist_t, labeltype >>
-    searchKnn(const void *query_data, size_t k, faiss::ConcurrentBitsetPtr bitset) const {
-        std::priority_queue<std::pair<dist_t, labeltype >> result;
-        if (cur_element_count == 0) return result;
-
+    // greedy search from the enter point down to level 1, returns the element to start the level 0 search from
+    tableint searchUpperLevels(const void *query_data) const {
         tableint currObj = enterpoint_node_;
         dist_t curdist = fstdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
 
@@ -1091,6 +1214,16 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
             }
         }
 
+        return currObj;
+    }
+
+    std::priority_queue<std::pair<dist_t, labeltype >>
+    searchKnn(const void *query_data, size_t k, faiss::ConcurrentBitsetPtr bitset) const {
+        std::priority_queue<std::pair<dist_t, labeltype >> result;
+        if (cur_element_count == 0) return result;
+
+        tableint currObj = searchUpperLevels(query_data);
+
         std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
         if (bitset != nullptr) {
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
@@ -1113,6 +1246,36 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         return result;
     };
 
+    // buffer.result is set to the k nearest elements, in ascending order of distance
+    void
+    searchKnn(const void *query_data, size_t k, const faiss::ConcurrentBitsetPtr& bitset, SearchBuffer& buffer) const {
+        auto& result = buffer.result;
+        result.clear();
+        if (cur_element_count == 0) return;
+
+        tableint currObj = searchUpperLevels(query_data);
+
+        auto& top_candidates = buffer.top_candidates;
+        top_candidates.clear();
+        buffer.candidate_set.clear();
+        if (bitset != nullptr) {
+            searchBaseLayerST<true>(currObj, query_data, std::max(ef_, k), bitset, top_candidates,
+                                    buffer.candidate_set);
+        } else {
+            searchBaseLayerST<false>(currObj, query_data, std::max(ef_, k), bitset, top_candidates,
+                                     buffer.candidate_set);
+        }
+        while (top_candidates.size() > k) {
+            top_candidates.pop();
+        }
+        while (top_candidates.size() > 0) {
+            std::pair<dist_t, tableint> rez = top_candidates.top();
+            result.emplace_back(rez.first, getExternalLabel(rez.second));
+            top_candidates.pop();
+        }
+        std::reverse(result.begin(), result.end());
+    }
+
     template <typename Comp>
     std::vector<std::pair<dist_t, labeltype>>
     searchKnn(const void* query_data, size_t k, Comp comp, faiss::ConcurrentBitsetPtr bitset) {
@@ -1131,6 +1294,67 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         return result;
     }
 
+    // All elements with distance < radius to the query, unordered. The level 0 search with ef finds the seeds,
+    // then the neighbors of every element within radius are expanded until no new element falls within radius.
+    // Deleted elements are expanded but not returned.
+    std::vector<std::pair<dist_t, labeltype>>
+    searchRange(const void *query_data, dist_t radius, faiss::ConcurrentBitsetPtr bitset) const {
+        std::vector<std::pair<dist_t, labeltype>> result;
+        if (cur_element_count == 0) return result;
+
+        tableint currObj = searchUpperLevels(query_data);
+
+        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
+        if (bitset != nullptr) {
+            std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
+                top_candidates1 = searchBaseLayerST<true>(currObj, query_data, ef_, bitset);
+            top_candidates.swap(top_candidates1);
+        } else {
+            std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
+                top_candidates1 = searchBaseLayerST<false>(currObj, query_data, ef_, bitset);
+            top_candidates.swap(top_candidates1);
+        }
+
+        VisitedList *vl = visited_list_pool_->getFreeVisitedList();
+        vl_type *visited_array = vl->mass;
+        vl_type visited_array_tag = vl->curV;
+
+        std::vector<tableint> frontier;
+        while (!top_candidates.empty()) {
+            std::pair<dist_t, tableint> rez = top_candidates.top();
+            if (rez.first < radius) {
+                visited_array[rez.second] = visited_array_tag;
+                frontier.push_back(rez.second);
+                result.emplace_back(rez.first, getExternalLabel(rez.second));
+            }
+            top_candidates.pop();
+        }
+
+        while (!frontier.empty()) {
+            tableint current_node_id = frontier.back();
+            frontier.pop_back();
+
+            int *data = (int *) get_linklist0(current_node_id);
+            size_t size = getListCount((linklistsizeint*)data);
+            for (size_t j = 1; j <= size; j++) {
+                tableint candidate_id = *(data + j);
+                if (visited_array[candidate_id] == visited_array_tag) continue;
+                visited_array[candidate_id] = visited_array_tag;
+
+                dist_t dist = fstdistfunc_(query_data, getDataByInternalId(candidate_id), dist_func_param_);
+                if (dist < radius) {
+                    frontier.push_back(candidate_id);
+                    labeltype label = getExternalLabel(candidate_id);
+                    if (bitset == nullptr || !bitset->test((faiss::ConcurrentBitset::id_type_t)label))
+                        result.emplace_back(dist, label);
+                }
+            }
+        }
+
+        visited_list_pool_->releaseVisitedList(vl);
+        return result;
+    }
+
     int64_t cal_size() {
         int64_t ret = 0;
         ret += sizeof(*this);
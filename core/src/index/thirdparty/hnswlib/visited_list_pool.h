@@ -2,7 +2,7 @@
 
 #include <mutex>
 #include <string.h>
-#include <deque>
+#include <vector>
 
 namespace hnswlib {
 typedef unsigned short int vl_type;
@@ -38,7 +38,7 @@ class VisitedList {
 /////////////////////////////////////////////////////////
 
 class VisitedListPool {
-    std::deque<VisitedList *> pool;
+    std::vector<VisitedList *> pool;  // a deque would free and allocate blocks as it empties and refills
     std::mutex poolguard;
     int numelements;
 
@@ -46,7 +46,7 @@ class VisitedListPool {
     VisitedListPool(int initmaxpools, int numelements1) {
         numelements = numelements1;
         for (int i = 0; i < initmaxpools; i++)
-            pool.push_front(new VisitedList(numelements));
+            pool.push_back(new VisitedList(numelements));
     }
 
     VisitedList *getFreeVisitedList() {
@@ -54,8 +54,8 @@ class VisitedListPool {
         {
             std::unique_lock <std::mutex> lock(poolguard);
             if (pool.size() > 0) {
-                rez = pool.front();
-                pool.pop_front();
+                rez = pool.back();
+                pool.pop_back();
             } else {
                 rez = new VisitedList(numelements);
             }
@@ -66,13 +66,13 @@ class VisitedListPool {
 
     void releaseVisitedList(VisitedList *vl) {
         std::unique_lock <std::mutex> lock(poolguard);
-        pool.push_front(vl);
+        pool.push_back(vl);
     };
 
     ~VisitedListPool() {
         while (pool.size()) {
-            VisitedList *rez = pool.front();
-            pool.pop_front();
+            VisitedList *rez = pool.back();
+            pool.pop_back();
             delete rez;
         }
     };
@@ -0,0 +1,777 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <omp.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "easyloggingpp/easylogging++.h"
+#include "knowhere/common/Config.h"
+#include "knowhere/index/vector_index/ConfAdapterMgr.h"
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+/*
+ * milvus_ann_bench drives every index type registered in VecIndexFactory through the knowhere::VecIndex API,
+ * following the same path as the server: ConfAdapter check -> BuildAll -> Serialize -> Load -> Query.
+ * Vectors are read from fvecs/bvecs files or generated as gaussian clusters, binary indexes search a
+ * sign-quantized copy of the same vectors. Results are written as JSON, see README.md for usage.
+ */
+
+namespace {
+
+namespace kn = milvus::knowhere;
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string base_file;
+    std::string query_file;
+    std::string config_file;
+    std::string output_file;
+    std::vector<std::string> index_types;
+    std::string metric = kn::Metric::L2;
+    std::string binary_metric = kn::Metric::HAMMING;
+    int64_t nb = 100000;
+    int64_t nq = 1000;
+    int64_t dim = 128;
+    int64_t clusters = 64;
+    int64_t topk = 10;
+    int64_t batch = 1;
+    int64_t threads = 0;
+    uint32_t seed = 42;
+};
+
+struct VectorSet {
+    int64_t rows = 0;
+    int64_t dim = 0;
+    std::vector<float> data;
+};
+
+struct BinaryVectorSet {
+    int64_t rows = 0;
+    int64_t dim = 0;  // in bits
+    std::vector<uint8_t> data;
+};
+
+double
+ElapsedMs(const Clock::time_point& start, const Clock::time_point& end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+bool
+EndsWith(const std::string& str, const std::string& suffix) {
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::vector<std::string>
+SplitList(const std::string& str) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= str.size()) {
+        size_t end = str.find(',', start);
+        if (end == std::string::npos) {
+            end = str.size();
+        }
+        if (end > start) {
+            items.emplace_back(str.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return items;
+}
+
+std::vector<std::string>
+AllIndexTypes() {
+    return {
+        kn::IndexEnum::INDEX_FAISS_IDMAP,
+        kn::IndexEnum::INDEX_FAISS_IVFFLAT,
+        kn::IndexEnum::INDEX_FAISS_IVFPQ,
+        kn::IndexEnum::INDEX_FAISS_IVFSQ8,
+        kn::IndexEnum::INDEX_FAISS_BIN_IDMAP,
+        kn::IndexEnum::INDEX_FAISS_BIN_IVFFLAT,
+        kn::IndexEnum::INDEX_NSG,
+        kn::IndexEnum::INDEX_HNSW,
+        kn::IndexEnum::INDEX_RHNSWFlat,
+        kn::IndexEnum::INDEX_RHNSWPQ,
+        kn::IndexEnum::INDEX_RHNSWSQ,
+        kn::IndexEnum::INDEX_ANNOY,
+        kn::IndexEnum::INDEX_NGTPANNG,
+        kn::IndexEnum::INDEX_NGTONNG,
+#ifdef MILVUS_SUPPORT_SPTAG
+        kn::IndexEnum::INDEX_SPTAG_KDT_RNT,
+        kn::IndexEnum::INDEX_SPTAG_BKT_RNT,
+#endif
+    };
+}
+
+bool
+IsBinaryIndex(const std::string& type) {
+    return type == kn::IndexEnum::INDEX_FAISS_BIN_IDMAP || type == kn::IndexEnum::INDEX_FAISS_BIN_IVFFLAT;
+}
+
+// offset indexes do not keep raw vectors in the index file, the raw data is appended when loading
+bool
+IsOffsetIndex(const std::string& type) {
+    return type == kn::IndexEnum::INDEX_FAISS_IVFFLAT || type == kn::IndexEnum::INDEX_NSG;
+}
+
+// largest sub-quantizer count not above 32 that divides the dimension
+int64_t
+PickPQM(int64_t dim) {
+    for (int64_t m : {32, 16, 8, 4, 2}) {
+        if (dim % m == 0) {
+            return m;
+        }
+    }
+    return 1;
+}
+
+kn::Config
+DefaultSweep(const std::string& type, int64_t nb, int64_t dim, int64_t topk) {
+    int64_t nlist = std::max<int64_t>(1, std::min<int64_t>(4096, 4 * static_cast<int64_t>(std::sqrt(nb))));
+    kn::Config build = kn::Config::array();
+    kn::Config search = kn::Config::array();
+
+    if (type == kn::IndexEnum::INDEX_FAISS_IVFFLAT || type == kn::IndexEnum::INDEX_FAISS_IVFSQ8 ||
+        type == kn::IndexEnum::INDEX_FAISS_BIN_IVFFLAT) {
+        build.push_back({{kn::IndexParams::nlist, nlist}});
+    } else if (type == kn::IndexEnum::INDEX_FAISS_IVFPQ) {
+        build.push_back({{kn::IndexParams::nlist, nlist}, {kn::IndexParams::m, PickPQM(dim)}});
+    } else if (type == kn::IndexEnum::INDEX_NSG) {
+        build.push_back({{kn::IndexParams::knng, 30},
+                         {kn::IndexParams::search_length, 40},
+                         {kn::IndexParams::out_degree, 30},
+                         {kn::IndexParams::candidate, 100}});
+    } else if (type == kn::IndexEnum::INDEX_HNSW || type == kn::IndexEnum::INDEX_RHNSWFlat ||
+               type == kn::IndexEnum::INDEX_RHNSWSQ) {
+        build.push_back({{kn::IndexParams::M, 16}, {kn::IndexParams::efConstruction, 200}});
+        build.push_back({{kn::IndexParams::M, 32}, {kn::IndexParams::efConstruction, 200}});
+    } else if (type == kn::IndexEnum::INDEX_RHNSWPQ) {
+        build.push_back({{kn::IndexParams::M, 16},
+                         {kn::IndexParams::efConstruction, 200},
+                         {kn::IndexParams::PQM, PickPQM(dim)}});
+    } else if (type == kn::IndexEnum::INDEX_ANNOY) {
+        build.push_back({{kn::IndexParams::n_trees, 8}});
+        build.push_back({{kn::IndexParams::n_trees, 32}});
+    } else if (type == kn::IndexEnum::INDEX_NGTPANNG) {
+        build.push_back({{kn::IndexParams::edge_size, 20},
+                         {kn::IndexParams::forcedly_pruned_edge_size, 60},
+                         {kn::IndexParams::selectively_pruned_edge_size, 30}});
+    } else if (type == kn::IndexEnum::INDEX_NGTONNG) {
+        build.push_back({{kn::IndexParams::edge_size, 20},
+                         {kn::IndexParams::outgoing_edge_size, 5},
+                         {kn::IndexParams::incoming_edge_size, 40}});
+    } else {
+        build.push_back(kn::Config::object());
+    }
+
+    if (type == kn::IndexEnum::INDEX_FAISS_IVFFLAT || type == kn::IndexEnum::INDEX_FAISS_IVFSQ8 ||
+        type == kn::IndexEnum::INDEX_FAISS_IVFPQ || type == kn::IndexEnum::INDEX_FAISS_BIN_IVFFLAT) {
+        for (int64_t nprobe : {1, 8, 32, 128}) {
+            search.push_back({{kn::IndexParams::nprobe, std::min(nprobe, nlist)}});
+        }
+    } else if (type == kn::IndexEnum::INDEX_NSG) {
+        for (int64_t search_length : {20, 40, 80, 160}) {
+            search.push_back({{kn::IndexParams::search_length, std::max(search_length, topk)}});
+        }
+    } else if (type == kn::IndexEnum::INDEX_HNSW || type == kn::IndexEnum::INDEX_RHNSWFlat ||
+               type == kn::IndexEnum::INDEX_RHNSWSQ || type == kn::IndexEnum::INDEX_RHNSWPQ) {
+        for (int64_t ef : {16, 32, 64, 128, 256}) {
+            search.push_back({{kn::IndexParams::ef, std::max(ef, topk)}});
+        }
+    } else if (type == kn::IndexEnum::INDEX_ANNOY) {
+        for (int64_t search_k : {100, 1000, 10000}) {
+            search.push_back({{kn::IndexParams::search_k, search_k}});
+        }
+    } else {
+        search.push_back(kn::Config::object());
+    }
+
+    return kn::Config{{"build", build}, {"search", search}};
+}
+
+// .fvecs and .bvecs: every vector is stored as an int32 dimension followed by float or uint8 components
+bool
+ReadVecs(const std::string& path, int64_t max_rows, VectorSet& vectors) {
+    bool is_bvecs = EndsWith(path, ".bvecs");
+    if (!is_bvecs && !EndsWith(path, ".fvecs")) {
+        std::cerr << "unsupported vector file: " << path << ", expect .fvecs or .bvecs" << std::endl;
+        return false;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "cannot open vector file: " << path << std::endl;
+        return false;
+    }
+
+    size_t elem_size = is_bvecs ? sizeof(uint8_t) : sizeof(float);
+    std::vector<char> row;
+    int32_t dim = 0;
+    while ((max_rows <= 0 || vectors.rows < max_rows) && in.read(reinterpret_cast<char*>(&dim), sizeof(dim))) {
+        if (dim <= 0 || (vectors.dim != 0 && dim != vectors.dim)) {
+            std::cerr << "invalid dimension " << dim << " in " << path << std::endl;
+            return false;
+        }
+        vectors.dim = dim;
+        row.resize(dim * elem_size);
+        if (!in.read(row.data(), row.size())) {
+            std::cerr << "truncated vector file: " << path << std::endl;
+            return false;
+        }
+
+        size_t offset = vectors.data.size();
+        vectors.data.resize(offset + dim);
+        if (is_bvecs) {
+            for (int32_t i = 0; i < dim; ++i) {
+                vectors.data[offset + i] = static_cast<uint8_t>(row[i]);
+            }
+        } else {
+            memcpy(vectors.data.data() + offset, row.data(), row.size());
+        }
+        ++vectors.rows;
+    }
+
+    return vectors.rows > 0;
+}
+
+// gaussian blobs around uniformly distributed centroids, base and query vectors share the same centroids
+void
+GenClusteredData(const Options& options, VectorSet& base, VectorSet& query) {
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<float> centroid_dist(-1.0f, 1.0f);
+    std::normal_distribution<float> noise_dist(0.0f, 0.1f);
+
+    int64_t dim = options.dim;
+    int64_t clusters = std::max<int64_t>(1, options.clusters);
+    std::vector<float> centroids(clusters * dim);
+    for (auto& value : centroids) {
+        value = centroid_dist(rng);
+    }
+
+    std::uniform_int_distribution<int64_t> cluster_dist(0, clusters - 1);
+    auto generate = [&](int64_t rows, VectorSet& vectors) {
+        vectors.rows = rows;
+        vectors.dim = dim;
+        vectors.data.resize(rows * dim);
+        for (int64_t i = 0; i < rows; ++i) {
+            const float* centroid = centroids.data() + cluster_dist(rng) * dim;
+            for (int64_t j = 0; j < dim; ++j) {
+                vectors.data[i * dim + j] = centroid[j] + noise_dist(rng);
+            }
+        }
+    };
+    generate(options.nb, base);
+    generate(options.nq, query);
+}
+
+void
+Normalize(VectorSet& vectors) {
+    for (int64_t i = 0; i < vectors.rows; ++i) {
+        float* vector = vectors.data.data() + i * vectors.dim;
+        double norm = 0;
+        for (int64_t j = 0; j < vectors.dim; ++j) {
+            norm += vector[j] * vector[j];
+        }
+        if (norm > 0) {
+            float scale = static_cast<float>(1.0 / std::sqrt(norm));
+            for (int64_t j = 0; j < vectors.dim; ++j) {
+                vector[j] *= scale;
+            }
+        }
+    }
+}
+
+// one bit per dimension: set when the component is above the per-dimension mean of the base vectors
+void
+Binarize(const VectorSet& vectors, const std::vector<float>& means, BinaryVectorSet& binary) {
+    int64_t code_size = (vectors.dim + 7) / 8;
+    binary.rows = vectors.rows;
+    binary.dim = code_size * 8;
+    binary.data.assign(vectors.rows * code_size, 0);
+    for (int64_t i = 0; i < vectors.rows; ++i) {
+        const float* vector = vectors.data.data() + i * vectors.dim;
+        uint8_t* code = binary.data.data() + i * code_size;
+        for (int64_t j = 0; j < vectors.dim; ++j) {
+            if (vector[j] > means[j]) {
+                code[j / 8] |= static_cast<uint8_t>(1 << (j % 8));
+            }
+        }
+    }
+}
+
+class Benchmark {
+ public:
+    explicit Benchmark(const Options& options) : options_(options) {
+    }
+
+    bool
+    Prepare(kn::Config& dataset_info);
+
+    kn::Config
+    Run(const std::string& type, const kn::Config& sweep);
+
+ private:
+    struct Data {
+        int64_t rows = 0;
+        int64_t dim = 0;
+        const void* vectors = nullptr;
+        size_t vector_size = 0;  // bytes per vector
+    };
+
+    Data
+    BaseData(bool binary) const;
+
+    Data
+    QueryData(bool binary) const;
+
+    bool
+    GroundTruth(bool binary, std::vector<int64_t>& ids);
+
+    kn::Config
+    RunBuild(const std::string& type, kn::Config build_conf, const kn::Config& search_sweep);
+
+    kn::Config
+    RunSearch(const kn::VecIndexPtr& index, const std::string& type, kn::Config search_conf,
+              const std::vector<int64_t>& gt_ids);
+
+ private:
+    Options options_;
+    VectorSet base_;
+    VectorSet query_;
+    BinaryVectorSet binary_base_;
+    BinaryVectorSet binary_query_;
+    std::vector<int64_t> ids_;
+    std::vector<int64_t> gt_ids_;
+    std::vector<int64_t> binary_gt_ids_;
+};
+
+bool
+Benchmark::Prepare(kn::Config& dataset_info) {
+    if (!options_.base_file.empty()) {
+        if (options_.query_file.empty()) {
+            std::cerr << "--query is required with --base" << std::endl;
+            return false;
+        }
+        if (!ReadVecs(options_.base_file, options_.nb, base_) || !ReadVecs(options_.query_file, options_.nq, query_)) {
+            return false;
+        }
+        if (base_.dim != query_.dim) {
+            std::cerr << "base dimension " << base_.dim << " and query dimension " << query_.dim << " mismatch"
+                      << std::endl;
+            return false;
+        }
+        dataset_info["source"] = options_.base_file;
+    } else {
+        GenClusteredData(options_, base_, query_);
+        dataset_info["source"] = "synthetic";
+        dataset_info["clusters"] = options_.clusters;
+        dataset_info["seed"] = options_.seed;
+    }
+
+    if (options_.metric == kn::Metric::IP) {
+        Normalize(base_);
+        Normalize(query_);
+    }
+
+    std::vector<float> means(base_.dim, 0.0f);
+    for (int64_t i = 0; i < base_.rows; ++i) {
+        for (int64_t j = 0; j < base_.dim; ++j) {
+            means[j] += base_.data[i * base_.dim + j] / base_.rows;
+        }
+    }
+    Binarize(base_, means, binary_base_);
+    Binarize(query_, means, binary_query_);
+
+    ids_.resize(base_.rows);
+    for (int64_t i = 0; i < base_.rows; ++i) {
+        ids_[i] = i;
+    }
+
+    dataset_info["nb"] = base_.rows;
+    dataset_info["nq"] = query_.rows;
+    dataset_info["dim"] = base_.dim;
+    dataset_info["metric"] = options_.metric;
+    dataset_info["binary_metric"] = options_.binary_metric;
+    dataset_info["topk"] = options_.topk;
+    dataset_info["batch"] = options_.batch;
+    dataset_info["threads"] = omp_get_max_threads();
+    return true;
+}
+
+Benchmark::Data
+Benchmark::BaseData(bool binary) const {
+    if (binary) {
+        return Data{binary_base_.rows, binary_base_.dim, binary_base_.data.data(),
+                    static_cast<size_t>(binary_base_.dim / 8)};
+    }
+    return Data{base_.rows, base_.dim, base_.data.data(), base_.dim * sizeof(float)};
+}
+
+Benchmark::Data
+Benchmark::QueryData(bool binary) const {
+    if (binary) {
+        return Data{binary_query_.rows, binary_query_.dim, binary_query_.data.data(),
+                    static_cast<size_t>(binary_query_.dim / 8)};
+    }
+    return Data{query_.rows, query_.dim, query_.data.data(), query_.dim * sizeof(float)};
+}
+
+// exact top k computed by the brute force index of the same metric, computed once and shared by all index types
+bool
+Benchmark::GroundTruth(bool binary, std::vector<int64_t>& ids) {
+    auto& cached = binary ? binary_gt_ids_ : gt_ids_;
+    if (cached.empty()) {
+        auto base = BaseData(binary);
+        auto query = QueryData(binary);
+        auto type = binary ? kn::IndexEnum::INDEX_FAISS_BIN_IDMAP : kn::IndexEnum::INDEX_FAISS_IDMAP;
+        kn::Config conf{{kn::meta::DIM, base.dim},
+                        {kn::meta::TOPK, options_.topk},
+                        {kn::Metric::TYPE, binary ? options_.binary_metric : options_.metric}};
+        try {
+            auto index = kn::VecIndexFactory::GetInstance().CreateVecIndex(type, kn::IndexMode::MODE_CPU);
+            index->BuildAll(kn::GenDatasetWithIds(base.rows, base.dim, base.vectors, ids_.data()), conf);
+            auto result = index->Query(kn::GenDataset(query.rows, query.dim, query.vectors), conf);
+            auto res_ids = result->Get<int64_t*>(kn::meta::IDS);
+            auto res_dist = result->Get<float*>(kn::meta::DISTANCE);
+            cached.assign(res_ids, res_ids + query.rows * options_.topk);
+            free(res_ids);
+            free(res_dist);
+        } catch (std::exception& ex) {
+            std::cerr << "failed to compute ground truth: " << ex.what() << std::endl;
+            return false;
+        }
+    }
+    ids = cached;
+    return true;
+}
+
+kn::Config
+Benchmark::Run(const std::string& type, const kn::Config& sweep) {
+    kn::Config report{{"index_type", type}, {"runs", kn::Config::array()}};
+    if (!sweep.contains("build") || !sweep.contains("search")) {
+        report["error"] = "sweep must contain 'build' and 'search' arrays";
+        return report;
+    }
+    for (auto& build_conf : sweep["build"]) {
+        std::cerr << "benchmark " << type << " " << build_conf.dump() << std::endl;
+        report["runs"].push_back(RunBuild(type, build_conf, sweep["search"]));
+    }
+    return report;
+}
+
+kn::Config
+Benchmark::RunBuild(const std::string& type, kn::Config build_conf, const kn::Config& search_sweep) {
+    bool binary = IsBinaryIndex(type);
+    auto base = BaseData(binary);
+    kn::Config run{{"build_params", build_conf}};
+
+    std::vector<int64_t> gt_ids;
+    if (!GroundTruth(binary, gt_ids)) {
+        run["error"] = "ground truth unavailable";
+        return run;
+    }
+
+    build_conf[kn::meta::DIM] = base.dim;
+    build_conf[kn::meta::ROWS] = base.rows;
+    build_conf[kn::meta::DEVICEID] = -1;
+    build_conf[kn::Metric::TYPE] = binary ? options_.binary_metric : options_.metric;
+
+    try {
+        auto adapter = kn::AdapterMgr::GetInstance().GetAdapter(type);
+        if (!adapter->CheckTrain(build_conf, kn::IndexMode::MODE_CPU)) {
+            run["error"] = "illegal build params";
+            return run;
+        }
+        run["effective_build_params"] = build_conf;
+
+        auto& factory = kn::VecIndexFactory::GetInstance();
+        auto index = factory.CreateVecIndex(type, kn::IndexMode::MODE_CPU);
+        if (index == nullptr) {
+            run["error"] = "index type not supported by VecIndexFactory";
+            return run;
+        }
+
+        auto start = Clock::now();
+        index->BuildAll(kn::GenDatasetWithIds(base.rows, base.dim, base.vectors, ids_.data()), build_conf);
+        run["build_time_ms"] = ElapsedMs(start, Clock::now());
+
+        // search the index the way the server does: serialize, then load it into a fresh instance
+        auto binary_set = index->Serialize(build_conf);
+        index = nullptr;
+        int64_t file_size = 0;
+        for (auto& pair : binary_set.binary_map_) {
+            file_size += pair.second->size;
+        }
+        run["index_file_size"] = file_size;
+
+        if (IsOffsetIndex(type)) {
+            auto raw_data = std::make_shared<kn::Binary>();
+            raw_data->size = base.rows * base.vector_size;
+            raw_data->data = std::shared_ptr<uint8_t[]>(
+                reinterpret_cast<uint8_t*>(const_cast<void*>(base.vectors)), [](uint8_t*) {});
+            binary_set.Append(RAW_DATA, raw_data);
+        }
+
+        start = Clock::now();
+        index = factory.CreateVecIndex(type, kn::IndexMode::MODE_CPU);
+        index->Load(binary_set);
+        index->UpdateIndexSize();
+        run["load_time_ms"] = ElapsedMs(start, Clock::now());
+        try {
+            run["index_size"] = index->IndexSize();
+        } catch (std::exception&) {
+            run["index_size"] = file_size;  // index types without a size estimation
+        }
+
+        run["searches"] = kn::Config::array();
+        for (auto& search_conf : search_sweep) {
+            run["searches"].push_back(RunSearch(index, type, search_conf, gt_ids));
+        }
+    } catch (std::exception& ex) {
+        run["error"] = ex.what();
+    }
+
+    return run;
+}
+
+kn::Config
+Benchmark::RunSearch(const kn::VecIndexPtr& index, const std::string& type, kn::Config search_conf,
+                     const std::vector<int64_t>& gt_ids) {
+    bool binary = IsBinaryIndex(type);
+    auto query = QueryData(binary);
+    int64_t topk = options_.topk;
+    int64_t batch = std::max<int64_t>(1, options_.batch);
+    kn::Config search{{"search_params", search_conf}};
+
+    search_conf[kn::meta::DIM] = query.dim;
+    search_conf[kn::meta::TOPK] = topk;
+    search_conf[kn::Metric::TYPE] = binary ? options_.binary_metric : options_.metric;
+    auto adapter = kn::AdapterMgr::GetInstance().GetAdapter(type);
+    if (!adapter->CheckSearch(search_conf, type, kn::IndexMode::MODE_CPU)) {
+        search["error"] = "illegal search params";
+        return search;
+    }
+
+    std::vector<int64_t> result_ids(query.rows * topk, -1);
+    std::vector<double> latencies;
+    auto search_batch = [&](int64_t offset, int64_t rows) {
+        auto vectors = static_cast<const uint8_t*>(query.vectors) + offset * query.vector_size;
+        auto result = index->Query(kn::GenDataset(rows, query.dim, vectors), search_conf);
+        auto res_ids = result->Get<int64_t*>(kn::meta::IDS);
+        auto res_dist = result->Get<float*>(kn::meta::DISTANCE);
+        memcpy(result_ids.data() + offset * topk, res_ids, rows * topk * sizeof(int64_t));
+        free(res_ids);
+        free(res_dist);
+    };
+
+    try {
+        search_batch(0, std::min(batch, query.rows));  // warm up
+
+        auto total_start = Clock::now();
+        for (int64_t offset = 0; offset < query.rows; offset += batch) {
+            int64_t rows = std::min(batch, query.rows - offset);
+            auto start = Clock::now();
+            search_batch(offset, rows);
+            latencies.push_back(ElapsedMs(start, Clock::now()));
+        }
+        double total_ms = ElapsedMs(total_start, Clock::now());
+        search["qps"] = total_ms > 0 ? query.rows * 1000.0 / total_ms : 0.0;
+    } catch (std::exception& ex) {
+        search["error"] = ex.what();
+        return search;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        auto rank = static_cast<size_t>(std::ceil(p * latencies.size()));
+        return latencies[std::min(latencies.size(), std::max<size_t>(rank, 1)) - 1];
+    };
+    search["latency_p50_ms"] = percentile(0.5);
+    search["latency_p99_ms"] = percentile(0.99);
+
+    int64_t hits = 0;
+    for (int64_t i = 0; i < query.rows; ++i) {
+        std::unordered_set<int64_t> expected(gt_ids.begin() + i * topk, gt_ids.begin() + (i + 1) * topk);
+        expected.erase(-1);
+        for (int64_t j = 0; j < topk; ++j) {
+            auto id = result_ids[i * topk + j];
+            if (id != -1 && expected.erase(id) > 0) {
+                ++hits;
+            }
+        }
+    }
+    search["recall"] = static_cast<double>(hits) / (query.rows * topk);
+
+    std::cerr << "  " << search.dump() << std::endl;
+    return search;
+}
+
+void
+PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --base <file>         base vectors, .fvecs or .bvecs (default: synthetic clustered data)\n"
+              << "  --query <file>        query vectors, required with --base\n"
+              << "  --nb <n>              number of base vectors, 0 reads the whole file (default 100000)\n"
+              << "  --nq <n>              number of query vectors, 0 reads the whole file (default 1000)\n"
+              << "  --dim <n>             dimension of synthetic vectors (default 128)\n"
+              << "  --clusters <n>        number of clusters of synthetic vectors (default 64)\n"
+              << "  --seed <n>            random seed of synthetic vectors (default 42)\n"
+              << "  --metric <L2|IP>      metric of float indexes (default L2)\n"
+              << "  --binary_metric <m>   metric of binary indexes, HAMMING/JACCARD/TANIMOTO (default HAMMING)\n"
+              << "  --index <t1,t2,...>   index types to run (default: every type in VecIndexFactory)\n"
+              << "  --config <file>       JSON sweeps {\"<index type>\": {\"build\": [...], \"search\": [...]}}\n"
+              << "  --topk <n>            k of the search and of recall@k (default 10)\n"
+              << "  --batch <n>           queries per Query call, latency is measured per call (default 1)\n"
+              << "  --threads <n>         omp threads, 0 keeps the omp default (default 0)\n"
+              << "  --output <file>       write the JSON report to file instead of stdout\n";
+}
+
+bool
+ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            return false;
+        }
+        if (arg.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+            std::cerr << "invalid argument: " << arg << std::endl;
+            return false;
+        }
+
+        std::string value = argv[++i];
+        try {
+            if (arg == "--base") {
+                options.base_file = value;
+            } else if (arg == "--query") {
+                options.query_file = value;
+            } else if (arg == "--config") {
+                options.config_file = value;
+            } else if (arg == "--output") {
+                options.output_file = value;
+            } else if (arg == "--index") {
+                options.index_types = SplitList(value);
+            } else if (arg == "--metric") {
+                options.metric = value;
+            } else if (arg == "--binary_metric") {
+                options.binary_metric = value;
+            } else if (arg == "--nb") {
+                options.nb = std::stoll(value);
+            } else if (arg == "--nq") {
+                options.nq = std::stoll(value);
+            } else if (arg == "--dim") {
+                options.dim = std::stoll(value);
+            } else if (arg == "--clusters") {
+                options.clusters = std::stoll(value);
+            } else if (arg == "--seed") {
+                options.seed = static_cast<uint32_t>(std::stoul(value));
+            } else if (arg == "--topk") {
+                options.topk = std::stoll(value);
+            } else if (arg == "--batch") {
+                options.batch = std::stoll(value);
+            } else if (arg == "--threads") {
+                options.threads = std::stoll(value);
+            } else {
+                std::cerr << "unknown option: " << arg << std::endl;
+                return false;
+            }
+        } catch (std::exception&) {
+            std::cerr << "invalid value of " << arg << ": " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (options.base_file.empty() && (options.nb <= 0 || options.nq <= 0 || options.dim <= 0)) {
+        std::cerr << "--nb, --nq and --dim must be positive for synthetic data" << std::endl;
+        return false;
+    }
+    if (options.topk <= 0) {
+        std::cerr << "--topk must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    if (options.threads > 0) {
+        omp_set_num_threads(static_cast<int>(options.threads));
+    }
+
+    kn::Config sweeps = kn::Config::object();
+    if (!options.config_file.empty()) {
+        std::ifstream in(options.config_file);
+        try {
+            in >> sweeps;
+        } catch (std::exception& ex) {
+            std::cerr << "invalid config file " << options.config_file << ": " << ex.what() << std::endl;
+            return 1;
+        }
+        if (options.index_types.empty()) {
+            for (auto& item : sweeps.items()) {
+                options.index_types.push_back(item.key());
+            }
+        }
+    }
+    if (options.index_types.empty()) {
+        options.index_types = AllIndexTypes();
+    }
+
+    Benchmark benchmark(options);
+    kn::Config dataset_info;
+    if (!benchmark.Prepare(dataset_info)) {
+        return 1;
+    }
+
+    kn::Config report{{"dataset", dataset_info}, {"results", kn::Config::array()}};
+    for (auto& type : options.index_types) {
+        auto nb = dataset_info["nb"].get<int64_t>();
+        auto dim = dataset_info["dim"].get<int64_t>();
+        if (IsBinaryIndex(type)) {
+            dim = (dim + 7) / 8 * 8;
+        }
+        auto sweep = sweeps.contains(type) ? sweeps[type] : DefaultSweep(type, nb, dim, options.topk);
+        report["results"].push_back(benchmark.Run(type, sweep));
+    }
+
+    if (options.output_file.empty()) {
+        std::cout << report.dump(4) << std::endl;
+    } else {
+        std::ofstream out(options.output_file);
+        if (!out) {
+            std::cerr << "cannot write report to " << options.output_file << std::endl;
+            return 1;
+        }
+        out << report.dump(4) << std::endl;
+    }
+    return 0;
+}
@@ -16,6 +16,11 @@
 #include <unordered_map>
 #include <vector>
 
+#include <faiss/FaissHook.h>
+#include <faiss/utils/BinaryDistance.h>
+#include <faiss/utils/binary_distances_avx.h>
+#include <faiss/utils/binary_distances_avx512.h>
+
 typedef float (*metric_func_ptr)(const float*, const float*, size_t);
 
 constexpr int64_t DIM = 512;
@@ -57,6 +62,13 @@ CheckResult(const float* result1, const float* result2, const size_t size) {
     }
 }
 
+void
+CheckResult(const int32_t* result1, const int32_t* result2, const size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        ASSERT_EQ(result1[i], result2[i]);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /* from faiss/utils/distances_simd.cpp */
 namespace FAISS {
@@ -413,3 +425,94 @@ TEST(METRICTEST, BENCHMARK) {
     TestMetricAlg(func_map, "ANNOY::IP", LOOP, distance_annoy.data(), NB, xb.data(), NQ, xq.data(), DIM);
     CheckResult(distance_faiss.data(), distance_annoy.data(), NB * NQ);
 }
+
+///////////////////////////////////////////////////////////////////////////////
+/* binary kernels, hooked in faiss/FaissHook.h */
+template <typename T>
+using binary_func_ptr = void (*)(const uint8_t*, const uint8_t*, size_t, size_t, T*);
+
+/* the per code computers used before the batch kernels */
+void
+HammingComputerBatch(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, int32_t* dis) {
+    faiss::HammingComputerM8 hc(x, code_size);
+    for (size_t j = 0; j < ny; j++) {
+        dis[j] = hc.hamming(y + j * code_size);
+    }
+}
+
+void
+JaccardComputerBatch(const uint8_t* x, const uint8_t* y, size_t code_size, size_t ny, float* dis) {
+    faiss::JaccardComputerDefault jc(x, code_size);
+    for (size_t j = 0; j < ny; j++) {
+        dis[j] = jc.compute(y + j * code_size);
+    }
+}
+
+template <typename T>
+void
+TestBinaryAlg(binary_func_ptr<T> func, const std::string& key, int64_t loop, T* distance, const int64_t nb,
+              const uint8_t* xb, const int64_t nq, const uint8_t* xq, const int64_t code_size) {
+    int64_t diff = 0;
+    for (int64_t i = 0; i < loop; i++) {
+        auto t0 = std::chrono::system_clock::now();
+        for (int64_t j = 0; j < nq; j++) {
+            func(xq + j * code_size, xb, code_size, nb, distance + j * nb);
+        }
+        auto t1 = std::chrono::system_clock::now();
+        diff += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+    }
+    std::cout << key << " code size " << code_size << " takes average " << diff / loop << "us" << std::endl;
+}
+
+TEST(METRICTEST, BINARY_BENCHMARK) {
+    constexpr int64_t BINARY_NB = 100000;
+
+    for (int64_t code_size : {32, 64, 128, 256, 260}) {
+        std::vector<uint8_t> xb(BINARY_NB * code_size);
+        std::vector<uint8_t> xq(NQ * code_size);
+        for (auto& v : xb) {
+            v = lrand48();
+        }
+        for (auto& v : xq) {
+            v = lrand48();
+        }
+
+        std::vector<int32_t> hamming_ref(BINARY_NB * NQ), hamming(BINARY_NB * NQ);
+        std::vector<float> jaccard_ref(BINARY_NB * NQ), jaccard(BINARY_NB * NQ);
+
+        std::cout << "==========" << std::endl;
+        TestBinaryAlg<int32_t>(faiss::bvec_hamming_batch_ref, "REF::Hamming", LOOP, hamming_ref.data(), BINARY_NB,
+                               xb.data(), NQ, xq.data(), code_size);
+        if (code_size % 8 == 0) {
+            TestBinaryAlg<int32_t>(HammingComputerBatch, "HammingComputerM8", LOOP, hamming.data(), BINARY_NB,
+                                   xb.data(), NQ, xq.data(), code_size);
+            CheckResult(hamming_ref.data(), hamming.data(), BINARY_NB * NQ);
+        }
+        if (faiss::support_avx2()) {
+            TestBinaryAlg<int32_t>(faiss::bvec_hamming_batch_avx, "AVX2::Hamming", LOOP, hamming.data(), BINARY_NB,
+                                   xb.data(), NQ, xq.data(), code_size);
+            CheckResult(hamming_ref.data(), hamming.data(), BINARY_NB * NQ);
+        }
+        if (faiss::support_avx512_vpopcntdq()) {
+            TestBinaryAlg<int32_t>(faiss::bvec_hamming_batch_avx512, "AVX512::Hamming", LOOP, hamming.data(),
+                                   BINARY_NB, xb.data(), NQ, xq.data(), code_size);
+            CheckResult(hamming_ref.data(), hamming.data(), BINARY_NB * NQ);
+        }
+
+        TestBinaryAlg<float>(faiss::bvec_jaccard_batch_ref, "REF::Jaccard", LOOP, jaccard_ref.data(), BINARY_NB,
+                             xb.data(), NQ, xq.data(), code_size);
+        TestBinaryAlg<float>(JaccardComputerBatch, "JaccardComputerDefault", LOOP, jaccard.data(), BINARY_NB,
+                             xb.data(), NQ, xq.data(), code_size);
+        CheckResult(jaccard_ref.data(), jaccard.data(), BINARY_NB * NQ);
+        if (faiss::support_avx2()) {
+            TestBinaryAlg<float>(faiss::bvec_jaccard_batch_avx, "AVX2::Jaccard", LOOP, jaccard.data(), BINARY_NB,
+                                 xb.data(), NQ, xq.data(), code_size);
+            CheckResult(jaccard_ref.data(), jaccard.data(), BINARY_NB * NQ);
+        }
+        if (faiss::support_avx512_vpopcntdq()) {
+            TestBinaryAlg<float>(faiss::bvec_jaccard_batch_avx512, "AVX512::Jaccard", LOOP, jaccard.data(),
+                                 BINARY_NB, xb.data(), NQ, xq.data(), code_size);
+            CheckResult(jaccard_ref.data(), jaccard.data(), BINARY_NB * NQ);
+        }
+    }
+}
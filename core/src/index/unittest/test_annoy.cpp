@@ -205,6 +205,27 @@ TEST_P(AnnoyTest, annoy_serialize) {
     }
 }
 
+TEST_P(AnnoyTest, annoy_build_threads) {
+    auto build = [&](int64_t build_threads) {
+        auto index = std::make_shared<milvus::knowhere::IndexAnnoy>();
+        auto build_conf = conf;
+        build_conf[milvus::knowhere::IndexParams::build_threads] = build_threads;
+        index->BuildAll(base_dataset, build_conf);
+        return index;
+    };
+
+    // trees are seeded by their number, the index does not depend on the build threads
+    auto index_1 = build(1);
+    auto index_4 = build(4);
+    auto bin_1 = index_1->Serialize(milvus::knowhere::Config()).GetByName("annoy_index_data");
+    auto bin_4 = index_4->Serialize(milvus::knowhere::Config()).GetByName("annoy_index_data");
+    ASSERT_EQ(bin_1->size, bin_4->size);
+    ASSERT_EQ(memcmp(bin_1->data.get(), bin_4->data.get(), bin_1->size), 0);
+
+    auto result = index_4->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+}
+
 /*
  * faiss style test
  * keep it
@@ -12,12 +12,37 @@
 #include <gtest/gtest.h>
 #include <src/index/knowhere/knowhere/common/Config.h>
 #include <src/index/knowhere/knowhere/index/vector_index/IndexHNSW.h>
+#include <src/index/knowhere/knowhere/index/vector_index/adapter/VectorAdapter.h>
 #include <src/index/knowhere/knowhere/index/vector_index/helpers/IndexParameter.h>
+#include <atomic>
 #include <iostream>
+#include <new>
 #include <random>
 #include "knowhere/common/Exception.h"
 #include "unittest/utils.h"
 
+namespace {
+// operator new calls while counting is on, to check the search path does not allocate
+std::atomic<bool> count_allocation{false};
+std::atomic<int64_t> allocation_num{0};
+}  // namespace
+
+void*
+operator new(size_t size) {
+    if (count_allocation) {
+        ++allocation_num;
+    }
+    if (void* ptr = malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
 using ::testing::Combine;
 using ::testing::TestWithParam;
 using ::testing::Values;
@@ -137,6 +162,154 @@ TEST_P(HNSWTest, HNSW_delete) {
     */
 }
 
+TEST_P(HNSWTest, HNSW_compact) {
+    assert(!xb.empty());
+
+    // build graph with the second half vectors, labels start from 0
+    int64_t half = nb / 2;
+    std::vector<int64_t> labels(half);
+    for (int64_t i = 0; i < half; ++i) {
+        labels[i] = i;
+    }
+    auto second_half = milvus::knowhere::GenDatasetWithIds(half, dim, xb.data() + half * dim, labels.data());
+    index_->Train(base_dataset, conf);
+    index_->Add(second_half, conf);
+    EXPECT_EQ(index_->Count(), half);
+
+    // re-label the graph to place the second half behind the first half, drop the last one
+    std::vector<int64_t> label_map(half);
+    for (int64_t i = 0; i < half; ++i) {
+        label_map[i] = i + half;
+    }
+    label_map[half - 1] = -1;
+    index_->Compact(label_map, nb);
+    EXPECT_EQ(index_->Count(), half - 1);
+
+    // extend the graph with the first half vectors
+    auto first_half = milvus::knowhere::GenDatasetWithIds(half, dim, xb.data(), labels.data());
+    index_->Add(first_half, conf);
+    EXPECT_EQ(index_->Count(), nb - 1);
+
+    auto result = index_->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+}
+
+TEST_P(HNSWTest, HNSW_range_search) {
+    assert(!xb.empty());
+
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+
+    // radius between the 5th and the 6th neighbor of the first query
+    auto topk_result = index_->Query(query_dataset, conf);
+    auto topk_dist = topk_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    float radius = (topk_dist[4] + topk_dist[5]) / 2;
+
+    conf[milvus::knowhere::meta::RADIUS] = radius;
+    conf[milvus::knowhere::meta::TOPK] = nb;
+    auto result = index_->QueryByRange(query_dataset, conf);
+    AssertRangeResult(result, xb, xq, nq, dim, radius, nb, false);
+    auto lims = result->Get<int64_t*>(milvus::knowhere::meta::LIMS);
+    ASSERT_GE(lims[1], 5);
+
+    // the queries themselves are deleted
+    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (auto i = 0; i < nq; ++i) {
+        bitset->set(i);
+    }
+    index_->SetBlacklist(bitset);
+    auto result_bs = index_->QueryByRange(query_dataset, conf);
+    auto lims_bs = result_bs->Get<int64_t*>(milvus::knowhere::meta::LIMS);
+    auto ids_bs = result_bs->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (auto i = 0; i < nq; ++i) {
+        for (auto j = lims_bs[i]; j < lims_bs[i + 1]; ++j) {
+            ASSERT_GE(ids_bs[j], nq);
+        }
+    }
+
+    // inner product keeps results above the radius, in descending order
+    conf[milvus::knowhere::Metric::TYPE] = milvus::knowhere::Metric::IP;
+    conf[milvus::knowhere::meta::TOPK] = k;
+    auto ip_index = std::make_shared<milvus::knowhere::IndexHNSW>();
+    ip_index->Train(base_dataset, conf);
+    ip_index->Add(base_dataset, conf);
+    auto ip_topk_result = ip_index->Query(query_dataset, conf);
+    auto ip_topk_dist = ip_topk_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    float ip_radius = (ip_topk_dist[4] + ip_topk_dist[5]) / 2;
+
+    conf[milvus::knowhere::meta::RADIUS] = ip_radius;
+    auto ip_result = ip_index->QueryByRange(query_dataset, conf);
+    auto ip_lims = ip_result->Get<int64_t*>(milvus::knowhere::meta::LIMS);
+    auto ip_dist = ip_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    ASSERT_GE(ip_lims[1], 5);
+    for (auto i = 0; i < nq; ++i) {
+        for (auto j = ip_lims[i]; j < ip_lims[i + 1]; ++j) {
+            ASSERT_GT(ip_dist[j], ip_radius);
+            if (j > ip_lims[i]) {
+                ASSERT_GE(ip_dist[j - 1], ip_dist[j]);
+            }
+        }
+    }
+}
+
+TEST_P(HNSWTest, HNSW_query_into) {
+    assert(!xb.empty());
+
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+
+    std::vector<int64_t> uids(nb);
+    for (int64_t i = 0; i < nb; ++i) {
+        uids[i] = i + 1000;
+    }
+
+    auto result = index_->Query(query_dataset, conf);
+    auto res_ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto res_dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+
+    std::vector<int64_t> ids(nq * k);
+    std::vector<float> distances(nq * k);
+    index_->QueryInto(query_dataset, conf, ids.data(), distances.data(), &uids);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(ids[i], res_ids[i] == -1 ? -1 : uids[res_ids[i]]);
+        ASSERT_FLOAT_EQ(distances[i], res_dist[i]);
+    }
+
+    free(res_ids);
+    free(res_dist);
+}
+
+TEST_P(HNSWTest, HNSW_query_allocation) {
+    assert(!xb.empty());
+
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+
+    // search one row at a time, the way small online queries arrive
+    std::vector<milvus::knowhere::DatasetPtr> queries;
+    for (int64_t i = 0; i < nq; ++i) {
+        queries.push_back(milvus::knowhere::GenDataset(1, dim, xq.data() + i * dim));
+    }
+    std::vector<int64_t> ids(k);
+    std::vector<float> distances(k);
+
+    // the first queries fill the search buffer pool
+    for (auto& query : queries) {
+        index_->QueryInto(query, conf, ids.data(), distances.data(), nullptr);
+    }
+
+    const int64_t rounds = 100;
+    allocation_num = 0;
+    count_allocation = true;
+    for (int64_t r = 0; r < rounds; ++r) {
+        for (auto& query : queries) {
+            index_->QueryInto(query, conf, ids.data(), distances.data(), nullptr);
+        }
+    }
+    count_allocation = false;
+    ASSERT_EQ(allocation_num, 0);
+}
+
 /*
 TEST_P(HNSWTest, HNSW_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
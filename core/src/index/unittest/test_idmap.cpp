@@ -16,9 +16,13 @@
 #include <iostream>
 #include <thread>
 
+#include <faiss/FaissHook.h>
+
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/IndexType.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIDMAP_FP16.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #ifdef MILVUS_GPU_VERSION
 #include <faiss/gpu/GpuCloner.h>
 #include "knowhere/index/vector_index/gpu/IndexGPUIDMAP.h"
@@ -128,6 +132,96 @@ TEST_P(IDMAPTest, idmap_basic) {
 #endif
 }
 
+TEST_P(IDMAPTest, idmap_fp16) {
+    milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                  {milvus::knowhere::meta::TOPK, k},
+                                  {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2}};
+
+    std::vector<uint16_t> xb_fp16(xb.size());
+    faiss::fvec_to_fp16(xb.data(), xb_fp16.data(), xb.size());
+    auto fp16_dataset = milvus::knowhere::GenDataset(nb, dim, xb_fp16.data());
+
+    auto fp16_index = std::make_shared<milvus::knowhere::IDMAP_FP16>();
+    fp16_index->Train(fp16_dataset, conf);
+    fp16_index->AddWithoutIds(fp16_dataset, conf);
+    EXPECT_EQ(fp16_index->Count(), nb);
+    EXPECT_EQ(fp16_index->Dim(), dim);
+    EXPECT_EQ(fp16_index->IndexSize(), nb * dim * sizeof(uint16_t));
+    ASSERT_ANY_THROW(fp16_index->GetRawVectors());
+
+    std::vector<float> decoded;
+    fp16_index->DecodeRawVectors(decoded);
+    ASSERT_EQ(decoded.size(), xb.size());
+    for (size_t i = 0; i < xb.size(); ++i) {
+        ASSERT_NEAR(decoded[i], xb[i], std::abs(xb[i]) * 1e-3 + 1e-4);
+    }
+
+    auto result = fp16_index->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    conf[milvus::knowhere::Metric::TYPE] = milvus::knowhere::Metric::IP;
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, conf);
+    auto ip_result = index_->Query(query_dataset, conf);
+    auto fp16_ip_result = fp16_index->Query(query_dataset, conf);
+    auto ids = ip_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto fp16_ids = fp16_ip_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto fp16_dist = fp16_ip_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq; ++i) {
+        EXPECT_EQ(ids[i * k], fp16_ids[i * k]);
+        for (int64_t j = 1; j < k; ++j) {
+            EXPECT_GE(fp16_dist[i * k + j - 1], fp16_dist[i * k + j]);
+        }
+    }
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    fp16_index->SetBlacklist(concurrent_bitset_ptr);
+    conf[milvus::knowhere::Metric::TYPE] = milvus::knowhere::Metric::L2;
+    auto result_bs = fp16_index->Query(query_dataset, conf);
+    AssertAnns(result_bs, nq, k, CheckMode::CHECK_NOT_EQUAL);
+}
+
+TEST_P(IDMAPTest, idmap_range_search) {
+    milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                  {milvus::knowhere::meta::TOPK, k},
+                                  {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2}};
+
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, conf);
+
+    // radius between the 5th and the 6th neighbor of the first query
+    auto topk_result = index_->Query(query_dataset, conf);
+    auto topk_dist = topk_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    float radius = (topk_dist[4] + topk_dist[5]) / 2;
+
+    conf[milvus::knowhere::meta::RADIUS] = radius;
+    conf[milvus::knowhere::meta::TOPK] = nb;
+    auto result = index_->QueryByRange(query_dataset, conf);
+    AssertRangeResult(result, xb, xq, nq, dim, radius, nb, true);
+    auto lims = result->Get<int64_t*>(milvus::knowhere::meta::LIMS);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    ASSERT_EQ(lims[1], 5);
+    ASSERT_EQ(ids[0], 0);
+
+    // results per query are capped by topk
+    conf[milvus::knowhere::meta::TOPK] = 2;
+    auto capped_result = index_->QueryByRange(query_dataset, conf);
+    AssertRangeResult(capped_result, xb, xq, nq, dim, radius, 2, true);
+
+    // deleted vectors are not returned
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < lims[1]; ++i) {
+        concurrent_bitset_ptr->set(ids[i]);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+    conf[milvus::knowhere::meta::TOPK] = nb;
+    auto result_bs = index_->QueryByRange(query_dataset, conf);
+    ASSERT_EQ(result_bs->Get<int64_t*>(milvus::knowhere::meta::LIMS)[1], 0);
+}
+
 TEST_P(IDMAPTest, idmap_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
         FileIOWriter writer(filename);
@@ -71,6 +71,7 @@ ShowInstructionSet() {
     support_message("PCLMULQDQ", instruction_set_inst.PCLMULQDQ());
     support_message("POPCNT", instruction_set_inst.POPCNT());
     support_message("PREFETCHWT1", instruction_set_inst.PREFETCHWT1());
+    support_message("AVX512_VPOPCNTDQ", instruction_set_inst.AVX512_VPOPCNTDQ());
     support_message("RDRAND", instruction_set_inst.RDRAND());
     support_message("RDSEED", instruction_set_inst.RDSEED());
     support_message("RDTSCP", instruction_set_inst.RDTSCP());
@@ -13,7 +13,10 @@
 
 #include <fiu-control.h>
 #include <fiu/fiu-local.h>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <string>
 #include <thread>
 
 #ifdef MILVUS_GPU_VERSION
@@ -39,6 +42,19 @@ using ::testing::Combine;
 using ::testing::TestWithParam;
 using ::testing::Values;
 
+namespace {
+
+void
+WriteListFile(const milvus::knowhere::IVFNMPtr& index, const milvus::knowhere::BinarySet& binary_set,
+              const std::string& path) {
+    std::ofstream writer(path, std::ios::binary | std::ios::trunc);
+    index->WriteListFile(binary_set, [&](const uint8_t* data, size_t size) {
+        writer.write(reinterpret_cast<const char*>(data), size);
+    });
+}
+
+}  // namespace
+
 class IVFNMCPUTest : public DataGen,
                      public TestWithParam<::std::tuple<milvus::knowhere::IndexType, milvus::knowhere::IndexMode>> {
  protected:
@@ -129,3 +145,131 @@ TEST_P(IVFNMCPUTest, ivf_basic_cpu) {
     milvus::knowhere::FaissGpuResourceMgr::GetInstance().Dump();
 #endif
 }
+
+TEST_P(IVFNMCPUTest, ivf_range_search_cpu) {
+    assert(!xb.empty());
+
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    milvus::knowhere::BinarySet bs = index_->Serialize(conf_);
+
+    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)xb.data(), [&](uint8_t*) {});
+    bptr->size = dim * nb * sizeof(float);
+    bs.Append(RAW_DATA, bptr);
+    index_->Load(bs);
+
+    // radius between the 5th and the 6th neighbor of the first query, probe all lists to compare with brute force
+    auto topk_result = index_->Query(query_dataset, conf_);
+    auto topk_dist = topk_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    float radius = (topk_dist[4] + topk_dist[5]) / 2;
+
+    conf_[milvus::knowhere::meta::RADIUS] = radius;
+    conf_[milvus::knowhere::meta::TOPK] = nb;
+    conf_[milvus::knowhere::IndexParams::nprobe] = conf_[milvus::knowhere::IndexParams::nlist];
+    auto result = index_->QueryByRange(query_dataset, conf_);
+    AssertRangeResult(result, xb, xq, nq, dim, radius, nb, true);
+
+    // the list file reads the same vectors
+    std::string list_file_path = "/tmp/ivf_nm_range_test.ivfl";
+    auto disk_index = IndexFactoryNM(index_type_, index_mode_);
+    WriteListFile(disk_index, bs, list_file_path);
+    disk_index->LoadWithListFile(bs, list_file_path);
+    auto disk_result = disk_index->QueryByRange(query_dataset, conf_);
+    AssertRangeResult(disk_result, xb, xq, nq, dim, radius, nb, true);
+    std::remove(list_file_path.c_str());
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+    auto result_bs = index_->QueryByRange(query_dataset, conf_);
+    auto lims = result_bs->Get<int64_t*>(milvus::knowhere::meta::LIMS);
+    auto ids = result_bs->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq; ++i) {
+        for (auto j = lims[i]; j < lims[i + 1]; ++j) {
+            ASSERT_NE(ids[j], i);
+        }
+    }
+}
+
+TEST_P(IVFNMCPUTest, ivf_list_file_cpu) {
+    assert(!xb.empty());
+
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    milvus::knowhere::BinarySet bs = index_->Serialize(conf_);
+
+    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)xb.data(), [&](uint8_t*) {});
+    bptr->size = dim * nb * sizeof(float);
+    milvus::knowhere::BinarySet mem_bs = bs;
+    mem_bs.Append(RAW_DATA, bptr);
+    index_->Load(mem_bs);
+    auto mem_result = index_->Query(query_dataset, conf_);
+    AssertAnns(mem_result, nq, k);
+
+    // the list file is written from raw data, then loaded without it
+    auto& list_cache = milvus::knowhere::IVFListCache::GetInstance();
+    auto cache_capacity = list_cache.Capacity();
+    int64_t block_budget = dim * sizeof(float) * 64;
+    list_cache.SetCapacity(block_budget);
+
+    std::string list_file_path = "/tmp/ivf_nm_test.ivfl";
+    auto disk_index = IndexFactoryNM(index_type_, index_mode_);
+    WriteListFile(disk_index, mem_bs, list_file_path);
+    disk_index->LoadWithListFile(bs, list_file_path);
+    auto disk_index_2 = IndexFactoryNM(index_type_, index_mode_);
+    disk_index_2->LoadWithListFile(bs, list_file_path);
+
+    // the codes stay on disk, only ids and centroids are charged to the index cache
+    disk_index->UpdateIndexSize();
+    ASSERT_LT(disk_index->IndexSize(), static_cast<int64_t>(nb * dim * sizeof(float)));
+
+    for (auto& index : {disk_index, disk_index_2}) {
+        auto result = index->Query(query_dataset, conf_);
+        AssertAnns(result, nq, k);
+        auto mem_ids = mem_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        for (int64_t i = 0; i < nq * k; ++i) {
+            ASSERT_EQ(mem_ids[i], ids[i]);
+        }
+
+        faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+        for (int64_t i = 0; i < nq; ++i) {
+            concurrent_bitset_ptr->set(i);
+        }
+        index->SetBlacklist(concurrent_bitset_ptr);
+        auto result_bs = index->Query(query_dataset, conf_);
+        AssertAnns(result_bs, nq, k, CheckMode::CHECK_NOT_EQUAL);
+
+        // both indexes share one cache budget
+        ASSERT_GT(list_cache.Usage(), 0);
+        ASSERT_LE(list_cache.Usage(), block_budget);
+    }
+
+    // blocks of an unloaded list file are dropped
+    disk_index = nullptr;
+    disk_index_2 = nullptr;
+    ASSERT_EQ(list_cache.Usage(), 0);
+    list_cache.SetCapacity(cache_capacity);
+
+    // list file of another index
+    std::string bad_path = "/tmp/ivf_nm_test_bad.ivfl";
+    { std::ofstream(bad_path) << "bad"; }
+    ASSERT_ANY_THROW(IndexFactoryNM(index_type_, index_mode_)->LoadWithListFile(bs, bad_path));
+
+    // raw data is required to write the list file
+    ASSERT_ANY_THROW(WriteListFile(IndexFactoryNM(index_type_, index_mode_), bs, bad_path));
+    std::remove(bad_path.c_str());
+    std::remove(list_file_path.c_str());
+}
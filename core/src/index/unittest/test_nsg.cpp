@@ -12,7 +12,11 @@
 #include <fiu-control.h>
 #include <fiu/fiu-local.h>
 #include <gtest/gtest.h>
+#include <boost/dynamic_bitset.hpp>
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <vector>
 
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
@@ -24,6 +28,8 @@
 #endif
 
 #include "knowhere/common/Timer.h"
+#include "knowhere/index/vector_index/impl/nsg/NSG.h"
+#include "knowhere/index/vector_index/impl/nsg/NSGHelper.h"
 #include "knowhere/index/vector_index/impl/nsg/NSGIO.h"
 
 #include "unittest/utils.h"
@@ -34,6 +40,90 @@ using ::testing::Values;
 
 constexpr int64_t DEVICE_GPU0 = 0;
 
+namespace milvus {
+namespace knowhere {
+namespace impl {
+extern unsigned int seed;
+}  // namespace impl
+}  // namespace knowhere
+}  // namespace milvus
+
+namespace {
+
+using milvus::knowhere::impl::Neighbor;
+using milvus::knowhere::impl::node_t;
+
+// the search loop of NsgIndex before it was templated on the distance functors: a virtual Distance and a
+// per-query bitset
+void
+OldNsgSearch(const milvus::knowhere::impl::NsgIndex& index, const milvus::knowhere::impl::Distance& distance,
+             const float* query, const float* data, size_t search_length, std::vector<Neighbor>& resset) {
+    auto& graph = index.nsg;
+    size_t ntotal = index.ntotal;
+    size_t dimension = index.dimension;
+    size_t buffer_size = search_length;
+
+    std::vector<node_t> init_ids(buffer_size);
+    resset.resize(buffer_size);
+    boost::dynamic_bitset<> has_calculated_dist{ntotal, 0};
+
+    size_t count = 0;
+    for (size_t i = 0; i < init_ids.size() && i < graph[index.navigation_point].size(); ++i) {
+        init_ids[i] = graph[index.navigation_point][i];
+        has_calculated_dist[init_ids[i]] = true;
+        ++count;
+    }
+    while (count < buffer_size) {
+        node_t id = rand_r(&milvus::knowhere::impl::seed) % ntotal;
+        if (has_calculated_dist[id]) {
+            continue;
+        }
+        init_ids[count] = id;
+        ++count;
+        has_calculated_dist[id] = true;
+    }
+
+    for (size_t i = 0; i < init_ids.size(); ++i) {
+        node_t id = init_ids[i];
+        resset[i] = Neighbor(id, distance.Compare(data + id * dimension, query, dimension), false);
+    }
+    std::sort(resset.begin(), resset.end());
+
+    size_t cursor = 0;
+    while (cursor < buffer_size) {
+        size_t nearest_updated_pos = buffer_size;
+        if (!resset[cursor].has_explored) {
+            resset[cursor].has_explored = true;
+            for (node_t id : graph[resset[cursor].id]) {
+                if (has_calculated_dist[id]) {
+                    continue;
+                }
+                has_calculated_dist[id] = true;
+
+                float dist = distance.Compare(query, data + dimension * id, dimension);
+                if (dist >= resset[buffer_size - 1].distance) {
+                    continue;
+                }
+                Neighbor nn(id, dist, false);
+                size_t pos = milvus::knowhere::impl::InsertIntoPool(resset.data(), buffer_size, nn);
+                if (pos < nearest_updated_pos) {
+                    nearest_updated_pos = pos;
+                }
+                if (buffer_size + 1 < resset.size()) {
+                    ++buffer_size;
+                }
+            }
+        }
+        if (cursor >= nearest_updated_pos) {
+            cursor = nearest_updated_pos;
+        } else {
+            ++cursor;
+        }
+    }
+}
+
+}  // namespace
+
 class NSGInterfaceTest : public DataGen, public ::testing::Test {
  protected:
     void
@@ -142,6 +232,65 @@ TEST_F(NSGInterfaceTest, compare_test) {
         distanceIP.Compare(xb.data(), xq.data(), 256);
     }
     tc.RecordSection("IP");
+
+    milvus::knowhere::impl::L2DistanceFunctor l2_functor(256);
+    milvus::knowhere::impl::IPDistanceFunctor ip_functor(256);
+    for (int i = 0; i < 1000; ++i) {
+        l2_functor(xb.data(), xq.data(), 256);
+    }
+    tc.RecordSection("L2 functor");
+    for (int i = 0; i < 1000; ++i) {
+        ip_functor(xb.data(), xq.data(), 256);
+    }
+    tc.RecordSection("IP functor");
+
+    float l2 = distanceL2.Compare(xb.data(), xq.data(), 256);
+    float ip = distanceIP.Compare(xb.data(), xq.data(), 256);
+    ASSERT_NEAR(l2_functor(xb.data(), xq.data(), 256), l2, std::abs(l2) * 1e-4);
+    ASSERT_NEAR(ip_functor(xb.data(), xq.data(), 256), ip, std::abs(ip) * 1e-4 + 1e-4);
+
+    // the old and the new search loop must walk the same graph to the same results
+    const size_t n = 2000, dimension = 256, knn = 20, search_length = 30;
+    milvus::knowhere::impl::Graph knng(n);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<Neighbor> pool;
+        for (size_t j = 0; j < n; ++j) {
+            if (j != i) {
+                pool.emplace_back(j, distanceL2.Compare(xb.data() + i * dimension, xb.data() + j * dimension,
+                                                        dimension));
+            }
+        }
+        std::partial_sort(pool.begin(), pool.begin() + knn, pool.end());
+        for (size_t j = 0; j < knn; ++j) {
+            knng[i].push_back(pool[j].id);
+        }
+    }
+    std::vector<int64_t> node_ids(n);
+    for (size_t i = 0; i < n; ++i) {
+        node_ids[i] = i;
+    }
+
+    milvus::knowhere::impl::NsgIndex nsg(dimension, n, milvus::knowhere::impl::NsgIndex::Metric_Type_L2);
+    nsg.SetKnnGraph(knng);
+    milvus::knowhere::impl::BuildParams b_params{40, 30, 100};
+    nsg.Build_with_ids(n, xb.data(), node_ids.data(), b_params);
+
+    milvus::knowhere::impl::SearchParams s_params{search_length, static_cast<size_t>(k)};
+    std::vector<float> dist(k);
+    std::vector<int64_t> ids(k);
+    for (int64_t q = 0; q < nq; ++q) {
+        const float* query = xq.data() + q * dimension;
+        // both loops draw their random entry points from the same seed
+        unsigned int query_seed = milvus::knowhere::impl::seed;
+        std::vector<Neighbor> old_resset;
+        OldNsgSearch(nsg, distanceL2, query, xb.data(), search_length, old_resset);
+
+        milvus::knowhere::impl::seed = query_seed;
+        nsg.Search(query, xb.data(), 1, dimension, k, dist.data(), ids.data(), s_params);
+        for (int64_t i = 0; i < k; ++i) {
+            ASSERT_EQ(ids[i], old_resset[i].id);
+        }
+    }
 }
 
 TEST_F(NSGInterfaceTest, delete_test) {
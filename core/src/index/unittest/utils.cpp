@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 #include <math.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -161,6 +162,45 @@ AssertAnns(const milvus::knowhere::DatasetPtr& result, const int nq, const int k
     }
 }
 
+void
+AssertRangeResult(const milvus::knowhere::DatasetPtr& result, const std::vector<float>& xb, const std::vector<float>& xq,
+                  const int nq, const int dim, const float radius, const int64_t max_results, const bool check_all) {
+    auto lims = result->Get<int64_t*>(milvus::knowhere::meta::LIMS);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto distances = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    int64_t nb = xb.size() / dim;
+    ASSERT_EQ(lims[0], 0);
+    for (auto i = 0; i < nq; i++) {
+        int64_t num = lims[i + 1] - lims[i];
+        ASSERT_LE(num, max_results);
+
+        int64_t expect_num = 0;
+        for (int64_t j = 0; j < nb; j++) {
+            float dist = 0;
+            for (auto d = 0; d < dim; d++) {
+                float diff = xq[i * dim + d] - xb[j * dim + d];
+                dist += diff * diff;
+            }
+            if (dist < radius) {
+                expect_num++;
+            }
+        }
+        if (check_all) {
+            ASSERT_EQ(num, std::min(expect_num, max_results));
+        } else {
+            ASSERT_LE(num, expect_num);
+        }
+
+        for (auto j = lims[i]; j < lims[i + 1]; j++) {
+            ASSERT_LT(distances[j], radius);
+            ASSERT_GE(ids[j], 0);
+            if (j > lims[i]) {
+                ASSERT_LE(distances[j - 1], distances[j]);
+            }
+        }
+    }
+}
+
 #if 0
 void
 AssertVec(const milvus::knowhere::DatasetPtr& result, const milvus::knowhere::DatasetPtr& base_dataset,
@@ -70,6 +70,12 @@ void
 AssertAnns(const milvus::knowhere::DatasetPtr& result, const int nq, const int k,
            const CheckMode check_mode = CheckMode::CHECK_EQUAL);
 
+// Check a L2 range search result against brute force: results are within radius and ordered, at most max_results
+// per query, and with check_all all vectors within radius are found while max_results is not reached.
+void
+AssertRangeResult(const milvus::knowhere::DatasetPtr& result, const std::vector<float>& xb, const std::vector<float>& xq,
+                  const int nq, const int dim, const float radius, const int64_t max_results, const bool check_all);
+
 void
 AssertVec(const milvus::knowhere::DatasetPtr& result, const milvus::knowhere::DatasetPtr& base_dataset,
           const milvus::knowhere::DatasetPtr& id_dataset, const int n, const int dim,
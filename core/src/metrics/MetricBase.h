@@ -55,10 +55,22 @@ class MetricsBase {
     BuildIndexDurationSecondsHistogramObserve(double value) {
     }
 
+    virtual void
+    BuildIndexPendingTaskGaugeSet(double value) {
+    }
+
+    virtual void
+    BuildIndexRunningTaskGaugeSet(double value) {
+    }
+
     virtual void
     CpuCacheUsageGaugeSet(double value) {
     }
 
+    virtual void
+    CachePreloadProgressGaugeSet(double value) {
+    }
+
     virtual void
     GpuCacheUsageGaugeSet() {
     }
@@ -95,6 +107,26 @@ class MetricsBase {
     SearchRawDataDurationSecondsHistogramObserve(double value) {
     }
 
+    virtual void
+    QueryStageHistogramObserve(const std::string& stage, double value) {
+    }
+
+    virtual void
+    ReqQueueDepthGaugeSet(const std::string& lane, double value) {
+    }
+
+    virtual void
+    ReqQueueWaitHistogramObserve(const std::string& lane, double value) {
+    }
+
+    virtual void
+    ReqDroppedCounterIncrement(const std::string& lane) {
+    }
+
+    virtual void
+    SnapshotOperationQueueWaitHistogramObserve(const std::string& shard, double value) {
+    }
+
     virtual void
     IndexFileSizeTotalIncrement(double value = 1) {
     }
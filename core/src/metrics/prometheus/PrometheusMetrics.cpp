@@ -143,6 +143,56 @@ PrometheusMetrics::QueryIndexTypePerSecondSet(std::string type, double value) {
     }
 }
 
+void
+PrometheusMetrics::QueryStageHistogramObserve(const std::string& stage, double value) {
+    if (!startup_) {
+        return;
+    }
+
+    search_stage_duration_
+        .Add({{"stage", stage}}, BucketBoundaries{100, 500, 1e3, 5e3, 1e4, 5e4, 1e5, 5e5, 1e6, 5e6})
+        .Observe(value);
+}
+
+void
+PrometheusMetrics::ReqQueueDepthGaugeSet(const std::string& lane, double value) {
+    if (!startup_) {
+        return;
+    }
+
+    request_queue_depth_.Add({{"lane", lane}}).Set(value);
+}
+
+void
+PrometheusMetrics::ReqQueueWaitHistogramObserve(const std::string& lane, double value) {
+    if (!startup_) {
+        return;
+    }
+
+    request_queue_wait_.Add({{"lane", lane}}, BucketBoundaries{100, 500, 1e3, 5e3, 1e4, 5e4, 1e5, 5e5, 1e6, 5e6})
+        .Observe(value);
+}
+
+void
+PrometheusMetrics::ReqDroppedCounterIncrement(const std::string& lane) {
+    if (!startup_) {
+        return;
+    }
+
+    request_dropped_.Add({{"lane", lane}}).Increment();
+}
+
+void
+PrometheusMetrics::SnapshotOperationQueueWaitHistogramObserve(const std::string& shard, double value) {
+    if (!startup_) {
+        return;
+    }
+
+    snapshot_operation_queue_wait_
+        .Add({{"shard", shard}}, BucketBoundaries{100, 500, 1e3, 5e3, 1e4, 5e4, 1e5, 5e5, 1e6, 5e6})
+        .Observe(value);
+}
+
 void
 PrometheusMetrics::ConnectionGaugeIncrement() {
     if (!startup_) {
@@ -94,6 +94,20 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    BuildIndexPendingTaskGaugeSet(double value) override {
+        if (startup_) {
+            build_index_pending_task_gauge_.Set(value);
+        }
+    }
+
+    void
+    BuildIndexRunningTaskGaugeSet(double value) override {
+        if (startup_) {
+            build_index_running_task_gauge_.Set(value);
+        }
+    }
+
     void
     CpuCacheUsageGaugeSet(double value) override {
         if (startup_) {
@@ -101,6 +115,13 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    CachePreloadProgressGaugeSet(double value) override {
+        if (startup_) {
+            cache_preload_progress_gauge_.Set(value);
+        }
+    }
+
     void
     GpuCacheUsageGaugeSet() override;
 
@@ -270,6 +291,16 @@ class PrometheusMetrics : public MetricsBase {
     void
     QueryIndexTypePerSecondSet(std::string type, double value) override;
     void
+    QueryStageHistogramObserve(const std::string& stage, double value) override;
+    void
+    ReqQueueDepthGaugeSet(const std::string& lane, double value) override;
+    void
+    ReqQueueWaitHistogramObserve(const std::string& lane, double value) override;
+    void
+    ReqDroppedCounterIncrement(const std::string& lane) override;
+    void
+    SnapshotOperationQueueWaitHistogramObserve(const std::string& shard, double value) override;
+    void
     ConnectionGaugeIncrement() override;
     void
     ConnectionGaugeDecrement() override;
@@ -390,6 +421,36 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Histogram& search_duration_histogram_ =
         search_request_duration_seconds_.Add({}, BucketBoundaries{0.1, 1.0, 10.0});
 
+    // record time spent in each stage of a search
+    prometheus::Family<prometheus::Histogram>& search_stage_duration_ =
+        prometheus::BuildHistogram()
+            .Name("search_stage_duration_microseconds")
+            .Help("histogram of time spent in each stage of a search by microseconds")
+            .Register(*registry_);
+
+    // record request queue of each lane
+    prometheus::Family<prometheus::Gauge>& request_queue_depth_ = prometheus::BuildGauge()
+                                                                      .Name("request_queue_depth")
+                                                                      .Help("number of requests waiting in each lane")
+                                                                      .Register(*registry_);
+    prometheus::Family<prometheus::Histogram>& request_queue_wait_ =
+        prometheus::BuildHistogram()
+            .Name("request_queue_wait_microseconds")
+            .Help("histogram of time a request waits in each lane by microseconds")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& request_dropped_ =
+        prometheus::BuildCounter()
+            .Name("request_dropped_total")
+            .Help("the number of requests rejected or dropped by admission control")
+            .Register(*registry_);
+
+    // record snapshot operation queue of each executor shard
+    prometheus::Family<prometheus::Histogram>& snapshot_operation_queue_wait_ =
+        prometheus::BuildHistogram()
+            .Name("snapshot_operation_queue_wait_microseconds")
+            .Help("histogram of time a snapshot operation waits in each executor shard by microseconds")
+            .Register(*registry_);
+
     // record raw_files size histogram
     prometheus::Family<prometheus::Histogram>& raw_files_size_ = prometheus::BuildHistogram()
                                                                      .Name("search_raw_files_bytes")
@@ -440,6 +501,14 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Histogram& all_build_index_duration_seconds_histogram_ =
         all_build_index_duration_seconds_.Add({}, BucketBoundaries{2e6, 4e6, 6e6, 8e6, 1e7});
 
+    // record number of build index tasks in builder pool
+    prometheus::Family<prometheus::Gauge>& build_index_task_ = prometheus::BuildGauge()
+                                                                   .Name("build_index_task_number")
+                                                                   .Help("number of build index tasks in builder")
+                                                                   .Register(*registry_);
+    prometheus::Gauge& build_index_pending_task_gauge_ = build_index_task_.Add({{"state", "pending"}});
+    prometheus::Gauge& build_index_running_task_gauge_ = build_index_task_.Add({{"state", "running"}});
+
     // record duration of merging mem collection
     prometheus::Family<prometheus::Histogram>& mem_table_merge_duration_seconds_ =
         prometheus::BuildHistogram()
@@ -548,6 +617,14 @@ class PrometheusMetrics : public MetricsBase {
         prometheus::BuildGauge().Name("cache_usage_bytes").Help("current cache usage by bytes").Register(*registry_);
     prometheus::Gauge& cpu_cache_usage_gauge_ = cpu_cache_usage_.Add({});
 
+    // record progress of collection preload at startup
+    prometheus::Family<prometheus::Gauge>& cache_preload_progress_ =
+        prometheus::BuildGauge()
+            .Name("cache_preload_progress_percent")
+            .Help("percent of preload segments which have been loaded or skipped")
+            .Register(*registry_);
+    prometheus::Gauge& cache_preload_progress_gauge_ = cache_preload_progress_.Add({});
+
     // record GPU cache usage and %
     prometheus::Family<prometheus::Gauge>& gpu_cache_usage_ = prometheus::BuildGauge()
                                                                   .Name("gpu_cache_usage_bytes")
@@ -80,6 +80,9 @@ struct VectorQuery {
     milvus::json extra_params = {};
     int64_t topk;
     int64_t nq;
+    // range search returns the entities within radius instead of the topk nearest, topk caps the results per query
+    bool range_search = false;
+    float radius = 0.0f;
     std::string metric_type = "";
     float boost;
     VectorRecord query_vector;
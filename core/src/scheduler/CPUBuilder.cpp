@@ -10,17 +10,55 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/CPUBuilder.h"
+#include "config/ServerConfig.h"
+#include "knowhere/index/vector_index/helpers/BuilderSuspend.h"
+#include "metrics/Metrics.h"
+#include "scheduler/task/BuildIndexTask.h"
 #include "utils/Log.h"
 
+#include <omp.h>
+#include <algorithm>
+#include <string>
+
 namespace milvus {
 namespace scheduler {
 
+CPUBuilder::CPUBuilder(int64_t thread_num) : thread_num_(thread_num) {
+    if (thread_num_ <= 0) {
+        thread_num_ = DefaultThreadNum();
+    }
+}
+
+int64_t
+CPUBuilder::DefaultThreadNum() {
+    int64_t concurrency = config.engine.build_index_concurrency();
+    if (concurrency > 0) {
+        return concurrency;
+    }
+
+    // each build task uses omp_thread_num threads, split cpu cores among concurrent builds
+    // if omp_thread_num is not specified, one build task occupies all cores
+    int64_t omp_thread = config.engine.omp_thread_num();
+    int64_t cores = std::thread::hardware_concurrency();
+    if (omp_thread <= 0 || cores <= 0) {
+        return 1;
+    }
+    return std::max<int64_t>(1, cores / omp_thread);
+}
+
 void
 CPUBuilder::Start() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (not running_) {
+        {
+            std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+            stop_ = false;
+        }
         running_ = true;
-        thread_ = std::thread(&CPUBuilder::worker_function, this);
+        for (int64_t i = 0; i < thread_num_; ++i) {
+            threads_.emplace_back(&CPUBuilder::worker_function, this);
+        }
+        LOG_SERVER_DEBUG_ << "CPUBuilder start with " << thread_num_ << " threads";
     }
 }
 
@@ -28,37 +66,106 @@ void
 CPUBuilder::Stop() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (running_) {
-        this->Put(nullptr);
-        thread_.join();
+        {
+            std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+            stop_ = true;
+        }
+        queue_cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+        threads_.clear();
         running_ = false;
     }
 }
 
 void
 CPUBuilder::Put(const TaskPtr& task) {
+    if (task == nullptr) {
+        return;
+    }
+
+    int64_t priority = 0;
+    if (auto build_task = std::dynamic_pointer_cast<BuildIndexTask>(task)) {
+        priority = build_task->Priority();
+    }
+
     {
         std::lock_guard<std::mutex> lock(queue_mutex_);
-        queue_.push(task);
+        queue_.push(BuildItem{task, priority, sequence_++});
+        server::Metrics::GetInstance().BuildIndexPendingTaskGaugeSet(queue_.size());
     }
     queue_cv_.notify_one();
 }
 
+json
+CPUBuilder::Dump() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    json running_tasks = json::array();
+    for (auto& task : running_tasks_) {
+        running_tasks.push_back(task->Dump());
+    }
+    json ret{
+        {"thread_num", thread_num_},
+        {"pending_task_num", queue_.size()},
+        {"running_tasks", running_tasks},
+    };
+    return ret;
+}
+
+void
+CPUBuilder::SearchBegin() {
+    int64_t threshold = config.engine.build_suspend_search_num();
+    std::lock_guard<std::mutex> lock(suspend_mutex_);
+    ++live_search_num_;
+    if (threshold > 0 && live_search_num_ == threshold) {
+        LOG_ENGINE_TRACE_ << "live_search_num_: " << live_search_num_ << ", suspend build index";
+        knowhere::BuilderSuspend();
+    }
+}
+
+void
+CPUBuilder::SearchEnd() {
+    int64_t threshold = config.engine.build_suspend_search_num();
+    std::lock_guard<std::mutex> lock(suspend_mutex_);
+    --live_search_num_;
+    if (threshold <= 0 || live_search_num_ < threshold) {
+        LOG_ENGINE_TRACE_ << "live_search_num_: " << live_search_num_ << ", resume build index";
+        knowhere::BuildResume();
+    }
+}
+
 void
 CPUBuilder::worker_function() {
     SetThreadName("cpubuilder_thread");
-    while (running_) {
+
+    // the openmp thread number set at startup only applies to the thread setting it,
+    // builder threads set their own so that omp_thread_num also bounds index building
+    int64_t omp_thread = config.engine.omp_thread_num();
+    if (omp_thread > 0) {
+        omp_set_num_threads(omp_thread);
+    }
+
+    while (true) {
         std::unique_lock<std::mutex> lock(queue_mutex_);
-        queue_cv_.wait(lock, [&] { return not queue_.empty(); });
-        auto task = queue_.front();
+        queue_cv_.wait(lock, [&] { return stop_ || not queue_.empty(); });
+        if (queue_.empty()) {
+            // stopped and all queued tasks are done, thread exit
+            break;
+        }
+        auto task = queue_.top().task_;
         queue_.pop();
+        running_tasks_.insert(task);
+        server::Metrics::GetInstance().BuildIndexPendingTaskGaugeSet(queue_.size());
+        server::Metrics::GetInstance().BuildIndexRunningTaskGaugeSet(running_tasks_.size());
         lock.unlock();
 
-        if (task == nullptr) {
-            // thread exit
-            break;
-        }
         task->Load(LoadType::DISK2CPU, 0);
         task->Execute();
+
+        lock.lock();
+        running_tasks_.erase(task);
+        server::Metrics::GetInstance().BuildIndexRunningTaskGaugeSet(running_tasks_.size());
     }
 }
 
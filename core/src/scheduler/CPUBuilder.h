@@ -16,15 +16,21 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <unordered_set>
+#include <vector>
 
+#include "scheduler/interface/interfaces.h"
 #include "task/Task.h"
 
 namespace milvus {
 namespace scheduler {
 
-class CPUBuilder {
+// A pool of build index workers.
+// Tasks are ordered by priority (BuildIndexTask uses segment row count, so large segments go first),
+// tasks with the same priority are executed in FIFO order.
+class CPUBuilder : public interface::dumpable {
  public:
-    CPUBuilder() = default;
+    explicit CPUBuilder(int64_t thread_num = 0);
 
     void
     Start();
@@ -35,18 +41,55 @@ class CPUBuilder {
     void
     Put(const TaskPtr& task);
 
+    json
+    Dump() const override;
+
+    // search jobs notify builder, the builder suspends running builds when search load is high
+    void
+    SearchBegin();
+
+    void
+    SearchEnd();
+
+    static int64_t
+    DefaultThreadNum();
+
  private:
     void
     worker_function();
 
  private:
+    struct BuildItem {
+        TaskPtr task_;
+        int64_t priority_ = 0;
+        uint64_t sequence_ = 0;
+    };
+
+    struct BuildItemCompare {
+        bool
+        operator()(const BuildItem& l, const BuildItem& r) const {
+            if (l.priority_ != r.priority_) {
+                return l.priority_ < r.priority_;
+            }
+            return l.sequence_ > r.sequence_;
+        }
+    };
+
+ private:
+    int64_t thread_num_ = 1;
     bool running_ = false;
     std::mutex mutex_;
-    std::thread thread_;
+    std::vector<std::thread> threads_;
 
-    std::queue<TaskPtr> queue_;
+    bool stop_ = false;
+    uint64_t sequence_ = 0;
+    std::priority_queue<BuildItem, std::vector<BuildItem>, BuildItemCompare> queue_;
+    std::unordered_set<TaskPtr> running_tasks_;
     std::condition_variable queue_cv_;
-    std::mutex queue_mutex_;
+    mutable std::mutex queue_mutex_;
+
+    int64_t live_search_num_ = 0;
+    std::mutex suspend_mutex_;
 };
 
 using CPUBuilderPtr = std::shared_ptr<CPUBuilder>;
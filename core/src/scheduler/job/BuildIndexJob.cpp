@@ -14,6 +14,7 @@
 
 #include <utility>
 
+#include "db/SnapshotUtils.h"
 #include "utils/Log.h"
 
 namespace milvus {
@@ -30,7 +31,7 @@ WhichFieldsToBuild(const engine::snapshot::ScopedSnapshotT& snapshot, engine::sn
     for (auto& field_name : field_names) {
         auto field = snapshot->GetField(field_name);
         auto ftype = static_cast<engine::DataType>(field->GetFtype());
-        bool is_vector = (ftype == engine::DataType::VECTOR_FLOAT || ftype == engine::DataType::VECTOR_BINARY);
+        bool is_vector = engine::IsVectorField(ftype);
         auto elements = snapshot->GetFieldElementsByField(field_name);
         for (auto& element : elements) {
             if (element->GetFEtype() != engine::FieldElementType::FET_INDEX) {
@@ -62,6 +63,9 @@ WhichFieldsToBuild(const engine::snapshot::ScopedSnapshotT& snapshot, engine::sn
 BuildIndexJob::BuildIndexJob(const engine::snapshot::ScopedSnapshotT& snapshot, engine::DBOptions options,
                              const engine::snapshot::IDS_TYPE& segment_ids)
     : Job(JobType::BUILD), snapshot_(snapshot), options_(std::move(options)), segment_ids_(segment_ids) {
+    if (snapshot_.Get() != nullptr) {
+        collection_id_ = snapshot_->GetCollectionId();
+    }
 }
 
 void
@@ -77,10 +81,17 @@ BuildIndexJob::OnCreateTasks(JobTasks& tasks) {
     }
 }
 
+void
+BuildIndexJob::AddFailedSegment(engine::snapshot::ID_TYPE segment_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    failed_segment_ids_.push_back(segment_id);
+}
+
 json
 BuildIndexJob::Dump() const {
     json ret{
         {"number_of_to_index_segment", segment_ids_.size()},
+        {"cancelled", cancelled_.load()},
     };
     auto base = Job::Dump();
     ret.insert(base.begin(), base.end());
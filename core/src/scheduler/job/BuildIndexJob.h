@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <list>
@@ -45,11 +46,30 @@ class BuildIndexJob : public Job {
         return options_;
     }
 
-    engine::snapshot::IDS_TYPE&
-    FailedSegments() {
+    const engine::snapshot::IDS_TYPE&
+    FailedSegments() const {
         return failed_segment_ids_;
     }
 
+    void
+    AddFailedSegment(engine::snapshot::ID_TYPE segment_id);
+
+    engine::snapshot::ID_TYPE
+    collection_id() const {
+        return collection_id_;
+    }
+
+    // tasks of a cancelled job skip loading and building, the job finishes as soon as queued tasks are popped
+    void
+    Cancel() {
+        cancelled_ = true;
+    }
+
+    bool
+    IsCancelled() const {
+        return cancelled_;
+    }
+
  protected:
     void
     OnCreateTasks(JobTasks& tasks) override;
@@ -59,6 +79,8 @@ class BuildIndexJob : public Job {
     engine::DBOptions options_;
     engine::snapshot::IDS_TYPE segment_ids_;
     engine::snapshot::IDS_TYPE failed_segment_ids_;
+    engine::snapshot::ID_TYPE collection_id_ = 0;
+    std::atomic<bool> cancelled_ = {false};
 };
 
 using BuildIndexJobPtr = std::shared_ptr<BuildIndexJob>;
@@ -45,6 +45,12 @@ Job::CreateTasks() {
     return tasks_;
 }
 
+void
+Job::SetStatus(const Status& status) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    status_ = status;
+}
+
 void
 Job::TaskDone(Task* task) {
     if (task == nullptr) {
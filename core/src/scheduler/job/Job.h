@@ -69,6 +69,10 @@ class Job : public interface::dumpable {
         return status_;
     }
 
+    // tasks of one job run concurrently, they report failures through this setter
+    void
+    SetStatus(const Status& status);
+
  protected:
     explicit Job(JobType type);
 
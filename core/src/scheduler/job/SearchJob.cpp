@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/job/SearchJob.h"
+#include "scheduler/SchedInst.h"
 #include "scheduler/task/SearchTask.h"
 #include "utils/Log.h"
 
@@ -25,6 +26,12 @@ SearchJob::SearchJob(const server::ContextPtr& context, const engine::snapshot::
       options_(options),
       query_ptr_(query_ptr),
       segment_ids_(segment_ids) {
+    // build index is throttled while search jobs are alive
+    CPUBuilderInst::GetInstance()->SearchBegin();
+}
+
+SearchJob::~SearchJob() {
+    CPUBuilderInst::GetInstance()->SearchEnd();
 }
 
 void
@@ -43,6 +43,8 @@ class SearchJob : public Job {
               engine::DBOptions options, const query::QueryPtr& query_ptr,
               const engine::snapshot::IDS_TYPE& segment_ids);
 
+    ~SearchJob();
+
  public:
     json
     Dump() const override;
@@ -77,6 +79,16 @@ class SearchJob : public Job {
         return mutex_;
     }
 
+    void
+    SetQueryTrace(const server::QueryTracePtr& query_trace) {
+        query_trace_ = query_trace;
+    }
+
+    const server::QueryTracePtr&
+    query_trace() const {
+        return query_trace_;
+    }
+
  protected:
     void
     OnCreateTasks(JobTasks& tasks) override;
@@ -89,6 +101,7 @@ class SearchJob : public Job {
     query::QueryPtr query_ptr_;
     engine::QueryResultPtr query_result_;
     engine::snapshot::IDS_TYPE segment_ids_;
+    server::QueryTracePtr query_trace_;
 };
 
 using SearchJobPtr = std::shared_ptr<SearchJob>;
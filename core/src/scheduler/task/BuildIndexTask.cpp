@@ -17,6 +17,7 @@
 
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "metrics/Metrics.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
@@ -31,9 +32,46 @@ BuildIndexTask::BuildIndexTask(const engine::snapshot::ScopedSnapshotT& snapshot
       options_(options),
       segment_id_(segment_id),
       target_fields_(target_fields) {
+    if (snapshot_.Get() != nullptr) {
+        auto segment_commit = snapshot_->GetSegmentCommitBySegmentId(segment_id_);
+        if (segment_commit != nullptr) {
+            row_count_ = segment_commit->GetRowCount();
+        }
+    }
     CreateExecEngine();
 }
 
+std::string
+BuildIndexTask::ProgressString() const {
+    switch (progress_.load()) {
+        case BuildIndexProgress::PENDING:
+            return "pending";
+        case BuildIndexProgress::LOADING:
+            return "loading";
+        case BuildIndexProgress::BUILDING:
+            return "building";
+        case BuildIndexProgress::FINISHED:
+            return "finished";
+        case BuildIndexProgress::FAILED:
+            return "failed";
+        case BuildIndexProgress::CANCELLED:
+            return "cancelled";
+        default:
+            return "unknown";
+    }
+}
+
+bool
+BuildIndexTask::IsCancelled() {
+    auto build_job = static_cast<scheduler::BuildIndexJob*>(job_);
+    if (build_job != nullptr && build_job->IsCancelled()) {
+        progress_ = BuildIndexProgress::CANCELLED;
+        execution_engine_ = nullptr;
+        return true;
+    }
+    return false;
+}
+
 void
 BuildIndexTask::CreateExecEngine() {
     if (execution_engine_ == nullptr) {
@@ -43,6 +81,12 @@ BuildIndexTask::CreateExecEngine() {
 
 Status
 BuildIndexTask::OnLoad(milvus::scheduler::LoadType type, uint8_t device_id) {
+    if (IsCancelled()) {
+        LOG_ENGINE_DEBUG_ << "Build index job cancelled, skip loading segment " << segment_id_;
+        return Status::OK();
+    }
+
+    progress_ = BuildIndexProgress::LOADING;
     TimeRecorder rc("BuildIndexTask::OnLoad");
     Status stat = Status::OK();
     std::string error_msg;
@@ -81,9 +125,10 @@ BuildIndexTask::OnLoad(milvus::scheduler::LoadType type, uint8_t device_id) {
         }
 
         LOG_ENGINE_ERROR_ << s.message();
+        progress_ = BuildIndexProgress::FAILED;
 
         auto build_job = static_cast<scheduler::BuildIndexJob*>(job_);
-        build_job->FailedSegments().push_back(segment_id_);
+        build_job->AddFailedSegment(segment_id_);
 
         return s;
     }
@@ -93,29 +138,42 @@ BuildIndexTask::OnLoad(milvus::scheduler::LoadType type, uint8_t device_id) {
 
 Status
 BuildIndexTask::OnExecute() {
+    if (IsCancelled()) {
+        LOG_ENGINE_DEBUG_ << "Build index job cancelled, skip building segment " << segment_id_;
+        return Status::OK();
+    }
+
     TimeRecorderAuto rc("BuildIndexTask::OnExecute " + std::to_string(segment_id_));
 
     if (execution_engine_ == nullptr) {
+        progress_ = BuildIndexProgress::FAILED;
         return Status(DB_ERROR, "execution engine is null");
     }
 
+    progress_ = BuildIndexProgress::BUILDING;
+    auto start_time = METRICS_NOW_TIME;
     Status status;
     try {
         status = execution_engine_->BuildIndex(gpu_device_id);
     } catch (std::exception& e) {
         status = Status(DB_ERROR, e.what());
     }
+    auto end_time = METRICS_NOW_TIME;
+    auto total_time = METRICS_MICROSECONDS(start_time, end_time);
+    server::Metrics::GetInstance().BuildIndexDurationSecondsHistogramObserve(total_time);
 
     if (!status.ok()) {
         LOG_ENGINE_ERROR_ << "Failed to build index: " << status.ToString();
         execution_engine_ = nullptr;
+        progress_ = BuildIndexProgress::FAILED;
 
         auto build_job = static_cast<scheduler::BuildIndexJob*>(job_);
-        build_job->FailedSegments().push_back(segment_id_);
+        build_job->AddFailedSegment(segment_id_);
 
         return status;
     }
 
+    progress_ = BuildIndexProgress::FINISHED;
     return Status::OK();
 }
 
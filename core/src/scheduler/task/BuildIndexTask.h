@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include "db/engine/ExecutionEngine.h"
@@ -22,6 +23,15 @@
 namespace milvus {
 namespace scheduler {
 
+enum class BuildIndexProgress {
+    PENDING = 0,
+    LOADING,
+    BUILDING,
+    FINISHED,
+    FAILED,
+    CANCELLED,
+};
+
 class BuildIndexTask : public Task {
  public:
     explicit BuildIndexTask(const engine::snapshot::ScopedSnapshotT& snapshot, const engine::DBOptions& options,
@@ -33,10 +43,26 @@ class BuildIndexTask : public Task {
         json ret{
             {"type", type_},
             {"segment_id", segment_id_},
+            {"row_count", row_count_},
+            {"progress", ProgressString()},
         };
         return ret;
     }
 
+    // larger segments are built first
+    int64_t
+    Priority() const {
+        return row_count_;
+    }
+
+    BuildIndexProgress
+    Progress() const {
+        return progress_;
+    }
+
+    std::string
+    ProgressString() const;
+
     Status
     OnLoad(LoadType type, uint8_t device_id) override;
 
@@ -47,6 +73,9 @@ class BuildIndexTask : public Task {
     void
     CreateExecEngine();
 
+    bool
+    IsCancelled();
+
  public:
     engine::snapshot::ScopedSnapshotT snapshot_;
     engine::DBOptions options_;
@@ -61,6 +90,8 @@ class BuildIndexTask : public Task {
 
  private:
     int64_t gpu_device_id = 0;
+    int64_t row_count_ = 0;
+    std::atomic<BuildIndexProgress> progress_ = {BuildIndexProgress::PENDING};
 };
 
 }  // namespace scheduler
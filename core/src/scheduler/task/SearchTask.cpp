@@ -20,7 +20,9 @@
 #include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "db/SnapshotUtils.h"
 #include "db/Utils.h"
 #include "db/engine/ExecutionEngineImpl.h"
 #include "scheduler/SchedInst.h"
@@ -56,11 +58,22 @@ SearchTask::OnLoad(LoadType type, uint8_t device_id) {
     std::string error_msg;
     std::string type_str;
 
+    server::QueryTracePtr query_trace =
+        job_ != nullptr ? static_cast<scheduler::SearchJob*>(job_)->query_trace() : nullptr;
+    if (query_trace != nullptr) {
+        query_trace->EndStage(server::QueryStage::DISPATCH);
+    }
+
     try {
         if (type == LoadType::DISK2CPU) {
+            auto load_begin = server::QueryTrace::Now();
             engine::ExecutionEngineContext context;
             context.query_ptr_ = query_ptr_;
+            context.query_trace_ = query_trace;
             stat = execution_engine_->Load(context);
+            if (query_trace != nullptr) {
+                query_trace->AddSegmentLoad(segment_id_, server::QueryTrace::Now() - load_begin);
+            }
             type_str = "DISK2CPU";
         } else if (type == LoadType::CPU2GPU) {
             stat = execution_engine_->CopyToGpu(device_id);
@@ -89,7 +102,7 @@ SearchTask::OnLoad(LoadType type, uint8_t device_id) {
             s = Status(SERVER_UNEXPECTED_ERROR, error_msg);
         }
 
-        job_->status() = s;
+        job_->SetStatus(s);
         return Status::OK();
     }
 
@@ -115,6 +128,7 @@ SearchTask::OnExecute() {
         engine::ExecutionEngineContext context;
         context.query_ptr_ = query_ptr_;
         context.query_result_ = std::make_shared<engine::QueryResult>();
+        context.query_trace_ = search_job->query_trace();
         STATUS_CHECK(execution_engine_->Search(context));
 
         rc.RecordSection("search done");
@@ -130,18 +144,27 @@ SearchTask::OnExecute() {
             LOG_ENGINE_WARNING_ << LogOut("[%s][%ld] Searching in an empty segment. segment id = %d", "search", 0,
                                           segment_ptr->GetID());
         } else {
+            server::QueryStageTimer reduce_timer(context.query_trace_, server::QueryStage::REDUCE);
             std::unique_lock<std::mutex> lock(search_job->mutex());
             if (!search_job->query_result()) {
                 search_job->query_result() = std::make_shared<engine::QueryResult>();
                 search_job->query_result()->row_num_ = nq;
+                if (vector_param->range_search) {
+                    search_job->query_result()->result_lims_.resize(nq + 1, 0);
+                }
             }
             if (vector_param->metric_type == "IP") {
                 ascending_reduce_ = false;
             }
-            SearchTask::MergeTopkToResultSet(context.query_result_->result_ids_,
-                                             context.query_result_->result_distances_, spec_k, nq, topk,
-                                             ascending_reduce_, search_job->query_result()->result_ids_,
-                                             search_job->query_result()->result_distances_);
+            auto& job_result = search_job->query_result();
+            if (vector_param->range_search) {
+                SearchTask::MergeRangeToResultSet(*context.query_result_, nq, topk, ascending_reduce_, *job_result);
+            } else {
+                SearchTask::MergeTopkToResultSet(
+                    context.query_result_->result_ids_, context.query_result_->result_distances_,
+                    context.query_result_->result_locations_, spec_k, nq, topk, ascending_reduce_,
+                    job_result->result_ids_, job_result->result_distances_, job_result->result_locations_);
+            }
 
             LOG_ENGINE_DEBUG_ << "Merged result: "
                               << "nq = " << nq << ", topk = " << topk
@@ -161,8 +184,9 @@ SearchTask::OnExecute() {
 
 void
 SearchTask::MergeTopkToResultSet(const engine::ResultIds& src_ids, const engine::ResultDistances& src_distances,
-                                 size_t src_k, size_t nq, size_t topk, bool ascending, engine::ResultIds& tar_ids,
-                                 engine::ResultDistances& tar_distances) {
+                                 const engine::ResultLocations& src_locations, size_t src_k, size_t nq, size_t topk,
+                                 bool ascending, engine::ResultIds& tar_ids, engine::ResultDistances& tar_distances,
+                                 engine::ResultLocations& tar_locations) {
     if (src_ids.empty()) {
         LOG_ENGINE_DEBUG_ << LogOut("[%s][%d] Search result is empty.", "search", 0);
         return;
@@ -171,8 +195,12 @@ SearchTask::MergeTopkToResultSet(const engine::ResultIds& src_ids, const engine:
     size_t tar_k = tar_ids.size() / nq;
     size_t buf_k = std::min(topk, src_k + tar_k);
 
+    // locations are optional, only merged when both sides have them
+    bool with_location = (src_locations.size() == src_ids.size()) && (tar_locations.size() == tar_ids.size());
+
     engine::ResultIds buf_ids(nq * buf_k, -1);
     engine::ResultDistances buf_distances(nq * buf_k, 0.0);
+    engine::ResultLocations buf_locations(with_location ? nq * buf_k : 0);
 
     for (uint64_t i = 0; i < nq; i++) {
         size_t buf_k_j = 0, src_k_j = 0, tar_k_j = 0;
@@ -192,10 +220,16 @@ SearchTask::MergeTopkToResultSet(const engine::ResultIds& src_ids, const engine:
                 (!ascending && src_distances[src_idx] > tar_distances[tar_idx])) {
                 buf_ids[buf_idx] = src_ids[src_idx];
                 buf_distances[buf_idx] = src_distances[src_idx];
+                if (with_location) {
+                    buf_locations[buf_idx] = src_locations[src_idx];
+                }
                 src_k_j++;
             } else {
                 buf_ids[buf_idx] = tar_ids[tar_idx];
                 buf_distances[buf_idx] = tar_distances[tar_idx];
+                if (with_location) {
+                    buf_locations[buf_idx] = tar_locations[tar_idx];
+                }
                 tar_k_j++;
             }
             buf_k_j++;
@@ -208,6 +242,9 @@ SearchTask::MergeTopkToResultSet(const engine::ResultIds& src_ids, const engine:
                     src_idx = src_k_multi_i + src_k_j;
                     buf_ids[buf_idx] = src_ids[src_idx];
                     buf_distances[buf_idx] = src_distances[src_idx];
+                    if (with_location) {
+                        buf_locations[buf_idx] = src_locations[src_idx];
+                    }
                     src_k_j++;
                     buf_k_j++;
                 }
@@ -217,6 +254,9 @@ SearchTask::MergeTopkToResultSet(const engine::ResultIds& src_ids, const engine:
                     tar_idx = tar_k_multi_i + tar_k_j;
                     buf_ids[buf_idx] = tar_ids[tar_idx];
                     buf_distances[buf_idx] = tar_distances[tar_idx];
+                    if (with_location) {
+                        buf_locations[buf_idx] = tar_locations[tar_idx];
+                    }
                     tar_k_j++;
                     buf_k_j++;
                 }
@@ -225,6 +265,67 @@ SearchTask::MergeTopkToResultSet(const engine::ResultIds& src_ids, const engine:
     }
     tar_ids.swap(buf_ids);
     tar_distances.swap(buf_distances);
+    tar_locations.swap(buf_locations);
+}
+
+void
+SearchTask::MergeRangeToResultSet(const engine::QueryResult& src, size_t nq, size_t topk, bool ascending,
+                                  engine::QueryResult& tar) {
+    /* both sides hold a variable number of sorted results per query, result_lims_[i] is where query i starts */
+    if (src.result_lims_.size() != nq + 1 || tar.result_lims_.size() != nq + 1) {
+        LOG_ENGINE_DEBUG_ << LogOut("[%s][%d] Range search result is empty.", "search", 0);
+        return;
+    }
+
+    bool with_location = (src.result_locations_.size() == src.result_ids_.size()) &&
+                         (tar.result_locations_.size() == tar.result_ids_.size());
+
+    engine::ResultIds buf_ids;
+    engine::ResultDistances buf_distances;
+    engine::ResultLocations buf_locations;
+    std::vector<int64_t> buf_lims(nq + 1, 0);
+    size_t reserve = std::min(src.result_ids_.size() + tar.result_ids_.size(), nq * topk);
+    buf_ids.reserve(reserve);
+    buf_distances.reserve(reserve);
+    if (with_location) {
+        buf_locations.reserve(reserve);
+    }
+
+    auto take = [&](const engine::QueryResult& from, size_t idx) {
+        buf_ids.push_back(from.result_ids_[idx]);
+        buf_distances.push_back(from.result_distances_[idx]);
+        if (with_location) {
+            buf_locations.push_back(from.result_locations_[idx]);
+        }
+    };
+
+    for (size_t i = 0; i < nq; i++) {
+        size_t src_idx = src.result_lims_[i], src_end = src.result_lims_[i + 1];
+        size_t tar_idx = tar.result_lims_[i], tar_end = tar.result_lims_[i + 1];
+        size_t count = 0;
+        while (count < topk && src_idx < src_end && tar_idx < tar_end) {
+            float src_dis = src.result_distances_[src_idx];
+            float tar_dis = tar.result_distances_[tar_idx];
+            if ((ascending && src_dis < tar_dis) || (!ascending && src_dis > tar_dis)) {
+                take(src, src_idx++);
+            } else {
+                take(tar, tar_idx++);
+            }
+            count++;
+        }
+        for (; count < topk && src_idx < src_end; count++) {
+            take(src, src_idx++);
+        }
+        for (; count < topk && tar_idx < tar_end; count++) {
+            take(tar, tar_idx++);
+        }
+        buf_lims[i + 1] = buf_ids.size();
+    }
+
+    tar.result_ids_.swap(buf_ids);
+    tar.result_distances_.swap(buf_distances);
+    tar.result_locations_.swap(buf_locations);
+    tar.result_lims_.swap(buf_lims);
 }
 
 int64_t
@@ -280,7 +381,7 @@ SearchTask::IndexType() {
             if (!field_visitor) {
                 continue;
             }
-            if (type == engine::DataType::VECTOR_FLOAT || type == engine::DataType::VECTOR_BINARY) {
+            if (engine::IsVectorField(type)) {
                 auto fe_visitor = field_visitor->GetElementVisitor(engine::FieldElementType::FET_INDEX);
                 if (fe_visitor) {
                     auto element = fe_visitor->GetElement();
@@ -46,9 +46,14 @@ class SearchTask : public Task {
     OnExecute() override;
 
     static void
-    MergeTopkToResultSet(const engine::ResultIds& src_ids, const engine::ResultDistances& src_distances, size_t src_k,
-                         size_t nq, size_t topk, bool ascending, engine::ResultIds& tar_ids,
-                         engine::ResultDistances& tar_distances);
+    MergeTopkToResultSet(const engine::ResultIds& src_ids, const engine::ResultDistances& src_distances,
+                         const engine::ResultLocations& src_locations, size_t src_k, size_t nq, size_t topk,
+                         bool ascending, engine::ResultIds& tar_ids, engine::ResultDistances& tar_distances,
+                         engine::ResultLocations& tar_locations);
+
+    static void
+    MergeRangeToResultSet(const engine::QueryResult& src, size_t nq, size_t topk, bool ascending,
+                          engine::QueryResult& tar);
 
     int64_t
     nq();
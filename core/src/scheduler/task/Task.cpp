@@ -23,7 +23,7 @@ Task::Load(LoadType type, uint8_t device_id) {
 
     if (job_) {
         if (!status.ok()) {
-            job_->status() = status;
+            job_->SetStatus(status);
             //            job_->TaskDone(this);
         }
     } else {
@@ -37,7 +37,7 @@ Task::Execute() {
 
     if (job_) {
         if (!status.ok()) {
-            job_->status() = status;
+            job_->SetStatus(status);
         }
         job_->TaskDone(this);
     } else {
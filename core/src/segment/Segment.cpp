@@ -114,6 +114,8 @@ Segment::AddField(const snapshot::FieldPtr& field) {
         int64_t dimension = params[knowhere::meta::DIM];
         if (ftype == DataType::VECTOR_BINARY) {
             field_width += (dimension / 8);
+        } else if (ftype == DataType::VECTOR_FLOAT16) {
+            field_width += (dimension * sizeof(uint16_t));
         } else {
             field_width += (dimension * sizeof(float));
         }
@@ -155,6 +157,7 @@ Segment::AddField(const std::string& field_name, DataType field_type, int64_t fi
             real_field_width = sizeof(uint64_t);
             break;
         case DataType::VECTOR_FLOAT:
+        case DataType::VECTOR_FLOAT16:
         case DataType::VECTOR_BINARY: {
             if (field_width <= 0) {
                 std::string msg = "vecor field dimension required: " + field_name;
@@ -216,33 +219,28 @@ Segment::AddChunk(const DataChunkPtr& chunk_ptr, int64_t from, int64_t to) {
 Status
 Segment::Reserve(const std::vector<std::string>& field_names, int64_t count) {
     if (count <= 0) {
-        return Status(DB_ERROR, "Invalid input fot segment resize");
+        return Status(DB_ERROR, "Invalid input fot segment reserve");
     }
 
+    auto reserve = [&](const std::string& name, int64_t width) {
+        auto& data = fixed_fields_[name];
+        if (data == nullptr) {
+            data = std::make_shared<BinaryData>();
+        }
+        data->data_.reserve(count * width);
+    };
+
     if (field_names.empty()) {
         for (auto& width_iter : fixed_fields_width_) {
-            int64_t resize_bytes = count * width_iter.second;
-
-            auto& data = fixed_fields_[width_iter.first];
-            if (data == nullptr) {
-                data = std::make_shared<BinaryData>();
-            }
-            data->data_.resize(resize_bytes);
+            reserve(width_iter.first, width_iter.second);
         }
     } else {
         for (const auto& name : field_names) {
             auto iter_width = fixed_fields_width_.find(name);
             if (iter_width == fixed_fields_width_.end()) {
-                return Status(DB_ERROR, "Invalid input fot segment resize");
-            }
-
-            int64_t resize_bytes = count * iter_width->second;
-
-            auto& data = fixed_fields_[name];
-            if (data == nullptr) {
-                data = std::make_shared<BinaryData>();
+                return Status(DB_ERROR, "Invalid input fot segment reserve");
             }
-            data->data_.resize(resize_bytes);
+            reserve(name, iter_width->second);
         }
     }
 
@@ -266,29 +264,33 @@ Segment::AppendChunk(const DataChunkPtr& chunk_ptr, int64_t from, int64_t to) {
         }
         auto& data = fixed_fields_[width_iter.first];
         if (data == nullptr) {
-            fixed_fields_[width_iter.first] = input->second;
-            continue;
+            if (row_count_ == 0 && from == 0 && add_count == chunk_ptr->count_) {
+                // the whole chunk is appended into an empty field, share it without copy
+                data = input->second;
+                continue;
+            }
+            data = std::make_shared<BinaryData>();
         }
 
-        size_t origin_bytes = data->data_.size();
+        auto& bytes = data->data_;
+        size_t origin_bytes = bytes.size();
         int64_t add_bytes = add_count * width_iter.second;
         int64_t previous_bytes = row_count_ * width_iter.second;
         int64_t target_bytes = previous_bytes + add_bytes;
-        if (data->data_.size() < target_bytes) {
-            data->data_.resize(target_bytes);
+        if (bytes.capacity() < target_bytes) {
+            // grow geometrically, call Reserve() before appending to avoid reallocation
+            bytes.reserve(std::max<size_t>(target_bytes, bytes.capacity() * 2));
         }
-        if (input == chunk_ptr->fixed_fields_.end()) {
-            // this field is not provided, complicate by 0
-            memset(data->data_.data() + origin_bytes, 0, target_bytes - origin_bytes);
-        } else {
-            // complicate by 0
-            if (origin_bytes < previous_bytes) {
-                memset(data->data_.data() + origin_bytes, 0, previous_bytes - origin_bytes);
-            }
-            // copy input into this field
-            memcpy(data->data_.data() + previous_bytes, input->second->data_.data() + from * width_iter.second,
-                   add_bytes);
+
+        // complicate by 0
+        if (origin_bytes < previous_bytes) {
+            bytes.resize(previous_bytes, 0);
+        } else if (origin_bytes > previous_bytes) {
+            bytes.resize(previous_bytes);
         }
+        // copy input into this field
+        const uint8_t* src = input->second->data_.data() + from * width_iter.second;
+        bytes.insert(bytes.end(), src, src + add_bytes);
     }
 
     row_count_ += add_count;
@@ -60,8 +60,9 @@ class Segment {
     Status
     AddChunk(const DataChunkPtr& chunk_ptr, int64_t from, int64_t to);
 
-    // reserve chunk data capacity to specify count
-    // this method should only be used on an empty segment
+    // reserve chunk data capacity to specify count, the row count is not changed
+    // if the total row count is known, call this method before appending to avoid reallocation and copy
+    // empty field_names means all fields
     Status
     Reserve(const std::vector<std::string>& field_names, int64_t count);
 
@@ -17,15 +17,18 @@
 
 #include "segment/SegmentReader.h"
 
+#include <faiss/FaissHook.h>
 #include <experimental/filesystem>
 #include <memory>
 
 #include "cache/CpuCacheMgr.h"
 #include "codecs/Codec.h"
+#include "config/ServerConfig.h"
 #include "db/SnapshotUtils.h"
 #include "db/Types.h"
 #include "db/Utils.h"
 #include "db/snapshot/ResourceHelper.h"
+#include "knowhere/index/vector_index/IndexIDMAP_FP16.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 #include "knowhere/index/vector_index/VecIndexFactory.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -76,6 +79,8 @@ SegmentReader::Initialize() {
             int64_t dimension = params[knowhere::meta::DIM];
             if (ftype == engine::DataType::VECTOR_BINARY) {
                 field_width = (dimension / 8);
+            } else if (ftype == engine::DataType::VECTOR_FLOAT16) {
+                field_width = (dimension * sizeof(uint16_t));
             } else {
                 field_width = (dimension * sizeof(float));
             }
@@ -183,7 +188,31 @@ SegmentReader::LoadEntities(const std::string& field_name, const std::vector<int
             return Status(DB_ERROR, "Invalid field width");
         }
 
+        // if the field data is loaded or in cache, copy entities from memory
+        engine::BinaryDataPtr field_data;
+        segment_ptr_->GetFixedFieldData(field_name, field_data);
+        if (field_data == nullptr) {
+            auto data_obj = cache::CpuCacheMgr::GetInstance().GetItem(file_path);
+            if (data_obj != nullptr) {
+                field_data = std::static_pointer_cast<engine::BinaryData>(data_obj);
+            }
+        }
+        if (field_data != nullptr) {
+            raw = std::make_shared<engine::BinaryData>();
+            raw->data_.resize(offsets.size() * field_width);
+            int64_t field_rows = field_data->Size() / field_width;
+            for (size_t i = 0; i < offsets.size(); ++i) {
+                if (offsets[i] < 0 || offsets[i] >= field_rows) {
+                    return Status(DB_ERROR, "Invalid entity offset: " + std::to_string(offsets[i]));
+                }
+                memcpy(raw->data_.data() + i * field_width, field_data->data_.data() + offsets[i] * field_width,
+                       field_width);
+            }
+            return Status::OK();
+        }
+
         codec::ReadRanges ranges;
+        ranges.reserve(offsets.size());
         for (auto offset : offsets) {
             ranges.push_back(codec::ReadRange(offset * field_width, field_width));
         }
@@ -214,10 +243,7 @@ SegmentReader::LoadFieldsEntities(const std::vector<std::string>& fields_name, c
 
         auto& target_data = data_chunk->fixed_fields_[name];
         if (target_data != nullptr) {
-            auto chunk_size = target_data->Size();
-            auto raw_data_size = raw_data->Size();
-            target_data->data_.resize(chunk_size + raw_data_size);
-            memcpy(target_data->data_.data() + chunk_size, raw_data->data_.data(), raw_data_size);
+            target_data->data_.insert(target_data->data_.end(), raw_data->data_.begin(), raw_data->data_.end());
         } else {
             data_chunk->fixed_fields_[name] = raw_data;
         }
@@ -314,6 +340,9 @@ SegmentReader::LoadVectorIndex(const std::string& field_name, knowhere::VecIndex
                 if (field->GetFtype() == engine::DataType::VECTOR_FLOAT) {
                     index_ptr = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IDMAP,
                                                                  knowhere::IndexMode::MODE_CPU);
+                } else if (field->GetFtype() == engine::DataType::VECTOR_FLOAT16) {
+                    // half precision vectors are searched as they are stored
+                    index_ptr = std::make_shared<knowhere::IDMAP_FP16>();
                 } else {
                     index_ptr = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP,
                                                                  knowhere::IndexMode::MODE_CPU);
@@ -347,9 +376,16 @@ SegmentReader::LoadVectorIndex(const std::string& field_name, knowhere::VecIndex
         STATUS_CHECK(ss_codec.GetVectorIndexFormat()->ReadIndex(fs_ptr_, index_file_path, index_data));
         recorder.RecordSection("read index file: " + index_file_path);
 
-        // for some kinds index(IVF), read raw file
+        // in ivf disk mode, raw vectors of IVF_FLAT are kept in a list file beside the index file,
+        // the raw file is only read to create the list file
         auto index_type = index_visitor->GetElement()->GetTypeName();
-        if (engine::utils::RequireRawFile(index_type)) {
+        bool list_file_mode =
+            config.engine.ivf_disk_mode() && index_type == knowhere::IndexEnum::INDEX_FAISS_IVFFLAT;
+        std::string list_file_path = index_file_path + codec::VectorIndexFormat::ListFilePostfix();
+        bool list_file_exist = list_file_mode && std::experimental::filesystem::exists(list_file_path);
+
+        // for some kinds index(IVF), read raw file
+        if (engine::utils::RequireRawFile(index_type) && !list_file_exist) {
             engine::BinaryDataPtr fixed_data;
             auto status = segment_ptr_->GetFixedFieldData(field_name, fixed_data);
             if (status.ok()) {
@@ -363,6 +399,16 @@ SegmentReader::LoadVectorIndex(const std::string& field_name, knowhere::VecIndex
             }
         }
 
+        // indexes are loaded with float vectors, decode half precision raw data
+        if (raw_data != nullptr && field->GetFtype() == engine::DataType::VECTOR_FLOAT16) {
+            auto decoded = std::make_shared<knowhere::Binary>();
+            decoded->size = raw_data->size / sizeof(uint16_t) * sizeof(float);
+            decoded->data = std::shared_ptr<uint8_t[]>(new uint8_t[decoded->size], std::default_delete<uint8_t[]>());
+            faiss::fp16_to_fvec(reinterpret_cast<const uint16_t*>(raw_data->data.get()),
+                                reinterpret_cast<float*>(decoded->data.get()), raw_data->size / sizeof(uint16_t));
+            raw_data = decoded;
+        }
+
         // for some kinds index(RHNSWSQ), read compress file
         if (engine::utils::RequireCompressFile(index_type)) {
             if (auto visitor = field_visitor->GetElementVisitor(engine::FieldElementType::FET_COMPRESS)) {
@@ -374,8 +420,13 @@ SegmentReader::LoadVectorIndex(const std::string& field_name, knowhere::VecIndex
             }
         }
 
-        STATUS_CHECK(ss_codec.GetVectorIndexFormat()->ConstructIndex(index_type, index_data, raw_data, compress_data,
-                                                                     index_ptr));
+        if (list_file_mode) {
+            STATUS_CHECK(ss_codec.GetVectorIndexFormat()->ConstructListFileIndex(fs_ptr_, index_type, index_data,
+                                                                                 raw_data, list_file_path, index_ptr));
+        } else {
+            STATUS_CHECK(ss_codec.GetVectorIndexFormat()->ConstructIndex(index_type, index_data, raw_data,
+                                                                         compress_data, index_ptr));
+        }
 
         index_ptr->SetUids(uids);
         index_ptr->SetBlacklist(concurrent_bitset_ptr);
@@ -391,6 +442,57 @@ SegmentReader::LoadVectorIndex(const std::string& field_name, knowhere::VecIndex
     return Status::OK();
 }
 
+Status
+SegmentReader::ReadVectorIndex(const std::string& field_name, knowhere::VecIndexPtr& index_ptr) {
+    try {
+        TimeRecorder recorder("SegmentReader::ReadVectorIndex: " + field_name);
+
+        auto field_visitor = segment_visitor_->GetFieldVisitor(field_name);
+        if (field_visitor == nullptr) {
+            return Status(DB_ERROR, "Invalid field name: " + field_name);
+        }
+
+        auto index_visitor = field_visitor->GetElementVisitor(engine::FieldElementType::FET_INDEX);
+        if (index_visitor == nullptr || index_visitor->GetFile() == nullptr) {
+            return Status(DB_ERROR, "Index file of field " + field_name + " not exist");
+        }
+
+        auto index_type = index_visitor->GetElement()->GetTypeName();
+        if (engine::utils::RequireCompressFile(index_type)) {
+            return Status(DB_ERROR, "Could not read index type without compress data: " + index_type);
+        }
+
+        auto& ss_codec = codec::Codec::instance();
+        knowhere::BinarySet index_data;
+        knowhere::BinaryPtr raw_data, compress_data;
+        std::string index_file_path =
+            engine::snapshot::GetResPath<engine::snapshot::SegmentFile>(dir_collections_, index_visitor->GetFile());
+        STATUS_CHECK(ss_codec.GetVectorIndexFormat()->ReadIndex(fs_ptr_, index_file_path, index_data));
+        recorder.RecordSection("read index file: " + index_file_path);
+
+        if (engine::utils::RequireRawFile(index_type)) {
+            engine::BinaryDataPtr fixed_data;
+            auto status = segment_ptr_->GetFixedFieldData(field_name, fixed_data);
+            if (status.ok()) {
+                STATUS_CHECK(ss_codec.GetVectorIndexFormat()->ConvertRaw(fixed_data, raw_data));
+            } else if (auto visitor = field_visitor->GetElementVisitor(engine::FieldElementType::FET_RAW)) {
+                auto file_path =
+                    engine::snapshot::GetResPath<engine::snapshot::SegmentFile>(dir_collections_, visitor->GetFile());
+                STATUS_CHECK(ss_codec.GetVectorIndexFormat()->ReadRaw(fs_ptr_, file_path, raw_data));
+            }
+        }
+
+        STATUS_CHECK(ss_codec.GetVectorIndexFormat()->ConstructIndex(index_type, index_data, raw_data, compress_data,
+                                                                     index_ptr));
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to read vector index: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+
+    return Status::OK();
+}
+
 Status
 SegmentReader::LoadStructuredIndex(const std::string& field_name, knowhere::IndexPtr& index_ptr) {
     try {
@@ -56,6 +56,11 @@ class SegmentReader {
     Status
     LoadVectorIndex(const std::string& field_name, knowhere::VecIndexPtr& index_ptr, bool flat = false);
 
+    // read vector index file into a new index object, the cache is not touched,
+    // so the caller is free to modify the returned index
+    Status
+    ReadVectorIndex(const std::string& field_name, knowhere::VecIndexPtr& index_ptr);
+
     Status
     LoadStructuredIndex(const std::string& field_name, knowhere::IndexPtr& index_ptr);
 
@@ -75,6 +75,11 @@ SegmentWriter::AddChunk(const engine::DataChunkPtr& chunk_ptr, int64_t from, int
     return segment_ptr_->AddChunk(chunk_ptr, from, to);
 }
 
+Status
+SegmentWriter::Reserve(int64_t count) {
+    return segment_ptr_->Reserve({}, count);
+}
+
 Status
 SegmentWriter::Serialize() {
     // write fields raw data
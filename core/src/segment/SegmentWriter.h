@@ -42,6 +42,10 @@ class SegmentWriter {
     Status
     AddChunk(const engine::DataChunkPtr& chunk_ptr, int64_t from, int64_t to);
 
+    // reserve capacity for all fields before adding chunks, count is the expected total row count
+    Status
+    Reserve(int64_t count);
+
     Status
     WriteBloomFilter(const std::string& file_path, const IdBloomFilterPtr& bloom_filter_ptr);
 
@@ -14,6 +14,7 @@
 #include <omp.h>
 #include <cmath>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "config/ServerConfig.h"
@@ -41,6 +42,9 @@ DBWrapper::StartService() {
     opt.auto_flush_interval_ = config.storage.auto_flush_interval();
     opt.metric_enable_ = config.metric.enable();
     opt.insert_buffer_size_ = config.cache.insert_buffer_size();
+    opt.preload_concurrency_ = config.cache.preload_concurrency();
+    opt.warm_set_enable_ = config.cache.warm_set.enable();
+    opt.warm_set_interval_ = config.cache.warm_set.interval();
 
     if (not config.cluster.enable()) {
         opt.mode_ = engine::DBOptions::MODE::SINGLE;
@@ -99,6 +103,11 @@ DBWrapper::StopService() {
         db_->Stop();
     }
 
+    // preload stops loading once the db is stopped
+    if (preload_thread_.joinable()) {
+        preload_thread_.join();
+    }
+
     // SS TODO
     /* engine::snapshot::OperationExecutor::GetInstance().Stop(); */
     return Status::OK();
@@ -106,35 +115,31 @@ DBWrapper::StopService() {
 
 Status
 DBWrapper::PreloadCollections(const std::string& preload_collections) {
+    std::vector<std::string> collection_names;
     if (preload_collections.empty()) {
-        // do nothing
+        return Status::OK();
     } else if (preload_collections == "*") {
         // load all collections
-        std::vector<std::string> names;
-        auto status = db_->ListCollections(names);
-        if (!status.ok()) {
-            return status;
-        }
-
-        for (auto& name : names) {
-            std::vector<std::string> field_names;  // input empty field names will load all fileds
-            auto status = db_->LoadCollection(nullptr, name, field_names);
-            if (!status.ok()) {
-                return status;
-            }
-        }
+        STATUS_CHECK(db_->ListCollections(collection_names));
     } else {
-        std::vector<std::string> collection_names;
         StringHelpFunctions::SplitStringByDelimeter(preload_collections, ",", collection_names);
         for (auto& name : collection_names) {
-            std::vector<std::string> field_names;  // input empty field names will load all fileds
-            auto status = db_->LoadCollection(nullptr, name, field_names);
-            if (!status.ok()) {
-                return status;
+            bool has_collection = false;
+            STATUS_CHECK(db_->HasCollection(name, has_collection));
+            if (!has_collection) {
+                return Status(DB_NOT_FOUND, "Collection to preload does not exist: " + name);
             }
         }
     }
 
+    // segments are loaded in background, the server serves requests meanwhile and reports progress by cmd status
+    preload_thread_ = std::thread([this, collection_names]() {
+        auto status = db_->PreloadCollections(nullptr, collection_names);
+        if (!status.ok()) {
+            LOG_SERVER_ERROR_ << "Failed to preload collections: " << status.message();
+        }
+    });
+
     return Status::OK();
 }
 
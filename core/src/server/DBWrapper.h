@@ -12,6 +12,7 @@
 #pragma once
 
 #include <string>
+#include <thread>
 
 #include "db/DB.h"
 #include "utils/Status.h"
@@ -52,6 +53,7 @@ class DBWrapper {
 
  private:
     engine::DBPtr db_;
+    std::thread preload_thread_;
 };
 
 }  // namespace server
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 namespace milvus {
@@ -22,6 +23,12 @@ class ConnectionContext {
     }
     virtual bool
     IsConnectionBroken() const = 0;
+
+    // deadline set by the client, time_point::max() if there is none
+    virtual std::chrono::system_clock::time_point
+    Deadline() const {
+        return std::chrono::system_clock::time_point::max();
+    }
 };
 
 using ConnectionContextPtr = std::shared_ptr<ConnectionContext>;
@@ -32,6 +32,7 @@ std::shared_ptr<Context>
 Context::Child(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(req_id_);
     new_context->SetTraceContext(trace_context_->Child(operation_name));
+    new_context->SetQueryTrace(query_trace_);
     return new_context;
 }
 
@@ -39,6 +40,7 @@ std::shared_ptr<Context>
 Context::Follower(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(req_id_);
     new_context->SetTraceContext(trace_context_->Follower(operation_name));
+    new_context->SetQueryTrace(query_trace_);
     return new_context;
 }
 
@@ -56,6 +58,15 @@ Context::IsConnectionBroken() const {
     return context_->IsConnectionBroken();
 }
 
+std::chrono::system_clock::time_point
+Context::Deadline() const {
+    if (context_ == nullptr) {
+        return std::chrono::system_clock::time_point::max();
+    }
+
+    return context_->Deadline();
+}
+
 ReqType
 Context::GetReqType() const {
     return req_type_;
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -18,6 +19,7 @@
 #include <grpcpp/server_context.h>
 
 #include "server/context/ConnectionContext.h"
+#include "server/context/QueryTrace.h"
 #include "server/delivery/request/Types.h"
 #include "tracing/TraceContext.h"
 
@@ -51,17 +53,31 @@ class Context {
     bool
     IsConnectionBroken() const;
 
+    std::chrono::system_clock::time_point
+    Deadline() const;
+
     ReqType
     GetReqType() const;
 
     void
     SetReqType(ReqType type);
 
+    void
+    SetQueryTrace(const QueryTracePtr& query_trace) {
+        query_trace_ = query_trace;
+    }
+
+    const QueryTracePtr&
+    GetQueryTrace() const {
+        return query_trace_;
+    }
+
  private:
     std::string req_id_;
     ReqType req_type_;
     tracing::TraceContextPtr trace_context_;
     ConnectionContextPtr context_;
+    QueryTracePtr query_trace_;
 };
 
 using ContextPtr = std::shared_ptr<milvus::server::Context>;
@@ -0,0 +1,61 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/context/QueryTrace.h"
+
+#include <memory>
+#include <string>
+
+#include "config/ServerConfig.h"
+#include "metrics/Metrics.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace server {
+
+namespace {
+constexpr size_t SLOW_QUERY_SEGMENT_NUM = 5;
+}  // namespace
+
+QueryTracePtr
+QueryTrace::Create() {
+    if (!config.metric.enable() && !config.logs.slow_query.enable()) {
+        return nullptr;
+    }
+    return std::make_shared<QueryTrace>();
+}
+
+void
+QueryTrace::Finish(const std::string& req_id, const std::string& collection_name) {
+    auto total_us = ElapsedUs();
+
+    if (config.metric.enable()) {
+        auto& metrics = Metrics::GetInstance();
+        for (int32_t i = 0; i < QUERY_STAGE_NUM; ++i) {
+            auto stage = static_cast<QueryStage>(i);
+            metrics.QueryStageHistogramObserve(QueryStageName(stage), StageUs(stage));
+        }
+    }
+
+    if (config.logs.slow_query.enable() && total_us >= config.logs.slow_query.threshold() * 1000) {
+        std::string segment_loads;
+        for (auto& load : SlowestSegmentLoads(SLOW_QUERY_SEGMENT_NUM)) {
+            segment_loads += (segment_loads.empty() ? "" : ", ") + std::to_string(load.first) + "=" +
+                             std::to_string(load.second) + "us";
+        }
+        LOG_SERVER_WARNING_ << "[slow query][" << req_id << "] collection: " << collection_name
+                            << ", total=" << total_us << "us, " << Breakdown() << ", slowest segment loads: ["
+                            << segment_loads << "]";
+    }
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,171 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+enum class QueryStage {
+    QUEUE_WAIT = 0,
+    DISPATCH,
+    SEGMENT_LOAD,
+    SCALAR_FILTER,
+    VECTOR_SEARCH,
+    REDUCE,
+    FIELD_FETCH,
+    STAGE_NUM,
+};
+
+constexpr int32_t QUERY_STAGE_NUM = static_cast<int32_t>(QueryStage::STAGE_NUM);
+
+inline const char*
+QueryStageName(QueryStage stage) {
+    static const char* names[QUERY_STAGE_NUM] = {
+        "queue_wait", "dispatch", "segment_load", "scalar_filter", "vector_search", "reduce", "field_fetch",
+    };
+    return names[static_cast<int32_t>(stage)];
+}
+
+// Per query stage timings, shared by the request and all the tasks of its search job.
+// Segment stages run on many threads at once, so their durations are summed over segments.
+// Everything here is inline since the engine records stages too and must not link against the server.
+class QueryTrace {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    QueryTrace() : begin_(Now()) {
+        for (auto& us : stage_us_) {
+            us = 0;
+        }
+        for (auto& us : stage_begin_us_) {
+            us = -1;
+        }
+    }
+
+    static int64_t
+    Now() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    // for stages which begin on one thread and end on another, only the first EndStage() counts
+    void
+    BeginStage(QueryStage stage) {
+        stage_begin_us_[static_cast<int32_t>(stage)] = Now();
+    }
+
+    void
+    EndStage(QueryStage stage) {
+        auto begin = stage_begin_us_[static_cast<int32_t>(stage)].exchange(-1);
+        if (begin >= 0) {
+            AddStage(stage, Now() - begin);
+        }
+    }
+
+    void
+    AddStage(QueryStage stage, int64_t us) {
+        stage_us_[static_cast<int32_t>(stage)].fetch_add(us, std::memory_order_relaxed);
+    }
+
+    // load time of one segment, counted in the segment_load stage, the slowest segments are named in the slow
+    // query log
+    void
+    AddSegmentLoad(int64_t segment_id, int64_t us) {
+        AddStage(QueryStage::SEGMENT_LOAD, us);
+        std::lock_guard<std::mutex> lock(segment_mutex_);
+        segment_load_us_.emplace_back(segment_id, us);
+    }
+
+    // pairs of segment id and load time, the slowest first
+    std::vector<std::pair<int64_t, int64_t>>
+    SlowestSegmentLoads(size_t n) const {
+        std::vector<std::pair<int64_t, int64_t>> loads;
+        {
+            std::lock_guard<std::mutex> lock(segment_mutex_);
+            loads = segment_load_us_;
+        }
+        auto slower = [](const std::pair<int64_t, int64_t>& a, const std::pair<int64_t, int64_t>& b) {
+            return a.second > b.second;
+        };
+        n = std::min(n, loads.size());
+        std::partial_sort(loads.begin(), loads.begin() + n, loads.end(), slower);
+        loads.resize(n);
+        return loads;
+    }
+
+    int64_t
+    StageUs(QueryStage stage) const {
+        return stage_us_[static_cast<int32_t>(stage)].load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    ElapsedUs() const {
+        return Now() - begin_;
+    }
+
+    std::string
+    Breakdown() const {
+        std::string str;
+        for (int32_t i = 0; i < QUERY_STAGE_NUM; ++i) {
+            auto stage = static_cast<QueryStage>(i);
+            str += std::string(i == 0 ? "" : ", ") + QueryStageName(stage) + "=" + std::to_string(StageUs(stage)) + "us";
+        }
+        return str;
+    }
+
+    // observe stage histograms and write the slow query log, called once the request is done
+    void
+    Finish(const std::string& req_id, const std::string& collection_name);
+
+    // null when neither metric nor slow query log is enabled, callers skip all timing then
+    static std::shared_ptr<QueryTrace>
+    Create();
+
+ private:
+    int64_t begin_;
+    std::atomic<int64_t> stage_us_[QUERY_STAGE_NUM];
+    std::atomic<int64_t> stage_begin_us_[QUERY_STAGE_NUM];
+    mutable std::mutex segment_mutex_;
+    std::vector<std::pair<int64_t, int64_t>> segment_load_us_;
+};
+
+using QueryTracePtr = std::shared_ptr<QueryTrace>;
+
+class QueryStageTimer {
+ public:
+    QueryStageTimer(const QueryTracePtr& trace, QueryStage stage)
+        : trace_(trace.get()), stage_(stage), begin_(trace_ ? QueryTrace::Now() : 0) {
+    }
+
+    ~QueryStageTimer() {
+        if (trace_) {
+            trace_->AddStage(stage_, QueryTrace::Now() - begin_);
+        }
+    }
+
+ private:
+    QueryTrace* trace_;
+    QueryStage stage_;
+    int64_t begin_;
+};
+
+}  // namespace server
+}  // namespace milvus
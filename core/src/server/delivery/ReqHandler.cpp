@@ -15,6 +15,7 @@
 
 #include "server/delivery/ReqScheduler.h"
 #include "server/delivery/request/BaseReq.h"
+#include "server/delivery/request/BulkImportReq.h"
 #include "server/delivery/request/CmdReq.h"
 #include "server/delivery/request/CompactReq.h"
 #include "server/delivery/request/CountEntitiesReq.h"
@@ -156,6 +157,14 @@ ReqHandler::Insert(const ContextPtr& context, const std::string& collection_name
     return req_ptr->status();
 }
 
+void
+ReqHandler::Insert(const ContextPtr& context, const std::string& collection_name, const std::string& partition_name,
+                   const int64_t& row_count, std::unordered_map<std::string, std::vector<uint8_t>>& chunk_data,
+                   const ReqCallback& callback) {
+    BaseReqPtr req_ptr = InsertReq::Create(context, collection_name, partition_name, row_count, chunk_data);
+    ReqScheduler::ExecReq(req_ptr, callback);
+}
+
 Status
 ReqHandler::GetEntityByID(const ContextPtr& context, const std::string& collection_name, const engine::IDNumbers& ids,
                           std::vector<std::string>& field_names, std::vector<bool>& valid_row,
@@ -166,6 +175,16 @@ ReqHandler::GetEntityByID(const ContextPtr& context, const std::string& collecti
     return req_ptr->status();
 }
 
+void
+ReqHandler::GetEntityByID(const ContextPtr& context, const std::string& collection_name, const engine::IDNumbers& ids,
+                          std::vector<std::string>& field_names, std::vector<bool>& valid_row,
+                          engine::snapshot::FieldElementMappings& field_mappings, engine::DataChunkPtr& data_chunk,
+                          const ReqCallback& callback) {
+    BaseReqPtr req_ptr =
+        GetEntityByIDReq::Create(context, collection_name, ids, field_names, valid_row, field_mappings, data_chunk);
+    ReqScheduler::ExecReq(req_ptr, callback);
+}
+
 Status
 ReqHandler::DeleteEntityByID(const ContextPtr& context, const std::string& collection_name,
                              const engine::IDNumbers& ids) {
@@ -182,6 +201,14 @@ ReqHandler::Search(const ContextPtr& context, const query::QueryPtr& query_ptr,
     return req_ptr->status();
 }
 
+void
+ReqHandler::Search(const ContextPtr& context, const query::QueryPtr& query_ptr, const milvus::json& json_params,
+                   engine::snapshot::FieldElementMappings& collection_mappings, engine::QueryResultPtr& result,
+                   const ReqCallback& callback) {
+    BaseReqPtr req_ptr = SearchReq::Create(context, query_ptr, json_params, collection_mappings, result);
+    ReqScheduler::ExecReq(req_ptr, callback);
+}
+
 Status
 ReqHandler::ListIDInSegment(const ContextPtr& context, const std::string& collection_name, int64_t segment_id,
                             engine::IDNumbers& ids) {
@@ -211,6 +238,14 @@ ReqHandler::Compact(const ContextPtr& context, const std::string& collection_nam
     return req_ptr->status();
 }
 
+Status
+ReqHandler::BulkImport(const ContextPtr& context, const std::string& collection_name,
+                       const std::string& partition_name, const std::string& path, int64_t& row_count) {
+    BaseReqPtr req_ptr = BulkImportReq::Create(context, collection_name, partition_name, path, row_count);
+    ReqScheduler::ExecReq(req_ptr);
+    return req_ptr->status();
+}
+
 Status
 ReqHandler::Cmd(const ContextPtr& context, const std::string& cmd, std::string& reply) {
     BaseReqPtr req_ptr = CmdReq::Create(context, cmd, reply);
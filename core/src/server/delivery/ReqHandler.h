@@ -82,11 +82,23 @@ class ReqHandler {
     Insert(const ContextPtr& context, const std::string& collection_name, const std::string& partition_name,
            const int64_t& row_count, std::unordered_map<std::string, std::vector<uint8_t>>& chunk_data);
 
+    // the async versions return immediately, output arguments must stay alive until the callback is invoked
+    void
+    Insert(const ContextPtr& context, const std::string& collection_name, const std::string& partition_name,
+           const int64_t& row_count, std::unordered_map<std::string, std::vector<uint8_t>>& chunk_data,
+           const ReqCallback& callback);
+
     Status
     GetEntityByID(const ContextPtr& context, const std::string& collection_name, const engine::IDNumbers& ids,
                   std::vector<std::string>& field_names, std::vector<bool>& valid_row,
                   engine::snapshot::FieldElementMappings& field_mappings, engine::DataChunkPtr& data_chunk);
 
+    void
+    GetEntityByID(const ContextPtr& context, const std::string& collection_name, const engine::IDNumbers& ids,
+                  std::vector<std::string>& field_names, std::vector<bool>& valid_row,
+                  engine::snapshot::FieldElementMappings& field_mappings, engine::DataChunkPtr& data_chunk,
+                  const ReqCallback& callback);
+
     Status
     DeleteEntityByID(const ContextPtr& context, const std::string& collection_name, const engine::IDNumbers& ids);
 
@@ -94,6 +106,11 @@ class ReqHandler {
     Search(const ContextPtr& context, const query::QueryPtr& query_ptr, const milvus::json& json_params,
            engine::snapshot::FieldElementMappings& collection_mappings, engine::QueryResultPtr& result);
 
+    void
+    Search(const ContextPtr& context, const query::QueryPtr& query_ptr, const milvus::json& json_params,
+           engine::snapshot::FieldElementMappings& collection_mappings, engine::QueryResultPtr& result,
+           const ReqCallback& callback);
+
     Status
     ListIDInSegment(const ContextPtr& context, const std::string& collection_name, int64_t segment_id,
                     engine::IDNumbers& ids);
@@ -107,6 +124,10 @@ class ReqHandler {
     Status
     Compact(const ContextPtr& context, const std::string& collection_name, double compact_threshold);
 
+    Status
+    BulkImport(const ContextPtr& context, const std::string& collection_name, const std::string& partition_name,
+               const std::string& path, int64_t& row_count);
+
     Status
     Cmd(const ContextPtr& context, const std::string& cmd, std::string& reply);
 };
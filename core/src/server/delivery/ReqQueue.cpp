@@ -10,19 +10,26 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/ReqQueue.h"
+#include "config/ServerConfig.h"
+#include "metrics/Metrics.h"
 #include "server/delivery/strategy/ReqStrategy.h"
 #include "server/delivery/strategy/SearchReqStrategy.h"
 #include "utils/Log.h"
 
 #include <fiu/fiu-local.h>
 #include <unistd.h>
+#include <algorithm>
+#include <chrono>
 #include <queue>
+#include <string>
 #include <utility>
 
 namespace milvus {
 namespace server {
 
 namespace {
+constexpr double RATE_ALPHA = 0.2;  // weight of the latest sample in the cost rate moving average
+
 Status
 ScheduleReq(const BaseReqPtr& req, std::queue<BaseReqPtr>& queue) {
     if (req == nullptr) {
@@ -48,19 +55,163 @@ ScheduleReq(const BaseReqPtr& req, std::queue<BaseReqPtr>& queue) {
 }  // namespace
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+ReqQueue::ReqQueue(const std::string& group) : group_(group) {
+}
+
 BaseReqPtr
 ReqQueue::TakeReq() {
-    return Take();
+    while (true) {
+        BaseReqPtr req;
+        ReqLane lane = ReqLane::LATENCY;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            auto& latency = lanes_[static_cast<int32_t>(ReqLane::LATENCY)];
+            auto& batch = lanes_[static_cast<int32_t>(ReqLane::BATCH)];
+            empty_.wait(lock, [&] { return stopped_ || !latency.queue_.empty() || !batch.queue_.empty(); });
+            if (latency.queue_.empty() && batch.queue_.empty()) {
+                return nullptr;  // stopped and drained
+            }
+
+            // weighted round robin, the batch lane is served once every latency_lane_weight latency requests
+            bool take_batch = latency.queue_.empty() ||
+                              (!batch.queue_.empty() && latency_taken_ >= config.engine.latency_lane_weight());
+            lane = take_batch ? ReqLane::BATCH : ReqLane::LATENCY;
+            latency_taken_ = take_batch ? 0 : latency_taken_ + 1;
+
+            auto& taken = lanes_[static_cast<int32_t>(lane)];
+            req = taken.queue_.front();
+            taken.queue_.pop();
+            taken.queued_cost_ -= req->queued_cost();
+            full_.notify_all();
+
+            server::Metrics::GetInstance().ReqQueueDepthGaugeSet(LaneName(lane), taken.queue_.size());
+        }
+
+        auto wait_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count() -
+                       req->queued_us();
+        server::Metrics::GetInstance().ReqQueueWaitHistogramObserve(LaneName(lane), wait_us);
+
+        // nobody is waiting for the result anymore, don't waste the executor on it
+        auto& context = req->context();
+        if (context != nullptr &&
+            (context->IsConnectionBroken() || context->Deadline() <= std::chrono::system_clock::now())) {
+            LOG_SERVER_WARNING_ << "Drop request of group " << group_ << ", the client is gone or its deadline passed";
+            server::Metrics::GetInstance().ReqDroppedCounterIncrement(LaneName(lane));
+            req->SetStatus(Status(SERVER_REQUEST_REJECTED, "Request dropped, the client deadline passed in queue"));
+            req->Done();
+            continue;
+        }
+
+        return req;
+    }
 }
 
 Status
 ReqQueue::PutReq(const BaseReqPtr& req_ptr) {
-    std::unique_lock<std::mutex> lock(mtx);
-    full_.wait(lock, [this] { return (queue_.size() < capacity_); });
-    auto status = ScheduleReq(req_ptr, queue_);
+    if (req_ptr == nullptr) {
+        return Status(SERVER_NULL_POINTER, "request queue cannot handle null object");
+    }
+
+    // estimated outside of the lock, a search cost looks up the collection snapshot
+    auto cost = std::max<int64_t>(req_ptr->EstimateCost(), 1);
+    auto lane = ChooseLane(cost);
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (stopped_) {
+        return Status(SERVER_REQUEST_REJECTED, "Request queue is stopped");
+    }
+
+    auto wait_us = EstimateWaitUs(lane, cost);
+    if (wait_us >= 0) {
+        std::string reason;
+        auto max_wait_ms = config.engine.max_queue_wait();
+        if (max_wait_ms > 0 && wait_us > max_wait_ms * 1000) {
+            reason = "exceeds engine.max_queue_wait " + std::to_string(max_wait_ms) + "ms";
+        } else {
+            auto& context = req_ptr->context();
+            auto deadline = context != nullptr ? context->Deadline() : std::chrono::system_clock::time_point::max();
+            if (deadline != std::chrono::system_clock::time_point::max() &&
+                std::chrono::system_clock::now() + std::chrono::microseconds(wait_us) > deadline) {
+                reason = "exceeds the client deadline";
+            }
+        }
+
+        if (!reason.empty()) {
+            server::Metrics::GetInstance().ReqDroppedCounterIncrement(LaneName(lane));
+            std::string msg =
+                "Request rejected, estimated queue wait " + std::to_string(wait_us / 1000) + "ms " + reason;
+            LOG_SERVER_WARNING_ << msg;
+            return Status(SERVER_REQUEST_REJECTED, msg);
+        }
+    }
+
+    auto& target = lanes_[static_cast<int32_t>(lane)];
+    if (req_ptr->async() && target.queue_.size() >= capacity_) {
+        // an async request is put from a completion queue thread, which must not wait for room
+        server::Metrics::GetInstance().ReqDroppedCounterIncrement(LaneName(lane));
+        return Status(SERVER_REQUEST_REJECTED, "Request rejected, " + LaneName(lane) + " queue is full");
+    }
+    full_.wait(lock, [&] { return stopped_ || target.queue_.size() < capacity_; });
+    if (stopped_) {
+        return Status(SERVER_REQUEST_REJECTED, "Request queue is stopped");
+    }
+
+    req_ptr->SetQueued(cost);
+    auto status = ScheduleReq(req_ptr, target.queue_);
+    if (status.ok()) {
+        target.queued_cost_ += cost;
+    }
     empty_.notify_all();
+
+    server::Metrics::GetInstance().ReqQueueDepthGaugeSet(LaneName(lane), target.queue_.size());
     return status;
 }
 
+void
+ReqQueue::ReqDone(const BaseReqPtr& req_ptr, int64_t execute_us) {
+    if (req_ptr == nullptr || req_ptr->queued_cost() <= 0) {
+        return;
+    }
+
+    double rate = static_cast<double>(req_ptr->queued_cost()) / std::max<int64_t>(execute_us, 1);
+    std::lock_guard<std::mutex> lock(mtx_);
+    cost_per_us_ = (cost_per_us_ <= 0.0) ? rate : (1.0 - RATE_ALPHA) * cost_per_us_ + RATE_ALPHA * rate;
+}
+
+void
+ReqQueue::Stop() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stopped_ = true;
+    empty_.notify_all();
+    full_.notify_all();
+}
+
+ReqLane
+ReqQueue::ChooseLane(int64_t cost) const {
+    auto threshold = config.engine.batch_lane_cost_threshold();
+    return (threshold > 0 && cost >= threshold) ? ReqLane::BATCH : ReqLane::LATENCY;
+}
+
+std::string
+ReqQueue::LaneName(ReqLane lane) const {
+    return group_ + (lane == ReqLane::BATCH ? "_batch" : "_latency");
+}
+
+int64_t
+ReqQueue::EstimateWaitUs(ReqLane lane, int64_t cost) const {
+    if (cost_per_us_ <= 0.0) {
+        return -1;
+    }
+
+    // a batch request also waits for the latency requests served ahead of it
+    int64_t ahead = lanes_[static_cast<int32_t>(lane)].queued_cost_;
+    if (lane == ReqLane::BATCH) {
+        ahead += lanes_[static_cast<int32_t>(ReqLane::LATENCY)].queued_cost_;
+    }
+    return static_cast<int64_t>(ahead / cost_per_us_);
+}
+
 }  // namespace server
 }  // namespace milvus
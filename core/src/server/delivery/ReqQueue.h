@@ -12,11 +12,13 @@
 #pragma once
 
 #include "server/delivery/request/BaseReq.h"
-#include "utils/BlockingQueue.h"
 #include "utils/Status.h"
 
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
 #include <thread>
 #include <vector>
@@ -24,18 +26,71 @@
 namespace milvus {
 namespace server {
 
-using BlockingReqQueue = BlockingQueue<BaseReqPtr>;
+enum class ReqLane {
+    LATENCY = 0,
+    BATCH,
+    LANE_NUM,
+};
+
+constexpr int32_t REQ_LANE_NUM = static_cast<int32_t>(ReqLane::LANE_NUM);
 
-class ReqQueue : public BlockingReqQueue {
+// Request queue of one request group. Cheap requests go to the latency lane and expensive ones (cost not less than
+// engine.batch_lane_cost_threshold) to the batch lane, the executor takes engine.latency_lane_weight latency requests
+// for each batch request. A request is rejected up front if the estimated queue wait exceeds engine.max_queue_wait
+// or the client deadline, the estimate is the queued cost ahead divided by the observed cost rate of the executor.
+class ReqQueue {
  public:
-    ReqQueue() = default;
+    explicit ReqQueue(const std::string& group);
     virtual ~ReqQueue() = default;
 
+    ReqQueue(const ReqQueue& rhs) = delete;
+
+    ReqQueue&
+    operator=(const ReqQueue& rhs) = delete;
+
+    // blocks until a request is available, returns null once the queue is stopped and drained
     BaseReqPtr
     TakeReq();
 
+    // blocks while the lane is full, an async request is rejected instead
     Status
     PutReq(const BaseReqPtr& req_ptr);
+
+    // called by the executor after a taken request is executed, feeds the cost rate estimate
+    void
+    ReqDone(const BaseReqPtr& req_ptr, int64_t execute_us);
+
+    void
+    Stop();
+
+ private:
+    ReqLane
+    ChooseLane(int64_t cost) const;
+
+    std::string
+    LaneName(ReqLane lane) const;
+
+    // estimated queue wait in microseconds of a request put into the lane, -1 if the cost rate is not known yet
+    int64_t
+    EstimateWaitUs(ReqLane lane, int64_t cost) const;
+
+    struct Lane {
+        std::queue<BaseReqPtr> queue_;
+        int64_t queued_cost_ = 0;
+    };
+
+ private:
+    std::string group_;
+    mutable std::mutex mtx_;
+    std::condition_variable full_;
+    std::condition_variable empty_;
+    size_t capacity_ = 32;
+    bool stopped_ = false;
+
+    Lane lanes_[REQ_LANE_NUM];
+    int64_t latency_taken_ = 0;  // latency requests taken in a row, for the weighted round robin
+
+    double cost_per_us_ = 0.0;  // moving average of executed cost per microsecond
 };
 
 using ReqQueuePtr = std::shared_ptr<ReqQueue>;
@@ -14,6 +14,7 @@
 
 #include <fiu/fiu-local.h>
 #include <unistd.h>
+#include <chrono>
 #include <utility>
 
 namespace milvus {
@@ -39,11 +40,19 @@ ReqScheduler::ExecReq(const BaseReqPtr& req_ptr) {
 }
 
 void
-ReqScheduler::Start() {
-    if (!stopped_) {
+ReqScheduler::ExecReq(const BaseReqPtr& req_ptr, const ReqCallback& callback) {
+    if (req_ptr == nullptr) {
         return;
     }
 
+    req_ptr->SetCallback(callback);
+    ReqScheduler& scheduler = ReqScheduler::GetInstance();
+    scheduler.ExecuteReq(req_ptr);
+}
+
+void
+ReqScheduler::Start() {
+    std::lock_guard<std::mutex> lock(queue_mtx_);
     stopped_ = false;
 }
 
@@ -55,10 +64,12 @@ ReqScheduler::Stop() {
 
     LOG_SERVER_INFO_ << "Scheduler gonna stop...";
     {
+        // no queue is created once stopped, queued requests are still executed before the threads exit
         std::lock_guard<std::mutex> lock(queue_mtx_);
+        stopped_ = true;
         for (auto& iter : req_groups_) {
             if (iter.second != nullptr) {
-                iter.second->Put(nullptr);
+                iter.second->Stop();
             }
         }
     }
@@ -71,7 +82,6 @@ ReqScheduler::Stop() {
     }
     req_groups_.clear();
     execute_threads_.clear();
-    stopped_ = true;
     LOG_SERVER_INFO_ << "Scheduler stopped";
 }
 
@@ -92,6 +102,7 @@ ReqScheduler::ExecuteReq(const BaseReqPtr& req_ptr) {
 
     if (!status.ok()) {
         LOG_SERVER_ERROR_ << "Put request to queue failed with code: " << status.ToString();
+        req_ptr->SetStatus(status);
         req_ptr->Done();
         return status;
     }
@@ -122,6 +133,7 @@ ReqScheduler::TakeToExecute(ReqQueuePtr req_queue) {
             break;  // stop the thread
         }
 
+        auto begin = std::chrono::steady_clock::now();
         try {
             fiu_do_on("ReqScheduler.TakeToExecute.throw_std_exception1", throw std::exception());
             auto status = req->Execute();
@@ -133,31 +145,42 @@ ReqScheduler::TakeToExecute(ReqQueuePtr req_queue) {
         } catch (std::exception& ex) {
             LOG_SERVER_ERROR_ << "Req failed to execute: " << ex.what();
         }
+        auto end = std::chrono::steady_clock::now();
+        req_queue->ReqDone(req, std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
     }
 }
 
 Status
 ReqScheduler::PutToQueue(const BaseReqPtr& req_ptr) {
-    std::lock_guard<std::mutex> lock(queue_mtx_);
-
     std::string group_name = req_ptr->req_group();
-    if (req_groups_.count(group_name) > 0) {
-        req_groups_[group_name]->PutReq(req_ptr);
-    } else {
-        ReqQueuePtr queue = std::make_shared<ReqQueue>();
-        queue->PutReq(req_ptr);
-        req_groups_.insert(std::make_pair(group_name, queue));
-        fiu_do_on("ReqScheduler.PutToQueue.null_queue", queue = nullptr);
-
-        // start a thread
-        ThreadPtr thread = std::make_shared<std::thread>(&ReqScheduler::TakeToExecute, this, queue);
-
-        fiu_do_on("ReqScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
-        execute_threads_.push_back(thread);
-        LOG_SERVER_INFO_ << "Create new thread for request group: " << group_name;
+    ReqQueuePtr queue;
+    {
+        // only the group lookup is serialized, putting may estimate the cost or wait for room in the queue
+        std::lock_guard<std::mutex> lock(queue_mtx_);
+        if (stopped_) {
+            return Status(SERVER_REQUEST_REJECTED, "Request scheduler is stopped");
+        }
+        auto iter = req_groups_.find(group_name);
+        if (iter != req_groups_.end()) {
+            queue = iter->second;
+        } else {
+            queue = std::make_shared<ReqQueue>(group_name);
+            req_groups_.insert(std::make_pair(group_name, queue));
+            fiu_do_on("ReqScheduler.PutToQueue.null_queue", queue = nullptr);
+
+            // start a thread
+            ThreadPtr thread = std::make_shared<std::thread>(&ReqScheduler::TakeToExecute, this, queue);
+
+            fiu_do_on("ReqScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
+            execute_threads_.push_back(thread);
+            LOG_SERVER_INFO_ << "Create new thread for request group: " << group_name;
+        }
     }
 
-    return Status::OK();
+    if (queue == nullptr) {
+        return Status(SERVER_NULL_POINTER, "Request queue of group " + group_name + " is null");
+    }
+    return queue->PutReq(req_ptr);
 }
 
 }  // namespace server
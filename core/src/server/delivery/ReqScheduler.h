@@ -45,6 +45,10 @@ class ReqScheduler {
     static void
     ExecReq(const BaseReqPtr& req_ptr);
 
+    // return immediately, the callback is invoked once the request is done or failed to be scheduled
+    static void
+    ExecReq(const BaseReqPtr& req_ptr, const ReqCallback& callback);
+
  protected:
     ReqScheduler();
 
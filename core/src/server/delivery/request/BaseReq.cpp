@@ -60,9 +60,20 @@ BaseReq::OnPostExecute() {
 
 void
 BaseReq::Done() {
-    std::unique_lock<std::mutex> lock(finish_mtx_);
-    done_ = true;
-    finish_cond_.notify_all();
+    ReqCallback callback;
+    {
+        std::unique_lock<std::mutex> lock(finish_mtx_);
+        done_ = true;
+        finish_cond_.notify_all();
+        callback.swap(callback_);  // Done() could be called more than once, the callback is invoked only once
+    }
+
+    if (callback) {
+        if (status_.ok()) {
+            PostExecute();
+        }
+        callback(status_);
+    }
 }
 
 void
@@ -70,6 +81,26 @@ BaseReq::SetStatus(const Status& status) {
     status_ = status;
 }
 
+void
+BaseReq::SetCallback(const ReqCallback& callback) {
+    std::unique_lock<std::mutex> lock(finish_mtx_);
+    callback_ = callback;
+    async_ = true;
+}
+
+int64_t
+BaseReq::EstimateCost() const {
+    return 1;
+}
+
+void
+BaseReq::SetQueued(int64_t cost) {
+    queued_cost_ = cost;
+    queued_us_ =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
 Status
 BaseReq::WaitToFinish() {
     std::unique_lock<std::mutex> lock(finish_mtx_);
@@ -15,7 +15,9 @@
 #include "server/delivery/request/Types.h"
 #include "utils/Status.h"
 
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -24,6 +26,9 @@
 namespace milvus {
 namespace server {
 
+// invoked on the scheduler thread once an async request is done, with the final status of the request
+using ReqCallback = std::function<void(const Status& status)>;
+
 class BaseReq {
  protected:
     BaseReq(const ContextPtr& context, ReqType type, bool async = false);
@@ -56,6 +61,16 @@ class BaseReq {
         return async_;
     }
 
+    int64_t
+    queued_cost() const {
+        return queued_cost_;
+    }
+
+    int64_t
+    queued_us() const {
+        return queued_us_;
+    }
+
     Status
     PreExecute();
 
@@ -74,6 +89,18 @@ class BaseReq {
     void
     SetStatus(const Status& status);
 
+    // execute the request asynchronously, nobody waits for it and the callback is invoked by Done()
+    void
+    SetCallback(const ReqCallback& callback);
+
+    // rough cost of the request in abstract units, the request queue uses it to pick a lane and to admit requests
+    virtual int64_t
+    EstimateCost() const;
+
+    // record the cost and the time when the request enters the request queue
+    void
+    SetQueued(int64_t cost);
+
  protected:
     virtual Status
     OnPreExecute();
@@ -95,6 +122,9 @@ class BaseReq {
     mutable std::mutex finish_mtx_;
     std::condition_variable finish_cond_;
     bool done_;
+    ReqCallback callback_;
+    int64_t queued_cost_ = 0;
+    int64_t queued_us_ = 0;
 };
 
 using BaseReqPtr = std::shared_ptr<BaseReq>;
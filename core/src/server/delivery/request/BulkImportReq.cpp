@@ -0,0 +1,65 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/BulkImportReq.h"
+#include "server/DBWrapper.h"
+#include "server/ValidationUtil.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+BulkImportReq::BulkImportReq(const ContextPtr& context, const std::string& collection_name,
+                             const std::string& partition_name, const std::string& path, int64_t& row_count)
+    : BaseReq(context, ReqType::kBulkImport),
+      collection_name_(collection_name),
+      partition_name_(partition_name),
+      path_(path),
+      row_count_(row_count) {
+}
+
+BaseReqPtr
+BulkImportReq::Create(const ContextPtr& context, const std::string& collection_name,
+                      const std::string& partition_name, const std::string& path, int64_t& row_count) {
+    return std::shared_ptr<BaseReq>(new BulkImportReq(context, collection_name, partition_name, path, row_count));
+}
+
+Status
+BulkImportReq::OnExecute() {
+    try {
+        std::string hdr = "BulkImportReq(collection=" + collection_name_ + ", path=" + path_ + ")";
+        TimeRecorderAuto rc(hdr);
+
+        STATUS_CHECK(ValidateCollectionName(collection_name_));
+        if (path_.empty()) {
+            return Status(SERVER_INVALID_ARGUMENT, "Import path is empty");
+        }
+
+        bool exist = false;
+        STATUS_CHECK(DBWrapper::DB()->HasCollection(collection_name_, exist));
+        if (!exist) {
+            return Status(SERVER_COLLECTION_NOT_EXIST, "Collection not exist: " + collection_name_);
+        }
+
+        std::string partition_name = partition_name_.empty() ? engine::DEFAULT_PARTITON_TAG : partition_name_;
+        STATUS_CHECK(DBWrapper::DB()->BulkImport(context_, collection_name_, partition_name, path_, row_count_));
+    } catch (std::exception& ex) {
+        return Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
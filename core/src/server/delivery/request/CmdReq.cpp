@@ -48,6 +48,14 @@ CmdReq::OnExecute() {
         json resp;
         resp["require_restart"] = ConfigMgr::GetInstance().RequireRestart();
         resp["indexing"] = DBWrapper::DB()->IsBuildingIndex();
+        engine::PreloadProgress preload;
+        DBWrapper::DB()->GetPreloadProgress(preload);
+        resp["preloading"] = preload.running_;
+        resp["preload"] = {
+            {"total_segments", preload.total_segments_},     {"loaded_segments", preload.loaded_segments_},
+            {"skipped_segments", preload.skipped_segments_}, {"total_bytes", preload.total_bytes_},
+            {"loaded_bytes", preload.loaded_bytes_},
+        };
         resp["uptime"] = uptime();
         resp["server_time"] = now();
         result_ = resp.dump();
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/CreateCollectionReq.h"
+#include "db/SnapshotUtils.h"
 #include "db/Utils.h"
 #include "server/DBWrapper.h"
 #include "server/ValidationUtil.h"
@@ -87,16 +88,12 @@ CreateCollectionReq::OnExecute() {
             }
 
             // validate vector field dimension
-            if (field_type == engine::DataType::VECTOR_FLOAT || field_type == engine::DataType::VECTOR_BINARY) {
+            if (engine::IsVectorField(field_type)) {
                 if (!field_params.contains(engine::PARAM_DIMENSION)) {
                     return Status(SERVER_INVALID_VECTOR_DIMENSION, "Dimension not defined in field_params");
                 } else {
                     auto dim = field_params[engine::PARAM_DIMENSION].get<int64_t>();
-                    if (field_type == engine::DataType::VECTOR_FLOAT) {
-                        STATUS_CHECK(ValidateDimension(dim, false));
-                    } else {
-                        STATUS_CHECK(ValidateDimension(dim, true));
-                    }
+                    STATUS_CHECK(ValidateDimension(dim, field_type == engine::DataType::VECTOR_BINARY));
                 }
             }
 
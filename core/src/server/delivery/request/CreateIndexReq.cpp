@@ -12,6 +12,7 @@
 #include "server/delivery/request/CreateIndexReq.h"
 #include "db/SnapshotUtils.h"
 #include "db/Utils.h"
+#include "knowhere/index/IndexType.h"
 #include "server/DBWrapper.h"
 #include "server/ValidationUtil.h"
 #include "utils/Log.h"
@@ -86,6 +87,14 @@ CreateIndexReq::OnExecute() {
 
         engine::CollectionIndex index;
         if (engine::IsVectorField(field)) {
+            // half precision vectors are only indexed by float vector indexes that keep full vectors
+            if (field->GetFtype() == engine::DataType::VECTOR_FLOAT16 &&
+                index_type != knowhere::IndexEnum::INDEX_FAISS_IDMAP &&
+                index_type != knowhere::IndexEnum::INDEX_FAISS_IVFFLAT &&
+                index_type != knowhere::IndexEnum::INDEX_HNSW) {
+                return Status(SERVER_INVALID_INDEX_TYPE, "Index type " + index_type + " not support float16 field");
+            }
+
             auto params = field->GetParams();
             auto dimension = params[engine::PARAM_DIMENSION].get<int64_t>();
 
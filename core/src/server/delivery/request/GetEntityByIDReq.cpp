@@ -18,6 +18,7 @@
 #include "server/delivery/request/GetEntityByIDReq.h"
 
 #include "db/Types.h"
+#include "db/Utils.h"
 #include "server/DBWrapper.h"
 #include "server/ValidationUtil.h"
 #include "utils/TimeRecorder.h"
@@ -107,6 +108,18 @@ GetEntityByIDReq::OnExecute() {
         // step 2: get vector data, now only support get one id
         STATUS_CHECK(
             DBWrapper::DB()->GetEntityByID(collection_name_, id_array_, field_names_, valid_row_, data_chunk_));
+
+        // step 3: float16 vectors are returned to clients as float vectors
+        for (const auto& schema : field_mappings_) {
+            auto& field = schema.first;
+            if (field->GetFtype() != engine::DataType::VECTOR_FLOAT16 || data_chunk_ == nullptr) {
+                continue;
+            }
+            auto iter = data_chunk_->fixed_fields_.find(field->GetName());
+            if (iter != data_chunk_->fixed_fields_.end() && iter->second != nullptr) {
+                engine::utils::Float16ToFloat(iter->second->data_);
+            }
+        }
         rc.ElapseFromBegin("done");
     } catch (std::exception& ex) {
         return Status(SERVER_UNEXPECTED_ERROR, ex.what());
@@ -60,13 +60,17 @@ InsertReq::OnExecute() {
         }
 
         // step 1: check collection existence
-        bool exist = false;
-        STATUS_CHECK(DBWrapper::DB()->HasCollection(collection_name_, exist));
-        if (!exist) {
-            return Status(SERVER_COLLECTION_NOT_EXIST, "Collection not exist: " + collection_name_);
+        engine::snapshot::CollectionPtr collection;
+        engine::snapshot::FieldElementMappings fields_schema;
+        auto status = DBWrapper::DB()->GetCollectionInfo(collection_name_, collection, fields_schema);
+        if (!status.ok()) {
+            if (status.code() == DB_NOT_FOUND) {
+                return Status(SERVER_COLLECTION_NOT_EXIST, "Collection not exist: " + collection_name_);
+            }
+            return status;
         }
 
-        // step 2: construct insert data
+        // step 2: construct insert data, float16 vector fields are stored in half precision
         engine::DataChunkPtr data_chunk = std::make_shared<engine::DataChunk>();
         data_chunk->count_ = row_count_;
         for (auto& pair : chunk_data_) {
@@ -74,9 +78,16 @@ InsertReq::OnExecute() {
             bin->data_.swap(pair.second);
             data_chunk->fixed_fields_.insert(std::make_pair(pair.first, bin));
         }
+        for (auto& schema : fields_schema) {
+            auto& field = schema.first;
+            auto iter = data_chunk->fixed_fields_.find(field->GetName());
+            if (field->GetFtype() == engine::DataType::VECTOR_FLOAT16 && iter != data_chunk->fixed_fields_.end()) {
+                STATUS_CHECK(engine::utils::FloatToFloat16(iter->second->data_));
+            }
+        }
 
         // step 3: check insert data limitation
-        auto status = ValidateInsertDataSize(data_chunk);
+        status = ValidateInsertDataSize(data_chunk);
         if (!status.ok()) {
             LOG_SERVER_ERROR_ << LogOut("[%s][%d] Invalid vector data: %s", "insert", 0, status.message().c_str());
             return status;
@@ -10,7 +10,9 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/SearchReq.h"
+#include "db/SnapshotUtils.h"
 #include "db/Utils.h"
+#include "db/snapshot/Snapshots.h"
 #include "server/DBWrapper.h"
 #include "server/ValidationUtil.h"
 #include "utils/CommonUtil.h"
@@ -18,6 +20,7 @@
 #include "utils/TimeRecorder.h"
 
 #include <fiu/fiu-local.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -37,6 +40,13 @@ SearchReq::SearchReq(const ContextPtr& context, const query::QueryPtr& query_ptr
       json_params_(json_params),
       field_mappings_(field_mappings),
       result_(result) {
+    if (context_ != nullptr) {
+        auto query_trace = QueryTrace::Create();
+        if (query_trace != nullptr) {
+            query_trace->BeginStage(QueryStage::QUEUE_WAIT);
+            context_->SetQueryTrace(query_trace);
+        }
+    }
 }
 
 BaseReqPtr
@@ -47,6 +57,48 @@ SearchReq::Create(const ContextPtr& context, const query::QueryPtr& query_ptr, c
 
 Status
 SearchReq::OnExecute() {
+    QueryTracePtr query_trace = context_ != nullptr ? context_->GetQueryTrace() : nullptr;
+    if (query_trace != nullptr) {
+        query_trace->EndStage(QueryStage::QUEUE_WAIT);
+    }
+
+    auto status = Search();
+
+    if (query_trace != nullptr) {
+        query_trace->Finish(context_->ReqID(), query_ptr_->collection_id);
+    }
+    return status;
+}
+
+int64_t
+SearchReq::EstimateCost() const {
+    if (query_ptr_ == nullptr) {
+        return 1;
+    }
+
+    int64_t cost = 0;
+    for (auto& pair : query_ptr_->vectors) {
+        auto& vector_query = pair.second;
+        if (vector_query == nullptr) {
+            continue;
+        }
+        auto nq = std::max<int64_t>(static_cast<int64_t>(vector_query->query_vector.vector_count), 1);
+        cost += nq * std::max<int64_t>(vector_query->topk, 1);
+    }
+    cost = std::max<int64_t>(cost, 1);
+
+    // an unknown collection is left to Search() to report, it is cheap anyway
+    engine::snapshot::ScopedSnapshotT ss;
+    auto status = engine::snapshot::Snapshots::GetInstance().GetSnapshot(ss, query_ptr_->collection_id);
+    if (status.ok()) {
+        cost *= std::max<int64_t>(static_cast<int64_t>(ss->GetResources<engine::snapshot::Segment>().size()), 1);
+    }
+
+    return cost;
+}
+
+Status
+SearchReq::Search() {
     try {
         fiu_do_on("SearchReq.OnExecute.throw_std_exception", throw std::exception());
         std::string hdr = "SearchReq(table=" + query_ptr_->collection_id;
@@ -74,8 +126,7 @@ SearchReq::OnExecute() {
         for (auto& schema : fields_schema) {
             auto field = schema.first;
             field_types.insert(std::make_pair(field->GetName(), field->GetFtype()));
-            if (field->GetFtype() == engine::DataType::VECTOR_FLOAT ||
-                field->GetFtype() == engine::DataType::VECTOR_BINARY) {
+            if (engine::IsVectorField(field)) {
                 // check dim
                 int64_t dimension = field->GetParams()[engine::PARAM_DIMENSION];
                 auto vector_query = query_ptr_->vectors.begin()->second;
@@ -92,7 +143,7 @@ SearchReq::OnExecute() {
                 }
 
                 // validate search metric type and DataType match
-                bool is_binary = (field->GetFtype() == engine::DataType::VECTOR_FLOAT) ? false : true;
+                bool is_binary = (field->GetFtype() == engine::DataType::VECTOR_BINARY);
                 if (query_ptr_->metric_types.find(field->GetName()) != query_ptr_->metric_types.end()) {
                     auto metric_type = query_ptr_->metric_types.at(field->GetName());
                     STATUS_CHECK(ValidateSearchMetricType(metric_type, is_binary));
@@ -151,7 +202,17 @@ SearchReq::OnExecute() {
 
         auto post_query_ctx = context_->Child("Constructing result");
 
-        // step 7: construct result array
+        // step 7: construct result array, float16 vectors are returned to clients as float vectors
+        for (const auto& schema : field_mappings_) {
+            auto& field = schema.first;
+            if (field->GetFtype() != engine::DataType::VECTOR_FLOAT16 || result_->data_chunk_ == nullptr) {
+                continue;
+            }
+            auto iter = result_->data_chunk_->fixed_fields_.find(field->GetName());
+            if (iter != result_->data_chunk_->fixed_fields_.end() && iter->second != nullptr) {
+                engine::utils::Float16ToFloat(iter->second->data_);
+            }
+        }
         post_query_ctx->GetTraceContext()->GetSpan()->Finish();
 
         // step 8: print time cost percent
@@ -35,6 +35,14 @@ class SearchReq : public BaseReq {
     Status
     OnExecute() override;
 
+    // query vectors x topk x segments, a search fans out over all segments of the collection
+    int64_t
+    EstimateCost() const override;
+
+ private:
+    Status
+    Search();
+
  private:
     milvus::query::QueryPtr query_ptr_;
     milvus::json json_params_;
@@ -22,6 +22,7 @@ namespace server {
 static const char* DQL_REQ_GROUP = "dql";
 static const char* DDL_DML_REQ_GROUP = "ddl_dml";
 static const char* INFO_REQ_GROUP = "info";
+static const char* IMPORT_REQ_GROUP = "import";  // a bulk import takes long, it must not block insert and delete
 
 std::string
 GetReqGroup(ReqType type) {
@@ -59,6 +60,7 @@ GetReqGroup(ReqType type) {
         {ReqType::kLoadCollection, DQL_REQ_GROUP},
         {ReqType::kFlush, DDL_DML_REQ_GROUP},
         {ReqType::kCompact, DDL_DML_REQ_GROUP},
+        {ReqType::kBulkImport, IMPORT_REQ_GROUP},
     };
 
     auto iter = s_map_type_group.find(type);
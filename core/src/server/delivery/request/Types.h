@@ -120,6 +120,7 @@ enum class ReqType {
     kLoadCollection = 500,
     kFlush,
     kCompact,
+    kBulkImport,
 };
 
 extern std::string
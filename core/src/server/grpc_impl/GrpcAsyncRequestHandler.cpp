@@ -0,0 +1,286 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/grpc_impl/GrpcAsyncRequestHandler.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+namespace {
+
+class AsyncCallBase {
+ public:
+    virtual ~AsyncCallBase() = default;
+
+    // called by the queue thread when the tag of this call comes out of the completion queue
+    virtual void
+    Proceed(bool ok) = 0;
+};
+
+// One unary call, it is first registered to wait for a request of the method, then processed and finally
+// deleted once its response is sent.
+template <typename RequestT, typename ResponseT>
+class AsyncCall : public AsyncCallBase {
+ public:
+    using RequestMethod = void (GrpcAsyncRequestHandler::*)(::grpc::ServerContext*, RequestT*,
+                                                            ::grpc::ServerAsyncResponseWriter<ResponseT>*,
+                                                            ::grpc::CompletionQueue*, ::grpc::ServerCompletionQueue*,
+                                                            void*);
+    using ProcessMethod = void (GrpcAsyncRequestHandler::*)(::grpc::ServerContext*, const RequestT*, ResponseT*,
+                                                            const GrpcAsyncRequestHandler::FinishFunc&);
+
+    AsyncCall(GrpcAsyncRequestHandler* handler, ::grpc::ServerCompletionQueue* cq, RequestMethod request_method,
+              ProcessMethod process_method)
+        : handler_(handler),
+          cq_(cq),
+          request_method_(request_method),
+          process_method_(process_method),
+          responder_(&context_) {
+        (handler_->*request_method_)(&context_, &request_, &responder_, cq_, cq_, this);
+    }
+
+    void
+    Proceed(bool ok) override {
+        if (finished_ || !ok) {
+            // response is sent, or the queue is shutting down
+            delete this;
+            return;
+        }
+
+        // wait for the next request of this method while this one is processed
+        new AsyncCall(handler_, cq_, request_method_, process_method_);
+
+        // this call may be deleted by the queue thread as soon as its response is sent, keep the handler aside
+        auto handler = handler_;
+        handler->BeginCall();
+        try {
+            (handler_->*process_method_)(&context_, &request_, &response_, [this, handler]() {
+                finished_ = true;
+                responder_.Finish(response_, ::grpc::Status::OK, this);
+                handler->EndCall();
+            });
+        } catch (std::exception& ex) {
+            LOG_SERVER_ERROR_ << "Async call failed: " << ex.what();
+            if (!finished_.exchange(true)) {
+                responder_.FinishWithError(::grpc::Status(::grpc::StatusCode::INTERNAL, ex.what()), this);
+                handler->EndCall();
+            }
+        }
+    }
+
+ private:
+    GrpcAsyncRequestHandler* handler_;
+    ::grpc::ServerCompletionQueue* cq_;
+    RequestMethod request_method_;
+    ProcessMethod process_method_;
+
+    ::grpc::ServerContext context_;
+    RequestT request_;
+    ResponseT response_;
+    ::grpc::ServerAsyncResponseWriter<ResponseT> responder_;
+    std::atomic<bool> finished_{false};
+};
+
+}  // namespace
+
+void
+GrpcAsyncRequestHandler::Serve(::grpc::ServerCompletionQueue* cq) {
+    SetThreadName("grpcasync_thread");
+
+    // one waiting call for each method, every arrived call registers the next one
+    new AsyncCall<::milvus::grpc::InsertParam, ::milvus::grpc::EntityIds>(
+        this, cq, &GrpcAsyncRequestHandler::RequestInsert, &GrpcAsyncRequestHandler::AsyncInsert);
+    new AsyncCall<::milvus::grpc::EntityIdentity, ::milvus::grpc::Entities>(
+        this, cq, &GrpcAsyncRequestHandler::RequestGetEntityByID, &GrpcAsyncRequestHandler::AsyncGetEntityByID);
+    new AsyncCall<::milvus::grpc::SearchParam, ::milvus::grpc::QueryResult>(
+        this, cq, &GrpcAsyncRequestHandler::RequestSearch, &GrpcAsyncRequestHandler::AsyncSearch);
+    new AsyncCall<::milvus::grpc::SearchParamPB, ::milvus::grpc::QueryResult>(
+        this, cq, &GrpcAsyncRequestHandler::RequestSearchPB, &GrpcAsyncRequestHandler::AsyncSearchPB);
+
+    void* tag = nullptr;
+    bool ok = false;
+    while (cq->Next(&tag, &ok)) {
+        static_cast<AsyncCallBase*>(tag)->Proceed(ok);
+    }
+}
+
+void
+GrpcAsyncRequestHandler::BeginCall() {
+    std::lock_guard<std::mutex> lock(calls_mutex_);
+    ++pending_calls_;
+}
+
+void
+GrpcAsyncRequestHandler::EndCall() {
+    std::lock_guard<std::mutex> lock(calls_mutex_);
+    if (--pending_calls_ == 0) {
+        calls_cond_.notify_all();
+    }
+}
+
+void
+GrpcAsyncRequestHandler::WaitForCalls() {
+    std::unique_lock<std::mutex> lock(calls_mutex_);
+    calls_cond_.wait(lock, [this] { return pending_calls_ == 0; });
+}
+
+void
+GrpcAsyncRequestHandler::AsyncInsert(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
+                                     ::milvus::grpc::EntityIds* response, const FinishFunc& finish) {
+    auto request_id = GetContext(context)->ReqID();
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", request_id.c_str(), "Insert");
+
+    // acquire resources, the queue thread must not wait for them, the call is rejected while too much insert data
+    // is in processing
+    int64_t request_size = request->ByteSizeLong();
+    if (!TryToInsert(request_id, request_size)) {
+        Status status(SERVER_REQUEST_REJECTED, "Too much insert data in processing, please retry later");
+        LOG_SERVER_WARNING_ << LogOut("Request [%s] %s rejected.", request_id.c_str(), "Insert");
+        SET_RESPONSE(response->mutable_status(), status, context);
+        finish();
+        return;
+    }
+
+    // the insert request refers to the chunk data until it is done
+    auto chunk_data = std::make_shared<std::unordered_map<std::string, std::vector<uint8_t>>>();
+    auto done = [this, context, response, finish, chunk_data, request_id, request_size](const Status& status) {
+        // return generated ids
+        if (status.ok()) {
+            FillInsertResult(*chunk_data, response);
+        }
+
+        LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", request_id.c_str(), "Insert");
+        SET_RESPONSE(response->mutable_status(), status, context);
+
+        // release resources
+        FinishInsert(request_id, request_size);
+        finish();
+    };
+
+    int32_t row_num = -1;
+    auto status = ParseInsertParam(request, row_num, *chunk_data);
+    if (!status.ok()) {
+        done(status);
+        return;
+    }
+
+    req_handler_.Insert(GetContext(context), request->collection_name(), request->partition_tag(), row_num,
+                        *chunk_data, done);
+}
+
+void
+GrpcAsyncRequestHandler::AsyncGetEntityByID(::grpc::ServerContext* context,
+                                            const ::milvus::grpc::EntityIdentity* request,
+                                            ::milvus::grpc::Entities* response, const FinishFunc& finish) {
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->ReqID().c_str(), "GetEntityByID");
+
+    struct Output {
+        engine::IDNumbers vector_ids_;
+        std::vector<std::string> field_names_;
+        std::vector<bool> valid_row_;
+        engine::snapshot::FieldElementMappings field_mappings_;
+        engine::DataChunkPtr data_chunk_;
+    };
+    auto output = std::make_shared<Output>();
+    ParseGetEntityParam(request, output->vector_ids_, output->field_names_);
+
+    req_handler_.GetEntityByID(
+        GetContext(context), request->collection_name(), output->vector_ids_, output->field_names_,
+        output->valid_row_, output->field_mappings_, output->data_chunk_,
+        [this, context, response, finish, output](const Status& status) {
+            FillGetEntityResult(output->vector_ids_, output->valid_row_, output->field_mappings_, output->data_chunk_,
+                                response);
+
+            LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->ReqID().c_str(), "GetEntityByID");
+            SET_RESPONSE(response->mutable_status(), status, context);
+            finish();
+        });
+}
+
+void
+GrpcAsyncRequestHandler::AsyncSearch(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                     ::milvus::grpc::QueryResult* response, const FinishFunc& finish) {
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->ReqID().c_str(), "Search");
+
+    // unlike the sync method, collection existence is left to the search request, it checks that anyway
+    query::QueryPtr query_ptr;
+    milvus::json json_params;
+    Status status = ParseSearchParam(request, query_ptr, json_params);
+    if (!status.ok()) {
+        SET_RESPONSE(response->mutable_status(), status, context);
+        finish();
+        return;
+    }
+
+    struct Output {
+        engine::QueryResultPtr result_ = std::make_shared<engine::QueryResult>();
+        engine::snapshot::FieldElementMappings field_mappings_;
+    };
+    auto output = std::make_shared<Output>();
+
+    req_handler_.Search(GetContext(context), query_ptr, json_params, output->field_mappings_, output->result_,
+                        [this, context, response, finish, output](const Status& status) {
+                            // step 6: construct and return result
+                            if (status.ok()) {
+                                FillSearchResult(output->result_, output->field_mappings_, response);
+                            }
+
+                            LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->ReqID().c_str(),
+                                                       "Search");
+                            SET_RESPONSE(response->mutable_status(), status, context);
+                            finish();
+                        });
+}
+
+void
+GrpcAsyncRequestHandler::AsyncSearchPB(::grpc::ServerContext* context, const ::milvus::grpc::SearchParamPB* request,
+                                       ::milvus::grpc::QueryResult* response, const FinishFunc& finish) {
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->ReqID().c_str(), "SearchPB");
+
+    query::QueryPtr query_ptr;
+    milvus::json json_params;
+    Status status = ParseSearchPBParam(request, query_ptr, json_params);
+    if (!status.ok()) {
+        SET_RESPONSE(response->mutable_status(), status, context);
+        finish();
+        return;
+    }
+
+    struct Output {
+        engine::QueryResultPtr result_ = std::make_shared<engine::QueryResult>();
+        engine::snapshot::FieldElementMappings field_mappings_;
+    };
+    auto output = std::make_shared<Output>();
+
+    req_handler_.Search(GetContext(context), query_ptr, json_params, output->field_mappings_, output->result_,
+                        [this, context, response, finish, output](const Status& status) {
+                            // step 6: construct and return result
+                            FillSearchPBResult(output->result_, response);
+
+                            LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->ReqID().c_str(),
+                                                       "SearchPB");
+                            SET_RESPONSE(response->mutable_status(), status, context);
+                            finish();
+                        });
+}
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,79 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#include "grpc/gen-milvus/milvus.grpc.pb.h"
+#include "server/grpc_impl/GrpcRequestHandler.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+using GrpcAsyncService = ::milvus::grpc::MilvusService::WithAsyncMethod_Insert<
+    ::milvus::grpc::MilvusService::WithAsyncMethod_GetEntityByID<::milvus::grpc::MilvusService::WithAsyncMethod_Search<
+        ::milvus::grpc::MilvusService::WithAsyncMethod_SearchPB<GrpcRequestHandler>>>>;
+
+// Serves Insert, GetEntityByID, Search and SearchPB from completion queues, the other methods are still served
+// by the sync methods of GrpcRequestHandler. An async call is handed to the request scheduler and its response
+// is sent from the scheduler callback, so no thread is parked while the request waits in the queue.
+class GrpcAsyncRequestHandler : public GrpcAsyncService {
+ public:
+    // send the response of the call, invoked exactly once by each async method
+    using FinishFunc = std::function<void()>;
+
+    // poll the completion queue until it is shut down, called by each async thread with its own queue
+    void
+    Serve(::grpc::ServerCompletionQueue* cq);
+
+    // a call is pending from the time it is processed until its response is sent, the scheduler callback of a
+    // pending call still refers to this handler and its completion queue
+    void
+    BeginCall();
+
+    void
+    EndCall();
+
+    // blocks until no call is pending, the completion queues must not be shut down before
+    void
+    WaitForCalls();
+
+    void
+    AsyncInsert(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
+                ::milvus::grpc::EntityIds* response, const FinishFunc& finish);
+
+    void
+    AsyncGetEntityByID(::grpc::ServerContext* context, const ::milvus::grpc::EntityIdentity* request,
+                       ::milvus::grpc::Entities* response, const FinishFunc& finish);
+
+    void
+    AsyncSearch(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                ::milvus::grpc::QueryResult* response, const FinishFunc& finish);
+
+    void
+    AsyncSearchPB(::grpc::ServerContext* context, const ::milvus::grpc::SearchParamPB* request,
+                  ::milvus::grpc::QueryResult* response, const FinishFunc& finish);
+
+ private:
+    std::mutex calls_mutex_;
+    std::condition_variable calls_cond_;
+    int64_t pending_calls_ = 0;
+};
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
@@ -13,6 +13,7 @@
 
 #include <fiu/fiu-local.h>
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -33,6 +34,7 @@ namespace server {
 namespace grpc {
 
 const char* EXTRA_PARAM_KEY = "params";
+const char* IMPORT_CMD = "import ";
 const size_t MAXIMUM_FIELD_NUM = 64;
 
 ::milvus::grpc::ErrorCode
@@ -108,24 +110,29 @@ CopyVectorData(const google::protobuf::RepeatedPtrField<::milvus::grpc::VectorRo
         data_size = float_data_size * sizeof(float);
     }
 
-    // copy vector data
-    vectors_data.resize(data_size);
-    int64_t offset = 0;
+    // copy vector data, append into reserved buffer so that it is not zero filled before copy
+    vectors_data.clear();
+    vectors_data.reserve(data_size);
     if (float_data_size > 0) {
         for (auto& record : grpc_records) {
-            int64_t single_size = record.float_data_size() * sizeof(float);
-            memcpy(&vectors_data[offset], record.float_data().data(), single_size);
-            offset += single_size;
+            auto src = reinterpret_cast<const uint8_t*>(record.float_data().data());
+            vectors_data.insert(vectors_data.end(), src, src + record.float_data_size() * sizeof(float));
         }
     } else if (binary_data_size > 0) {
         for (auto& record : grpc_records) {
-            int64_t single_size = record.binary_data().size();
-            memcpy(&vectors_data[offset], record.binary_data().data(), single_size);
-            offset += single_size;
+            auto src = reinterpret_cast<const uint8_t*>(record.binary_data().data());
+            vectors_data.insert(vectors_data.end(), src, src + record.binary_data().size());
         }
     }
 }
 
+template <typename T>
+void
+CopyFieldData(const google::protobuf::RepeatedField<T>& grpc_values, std::vector<uint8_t>& field_data) {
+    auto src = reinterpret_cast<const uint8_t*>(grpc_values.data());
+    field_data.assign(src, src + grpc_values.size() * sizeof(T));
+}
+
 void
 CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::VectorRowRecord>& grpc_records,
                const google::protobuf::RepeatedField<google::protobuf::int64>& grpc_id_array,
@@ -304,8 +311,8 @@ CopyDataChunkToEntity(const engine::DataChunkPtr& data_chunk,
                 memcpy(vector_row_record->mutable_binary_data()->data(), binary_vector.data(), binary_vector.size());
             }
 
-        } else if (type == engine::DataType::VECTOR_FLOAT) {
-            // add float vector data
+        } else if (type == engine::DataType::VECTOR_FLOAT || type == engine::DataType::VECTOR_FLOAT16) {
+            // add float vector data, float16 vectors are already converted to float
             std::vector<float> float_vector;
             auto vector_size = single_size * sizeof(int8_t) / sizeof(float);
             float_vector.resize(vector_size);
@@ -542,6 +549,15 @@ class GrpcConnectionContext : public milvus::server::ConnectionContext {
         return context_->IsCancelled();
     }
 
+    std::chrono::system_clock::time_point
+    Deadline() const override {
+        if (context_ == nullptr) {
+            return std::chrono::system_clock::time_point::max();
+        }
+
+        return context_->deadline();
+    }
+
  private:
     ::grpc::ServerContext* context_ = nullptr;
 };
@@ -873,23 +889,42 @@ GrpcRequestHandler::GetEntityByID(::grpc::ServerContext* context, const ::milvus
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->ReqID().c_str(), __func__);
 
     engine::IDNumbers vector_ids;
+    std::vector<std::string> field_names;
+    ParseGetEntityParam(request, vector_ids, field_names);
+
+    engine::DataChunkPtr data_chunk;
+    engine::snapshot::FieldElementMappings field_mappings;
+
+    std::vector<bool> valid_row;
+
+    Status status = req_handler_.GetEntityByID(GetContext(context), request->collection_name(), vector_ids, field_names,
+                                               valid_row, field_mappings, data_chunk);
+    FillGetEntityResult(vector_ids, valid_row, field_mappings, data_chunk, response);
+
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->ReqID().c_str(), __func__);
+    SET_RESPONSE(response->mutable_status(), status, context);
+
+    return ::grpc::Status::OK;
+}
+
+void
+GrpcRequestHandler::ParseGetEntityParam(const ::milvus::grpc::EntityIdentity* request, engine::IDNumbers& vector_ids,
+                                        std::vector<std::string>& field_names) {
     vector_ids.reserve(request->id_array_size());
     for (int64_t i = 0; i < request->id_array_size(); i++) {
         vector_ids.push_back(request->id_array(i));
     }
 
-    std::vector<std::string> field_names(request->field_names_size());
+    field_names.resize(request->field_names_size());
     for (int64_t i = 0; i < request->field_names_size(); i++) {
         field_names[i] = request->field_names(i);
     }
+}
 
-    engine::DataChunkPtr data_chunk;
-    engine::snapshot::FieldElementMappings field_mappings;
-
-    std::vector<bool> valid_row;
-
-    Status status = req_handler_.GetEntityByID(GetContext(context), request->collection_name(), vector_ids, field_names,
-                                               valid_row, field_mappings, data_chunk);
+void
+GrpcRequestHandler::FillGetEntityResult(const engine::IDNumbers& vector_ids, const std::vector<bool>& valid_row,
+                                        const engine::snapshot::FieldElementMappings& field_mappings,
+                                        const engine::DataChunkPtr& data_chunk, ::milvus::grpc::Entities* response) {
     for (auto it : vector_ids) {
         response->add_ids(it);
     }
@@ -903,11 +938,6 @@ GrpcRequestHandler::GetEntityByID(::grpc::ServerContext* context, const ::milvus
     }
 
     CopyDataChunkToEntity(data_chunk, field_mappings, valid_size, response);
-
-    LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->ReqID().c_str(), __func__);
-    SET_RESPONSE(response->mutable_status(), status, context);
-
-    return ::grpc::Status::OK;
 }
 
 ::grpc::Status
@@ -1150,6 +1180,9 @@ GrpcRequestHandler::Cmd(::grpc::ServerContext* context, const ::milvus::grpc::Co
         reply_json["requests"] = requests;
         reply = reply_json.dump();
         response->set_string_reply(reply);
+    } else if (cmd.compare(0, strlen(IMPORT_CMD), IMPORT_CMD) == 0) {
+        status = BulkImport(GetContext(context), cmd.substr(strlen(IMPORT_CMD)), reply);
+        response->set_string_reply(reply);
     } else {
         status = req_handler_.Cmd(GetContext(context), cmd, reply);
         response->set_string_reply(reply);
@@ -1161,6 +1194,39 @@ GrpcRequestHandler::Cmd(::grpc::ServerContext* context, const ::milvus::grpc::Co
     return ::grpc::Status::OK;
 }
 
+Status
+GrpcRequestHandler::BulkImport(const std::shared_ptr<Context>& context, const std::string& param, std::string& reply) {
+    milvus::json json;
+    try {
+        json = json::parse(param);
+    } catch (std::exception& ex) {
+        return Status(SERVER_INVALID_ARGUMENT, "Invalid import parameter: " + std::string(ex.what()));
+    }
+
+    if (!json.is_object() || !json.contains("collection_name") || !json["collection_name"].is_string() ||
+        !json.contains("path") || !json["path"].is_string()) {
+        return Status(SERVER_INVALID_ARGUMENT, "Import parameter must contain string collection_name and path");
+    }
+
+    std::string partition_tag;
+    if (json.contains("partition_tag")) {
+        if (!json["partition_tag"].is_string()) {
+            return Status(SERVER_INVALID_ARGUMENT, "Import parameter partition_tag must be a string");
+        }
+        partition_tag = json["partition_tag"].get<std::string>();
+    }
+
+    int64_t row_count = 0;
+    auto status = req_handler_.BulkImport(context, json["collection_name"].get<std::string>(), partition_tag,
+                                          json["path"].get<std::string>(), row_count);
+    if (status.ok()) {
+        milvus::json reply_json;
+        reply_json["row_count"] = row_count;
+        reply = reply_json.dump();
+    }
+    return status;
+}
+
 ::grpc::Status
 GrpcRequestHandler::DeleteByID(::grpc::ServerContext* context, const ::milvus::grpc::DeleteByIDParam* request,
                                ::milvus::grpc::Status* response) {
@@ -1298,9 +1364,6 @@ GrpcRequestHandler::Compact(::grpc::ServerContext* context, const ::milvus::grpc
 ::grpc::Status
 GrpcRequestHandler::Insert(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
                            ::milvus::grpc::EntityIds* response) {
-    //    engine::VectorsData vectors;
-    //    CopyRowRecords(request->entity().vector_data(0).value(), request->entity_id_array(), vectors);
-
     auto request_id = GetContext(context)->ReqID();
     CHECK_NULLPTR_RETURN(request);
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", request_id.c_str(), __func__);
@@ -1311,39 +1374,52 @@ GrpcRequestHandler::Insert(::grpc::ServerContext* context, const ::milvus::grpc:
     int64_t request_size = request->ByteSizeLong();
     WaitToInsert(request_id, request_size);
 
-    engine::IDNumbers vector_ids;
-    vector_ids.reserve(request->entity_id_array_size());
+    int32_t row_num = -1;
+    std::unordered_map<std::string, std::vector<uint8_t>> chunk_data;
+    auto status = ParseInsertParam(request, row_num, chunk_data);
+    if (status.ok()) {
+        status = req_handler_.Insert(GetContext(context), request->collection_name(), request->partition_tag(),
+                                     row_num, chunk_data);
+    }
+
+    // return generated ids
+    if (status.ok()) {
+        FillInsertResult(chunk_data, response);
+    }
+
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", request_id.c_str(), __func__);
+    SET_RESPONSE(response->mutable_status(), status, context);
+
+    // release resources
+    FinishInsert(request_id, request_size);
+
+    return ::grpc::Status::OK;
+}
+
+Status
+GrpcRequestHandler::ParseInsertParam(const ::milvus::grpc::InsertParam* request, int32_t& row_num,
+                                     std::unordered_map<std::string, std::vector<uint8_t>>& chunk_data) {
     for (int64_t i = 0; i < request->entity_id_array_size(); i++) {
         if (request->entity_id_array(i) < 0) {
-            auto status = Status{SERVER_INVALID_ROWRECORD_ARRAY, "id can not be negative number"};
-            SET_RESPONSE(response->mutable_status(), status, context);
-            return ::grpc::Status::OK;
+            return Status{SERVER_INVALID_ROWRECORD_ARRAY, "id can not be negative number"};
         }
     }
 
-    auto field_size = request->fields_size();
-
-    std::unordered_map<std::string, std::vector<uint8_t>> chunk_data;
-
-    auto valid_row_count = [&](int32_t& base, int32_t test) -> bool {
+    auto valid_row_count = [&](int32_t& base, int32_t test) -> Status {
         if (base < 0) {
             base = test;
             if (request->entity_id_array_size() > 0 && base != request->entity_id_array_size()) {
-                auto status = Status{SERVER_INVALID_ROWRECORD_ARRAY, "ID size not matches entity size"};
-                SET_RESPONSE(response->mutable_status(), status, context);
-                return false;
+                return Status{SERVER_INVALID_ROWRECORD_ARRAY, "ID size not matches entity size"};
             }
         } else if (base != test) {
-            auto status = Status{SERVER_INVALID_ROWRECORD_ARRAY, "Field row count inconsist"};
-            SET_RESPONSE(response->mutable_status(), status, context);
-            return false;
+            return Status{SERVER_INVALID_ROWRECORD_ARRAY, "Field row count inconsist"};
         }
-        return true;
+        return Status::OK();
     };
 
     // copy field data
-    int32_t row_num = -1;
-    for (int i = 0; i < field_size; i++) {
+    row_num = -1;
+    for (int i = 0; i < request->fields_size(); i++) {
         auto grpc_int32_size = request->fields(i).attr_record().int32_value_size();
         auto grpc_int64_size = request->fields(i).attr_record().int64_value_size();
         auto grpc_float_size = request->fields(i).attr_record().float_value_size();
@@ -1353,69 +1429,43 @@ GrpcRequestHandler::Insert(::grpc::ServerContext* context, const ::milvus::grpc:
 
         std::vector<uint8_t> temp_data;
         if (grpc_int32_size > 0) {
-            if (!valid_row_count(row_num, grpc_int32_size)) {
-                return ::grpc::Status::OK;
-            }
-            temp_data.resize(grpc_int32_size * sizeof(int32_t));
-            memcpy(temp_data.data(), field.attr_record().int32_value().data(), grpc_int32_size * sizeof(int32_t));
+            STATUS_CHECK(valid_row_count(row_num, grpc_int32_size));
+            CopyFieldData(field.attr_record().int32_value(), temp_data);
         } else if (grpc_int64_size > 0) {
-            if (!valid_row_count(row_num, grpc_int64_size)) {
-                return ::grpc::Status::OK;
-            }
-            temp_data.resize(grpc_int64_size * sizeof(int64_t));
-            memcpy(temp_data.data(), field.attr_record().int64_value().data(), grpc_int64_size * sizeof(int64_t));
+            STATUS_CHECK(valid_row_count(row_num, grpc_int64_size));
+            CopyFieldData(field.attr_record().int64_value(), temp_data);
         } else if (grpc_float_size > 0) {
-            if (!valid_row_count(row_num, grpc_float_size)) {
-                return ::grpc::Status::OK;
-            }
-            temp_data.resize(grpc_float_size * sizeof(float));
-            memcpy(temp_data.data(), field.attr_record().float_value().data(), grpc_float_size * sizeof(float));
+            STATUS_CHECK(valid_row_count(row_num, grpc_float_size));
+            CopyFieldData(field.attr_record().float_value(), temp_data);
         } else if (grpc_double_size > 0) {
-            if (!valid_row_count(row_num, grpc_double_size)) {
-                return ::grpc::Status::OK;
-            }
-            temp_data.resize(grpc_double_size * sizeof(double));
-            memcpy(temp_data.data(), field.attr_record().double_value().data(), grpc_double_size * sizeof(double));
+            STATUS_CHECK(valid_row_count(row_num, grpc_double_size));
+            CopyFieldData(field.attr_record().double_value(), temp_data);
         } else {
-            if (!valid_row_count(row_num, field.vector_record().records_size())) {
-                return ::grpc::Status::OK;
-            }
+            STATUS_CHECK(valid_row_count(row_num, field.vector_record().records_size()));
             CopyVectorData(field.vector_record().records(), temp_data);
         }
 
-        chunk_data.insert(std::make_pair(field_name, temp_data));
+        chunk_data.emplace(field_name, std::move(temp_data));
     }
 
     // copy id array
     if (request->entity_id_array_size() > 0) {
-        int64_t size = request->entity_id_array_size() * sizeof(int64_t);
-        std::vector<uint8_t> temp_data(size, 0);
-        memcpy(temp_data.data(), request->entity_id_array().data(), size);
-        chunk_data.insert(std::make_pair(engine::FIELD_UID, temp_data));
+        std::vector<uint8_t> temp_data;
+        CopyFieldData(request->entity_id_array(), temp_data);
+        chunk_data.emplace(engine::FIELD_UID, std::move(temp_data));
     }
 
-    std::string collection_name = request->collection_name();
-    std::string partition_name = request->partition_tag();
-    Status status = req_handler_.Insert(GetContext(context), collection_name, partition_name, row_num, chunk_data);
-    if (!status.ok()) {
-        SET_RESPONSE(response->mutable_status(), status, context);
-        return ::grpc::Status::OK;
-    }
+    return Status::OK();
+}
 
-    // return generated ids
+void
+GrpcRequestHandler::FillInsertResult(const std::unordered_map<std::string, std::vector<uint8_t>>& chunk_data,
+                                     ::milvus::grpc::EntityIds* response) {
     auto pair = chunk_data.find(engine::FIELD_UID);
     if (pair != chunk_data.end()) {
         response->mutable_entity_id_array()->Resize(static_cast<int>(pair->second.size() / sizeof(int64_t)), 0);
         memcpy(response->mutable_entity_id_array()->mutable_data(), pair->second.data(), pair->second.size());
     }
-
-    LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", request_id.c_str(), __func__);
-    SET_RESPONSE(response->mutable_status(), status, context);
-
-    // release resources
-    FinishInsert(request_id, request_size);
-
-    return ::grpc::Status::OK;
 }
 
 ::grpc::Status
@@ -1424,28 +1474,41 @@ GrpcRequestHandler::SearchPB(::grpc::ServerContext* context, const ::milvus::grp
     CHECK_NULLPTR_RETURN(request);
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->ReqID().c_str(), __func__);
 
+    query::QueryPtr query_ptr;
+    milvus::json json_params;
+    Status status = ParseSearchPBParam(request, query_ptr, json_params);
+    if (!status.ok()) {
+        SET_RESPONSE(response->mutable_status(), status, context)
+        return ::grpc::Status::OK;
+    }
+
+    engine::QueryResultPtr result = std::make_shared<engine::QueryResult>();
+    engine::snapshot::FieldElementMappings field_mappings;
+    status = req_handler_.Search(GetContext(context), query_ptr, json_params, field_mappings, result);
+
+    // step 6: construct and return result
+    FillSearchPBResult(result, response);
+
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->ReqID().c_str(), __func__);
+    SET_RESPONSE(response->mutable_status(), status, context);
+
+    return ::grpc::Status::OK;
+}
+
+Status
+GrpcRequestHandler::ParseSearchPBParam(const ::milvus::grpc::SearchParamPB* request, query::QueryPtr& query_ptr,
+                                       milvus::json& json_params) {
     auto boolean_query = std::make_shared<query::BooleanQuery>();
-    auto query_ptr = std::make_shared<query::Query>();
+    query_ptr = std::make_shared<query::Query>();
     DeSerialization(request->general_query(), boolean_query, query_ptr);
 
     auto general_query = std::make_shared<query::GeneralQuery>();
     query::GenBinaryQuery(boolean_query, general_query->bin);
 
-    Status status;
-
     if (!query::ValidateBinaryQuery(general_query->bin)) {
-        status = Status{SERVER_INVALID_BINARY_QUERY, "Generate wrong binary query tree"};
-        SET_RESPONSE(response->mutable_status(), status, context)
-        return ::grpc::Status::OK;
+        return Status{SERVER_INVALID_BINARY_QUERY, "Generate wrong binary query tree"};
     }
 
-    std::vector<std::string> partition_list;
-    partition_list.resize(request->partition_tag_array_size());
-    for (uint64_t i = 0; i < request->partition_tag_array_size(); ++i) {
-        partition_list[i] = request->partition_tag_array(i);
-    }
-
-    milvus::json json_params;
     for (int i = 0; i < request->extra_params_size(); i++) {
         const ::milvus::grpc::KeyValuePair& extra = request->extra_params(i);
         if (extra.key() == EXTRA_PARAM_KEY) {
@@ -1453,15 +1516,13 @@ GrpcRequestHandler::SearchPB(::grpc::ServerContext* context, const ::milvus::grp
         }
     }
 
-    engine::QueryResultPtr result = std::make_shared<engine::QueryResult>();
-    std::vector<std::string> field_names;
-    engine::snapshot::FieldElementMappings field_mappings;
-    status = req_handler_.Search(GetContext(context), query_ptr, json_params, field_mappings, result);
+    return Status::OK();
+}
 
-    // step 6: construct and return result
+void
+GrpcRequestHandler::FillSearchPBResult(const engine::QueryResultPtr& result, ::milvus::grpc::QueryResult* response) {
     response->set_row_num(result->row_num_);
     auto grpc_entity = response->mutable_entities();
-    //    ConstructEntityResults(result->attrs_, result->vectors_, field_names, grpc_entity);
     grpc_entity->mutable_ids()->Resize(static_cast<int>(result->result_ids_.size()), 0);
     memcpy(grpc_entity->mutable_ids()->mutable_data(), result->result_ids_.data(),
            result->result_ids_.size() * sizeof(int64_t));
@@ -1469,11 +1530,6 @@ GrpcRequestHandler::SearchPB(::grpc::ServerContext* context, const ::milvus::grp
     response->mutable_distances()->Resize(static_cast<int>(result->result_distances_.size()), 0.0);
     memcpy(response->mutable_distances()->mutable_data(), result->result_distances_.data(),
            result->result_distances_.size() * sizeof(float));
-
-    LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->ReqID().c_str(), __func__);
-    SET_RESPONSE(response->mutable_status(), status, context);
-
-    return ::grpc::Status::OK;
 }
 
 #if 0
@@ -1743,6 +1799,10 @@ GrpcRequestHandler::DeserializeJsonToBoolQuery(
                     vector_query->metric_type = metric_type;
                     query_ptr->metric_types.insert({field_name, param_json["metric_type"]});
                 }
+                if (param_json.contains("radius")) {
+                    vector_query->range_search = true;
+                    vector_query->radius = param_json["radius"].get<float>();
+                }
                 if (!vector_param_it.value()["params"].empty()) {
                     vector_query->extra_params = vector_param_it.value()["params"];
                 }
@@ -1784,37 +1844,54 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
 
     CollectionSchema collection_schema;
     status = req_handler_.GetCollectionInfo(GetContext(context), request->collection_name(), collection_schema);
-
-    auto grpc_entity = response->mutable_entities();
     if (!status.ok()) {
         SET_RESPONSE(response->mutable_status(), status, context);
         return ::grpc::Status::OK;
     }
 
-    query::BooleanQueryPtr boolean_query = std::make_shared<query::BooleanQuery>();
-    query::QueryPtr query_ptr = std::make_shared<query::Query>();
-    query_ptr->collection_id = request->collection_name();
-
-    status = DeserializeJsonToBoolQuery(request->vector_param(), request->dsl(), boolean_query, query_ptr);
+    query::QueryPtr query_ptr;
+    milvus::json json_params;
+    status = ParseSearchParam(request, query_ptr, json_params);
     if (!status.ok()) {
         SET_RESPONSE(response->mutable_status(), status, context);
         return ::grpc::Status::OK;
     }
 
-    status = query::ValidateBooleanQuery(boolean_query);
+    engine::QueryResultPtr result = std::make_shared<engine::QueryResult>();
+    engine::snapshot::FieldElementMappings field_mappings;
+
+    status = req_handler_.Search(GetContext(context), query_ptr, json_params, field_mappings, result);
+
     if (!status.ok()) {
         SET_RESPONSE(response->mutable_status(), status, context);
         return ::grpc::Status::OK;
     }
 
+    // step 6: construct and return result
+    FillSearchResult(result, field_mappings, response);
+
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->ReqID().c_str(), __func__);
+    SET_RESPONSE(response->mutable_status(), status, context);
+
+    return ::grpc::Status::OK;
+}
+
+Status
+GrpcRequestHandler::ParseSearchParam(const ::milvus::grpc::SearchParam* request, query::QueryPtr& query_ptr,
+                                     milvus::json& json_params) {
+    query::BooleanQueryPtr boolean_query = std::make_shared<query::BooleanQuery>();
+    query_ptr = std::make_shared<query::Query>();
+    query_ptr->collection_id = request->collection_name();
+
+    STATUS_CHECK(DeserializeJsonToBoolQuery(request->vector_param(), request->dsl(), boolean_query, query_ptr));
+    STATUS_CHECK(query::ValidateBooleanQuery(boolean_query));
+
     query::GeneralQueryPtr general_query = std::make_shared<query::GeneralQuery>();
     query::GenBinaryQuery(boolean_query, general_query->bin);
     query_ptr->root = general_query;
 
     if (!query::ValidateBinaryQuery(general_query->bin)) {
-        status = Status{SERVER_INVALID_BINARY_QUERY, "Generate wrong binary query tree"};
-        SET_RESPONSE(grpc_entity->mutable_status(), status, context);
-        return ::grpc::Status::OK;
+        return Status{SERVER_INVALID_BINARY_QUERY, "Generate wrong binary query tree"};
     }
 
     std::vector<std::string> partition_list;
@@ -1825,7 +1902,6 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
 
     query_ptr->partitions = partition_list;
 
-    milvus::json json_params;
     for (int i = 0; i < request->extra_params_size(); i++) {
         const ::milvus::grpc::KeyValuePair& extra = request->extra_params(i);
         if (extra.key() == EXTRA_PARAM_KEY) {
@@ -1833,18 +1909,15 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
         }
     }
 
-    engine::QueryResultPtr result = std::make_shared<engine::QueryResult>();
-    engine::snapshot::FieldElementMappings field_mappings;
-
-    status = req_handler_.Search(GetContext(context), query_ptr, json_params, field_mappings, result);
-
-    if (!status.ok()) {
-        SET_RESPONSE(response->mutable_status(), status, context);
-        return ::grpc::Status::OK;
-    }
+    return Status::OK();
+}
 
-    // step 6: construct and return result
+void
+GrpcRequestHandler::FillSearchResult(const engine::QueryResultPtr& result,
+                                     const engine::snapshot::FieldElementMappings& field_mappings,
+                                     ::milvus::grpc::QueryResult* response) {
     response->set_row_num(result->row_num_);
+    auto grpc_entity = response->mutable_entities();
     int64_t id_size = result->result_ids_.size();
     grpc_entity->mutable_valid_row()->Resize(id_size, true);
 
@@ -1858,10 +1931,12 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
     memcpy(response->mutable_distances()->mutable_data(), result->result_distances_.data(),
            result->result_distances_.size() * sizeof(float));
 
-    LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->ReqID().c_str(), __func__);
-    SET_RESPONSE(response->mutable_status(), status, context);
-
-    return ::grpc::Status::OK;
+    // range search returns a variable number of results per query, lims[i] is where query i starts
+    if (!result->result_lims_.empty()) {
+        ::milvus::grpc::KeyValuePair* kv = response->add_extra_params();
+        kv->set_key("lims");
+        kv->set_value(milvus::json(result->result_lims_).dump());
+    }
 }
 
 void
@@ -1878,6 +1953,22 @@ GrpcRequestHandler::WaitToInsert(const std::string& request_id, int64_t request_
     lock.unlock();
 }
 
+bool
+GrpcRequestHandler::TryToInsert(const std::string& request_id, int64_t request_size) {
+    std::lock_guard<std::mutex> lock(max_concurrent_insert_request_mutex);
+    if (max_concurrent_insert_request_size - request_size <= 0) {
+        return false;
+    }
+    max_concurrent_insert_request_size -= request_size;
+    LOG_SERVER_DEBUG_ << LogOut(
+        "Start to process insert request [%s], "
+        "gRPC buffer size(request/remain/total): %s, %s, %s",
+        request_id.c_str(), CommonUtil::ConvertSize(request_size).c_str(),
+        CommonUtil::ConvertSize(max_concurrent_insert_request_size).c_str(),
+        CommonUtil::ConvertSize(max_concurrent_insert_request_size_).c_str());
+    return true;
+}
+
 void
 GrpcRequestHandler::FinishInsert(const std::string& request_id, int64_t request_size) {
     {
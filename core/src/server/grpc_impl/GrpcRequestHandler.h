@@ -19,6 +19,7 @@
 #include <random>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "grpc/gen-milvus/milvus.grpc.pb.h"
 #include "grpc/gen-status/status.pb.h"
@@ -59,10 +60,14 @@ ErrorMap(ErrorCode code);
 
 extern const char* EXTRA_PARAM_KEY;
 
-class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service, public GrpcInterceptorHookHandler {
+class GrpcRequestHandler : public ::milvus::grpc::MilvusService::Service, public GrpcInterceptorHookHandler {
  public:
     explicit GrpcRequestHandler(const std::shared_ptr<opentracing::Tracer>& tracer);
 
+    // the generated async method wrappers default construct their base class
+    GrpcRequestHandler() : GrpcRequestHandler(opentracing::Tracer::Global()) {
+    }
+
     void
     OnPostRecvInitialMetaData(::grpc::experimental::ServerRpcInfo* server_rpc_info,
                               ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) override;
@@ -330,16 +335,59 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     Status
     ProcessLeafQueryJson(const milvus::json& query_json, query::BooleanQueryPtr& query, std::string& field_name);
 
- private:
+ protected:
+    // "import {json}" command, the json has the fields of the http bulk import: collection_name, partition_tag, path
+    Status
+    BulkImport(const std::shared_ptr<Context>& context, const std::string& param, std::string& reply);
+
+    // request parsing and response filling, shared by the sync methods and the async ones of GrpcAsyncRequestHandler
+    Status
+    ParseInsertParam(const ::milvus::grpc::InsertParam* request, int32_t& row_num,
+                     std::unordered_map<std::string, std::vector<uint8_t>>& chunk_data);
+
+    void
+    FillInsertResult(const std::unordered_map<std::string, std::vector<uint8_t>>& chunk_data,
+                     ::milvus::grpc::EntityIds* response);
+
+    void
+    ParseGetEntityParam(const ::milvus::grpc::EntityIdentity* request, engine::IDNumbers& vector_ids,
+                        std::vector<std::string>& field_names);
+
+    void
+    FillGetEntityResult(const engine::IDNumbers& vector_ids, const std::vector<bool>& valid_row,
+                        const engine::snapshot::FieldElementMappings& field_mappings,
+                        const engine::DataChunkPtr& data_chunk, ::milvus::grpc::Entities* response);
+
+    Status
+    ParseSearchParam(const ::milvus::grpc::SearchParam* request, query::QueryPtr& query_ptr,
+                     milvus::json& json_params);
+
+    void
+    FillSearchResult(const engine::QueryResultPtr& result, const engine::snapshot::FieldElementMappings& field_mappings,
+                     ::milvus::grpc::QueryResult* response);
+
+    Status
+    ParseSearchPBParam(const ::milvus::grpc::SearchParamPB* request, query::QueryPtr& query_ptr,
+                       milvus::json& json_params);
+
+    void
+    FillSearchPBResult(const engine::QueryResultPtr& result, ::milvus::grpc::QueryResult* response);
+
     void
     WaitToInsert(const std::string& request_id, int64_t request_size);
 
+    // like WaitToInsert, but returns false instead of waiting when there is not enough room
+    bool
+    TryToInsert(const std::string& request_id, int64_t request_size);
+
     void
     FinishInsert(const std::string& request_id, int64_t request_size);
 
- private:
+ protected:
     ReqHandler req_handler_;
 
+ private:
+
     std::unordered_map<std::string, std::shared_ptr<Context>> context_map_;
     std::shared_ptr<opentracing::Tracer> tracer_;
 
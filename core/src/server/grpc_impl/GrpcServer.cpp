@@ -35,6 +35,7 @@
 #include "config/ServerConfig.h"
 #include "grpc/gen-milvus/milvus.grpc.pb.h"
 #include "server/DBWrapper.h"
+#include "server/grpc_impl/GrpcAsyncRequestHandler.h"
 #include "server/grpc_impl/interceptor/SpanInterceptor.h"
 #include "utils/Log.h"
 
@@ -90,25 +91,57 @@ GrpcServer::StartService() {
     builder.SetDefaultCompressionAlgorithm(GRPC_COMPRESS_STREAM_GZIP);
     builder.SetDefaultCompressionLevel(GRPC_COMPRESS_LEVEL_NONE);
 
-    GrpcRequestHandler service(opentracing::Tracer::Global());
-    service.RegisterRequestHandler(ReqHandler());
+    // the async handler serves the hot methods from completion queues, the others are still sync
+    std::unique_ptr<GrpcRequestHandler> service;
+    GrpcAsyncRequestHandler* async_service = nullptr;
+    std::vector<std::unique_ptr<::grpc::ServerCompletionQueue>> completion_queues;
+    if (config.network.grpc_async.enable()) {
+        async_service = new GrpcAsyncRequestHandler();
+        service.reset(async_service);
+        for (int64_t i = 0; i < config.network.grpc_async.threads(); ++i) {
+            completion_queues.emplace_back(builder.AddCompletionQueue());
+        }
+    } else {
+        service = std::make_unique<GrpcRequestHandler>(opentracing::Tracer::Global());
+    }
+    service->RegisterRequestHandler(ReqHandler());
 
     builder.AddListeningPort(server_address, ::grpc::InsecureServerCredentials());
-    builder.RegisterService(&service);
+    builder.RegisterService(service.get());
 
     // Add gRPC interceptor
     using InterceptorI = ::grpc::experimental::ServerInterceptorFactoryInterface;
     using InterceptorIPtr = std::unique_ptr<InterceptorI>;
     std::vector<InterceptorIPtr> creators;
 
-    creators.push_back(
-        std::unique_ptr<::grpc::experimental::ServerInterceptorFactoryInterface>(new SpanInterceptorFactory(&service)));
+    creators.push_back(std::unique_ptr<::grpc::experimental::ServerInterceptorFactoryInterface>(
+        new SpanInterceptorFactory(service.get())));
 
     builder.experimental().SetInterceptorCreators(std::move(creators));
 
     server_ptr_ = builder.BuildAndStart();
+
+    std::vector<std::thread> async_threads;
+    for (auto& cq : completion_queues) {
+        async_threads.emplace_back(&GrpcAsyncRequestHandler::Serve, async_service, cq.get());
+    }
+
     server_ptr_->Wait();
 
+    // the scheduler callbacks of pending calls still send responses to the queues, wait for them before
+    // the queues are shut down and the service is destroyed
+    if (async_service != nullptr) {
+        async_service->WaitForCalls();
+    }
+
+    // queues are shut down after the server, the async threads drain them and exit
+    for (auto& cq : completion_queues) {
+        cq->Shutdown();
+    }
+    for (auto& thread : async_threads) {
+        thread.join();
+    }
+
     return Status::OK();
 }
 
@@ -78,6 +78,7 @@ static std::map<std::string, engine::DataType> str2type = {{"int32", engine::Dat
                                                            {"float", engine::DataType::FLOAT},
                                                            {"double", engine::DataType::DOUBLE},
                                                            {"vector_float", engine::DataType::VECTOR_FLOAT},
+                                                           {"vector_float16", engine::DataType::VECTOR_FLOAT16},
                                                            {"vector_binary", engine::DataType::VECTOR_BINARY}};
 
 static std::map<engine::DataType, std::string> type2str = {{engine::DataType::INT32, "int32"},
@@ -85,6 +86,7 @@ static std::map<engine::DataType, std::string> type2str = {{engine::DataType::IN
                                                            {engine::DataType::FLOAT, "float"},
                                                            {engine::DataType::DOUBLE, "double"},
                                                            {engine::DataType::VECTOR_FLOAT, "vector_float"},
+                                                           {engine::DataType::VECTOR_FLOAT16, "vector_float16"},
                                                            {engine::DataType::VECTOR_BINARY, "vector_binary"}};
 
 }  // namespace web
@@ -246,7 +246,8 @@ WebRequestHandler::CopyData2Json(const milvus::engine::DataChunkPtr& data_chunk,
                     entity_json[name] = binary_vector;
                     break;
                 }
-                case engine::DataType::VECTOR_FLOAT: {
+                case engine::DataType::VECTOR_FLOAT:
+                case engine::DataType::VECTOR_FLOAT16: {
                     std::vector<float> float_vector;
                     auto vector_size = single_size * sizeof(int8_t) / sizeof(float);
                     float_vector.resize(vector_size);
@@ -514,6 +515,36 @@ WebRequestHandler::Compact(const nlohmann::json& json, std::string& result_str)
     return status;
 }
 
+Status
+WebRequestHandler::BulkImport(const nlohmann::json& json, std::string& result_str) {
+    if (!json.contains("collection_name") || !json.contains("path")) {
+        return Status(BODY_FIELD_LOSS, "Field \"import\" must contains collection_name and path");
+    }
+
+    auto collection_name = json["collection_name"];
+    auto path = json["path"];
+    if (!collection_name.is_string() || !path.is_string()) {
+        return Status(ILLEGAL_BODY, "Field \"collection_name\" and \"path\" must be strings");
+    }
+
+    std::string partition_tag;
+    if (json.contains("partition_tag")) {
+        partition_tag = json["partition_tag"].get<std::string>();
+    }
+
+    int64_t row_count = 0;
+    auto status = req_handler_.BulkImport(context_ptr_, collection_name.get<std::string>(), partition_tag,
+                                          path.get<std::string>(), row_count);
+    if (status.ok()) {
+        nlohmann::json result;
+        AddStatusToJson(result, status.code(), status.message());
+        result["row_count"] = row_count;
+        result_str = result.dump();
+    }
+
+    return status;
+}
+
 Status
 WebRequestHandler::GetConfig(std::string& result_str) {
     std::string cmd = "get_milvus_config";
@@ -640,6 +671,10 @@ WebRequestHandler::ProcessLeafQueryJson(const nlohmann::json& json, milvus::quer
                 vector_query->metric_type = metric_type;
                 query_ptr->metric_types.insert({vector_name, metric_type});
             }
+            if (param_json.contains("radius")) {
+                vector_query->range_search = true;
+                vector_query->radius = param_json["radius"].get<float>();
+            }
             if (!vector_param_it.value()["params"].empty()) {
                 vector_query->extra_params = vector_param_it.value()["params"];
             }
@@ -648,7 +683,8 @@ WebRequestHandler::ProcessLeafQueryJson(const nlohmann::json& json, milvus::quer
             vector_query->query_vector.vector_count = values.size();
             for (auto& vector_records : values) {
                 if (field_type_.find(vector_name) != field_type_.end()) {
-                    if (field_type_.at(vector_name) == engine::DataType::VECTOR_FLOAT) {
+                    if (field_type_.at(vector_name) == engine::DataType::VECTOR_FLOAT ||
+                        field_type_.at(vector_name) == engine::DataType::VECTOR_FLOAT16) {
                         for (auto& data : vector_records) {
                             vector_query->query_vector.float_data.emplace_back(data.get<float>());
                         }
@@ -814,13 +850,17 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
             return Status::OK();
         }
 
+        // range search returns a variable number of results per query, result_lims_ holds where each one starts
+        bool with_lims = result->result_lims_.size() == static_cast<size_t>(result->row_num_ + 1);
         auto step = result->result_ids_.size() / result->row_num_;  // topk
         for (int64_t i = 0; i < result->row_num_; i++) {
-            nlohmann::json raw_result_json;
-            for (size_t j = 0; j < step; j++) {
+            nlohmann::json raw_result_json = nlohmann::json::array();
+            size_t begin = with_lims ? result->result_lims_[i] : i * step;
+            size_t end = with_lims ? result->result_lims_[i + 1] : begin + step;
+            for (size_t j = begin; j < end; j++) {
                 nlohmann::json one_result_json;
-                one_result_json["id"] = std::to_string(result->result_ids_.at(i * step + j));
-                one_result_json["distance"] = std::to_string(result->result_distances_.at(i * step + j));
+                one_result_json["id"] = std::to_string(result->result_ids_.at(j));
+                one_result_json["distance"] = std::to_string(result->result_distances_.at(j));
                 FloatJson one_entity_json;
                 for (const auto& field : field_mappings) {
                     auto field_name = field.first->GetName();
@@ -828,37 +868,38 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
                     switch (field.first->GetFtype()) {
                         case engine::DataType::INT32: {
                             int32_t int32_value;
-                            int64_t offset = (i * step + j) * sizeof(int32_t);
+                            int64_t offset = j * sizeof(int32_t);
                             memcpy(&int32_value, field_data.at(field_name)->data_.data() + offset, sizeof(int32_t));
                             one_entity_json[field_name] = int32_value;
                             break;
                         }
                         case engine::DataType::INT64: {
                             int64_t int64_value;
-                            int64_t offset = (i * step + j) * sizeof(int64_t);
+                            int64_t offset = j * sizeof(int64_t);
                             memcpy(&int64_value, field_data.at(field_name)->data_.data() + offset, sizeof(int64_t));
                             one_entity_json[field_name] = int64_value;
                             break;
                         }
                         case engine::DataType::FLOAT: {
                             float float_value;
-                            int64_t offset = (i * step + j) * sizeof(float);
+                            int64_t offset = j * sizeof(float);
                             memcpy(&float_value, field_data.at(field_name)->data_.data() + offset, sizeof(float));
                             one_entity_json[field_name] = float_value;
                             break;
                         }
                         case engine::DataType::DOUBLE: {
                             double double_value;
-                            int64_t offset = (i * step + j) * sizeof(double);
+                            int64_t offset = j * sizeof(double);
                             memcpy(&double_value, field_data.at(field_name)->data_.data() + offset, sizeof(double));
                             one_entity_json[field_name] = double_value;
                             break;
                         }
-                        case engine::DataType::VECTOR_FLOAT: {
+                        case engine::DataType::VECTOR_FLOAT:
+                        case engine::DataType::VECTOR_FLOAT16: {
                             std::vector<float> float_vector;
                             auto dim =
                                 field_data.at(field_name)->data_.size() / (result->result_ids_.size() * sizeof(float));
-                            int64_t offset = (i * step + j) * dim * sizeof(float);
+                            int64_t offset = j * dim * sizeof(float);
                             float_vector.resize(dim);
                             memcpy(float_vector.data(), field_data.at(field_name)->data_.data() + offset,
                                    dim * sizeof(float));
@@ -868,7 +909,7 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
                         case engine::DataType::VECTOR_BINARY: {
                             std::vector<int8_t> binary_vector;
                             auto dim = field_data.at(field_name)->data_.size() / (result->result_ids_.size());
-                            int64_t offset = (i * step + j) * dim;
+                            int64_t offset = j * dim;
                             binary_vector.resize(dim);
                             memcpy(binary_vector.data(), field_data.at(field_name)->data_.data() + offset,
                                    dim * sizeof(int8_t));
@@ -1664,8 +1705,9 @@ WebRequestHandler::InsertEntity(const OString& collection_name, const milvus::se
                     break;
                 }
                 case engine::DataType::VECTOR_FLOAT:
+                case engine::DataType::VECTOR_FLOAT16:
                 case engine::DataType::VECTOR_BINARY: {
-                    bool is_bin = !(field_types.at(field_name) == engine::DataType::VECTOR_FLOAT);
+                    bool is_bin = (field_types.at(field_name) == engine::DataType::VECTOR_BINARY);
                     CopyRowVectorFromJson(entity.value(), temp_data, is_bin);
                     auto size = temp_data.size();
                     if (chunk_data.find(field_name) == chunk_data.end()) {
@@ -1920,6 +1962,9 @@ WebRequestHandler::SystemOp(const OString& op, const OString& body_str, OString&
             if (j.contains("compact")) {
                 status = Compact(j["compact"], result_str);
             }
+            if (j.contains("import")) {
+                status = BulkImport(j["import"], result_str);
+            }
         } else if (op->equals("config")) {
             status = SetConfig(j, result_str);
         } else {
@@ -125,6 +125,9 @@ class WebRequestHandler {
     Status
     Compact(const nlohmann::json& json, std::string& result_str);
 
+    Status
+    BulkImport(const nlohmann::json& json, std::string& result_str);
+
     Status
     GetConfig(std::string& result_str);
 
@@ -98,6 +98,7 @@ constexpr ErrorCode SERVER_INVALID_BINARY_QUERY = ToServerErrorCode(119);
 constexpr ErrorCode SERVER_INVALID_DSL_PARAMETER = ToServerErrorCode(120);
 constexpr ErrorCode SERVER_INVALID_FIELD_NAME = ToServerErrorCode(121);
 constexpr ErrorCode SERVER_INVALID_FIELD_NUM = ToServerErrorCode(122);
+constexpr ErrorCode SERVER_REQUEST_REJECTED = ToServerErrorCode(123);
 
 // db error code
 constexpr ErrorCode DB_META_TRANSACTION_FAILED = ToDbErrorCode(1);
@@ -138,5 +139,6 @@ constexpr ErrorCode SS_OPERATION_PENDING = ToSSErrorCode(9);
 constexpr ErrorCode SS_TIMEOUT = ToSSErrorCode(10);
 constexpr ErrorCode SS_NOT_COMMITED = ToSSErrorCode(11);
 constexpr ErrorCode SS_COLLECTION_DROPPED = ToSSErrorCode(12);
+constexpr ErrorCode SS_HOLDER_EVICTED = ToSSErrorCode(13);
 
 }  // namespace milvus
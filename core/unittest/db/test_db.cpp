@@ -16,11 +16,15 @@
 #include <src/cache/CpuCacheMgr.h>
 #include <algorithm>
 #include <experimental/filesystem>
+#include <fstream>
 #include <set>
 #include <string>
 
+#include "codecs/Codec.h"
+#include "db/DBImpl.h"
 #include "db/SnapshotUtils.h"
 #include "db/SnapshotVisitor.h"
+#include "db/Utils.h"
 #include "db/merge/MergeAdaptiveStrategy.h"
 #include "db/merge/MergeLayerStrategy.h"
 #include "db/merge/MergeSimpleStrategy.h"
@@ -30,6 +34,9 @@
 #include "db/utils.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "segment/Segment.h"
+#include "storage/disk/DiskIOReader.h"
+#include "storage/disk/DiskIOWriter.h"
+#include "storage/disk/DiskOperation.h"
 
 using SegmentVisitor = milvus::engine::SegmentVisitor;
 using InActiveResourcesGCEvent = milvus::engine::snapshot::InActiveResourcesGCEvent;
@@ -86,7 +93,8 @@ CreateCollection2(std::shared_ptr<DB> db, const std::string& collection_name, bo
 }
 
 milvus::Status
-CreateCollection3(std::shared_ptr<DB> db, const std::string& collection_name, const LSN_TYPE& lsn) {
+CreateCollection3(std::shared_ptr<DB> db, const std::string& collection_name, const LSN_TYPE& lsn,
+                  milvus::engine::DataType vector_type = milvus::engine::DataType::VECTOR_FLOAT) {
     CreateCollectionContext context;
     context.lsn = lsn;
     auto collection_schema = std::make_shared<Collection>(collection_name);
@@ -94,7 +102,7 @@ CreateCollection3(std::shared_ptr<DB> db, const std::string& collection_name, co
 
     milvus::json params;
     params[milvus::knowhere::meta::DIM] = COLLECTION_DIM;
-    auto vector_field = std::make_shared<Field>("float_vector", 0, milvus::engine::DataType::VECTOR_FLOAT, params);
+    auto vector_field = std::make_shared<Field>("float_vector", 0, vector_type, params);
     context.fields_schema[vector_field] = {};
 
     std::unordered_map<std::string, milvus::engine::DataType> attr_type = {
@@ -507,6 +515,335 @@ TEST_F(DBTest, QueryTest) {
     ASSERT_EQ(result->row_num_, nq);
 }
 
+TEST_F(DBTest, RefineQueryTest) {
+    LSN_TYPE lsn = 0;
+    auto next_lsn = [&]() -> decltype(lsn) { return ++lsn; };
+
+    std::string c1 = "c1";
+    auto status = CreateCollection3(db_, c1, next_lsn());
+    ASSERT_TRUE(status.ok());
+
+    const uint64_t entity_count = 10000;
+    milvus::engine::DataChunkPtr data_chunk;
+    BuildEntities2(entity_count, 0, data_chunk);
+    auto& raw_vectors = data_chunk->fixed_fields_["float_vector"]->data_;
+    std::vector<float> vectors(entity_count * COLLECTION_DIM);
+    memcpy(vectors.data(), raw_vectors.data(), raw_vectors.size());
+
+    status = db_->Insert(c1, "", data_chunk);
+    ASSERT_TRUE(status.ok());
+
+    status = db_->Flush();
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::CollectionIndex index;
+    index.index_name_ = "refine_index";
+    index.index_type_ = milvus::knowhere::IndexEnum::INDEX_FAISS_IVFSQ8;
+    index.metric_name_ = milvus::knowhere::Metric::L2;
+    index.extra_params_["nlist"] = 64;
+    status = db_->CreateIndex(dummy_context_, c1, "float_vector", index);
+    ASSERT_TRUE(status.ok());
+
+    milvus::server::ContextPtr ctx1;
+    std::vector<std::string> field_names;
+    std::vector<std::string> partitions;
+    int64_t nq = 5;
+    int64_t topk = 10;
+
+    // refine_k less than topk is rejected
+    {
+        milvus::query::QueryPtr query_ptr = std::make_shared<milvus::query::Query>();
+        milvus::engine::QueryResultPtr result = std::make_shared<milvus::engine::QueryResult>();
+        BuildQueryPtr(c1, nq, topk, field_names, partitions, query_ptr);
+        query_ptr->vectors.begin()->second->extra_params = {{"nprobe", 64}, {"refine_k", topk - 1}};
+        status = db_->Query(ctx1, query_ptr, result);
+        ASSERT_FALSE(status.ok());
+    }
+
+    // candidates are reranked by exact distance, the refined top k is the exact top k
+    {
+        milvus::query::QueryPtr query_ptr = std::make_shared<milvus::query::Query>();
+        milvus::engine::QueryResultPtr result = std::make_shared<milvus::engine::QueryResult>();
+        BuildQueryPtr(c1, nq, topk, field_names, partitions, query_ptr);
+        std::vector<int64_t> all_values(entity_count);
+        for (uint64_t i = 0; i < entity_count; ++i) {
+            all_values[i] = i;
+        }
+        query_ptr->root->bin->left_query->leaf->term_query->json_obj = {{"int64", {{"values", all_values}}}};
+        auto& vector_query = query_ptr->vectors.begin()->second;
+        vector_query->extra_params = {{"nprobe", 64}, {"refine_k", topk * 10}};
+        status = db_->Query(ctx1, query_ptr, result);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(result->row_num_, nq);
+
+        auto& query_vectors = vector_query->query_vector.float_data;
+        for (int64_t i = 0; i < nq; ++i) {
+            std::vector<float> exact(entity_count);
+            for (uint64_t n = 0; n < entity_count; ++n) {
+                float dist = 0;
+                for (int64_t d = 0; d < COLLECTION_DIM; ++d) {
+                    float diff = query_vectors[i * COLLECTION_DIM + d] - vectors[n * COLLECTION_DIM + d];
+                    dist += diff * diff;
+                }
+                exact[n] = dist;
+            }
+            std::partial_sort(exact.begin(), exact.begin() + topk, exact.end());
+            for (int64_t j = 0; j < topk; ++j) {
+                ASSERT_NEAR(result->result_distances_[i * topk + j], exact[j], exact[j] * 1e-4 + 1e-5);
+            }
+        }
+    }
+}
+
+TEST_F(DBTest, Float16Test) {
+    LSN_TYPE lsn = 0;
+    auto next_lsn = [&]() -> decltype(lsn) { return ++lsn; };
+
+    std::string c1 = "c1";
+    auto status = CreateCollection3(db_, c1, next_lsn(), milvus::engine::DataType::VECTOR_FLOAT16);
+    ASSERT_TRUE(status.ok());
+
+    const uint64_t entity_count = 10000;
+    milvus::engine::DataChunkPtr data_chunk;
+    BuildEntities2(entity_count, 0, data_chunk);
+
+    // the field stores 2 bytes per dimension
+    status = milvus::engine::utils::FloatToFloat16(data_chunk->fixed_fields_["float_vector"]->data_);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(data_chunk->fixed_fields_["float_vector"]->Size(), entity_count * COLLECTION_DIM * sizeof(uint16_t));
+    status = db_->Insert(c1, "", data_chunk);
+    ASSERT_TRUE(status.ok());
+
+    status = db_->Flush();
+    ASSERT_TRUE(status.ok());
+
+    milvus::server::ContextPtr ctx1;
+    std::vector<std::string> field_names;
+    std::vector<std::string> partitions;
+    int64_t nq = 5;
+    int64_t topk = 10;
+    auto do_query = [&](const milvus::json& extra_params) {
+        milvus::query::QueryPtr query_ptr = std::make_shared<milvus::query::Query>();
+        milvus::engine::QueryResultPtr result = std::make_shared<milvus::engine::QueryResult>();
+        BuildQueryPtr(c1, nq, topk, field_names, partitions, query_ptr);
+        query_ptr->vectors.begin()->second->extra_params = extra_params;
+        status = db_->Query(ctx1, query_ptr, result);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(result->row_num_, nq);
+        for (int64_t i = 0; i < nq; ++i) {
+            for (int64_t j = 1; j < topk; ++j) {
+                ASSERT_LE(result->result_distances_[i * topk + j - 1], result->result_distances_[i * topk + j]);
+            }
+        }
+    };
+
+    // searched by the half precision flat index
+    do_query({});
+
+    milvus::engine::CollectionIndex index;
+    index.index_name_ = "fp16_index";
+    index.index_type_ = milvus::knowhere::IndexEnum::INDEX_HNSW;
+    index.metric_name_ = milvus::knowhere::Metric::L2;
+    index.extra_params_ = {{"M", 16}, {"efConstruction", 64}};
+    status = db_->CreateIndex(dummy_context_, c1, "float_vector", index);
+    ASSERT_TRUE(status.ok());
+
+    do_query({{"ef", 64}});
+}
+
+TEST_F(DBTest, Float16MergeTest) {
+    LSN_TYPE lsn = 0;
+    auto next_lsn = [&]() -> decltype(lsn) { return ++lsn; };
+
+    std::string c1 = "c1";
+    auto status = CreateCollection3(db_, c1, next_lsn(), milvus::engine::DataType::VECTOR_FLOAT16);
+    ASSERT_TRUE(status.ok());
+
+    const uint64_t entity_count = 1000;
+    std::vector<float> last_batch;
+    auto do_insert = [&](uint64_t batch_index) {
+        milvus::engine::DataChunkPtr data_chunk;
+        BuildEntities2(entity_count, batch_index, data_chunk);
+        auto& vectors = data_chunk->fixed_fields_["float_vector"]->data_;
+        last_batch.resize(entity_count * COLLECTION_DIM);
+        memcpy(last_batch.data(), vectors.data(), vectors.size());
+        status = milvus::engine::utils::FloatToFloat16(vectors);
+        ASSERT_TRUE(status.ok());
+        status = db_->Insert(c1, "", data_chunk);
+        ASSERT_TRUE(status.ok());
+        status = db_->Flush();
+        ASSERT_TRUE(status.ok());
+    };
+
+    // the first segment gets an HNSW index, merge extends its graph with the vectors of the second one
+    do_insert(0);
+    milvus::engine::CollectionIndex index;
+    index.index_name_ = "fp16_index";
+    index.index_type_ = milvus::knowhere::IndexEnum::INDEX_HNSW;
+    index.metric_name_ = milvus::knowhere::Metric::L2;
+    index.extra_params_ = {{"M", 16}, {"efConstruction", 64}};
+    status = db_->CreateIndex(dummy_context_, c1, "float_vector", index);
+    ASSERT_TRUE(status.ok());
+    do_insert(1);
+
+    // wait to merge finished
+    sleep(2);
+
+    int64_t row_count = 0;
+    status = db_->CountEntities(c1, row_count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(row_count, entity_count * 2);
+
+    // vectors added to the graph during merge are found by themselves
+    milvus::server::ContextPtr ctx1;
+    std::vector<std::string> field_names;
+    std::vector<std::string> partitions;
+    int64_t nq = 5;
+    int64_t topk = 10;
+    milvus::query::QueryPtr query_ptr = std::make_shared<milvus::query::Query>();
+    milvus::engine::QueryResultPtr result = std::make_shared<milvus::engine::QueryResult>();
+    BuildQueryPtr(c1, nq, topk, field_names, partitions, query_ptr);
+    auto& vector_query = query_ptr->vectors.begin()->second;
+    vector_query->extra_params = {{"ef", 64}};
+    vector_query->query_vector.float_data.assign(last_batch.begin(), last_batch.begin() + nq * COLLECTION_DIM);
+    status = db_->Query(ctx1, query_ptr, result);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(result->row_num_, nq);
+    for (int64_t i = 0; i < nq; ++i) {
+        ASSERT_LT(result->result_distances_[i * topk], 0.01);
+    }
+}
+
+TEST_F(DBTest, HnswMergeDeleteTest) {
+    LSN_TYPE lsn = 0;
+    auto next_lsn = [&]() -> decltype(lsn) { return ++lsn; };
+
+    std::string c1 = "c1";
+    auto status = CreateCollection3(db_, c1, next_lsn());
+    ASSERT_TRUE(status.ok());
+
+    const int64_t entity_count = 1000;
+    std::vector<float> first_batch;
+    milvus::engine::IDNumbers first_ids;
+    auto do_insert = [&](uint64_t batch_index) {
+        milvus::engine::DataChunkPtr data_chunk;
+        BuildEntities2(entity_count, batch_index, data_chunk);
+        if (batch_index == 0) {
+            auto& vectors = data_chunk->fixed_fields_["float_vector"]->data_;
+            first_batch.resize(entity_count * COLLECTION_DIM);
+            memcpy(first_batch.data(), vectors.data(), vectors.size());
+        }
+        status = db_->Insert(c1, "", data_chunk);
+        ASSERT_TRUE(status.ok());
+        if (batch_index == 0) {
+            milvus::engine::utils::GetIDFromChunk(data_chunk, first_ids);
+        }
+        status = db_->Flush();
+        ASSERT_TRUE(status.ok());
+    };
+
+    do_insert(0);
+    milvus::engine::CollectionIndex index;
+    index.index_name_ = "hnsw_index";
+    index.index_type_ = milvus::knowhere::IndexEnum::INDEX_HNSW;
+    index.metric_name_ = milvus::knowhere::Metric::L2;
+    index.extra_params_ = {{"M", 16}, {"efConstruction", 64}};
+    status = db_->CreateIndex(dummy_context_, c1, "float_vector", index);
+    ASSERT_TRUE(status.ok());
+
+    // the indexed segment has fewer live entities than graph nodes
+    const int64_t delete_count = 100;
+    ASSERT_EQ(first_ids.size(), entity_count);
+    milvus::engine::IDNumbers delete_ids(first_ids.begin(), first_ids.begin() + delete_count);
+    status = db_->DeleteEntityByID(c1, delete_ids);
+    ASSERT_TRUE(status.ok());
+    status = db_->Flush();
+    ASSERT_TRUE(status.ok());
+
+    // merge reuses the graph of the first segment
+    do_insert(1);
+    sleep(2);
+
+    int64_t row_count = 0;
+    status = db_->CountEntities(c1, row_count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(row_count, entity_count * 2 - delete_count);
+
+    // every surviving entity of the first segment is still in the graph
+    milvus::server::ContextPtr ctx1;
+    std::vector<std::string> field_names;
+    std::vector<std::string> partitions;
+    int64_t nq = entity_count - delete_count;
+    int64_t topk = 10;
+    milvus::query::QueryPtr query_ptr = std::make_shared<milvus::query::Query>();
+    milvus::engine::QueryResultPtr result = std::make_shared<milvus::engine::QueryResult>();
+    BuildQueryPtr(c1, nq, topk, field_names, partitions, query_ptr);
+    std::vector<int64_t> all_values(entity_count);
+    for (int64_t i = 0; i < entity_count; ++i) {
+        all_values[i] = i;
+    }
+    query_ptr->root->bin->left_query->leaf->term_query->json_obj = {{"int64", {{"values", all_values}}}};
+    auto& vector_query = query_ptr->vectors.begin()->second;
+    vector_query->extra_params = {{"ef", 256}};
+    vector_query->query_vector.float_data.assign(first_batch.begin() + delete_count * COLLECTION_DIM,
+                                                 first_batch.end());
+    status = db_->Query(ctx1, query_ptr, result);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(result->row_num_, nq);
+    for (int64_t i = 0; i < nq; ++i) {
+        ASSERT_EQ(result->result_ids_[i * topk], first_ids[delete_count + i]);
+        ASSERT_LT(result->result_distances_[i * topk], 0.01);
+    }
+}
+
+TEST_F(DBTest, IndexEvictedCollectionTest) {
+    std::string c1 = "c1";
+    CreateCollectionContext context;
+    context.lsn = 1;
+    milvus::json collection_params;
+    collection_params[milvus::engine::PARAM_SEGMENT_ROW_COUNT] = 100;
+    context.collection = std::make_shared<Collection>(c1, collection_params);
+    milvus::json params;
+    params[milvus::knowhere::meta::DIM] = COLLECTION_DIM;
+    context.fields_schema[std::make_shared<Field>("float_vector", 0, milvus::engine::DataType::VECTOR_FLOAT,
+                                                  params)] = {};
+    context.fields_schema[std::make_shared<Field>("int64", 0, milvus::engine::DataType::INT64)] = {};
+    auto status = db_->CreateCollection(context);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::CollectionIndex index;
+    index.index_name_ = "ivf_index";
+    index.index_type_ = milvus::knowhere::IndexEnum::INDEX_FAISS_IVFFLAT;
+    index.metric_name_ = milvus::knowhere::Metric::L2;
+    index.extra_params_ = {{"nlist", 16}};
+    status = db_->CreateIndex(dummy_context_, c1, "float_vector", index);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::DataChunkPtr data_chunk;
+    BuildEntities2(1000, 0, data_chunk);
+    status = db_->Insert(c1, "", data_chunk);
+    ASSERT_TRUE(status.ok());
+    status = db_->Flush(c1);
+    ASSERT_TRUE(status.ok());
+
+    // the flushed collection is evicted before the background build starts
+    Snapshots::GetInstance().SetMemoryLimit(1);
+    std::vector<std::string> loaded_names;
+    Snapshots::GetInstance().GetLoadedCollectionNames(loaded_names);
+    ASSERT_EQ(std::find(loaded_names.begin(), loaded_names.end(), c1), loaded_names.end());
+    sleep(3);
+    Snapshots::GetInstance().SetMemoryLimit(0);
+
+    ScopedSnapshotT ss;
+    status = Snapshots::GetInstance().GetSnapshot(ss, c1);
+    ASSERT_TRUE(status.ok());
+    milvus::engine::SnapshotVisitor ss_visitor(ss);
+    milvus::engine::snapshot::IDS_TYPE segment_ids;
+    status = ss_visitor.SegmentsToIndex("", segment_ids, false);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(segment_ids.empty());
+}
+
 TEST_F(DBTest, InsertTest) {
     auto do_insert = [&](bool autogen_id, bool provide_id) -> void {
         CreateCollectionContext context;
@@ -1576,3 +1913,375 @@ TEST_F(DBTest, LoadTest) {
         entity_count * (COLLECTION_DIM * sizeof(float) + sizeof(int32_t) + sizeof(int64_t) + sizeof(double)) * 2;
     ASSERT_GE(cache_mgr.CacheUsage(), total_size);
 }
+
+TEST_F(DBTest, PreloadTest) {
+    std::vector<std::string> collection_names = {"PRELOAD_TEST_1", "PRELOAD_TEST_2"};
+    const uint64_t entity_count = 1000;
+    for (auto& collection_name : collection_names) {
+        auto status = CreateCollection2(db_, collection_name);
+        ASSERT_TRUE(status.ok());
+
+        milvus::engine::DataChunkPtr data_chunk;
+        BuildEntities(entity_count, 0, data_chunk);
+        status = db_->Insert(collection_name, "", data_chunk);
+        ASSERT_TRUE(status.ok());
+    }
+
+    auto status = db_->Flush();
+    ASSERT_TRUE(status.ok());
+
+    auto& cache_mgr = milvus::cache::CpuCacheMgr::GetInstance();
+    cache_mgr.ClearCache();
+
+    status = db_->PreloadCollections(dummy_context_, collection_names);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::PreloadProgress progress;
+    db_->GetPreloadProgress(progress);
+    ASSERT_FALSE(progress.running_);
+    ASSERT_EQ(progress.total_segments_, 2);
+    ASSERT_EQ(progress.loaded_segments_, 2);
+    ASSERT_EQ(progress.skipped_segments_, 0);
+    ASSERT_EQ(progress.loaded_bytes_, progress.total_bytes_);
+
+    // 2 segments, 4 fields, at least 8 files loaded
+    ASSERT_GE(cache_mgr.ItemCount(), 8);
+
+    // segments which don't fit into the cache are skipped instead of evicting others
+    auto capacity = cache_mgr.CacheCapacity();
+    cache_mgr.ClearCache();
+    cache_mgr.SetCapacity(1024);
+
+    status = db_->PreloadCollections(dummy_context_, collection_names);
+    ASSERT_TRUE(status.ok());
+
+    db_->GetPreloadProgress(progress);
+    ASSERT_EQ(progress.loaded_segments_, 0);
+    ASSERT_EQ(progress.skipped_segments_, 2);
+    ASSERT_EQ(cache_mgr.ItemCount(), 0);
+
+    cache_mgr.SetCapacity(capacity);
+
+    status = db_->PreloadCollections(dummy_context_, {"PRELOAD_TEST_NOT_EXIST"});
+    ASSERT_FALSE(status.ok());
+}
+
+TEST_F(DBTest, WarmSetTest) {
+    std::string collection_name = "WARM_SET_TEST";
+    auto status = CreateCollection2(db_, collection_name);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::DataChunkPtr data_chunk;
+    BuildEntities(1000, 0, data_chunk);
+    status = db_->Insert(collection_name, "", data_chunk);
+    ASSERT_TRUE(status.ok());
+    status = db_->Flush();
+    ASSERT_TRUE(status.ok());
+
+    auto& cache_mgr = milvus::cache::CpuCacheMgr::GetInstance();
+    cache_mgr.ClearCache();
+
+    std::vector<std::string> fields;
+    status = db_->LoadCollection(dummy_context_, collection_name, fields);
+    ASSERT_TRUE(status.ok());
+    ASSERT_GT(cache_mgr.ItemCount(), 0);
+
+    // access the coldest item many times, it becomes the hottest one
+    std::vector<std::pair<std::string, int64_t>> keys;
+    cache_mgr.HotKeys(keys);
+    ASSERT_EQ(keys.size(), cache_mgr.ItemCount());
+    std::string hot_key = keys.back().first;
+    int64_t hits = keys.front().second + 10;
+    for (int64_t i = keys.back().second; i < hits; ++i) {
+        cache_mgr.GetItem(hot_key);
+    }
+
+    std::string warm_set_path = std::string("/tmp/milvus_ss/db") + milvus::engine::WARM_SET_FILE;
+    status = cache_mgr.SaveWarmSet(warm_set_path);
+    ASSERT_TRUE(status.ok());
+
+    std::vector<std::pair<std::string, int64_t>> saved_keys;
+    status = milvus::cache::CpuCacheMgr::LoadWarmSet(warm_set_path, saved_keys);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(saved_keys.size(), keys.size());
+    ASSERT_EQ(saved_keys.front().first, hot_key);
+    ASSERT_EQ(saved_keys.front().second, hits);
+
+    status = milvus::cache::CpuCacheMgr::LoadWarmSet(warm_set_path + "_not_exist", saved_keys);
+    ASSERT_FALSE(status.ok());
+}
+
+TEST_F(DBTest, WarmSetReloadTest) {
+    auto db_impl = std::dynamic_pointer_cast<milvus::engine::DBImpl>(db_);
+    ASSERT_NE(db_impl, nullptr);
+
+    // collections of one segment each, the first one is merged and the last one dropped after the warm set is saved
+    std::vector<std::string> collection_names = {"WARM_SET_MERGED", "WARM_SET_HOT", "WARM_SET_COLD",
+                                                 "WARM_SET_DROPPED"};
+    std::vector<std::vector<std::string>> collection_keys;
+    std::vector<ScopedSnapshotT> snapshots;
+    auto& cache_mgr = milvus::cache::CpuCacheMgr::GetInstance();
+    for (auto& name : collection_names) {
+        auto status = CreateCollection2(db_, name);
+        ASSERT_TRUE(status.ok());
+        milvus::engine::DataChunkPtr data_chunk;
+        BuildEntities(1000, 0, data_chunk);
+        status = db_->Insert(name, "", data_chunk);
+        ASSERT_TRUE(status.ok());
+        status = db_->Flush(name);
+        ASSERT_TRUE(status.ok());
+
+        // keys of a collection are the files loaded by it
+        cache_mgr.ClearCache();
+        std::vector<std::string> fields;
+        status = db_->LoadCollection(dummy_context_, name, fields);
+        ASSERT_TRUE(status.ok());
+        std::vector<std::pair<std::string, int64_t>> keys;
+        cache_mgr.HotKeys(keys);
+        ASSERT_FALSE(keys.empty());
+        collection_keys.emplace_back();
+        for (auto& pair : keys) {
+            collection_keys.back().push_back(pair.first);
+        }
+
+        ScopedSnapshotT ss;
+        status = Snapshots::GetInstance().GetSnapshot(ss, name);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(ss->GetResources<milvus::engine::snapshot::Segment>().size(), 1);
+        snapshots.push_back(ss);
+    }
+
+    // all collections are cached, the hot one is accessed more than the others
+    cache_mgr.ClearCache();
+    for (size_t i = 0; i < collection_names.size(); ++i) {
+        std::vector<std::string> fields;
+        auto status = db_->LoadCollection(dummy_context_, collection_names[i], fields);
+        ASSERT_TRUE(status.ok());
+        for (auto& key : collection_keys[i]) {
+            for (size_t j = 0; j < (i == 1 ? 20 : 5); ++j) {
+                cache_mgr.GetItem(key);
+            }
+        }
+    }
+    std::string warm_set_path = std::string("/tmp/milvus_ss/db") + milvus::engine::WARM_SET_FILE;
+    auto status = cache_mgr.SaveWarmSet(warm_set_path);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::DataChunkPtr data_chunk;
+    BuildEntities(1000, 1, data_chunk);
+    status = db_->Insert(collection_names[0], "", data_chunk);
+    ASSERT_TRUE(status.ok());
+    status = db_->Flush(collection_names[0]);
+    ASSERT_TRUE(status.ok());
+    sleep(2);
+    ScopedSnapshotT merged_ss;
+    status = Snapshots::GetInstance().GetSnapshot(merged_ss, collection_names[0]);
+    ASSERT_TRUE(status.ok());
+    auto& merged_segments = merged_ss->GetResources<milvus::engine::snapshot::Segment>();
+    ASSERT_EQ(merged_segments.size(), 1);
+    ASSERT_EQ(merged_segments.count(snapshots[0]->GetResources<milvus::engine::snapshot::Segment>().begin()->first),
+              0);
+    status = db_->DropCollection(collection_names[3]);
+    ASSERT_TRUE(status.ok());
+
+    // the keys map back to the segments of the hot and the cold collections, in hit order
+    std::vector<milvus::engine::DBImpl::PreloadItem> items;
+    status = db_impl->CollectWarmSetItems(warm_set_path, items);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(items.size(), 2);
+    for (size_t i = 0; i < items.size(); ++i) {
+        auto& segments = snapshots[i + 1]->GetResources<milvus::engine::snapshot::Segment>();
+        ASSERT_EQ(items[i].segment_->GetID(), segments.begin()->first);
+        ASSERT_EQ(items[i].segment_->GetCollectionId(), snapshots[i + 1]->GetCollectionId());
+    }
+
+    // the cache only fits one of them, the hot one is reloaded first and the cold one is skipped
+    auto capacity = cache_mgr.CacheCapacity();
+    cache_mgr.ClearCache();
+    cache_mgr.SetCapacity(std::max(items[0].size_, items[1].size_));
+    status = db_impl->ReloadWarmSet(warm_set_path);
+    ASSERT_TRUE(status.ok());
+    for (auto& key : collection_keys[1]) {
+        ASSERT_TRUE(cache_mgr.ItemExists(key));
+    }
+    ASSERT_EQ(cache_mgr.ItemCount(), collection_keys[1].size());
+
+    // with enough room both are reloaded, files of merged or dropped segments are not
+    cache_mgr.ClearCache();
+    cache_mgr.SetCapacity(capacity);
+    status = db_impl->ReloadWarmSet(warm_set_path);
+    ASSERT_TRUE(status.ok());
+    for (size_t i = 0; i < collection_names.size(); ++i) {
+        for (auto& key : collection_keys[i]) {
+            ASSERT_EQ(cache_mgr.ItemExists(key), i == 1 || i == 2);
+        }
+    }
+}
+
+TEST_F(DBTest, BulkImportTest) {
+    std::string collection_name = "BULK_IMPORT_TEST";
+    auto status = CreateCollection2(db_, collection_name);
+    ASSERT_TRUE(status.ok());
+
+    std::string import_path = "/tmp/milvus_ss/import";
+    std::experimental::filesystem::create_directories(import_path);
+
+    const int64_t row_count = 2500;
+    auto write_column = [&](const std::string& name, const void* data, size_t num_bytes) {
+        std::ofstream file(import_path + "/" + name, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data), num_bytes);
+    };
+
+    // each row of fvecs is prefixed by its dimension
+    std::vector<uint8_t> fvecs;
+    for (int64_t i = 0; i < row_count; ++i) {
+        int32_t dim = COLLECTION_DIM;
+        auto p = reinterpret_cast<const uint8_t*>(&dim);
+        fvecs.insert(fvecs.end(), p, p + sizeof(int32_t));
+        for (int64_t j = 0; j < COLLECTION_DIM; ++j) {
+            float value = drand48();
+            p = reinterpret_cast<const uint8_t*>(&value);
+            fvecs.insert(fvecs.end(), p, p + sizeof(float));
+        }
+    }
+    write_column(std::string(VECTOR_FIELD_NAME) + ".fvecs", fvecs.data(), fvecs.size());
+
+    std::vector<int32_t> field_0(row_count, 1);
+    std::vector<int64_t> field_1(row_count, 2);
+    std::vector<double> field_2(row_count, 3.0);
+    write_column("field_0.bin", field_0.data(), field_0.size() * sizeof(int32_t));
+    write_column("field_1.bin", field_1.data(), field_1.size() * sizeof(int64_t));
+    write_column("field_2.bin", field_2.data(), (field_2.size() - 1) * sizeof(double));
+
+    // row count of columns mismatch
+    int64_t imported = 0;
+    status = db_->BulkImport(dummy_context_, collection_name, milvus::engine::DEFAULT_PARTITON_TAG, import_path,
+                             imported);
+    ASSERT_FALSE(status.ok());
+
+    write_column("field_2.bin", field_2.data(), field_2.size() * sizeof(double));
+    status = db_->BulkImport(dummy_context_, collection_name, milvus::engine::DEFAULT_PARTITON_TAG, import_path,
+                             imported);
+    ASSERT_TRUE(status.ok()) << status.message();
+    ASSERT_EQ(imported, row_count);
+
+    // imported entities are visible without flush
+    int64_t count = 0;
+    status = db_->CountEntities(collection_name, count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(count, row_count);
+
+    status = db_->BulkImport(dummy_context_, collection_name, "not_exist", import_path, imported);
+    ASSERT_FALSE(status.ok());
+}
+
+TEST_F(DBTest, BulkImportFormatTest) {
+    // user defined ids, and segments smaller than the import
+    std::string collection_name = "BULK_IMPORT_FORMAT_TEST";
+    const int64_t segment_row_count = 1000;
+    CreateCollectionContext context;
+    milvus::json collection_params;
+    collection_params[milvus::engine::PARAM_UID_AUTOGEN] = false;
+    collection_params[milvus::engine::PARAM_SEGMENT_ROW_COUNT] = segment_row_count;
+    context.collection = std::make_shared<Collection>(collection_name, collection_params);
+    milvus::json float_params, binary_params;
+    float_params[milvus::knowhere::meta::DIM] = COLLECTION_DIM;
+    binary_params[milvus::knowhere::meta::DIM] = 64;
+    context.fields_schema[std::make_shared<Field>("float_vector", 0, milvus::engine::DataType::VECTOR_FLOAT,
+                                                  float_params)] = {};
+    context.fields_schema[std::make_shared<Field>("float16_vector", 0, milvus::engine::DataType::VECTOR_FLOAT16,
+                                                  float_params)] = {};
+    context.fields_schema[std::make_shared<Field>("binary_vector", 0, milvus::engine::DataType::VECTOR_BINARY,
+                                                  binary_params)] = {};
+    context.fields_schema[std::make_shared<Field>("int64", 0, milvus::engine::DataType::INT64)] = {};
+    auto status = db_->CreateCollection(context);
+    ASSERT_TRUE(status.ok());
+
+    std::string import_path = "/tmp/milvus_ss/import_format";
+    std::experimental::filesystem::remove_all(import_path);
+    std::experimental::filesystem::create_directories(import_path);
+    auto write_column = [&](const std::string& name, const void* data, size_t num_bytes) {
+        std::ofstream file(import_path + "/" + name, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data), num_bytes);
+    };
+    // each row of a vecs file is prefixed by its dimension, or its byte count for bvecs
+    auto write_vecs = [&](const std::string& name, const std::vector<uint8_t>& data, int32_t dim, size_t row_bytes) {
+        std::vector<uint8_t> vecs;
+        for (size_t offset = 0; offset < data.size(); offset += row_bytes) {
+            auto p = reinterpret_cast<const uint8_t*>(&dim);
+            vecs.insert(vecs.end(), p, p + sizeof(int32_t));
+            vecs.insert(vecs.end(), data.begin() + offset, data.begin() + offset + row_bytes);
+        }
+        write_column(name, vecs.data(), vecs.size());
+    };
+
+    const int64_t row_count = 2500;
+    milvus::engine::IDNumbers ids(row_count);
+    std::vector<float> float_data(row_count * COLLECTION_DIM);
+    std::vector<uint8_t> binary_data(row_count * 8);
+    auto int64_data = std::make_shared<milvus::engine::BinaryData>();
+    int64_data->data_.resize(row_count * sizeof(int64_t));
+    auto int64_values = reinterpret_cast<int64_t*>(int64_data->data_.data());
+    for (int64_t i = 0; i < row_count; ++i) {
+        ids[i] = 100000 + i;
+        int64_values[i] = i * 3;
+        for (int64_t j = 0; j < COLLECTION_DIM; ++j) {
+            float_data[i * COLLECTION_DIM + j] = drand48();
+        }
+        for (int64_t j = 0; j < 8; ++j) {
+            binary_data[i * 8 + j] = lrand48() % 256;
+        }
+    }
+    auto float_bytes = reinterpret_cast<const uint8_t*>(float_data.data());
+    std::vector<uint8_t> float_raw(float_bytes, float_bytes + float_data.size() * sizeof(float));
+    write_column(std::string(milvus::engine::FIELD_UID) + ".bin", ids.data(), ids.size() * sizeof(int64_t));
+    write_vecs("float_vector.fvecs", float_raw, COLLECTION_DIM, COLLECTION_DIM * sizeof(float));
+    write_vecs("float16_vector.fvecs", float_raw, COLLECTION_DIM, COLLECTION_DIM * sizeof(float));
+    write_vecs("binary_vector.bvecs", binary_data, 8, 8);
+
+    // the int64 column is a block file, as the raw file of a segment
+    {
+        milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+        milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+        milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(import_path);
+        auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+        auto block_format = milvus::codec::Codec::instance().GetBlockFormat();
+        status = block_format->Write(fs_ptr, import_path + "/int64.blk", int64_data);
+        ASSERT_TRUE(status.ok());
+    }
+
+    int64_t imported = 0;
+    status = db_->BulkImport(dummy_context_, collection_name, milvus::engine::DEFAULT_PARTITON_TAG, import_path,
+                             imported);
+    ASSERT_TRUE(status.ok()) << status.message();
+    ASSERT_EQ(imported, row_count);
+
+    ScopedSnapshotT ss;
+    status = Snapshots::GetInstance().GetSnapshot(ss, collection_name);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(ss->GetResources<milvus::engine::snapshot::Segment>().size(),
+              (row_count + segment_row_count - 1) / segment_row_count);
+
+    // rows of every segment are read back by their user ids
+    std::vector<std::string> field_names = {"float_vector", "float16_vector", "binary_vector", "int64"};
+    milvus::engine::DataChunkPtr data_chunk;
+    std::vector<bool> valid_row;
+    status = db_->GetEntityByID(collection_name, ids, field_names, valid_row, data_chunk);
+    ASSERT_TRUE(status.ok()) << status.message();
+    ASSERT_EQ(data_chunk->count_, row_count);
+    ASSERT_EQ(std::count(valid_row.begin(), valid_row.end(), true), row_count);
+
+    ASSERT_EQ(data_chunk->fixed_fields_["float_vector"]->data_, float_raw);
+    std::vector<uint8_t> float16_raw = float_raw;
+    status = milvus::engine::utils::FloatToFloat16(float16_raw);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(data_chunk->fixed_fields_["float16_vector"]->data_, float16_raw);
+    ASSERT_EQ(data_chunk->fixed_fields_["binary_vector"]->data_, binary_data);
+    ASSERT_EQ(data_chunk->fixed_fields_["int64"]->data_, int64_data->data_);
+
+    // a user id column is required
+    std::experimental::filesystem::remove(import_path + "/" + milvus::engine::FIELD_UID + ".bin");
+    status = db_->BulkImport(dummy_context_, collection_name, milvus::engine::DEFAULT_PARTITON_TAG, import_path,
+                             imported);
+    ASSERT_FALSE(status.ok());
+}
@@ -303,3 +303,165 @@ TEST_F(MetaTest, MultiThreadRequestTest) {
         t.join();
     }
 }
+
+TEST_F(SqliteMetaTest, ApplyTest) {
+    ID_TYPE result_id;
+
+    auto collection = std::make_shared<Collection>("sqlite_test_c1");
+    auto c_ctx = ResourceContextBuilder<Collection>().SetResource(collection).CreatePtr();
+    auto status = meta_->Execute<Collection>(c_ctx, result_id);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_GT(result_id, 0);
+    collection->SetID(result_id);
+
+    Collection::Ptr return_collection;
+    status = meta_->Select<Collection>(collection->GetID(), return_collection);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_NE(return_collection, nullptr);
+    ASSERT_EQ(return_collection->GetName(), collection->GetName());
+    ASSERT_FALSE(return_collection->IsActive());
+
+    collection->Activate();
+    auto c2_ctx = ResourceContextBuilder<Collection>().SetResource(collection)
+        .SetOp(Op::oUpdate).AddAttr(milvus::engine::meta::F_STATE).CreatePtr();
+    status = meta_->Execute<Collection>(c2_ctx, result_id);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_EQ(result_id, collection->GetID());
+
+    status = meta_->Select<Collection>(collection->GetID(), return_collection);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_NE(return_collection, nullptr);
+    ASSERT_TRUE(return_collection->IsActive());
+
+    auto c3_ctx = ResourceContextBuilder<Collection>().SetID(collection->GetID()).SetOp(Op::oDelete).CreatePtr();
+    status = meta_->Execute<Collection>(c3_ctx, result_id);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_EQ(result_id, collection->GetID());
+
+    status = meta_->Select<Collection>(collection->GetID(), return_collection);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_EQ(return_collection, nullptr);
+}
+
+TEST_F(SqliteMetaTest, InQueryTest) {
+    const size_t collection_count = 300;
+    IDS_TYPE ids;
+    for (size_t i = 0; i < collection_count; ++i) {
+        ID_TYPE result_id;
+        auto collection = std::make_shared<Collection>("sqlite_test_c" + std::to_string(i));
+        auto c_ctx = ResourceContextBuilder<Collection>().SetResource(collection).CreatePtr();
+        auto status = meta_->Execute<Collection>(c_ctx, result_id);
+        ASSERT_TRUE(status.ok()) << status.ToString();
+        ids.push_back(result_id);
+    }
+
+    // repeated values in the list do not repeat rows
+    std::vector<Collection::Ptr> return_collections;
+    auto status = meta_->SelectBy<Collection, ID_TYPE>(milvus::engine::meta::F_ID,
+                                                       {ids[0], ids[1], ids[2], ids[2]}, return_collections);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_EQ(return_collections.size(), 3);
+
+    return_collections.clear();
+    status = meta_->SelectBy<Collection, std::string>(milvus::engine::meta::F_NAME,
+                                                      {"sqlite_test_c1", "sqlite_test_c2", "no_such_collection"},
+                                                      return_collections);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_EQ(return_collections.size(), 2);
+
+    // the store pads each id list to a power of two and splits long lists
+    auto store = std::make_shared<Store>(meta_, "/tmp/milvus_ss/sqlite_meta");
+    for (size_t count : {1, 3, 5, 256, 257, 300}) {
+        IDS_TYPE query_ids(ids.begin(), ids.begin() + count);
+        return_collections.clear();
+        status = store->GetResources<Collection>(query_ids, return_collections);
+        ASSERT_TRUE(status.ok()) << status.ToString();
+        ASSERT_EQ(return_collections.size(), count);
+        std::set<ID_TYPE> return_ids;
+        for (auto& collection : return_collections) {
+            return_ids.insert(collection->GetID());
+        }
+        ASSERT_EQ(return_ids, std::set<ID_TYPE>(query_ids.begin(), query_ids.end()));
+    }
+}
+
+TEST_F(SqliteMetaTest, RollbackTest) {
+    auto build_add = [](const std::string& name) {
+        milvus::engine::meta::MetaApplyContext context;
+        context.table_ = milvus::engine::meta::TABLE_COLLECTION;
+        context.op_ = Op::oAdd;
+        context.attrs_ = {{milvus::engine::meta::F_NAME, "'" + name + "'"},
+                          {milvus::engine::meta::F_LSN, "0"},
+                          {milvus::engine::meta::F_PARAMS, "'{}'"},
+                          {milvus::engine::meta::F_STATE, "0"},
+                          {milvus::engine::meta::F_CREATED_ON, "0"},
+                          {milvus::engine::meta::F_UPDATED_ON, "0"}};
+        return context;
+    };
+    auto count_collections = [&]() {
+        std::vector<ID_TYPE> ids;
+        auto status = meta_->SelectResourceIDs<Collection, std::string>(ids, "", {""});
+        EXPECT_TRUE(status.ok()) << status.ToString();
+        return ids.size();
+    };
+
+    // a statement which fails to prepare
+    milvus::engine::meta::MetaApplyContext bad_sql;
+    bad_sql.sql_ = "INSERT INTO no_such_table VALUES (1);";
+    std::vector<int64_t> result_ids;
+    auto status = engine_->ExecuteTransaction({build_add("sqlite_test_c1"), bad_sql}, result_ids);
+    ASSERT_FALSE(status.ok());
+    ASSERT_EQ(count_collections(), 0);
+
+    // a statement which fails to step, a not null field is missing
+    auto bad_add = build_add("sqlite_test_c2");
+    bad_add.attrs_.erase(milvus::engine::meta::F_LSN);
+    result_ids.clear();
+    status = engine_->ExecuteTransaction({build_add("sqlite_test_c1"), bad_add}, result_ids);
+    ASSERT_FALSE(status.ok());
+    ASSERT_EQ(count_collections(), 0);
+
+    // cached statements are still usable after a rollback
+    result_ids.clear();
+    status = engine_->ExecuteTransaction({build_add("sqlite_test_c1"), build_add("sqlite_test_c2")}, result_ids);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_EQ(result_ids.size(), 2);
+    ASSERT_EQ(count_collections(), 2);
+}
+
+TEST_F(SqliteMetaTest, MultiThreadQueryTest) {
+    const size_t thread_count = 4;
+    const size_t collection_count = 50;
+    auto request_worker = [&](size_t i) {
+        for (size_t ii = 0; ii < collection_count; ii++) {
+            std::string collection_name = "sqlite_test_c" + std::to_string(i) + "_" + std::to_string(ii);
+            ID_TYPE result_id;
+            auto collection = std::make_shared<Collection>(collection_name);
+            auto c_ctx = ResourceContextBuilder<Collection>().SetResource(collection).CreatePtr();
+            auto status = meta_->Execute<Collection>(c_ctx, result_id);
+            ASSERT_TRUE(status.ok()) << status.ToString();
+
+            // rows of concurrent queries never mix
+            std::vector<Collection::Ptr> return_collections;
+            status = meta_->SelectBy<Collection, std::string>(milvus::engine::meta::F_NAME, {collection_name},
+                                                              return_collections);
+            ASSERT_TRUE(status.ok()) << status.ToString();
+            ASSERT_EQ(return_collections.size(), 1);
+            ASSERT_EQ(return_collections.at(0)->GetID(), result_id);
+            ASSERT_EQ(return_collections.at(0)->GetName(), collection_name);
+        }
+    };
+
+    std::vector<std::thread> request_threads;
+    for (size_t i = 0; i < thread_count; i++) {
+        request_threads.emplace_back(request_worker, i);
+    }
+    for (auto& t : request_threads) {
+        t.join();
+    }
+
+    std::vector<ID_TYPE> ids;
+    auto status = meta_->SelectResourceIDs<Collection, std::string>(ids, "", {""});
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_EQ(ids.size(), thread_count * collection_count);
+}
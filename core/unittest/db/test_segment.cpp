@@ -17,6 +17,7 @@
 #include <string>
 #include <experimental/filesystem>
 
+#include "codecs/BlockFormat.h"
 #include "codecs/Codec.h"
 #include "db/IDGenerator.h"
 #include "db/utils.h"
@@ -83,6 +84,18 @@ CreateCollection(std::shared_ptr<DB> db, const std::string& collection_name, con
 
     return db->CreateCollection(context);
 }
+
+// counts read calls, so that the tests can tell whether ranges are merged into one read
+class CountingIOReader : public milvus::storage::DiskIOReader {
+ public:
+    void
+    Read(void* ptr, int64_t size) override {
+        ++read_count_;
+        milvus::storage::DiskIOReader::Read(ptr, size);
+    }
+
+    int64_t read_count_ = 0;
+};
 }  // namespace
 
 TEST_F(SegmentTest, SegmentTest) {
@@ -340,6 +353,71 @@ TEST(BloomFilterTest, CloneTest) {
     error_rate_check(clone_filter, removed_id_array);
 }
 
+TEST(BlockFormatTest, ReadRangesTest) {
+    std::string file_path = "/tmp/milvus_block.blk";
+
+    auto counting_reader = std::make_shared<CountingIOReader>();
+    milvus::storage::IOReaderPtr reader_ptr = counting_reader;
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = nullptr;
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+
+    const int64_t data_size = 1024 * 1024;
+    auto raw = std::make_shared<milvus::engine::BinaryData>();
+    raw->data_.resize(data_size);
+    for (int64_t i = 0; i < data_size; ++i) {
+        raw->data_[i] = static_cast<uint8_t>(i % 251);
+    }
+
+    milvus::codec::BlockFormat block_format;
+    auto status = block_format.Write(fs_ptr, file_path, raw);
+    ASSERT_TRUE(status.ok());
+
+    // returns the number of read calls
+    auto read_ranges = [&](const milvus::codec::ReadRanges& ranges) -> int64_t {
+        counting_reader->read_count_ = 0;
+        milvus::engine::BinaryDataPtr out;
+        auto status = block_format.Read(fs_ptr, file_path, ranges, out);
+        EXPECT_TRUE(status.ok());
+
+        // the output keeps the order of input ranges
+        int64_t pos = 0;
+        for (auto& range : ranges) {
+            for (int64_t i = 0; i < range.num_bytes_; ++i) {
+                EXPECT_EQ(out->data_[pos + i], raw->data_[range.offset_ + i]);
+            }
+            pos += range.num_bytes_;
+        }
+        EXPECT_EQ(static_cast<int64_t>(out->data_.size()), pos);
+        return counting_reader->read_count_;
+    };
+
+    int64_t single_read = read_ranges({{0, 16}});
+
+    // ranges close to each other are read by one call, overlapping ranges included
+    ASSERT_EQ(read_ranges({{100, 16}, {108, 16}, {130, 16}, {200, 16}}), single_read);
+
+    // ranges far away from each other are read separately
+    ASSERT_EQ(read_ranges({{0, 16}, {100000, 16}, {500000, 16}}), single_read + 2);
+
+    // unsorted ranges are read in file order, the output still follows the input
+    ASSERT_EQ(read_ranges({{500000, 16}, {130, 8}, {0, 16}, {100, 16}}), single_read + 1);
+
+    // out of range
+    milvus::engine::BinaryDataPtr out;
+    status = block_format.Read(fs_ptr, file_path, {{data_size - 8, 16}}, out);
+    ASSERT_FALSE(status.ok());
+
+    // a changed file is rejected by the sum check, as the whole file read does
+    {
+        std::fstream fs(file_path, std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(-64, std::ios::end);
+        char c = 0x7f;
+        fs.write(&c, 1);
+    }
+    ASSERT_ANY_THROW(block_format.Read(fs_ptr, file_path, {{0, 16}}, out));
+}
+
 TEST(SegmentUtilTest, CalcCopyRangeTest) {
     // invalid input test
     std::vector<int32_t> offsets;
@@ -597,3 +675,75 @@ TEST_F(SegmentTest, SEGMENT_RW_TEST) {
     //     milvus::storage::S3ClientWrapper::GetInstance().StopService();
     // }
 }
+
+TEST_F(SegmentTest, SEGMENT_APPEND_TEST) {
+    const int64_t dimension = 4;
+    const int64_t vector_width = dimension * sizeof(float);
+    const int64_t chunk_count = 10;
+    const int64_t chunk_rows = 100;
+
+    auto make_chunk = [&](int64_t base) {
+        auto chunk = std::make_shared<milvus::engine::DataChunk>();
+        chunk->count_ = chunk_rows;
+
+        auto uids = std::make_shared<milvus::engine::BinaryData>();
+        uids->data_.resize(chunk_rows * sizeof(int64_t));
+        auto vectors = std::make_shared<milvus::engine::BinaryData>();
+        vectors->data_.resize(chunk_rows * vector_width);
+        auto uid_ptr = reinterpret_cast<int64_t*>(uids->data_.data());
+        auto vector_ptr = reinterpret_cast<float*>(vectors->data_.data());
+        for (int64_t i = 0; i < chunk_rows; ++i) {
+            uid_ptr[i] = base + i;
+            for (int64_t j = 0; j < dimension; ++j) {
+                vector_ptr[i * dimension + j] = base + i;
+            }
+        }
+        chunk->fixed_fields_[milvus::engine::FIELD_UID] = uids;
+        chunk->fixed_fields_["vector"] = vectors;
+        return chunk;
+    };
+
+    milvus::engine::Segment segment;
+    ASSERT_TRUE(segment.AddField(milvus::engine::FIELD_UID, milvus::engine::DataType::INT64).ok());
+    ASSERT_TRUE(segment.AddField("vector", milvus::engine::DataType::VECTOR_FLOAT, vector_width).ok());
+    ASSERT_TRUE(segment.Reserve({}, chunk_count * chunk_rows).ok());
+
+    milvus::engine::BinaryDataPtr vectors;
+    ASSERT_TRUE(segment.GetFixedFieldData("vector", vectors).ok());
+    const uint8_t* reserved_ptr = vectors->data_.data();
+    ASSERT_EQ(vectors->data_.capacity(), chunk_count * chunk_rows * vector_width);
+    ASSERT_EQ(segment.GetRowCount(), 0);
+
+    for (int64_t i = 0; i < chunk_count; ++i) {
+        ASSERT_TRUE(segment.AddChunk(make_chunk(i * chunk_rows)).ok());
+    }
+    ASSERT_EQ(segment.GetRowCount(), chunk_count * chunk_rows);
+
+    // no reallocation after reserved
+    ASSERT_TRUE(segment.GetFixedFieldData("vector", vectors).ok());
+    ASSERT_EQ(vectors->data_.data(), reserved_ptr);
+    ASSERT_EQ(vectors->data_.size(), chunk_count * chunk_rows * vector_width);
+
+    milvus::engine::BinaryDataPtr uids;
+    ASSERT_TRUE(segment.GetFixedFieldData(milvus::engine::FIELD_UID, uids).ok());
+    auto uid_ptr = reinterpret_cast<const int64_t*>(uids->data_.data());
+    auto vector_ptr = reinterpret_cast<const float*>(vectors->data_.data());
+    for (int64_t i = 0; i < chunk_count * chunk_rows; ++i) {
+        ASSERT_EQ(uid_ptr[i], i);
+        ASSERT_EQ(vector_ptr[i * dimension], i);
+    }
+
+    // append single entities without reservation
+    milvus::engine::Segment temp_segment;
+    ASSERT_TRUE(temp_segment.AddField(milvus::engine::FIELD_UID, milvus::engine::DataType::INT64).ok());
+    auto chunk = make_chunk(0);
+    for (int64_t i = chunk_rows - 1; i >= 0; --i) {
+        ASSERT_TRUE(temp_segment.AppendChunk(chunk, i, i).ok());
+    }
+    ASSERT_EQ(temp_segment.GetRowCount(), chunk_rows);
+    ASSERT_TRUE(temp_segment.GetFixedFieldData(milvus::engine::FIELD_UID, uids).ok());
+    uid_ptr = reinterpret_cast<const int64_t*>(uids->data_.data());
+    for (int64_t i = 0; i < chunk_rows; ++i) {
+        ASSERT_EQ(uid_ptr[i], chunk_rows - 1 - i);
+    }
+}
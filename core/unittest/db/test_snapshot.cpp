@@ -16,6 +16,7 @@
 #include <string>
 #include <set>
 #include <algorithm>
+#include <future>
 
 #include "db/utils.h"
 #include "db/snapshot/HandlerFactory.h"
@@ -283,6 +284,243 @@ TEST_F(SnapshotTest, DropCollectionTest) {
     ASSERT_FALSE(status.ok());
 }
 
+namespace {
+
+// leaves a pending collection commit behind, as an in-flight or failed operation does
+class PendingCollectionCommitOperation : public milvus::engine::snapshot::Operations {
+ public:
+    PendingCollectionCommitOperation(const milvus::engine::snapshot::CollectionCommit& commit, LSN_TYPE lsn)
+        : milvus::engine::snapshot::Operations(OperationContext(), ScopedSnapshotT(),
+                                               milvus::engine::snapshot::OperationsType::W_Leaf),
+          commit_(commit.GetCollectionId(), commit.GetSchemaId(), commit.GetMappings(), commit.GetRowCount(),
+                  commit.GetSize(), 0, lsn, State::PENDING) {
+    }
+
+    const Status&
+    ApplyToStore(StorePtr store) override {
+        if (done_) {
+            return status_;
+        }
+        milvus::engine::snapshot::CollectionCommitPtr pending;
+        auto status = store->CreateResource<milvus::engine::snapshot::CollectionCommit>(
+            milvus::engine::snapshot::CollectionCommit(commit_), pending);
+        SetStatus(status);
+        Done(store);
+        return status_;
+    }
+
+ private:
+    milvus::engine::snapshot::CollectionCommit commit_;
+};
+
+// records its tag when applied, after the gate is opened if there is one
+class RecordOperation : public milvus::engine::snapshot::Operations {
+ public:
+    RecordOperation(ScopedSnapshotT ss, int tag, std::vector<int>& records, std::mutex& mutex,
+                    std::shared_future<void> gate = std::shared_future<void>())
+        : milvus::engine::snapshot::Operations(OperationContext(), ss,
+                                               milvus::engine::snapshot::OperationsType::W_Leaf),
+          tag_(tag),
+          records_(records),
+          mutex_(mutex),
+          gate_(gate) {
+    }
+
+    const Status&
+    ApplyToStore(StorePtr store) override {
+        if (done_) {
+            return status_;
+        }
+        if (gate_.valid()) {
+            gate_.wait();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            records_.push_back(tag_);
+        }
+        Done(store);
+        return status_;
+    }
+
+ private:
+    int tag_;
+    std::vector<int>& records_;
+    std::mutex& mutex_;
+    std::shared_future<void> gate_;
+};
+
+}  // namespace
+
+TEST_F(SnapshotTest, OperationExecutorShardTest) {
+    auto shard_num = milvus::engine::snapshot::OperationExecutor::GetInstance().ShardNum();
+    ASSERT_GT(shard_num, 1);
+
+    // one collection on the first shard, and one on another shard
+    LSN_TYPE lsn = 0;
+    ScopedSnapshotT ss_0, ss_1;
+    for (size_t i = 0; i < 2 * shard_num && (!ss_0 || !ss_1); ++i) {
+        auto ss = CreateCollection("shard_c" + std::to_string(i), ++lsn);
+        ASSERT_TRUE(ss);
+        if (ss->GetCollectionId() % shard_num == 0) {
+            ss_0 = ss_0 ? ss_0 : ss;
+        } else {
+            ss_1 = ss_1 ? ss_1 : ss;
+        }
+    }
+    ASSERT_TRUE(ss_0);
+    ASSERT_TRUE(ss_1);
+
+    std::mutex mutex;
+    std::vector<int> records;
+    auto wait_records = [&](size_t size) {
+        for (int i = 0; i < 500; ++i) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (records.size() >= size) {
+                    return records;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        return records;
+    };
+
+    // a blocked collection does not hold back a collection on another shard
+    std::promise<void> gate;
+    auto blocked = std::make_shared<RecordOperation>(ss_0, 0, records, mutex, gate.get_future().share());
+    ASSERT_TRUE(blocked->Push(false).ok());
+    auto other = std::make_shared<RecordOperation>(ss_1, 1, records, mutex);
+    ASSERT_TRUE(other->Push(false).ok());
+    ASSERT_EQ(wait_records(1), std::vector<int>({1}));
+
+    // operations without a started snapshot, as create collection, go to the first shard and are applied before
+    // the operations of a collection submitted after them
+    auto create_like = std::make_shared<RecordOperation>(ScopedSnapshotT(), 2, records, mutex);
+    ASSERT_TRUE(create_like->Push(false).ok());
+    auto later = std::make_shared<RecordOperation>(ss_0, 3, records, mutex);
+    ASSERT_TRUE(later->Push(false).ok());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(wait_records(1), std::vector<int>({1}));
+
+    gate.set_value();
+    ASSERT_TRUE(later->WaitToFinish().ok());
+    ASSERT_EQ(wait_records(4), std::vector<int>({1, 0, 2, 3}));
+
+    // operations of one collection are applied in submission order
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        records.clear();
+    }
+    std::vector<int> expected;
+    std::vector<std::shared_ptr<RecordOperation>> ops;
+    for (int i = 0; i < 50; ++i) {
+        ops.emplace_back(std::make_shared<RecordOperation>(ss_1, i, records, mutex));
+        ASSERT_TRUE(ops.back()->Push(false).ok());
+        expected.push_back(i);
+    }
+    for (auto& op : ops) {
+        ASSERT_TRUE(op->WaitToFinish().ok());
+    }
+    ASSERT_EQ(wait_records(expected.size()), expected);
+}
+
+TEST_F(SnapshotTest, EvictCollectionTest) {
+    LSN_TYPE lsn = 0;
+    std::vector<std::string> collection_names = {"evict_c1", "evict_c2", "evict_c3"};
+    for (auto& collection_name : collection_names) {
+        auto ss = CreateCollection(collection_name, ++lsn);
+        ASSERT_TRUE(ss);
+    }
+
+    std::vector<std::string> loaded_names;
+    auto status = Snapshots::GetInstance().GetLoadedCollectionNames(loaded_names);
+    ASSERT_TRUE(status.ok()) << status.message();
+    ASSERT_EQ(loaded_names.size(), collection_names.size());
+
+    ScopedSnapshotT ss_c2;
+    status = Snapshots::GetInstance().GetSnapshot(ss_c2, collection_names[1]);
+    ASSERT_TRUE(status.ok()) << status.message();
+    auto pending_op = std::make_shared<PendingCollectionCommitOperation>(*ss_c2->GetCollectionCommit(), 100);
+    ss_c2 = ScopedSnapshotT();
+
+    // a collection in use is never evicted
+    ScopedSnapshotT in_use;
+    status = Snapshots::GetInstance().GetSnapshot(in_use, collection_names[0]);
+    ASSERT_TRUE(status.ok()) << status.message();
+    Snapshots::GetInstance().SetMemoryLimit(1);
+
+    loaded_names.clear();
+    Snapshots::GetInstance().GetLoadedCollectionNames(loaded_names);
+    ASSERT_NE(std::find(loaded_names.begin(), loaded_names.end(), collection_names[0]), loaded_names.end());
+
+    std::vector<std::string> all_names;
+    Snapshots::GetInstance().GetCollectionNames(all_names);
+    ASSERT_EQ(all_names.size(), collection_names.size());
+
+    // a newer commit that is not active yet must not be taken as the lsn or the snapshot of an evicted collection
+    status = pending_op->Push();
+    ASSERT_TRUE(status.ok()) << status.message();
+
+    // evicted collections are still known, and loaded again when accessed
+    for (size_t i = 0; i < collection_names.size(); ++i) {
+        LSN_TYPE collection_lsn = 0;
+        status = Snapshots::GetInstance().GetCollectionLsn(collection_names[i], collection_lsn);
+        ASSERT_TRUE(status.ok()) << status.message();
+        ASSERT_EQ(collection_lsn, static_cast<LSN_TYPE>(i + 1));
+
+        ScopedSnapshotT ss;
+        status = Snapshots::GetInstance().GetSnapshot(ss, collection_names[i]);
+        ASSERT_TRUE(status.ok()) << status.message();
+        ASSERT_EQ(ss->GetName(), collection_names[i]);
+        ASSERT_EQ(ss->GetMaxLsn(), static_cast<LSN_TYPE>(i + 1));
+        ASSERT_EQ(ss->GetResources<Field>().size(), in_use->GetResources<Field>().size());
+    }
+
+    Snapshots::GetInstance().SetMemoryLimit(0);
+}
+
+TEST_F(SnapshotTest, ConcurrentGetAndEvictTest) {
+    LSN_TYPE lsn = 0;
+    std::vector<std::string> collection_names = {"evict_c1", "evict_c2", "evict_c3"};
+    for (auto& collection_name : collection_names) {
+        auto ss = CreateCollection(collection_name, ++lsn);
+        ASSERT_TRUE(ss);
+    }
+    Snapshots::GetInstance().SetMemoryLimit(1);
+
+    // a snapshot got while its holder is evicted must still be held by a live holder
+    std::atomic<bool> stop = {false};
+    auto reader = [&](size_t offset) {
+        for (size_t i = 0; i < 2000; ++i) {
+            auto& collection_name = collection_names[(i + offset) % collection_names.size()];
+            ScopedSnapshotT ss;
+            auto status = Snapshots::GetInstance().GetSnapshot(ss, collection_name);
+            ASSERT_TRUE(status.ok()) << status.message();
+            ASSERT_EQ(ss->GetName(), collection_name);
+            ASSERT_GE(ss->ref_count(), 2);
+        }
+    };
+    auto evictor = [&]() {
+        while (!stop.load()) {
+            Snapshots::GetInstance().SetMemoryLimit(1);
+        }
+    };
+
+    std::thread evict_thread(evictor);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < 4; ++i) {
+        readers.emplace_back(reader, i);
+    }
+    for (auto& t : readers) {
+        t.join();
+    }
+    stop = true;
+    evict_thread.join();
+
+    Snapshots::GetInstance().SetMemoryLimit(0);
+}
+
 TEST_F(SnapshotTest, ConCurrentCollectionOperation) {
     std::string collection_name("c1");
     LSN_TYPE lsn = 1;
@@ -159,6 +159,7 @@ DBTest::GetOptions() {
     options.meta_.backend_uri_ = "mock://:@:/";
     options.wal_enable_ = false;
     options.auto_flush_interval_ = 1;
+    options.preload_concurrency_ = 1;  // segments are preloaded in the order of the items
     return options;
 }
 
@@ -257,6 +258,28 @@ void
 MetaTest::TearDown() {
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+const char* SQLITE_META_TEST_PATH = "/tmp/milvus_ss/sqlite_meta";
+}  // namespace
+
+void
+SqliteMetaTest::SetUp() {
+    std::experimental::filesystem::remove_all(SQLITE_META_TEST_PATH);
+    std::experimental::filesystem::create_directories(SQLITE_META_TEST_PATH);
+    milvus::engine::DBMetaOptions options;
+    options.path_ = SQLITE_META_TEST_PATH;
+    engine_ = std::make_shared<milvus::engine::meta::SqliteEngine>(options);
+    meta_ = std::make_shared<milvus::engine::meta::MetaAdapter>(engine_);
+}
+
+void
+SqliteMetaTest::TearDown() {
+    meta_ = nullptr;
+    engine_ = nullptr;
+    std::experimental::filesystem::remove_all(SQLITE_META_TEST_PATH);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void
 SchedulerTest::SetUp() {
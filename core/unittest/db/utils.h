@@ -389,6 +389,19 @@ class MetaTest : public BaseTest {
     TearDown() override;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+class SqliteMetaTest : public BaseTest {
+ protected:
+    milvus::engine::meta::MetaEnginePtr engine_;
+    MetaAdapterPtr meta_;
+
+ protected:
+    void
+    SetUp() override;
+    void
+    TearDown() override;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 class SchedulerTest : public BaseTest {
  protected:
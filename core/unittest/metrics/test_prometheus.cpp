@@ -34,6 +34,7 @@ TEST(PrometheusTest, PROMETHEUS_TEST) {
     instance.IndexFileSizeHistogramObserve(1.0);
     instance.BuildIndexDurationSecondsHistogramObserve(1.0);
     instance.CpuCacheUsageGaugeSet(1.0);
+    instance.CachePreloadProgressGaugeSet(1.0);
     instance.GpuCacheUsageGaugeSet();
     instance.MetaAccessTotalIncrement();
     instance.MetaAccessDurationSecondsHistogramObserve(1.0);
@@ -44,6 +45,11 @@ TEST(PrometheusTest, PROMETHEUS_TEST) {
     instance.MemTableMergeDurationSecondsHistogramObserve(1.0);
     instance.SearchIndexDataDurationSecondsHistogramObserve(1.0);
     instance.SearchRawDataDurationSecondsHistogramObserve(1.0);
+    instance.QueryStageHistogramObserve("vector_search", 1.0);
+    instance.ReqQueueDepthGaugeSet("dql_latency", 1.0);
+    instance.ReqQueueWaitHistogramObserve("dql_latency", 1.0);
+    instance.ReqDroppedCounterIncrement("dql_batch");
+    instance.SnapshotOperationQueueWaitHistogramObserve("0", 1.0);
     instance.IndexFileSizeTotalIncrement();
     instance.RawFileSizeTotalIncrement();
     instance.IndexFileSizeGaugeSet(1.0);
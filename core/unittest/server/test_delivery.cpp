@@ -0,0 +1,379 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/ServerConfig.h"
+#include "server/context/ConnectionContext.h"
+#include "server/context/Context.h"
+#include "server/delivery/ReqQueue.h"
+#include "server/delivery/ReqScheduler.h"
+#include "server/delivery/request/BaseReq.h"
+#include "server/grpc_impl/GrpcAsyncRequestHandler.h"
+
+namespace {
+
+using milvus::server::BaseReqPtr;
+using milvus::server::ReqType;
+
+class MockReq : public milvus::server::BaseReq {
+ public:
+    MockReq(const milvus::server::ContextPtr& context, int64_t cost, const std::string& name)
+        : BaseReq(context, ReqType::kInsert), cost_(cost), name_(name) {
+    }
+
+    int64_t
+    EstimateCost() const override {
+        return cost_;
+    }
+
+    const std::string&
+    name() const {
+        return name_;
+    }
+
+    void
+    SetPreStatus(const milvus::Status& status) {
+        pre_status_ = status;
+    }
+
+ protected:
+    milvus::Status
+    OnPreExecute() override {
+        return pre_status_;
+    }
+
+    milvus::Status
+    OnExecute() override {
+        return milvus::Status::OK();
+    }
+
+ private:
+    int64_t cost_;
+    std::string name_;
+    milvus::Status pre_status_;
+};
+
+class MockConnectionContext : public milvus::server::ConnectionContext {
+ public:
+    explicit MockConnectionContext(std::chrono::system_clock::time_point deadline, bool broken = false)
+        : deadline_(deadline), broken_(broken) {
+    }
+
+    bool
+    IsConnectionBroken() const override {
+        return broken_;
+    }
+
+    std::chrono::system_clock::time_point
+    Deadline() const override {
+        return deadline_;
+    }
+
+ private:
+    std::chrono::system_clock::time_point deadline_;
+    bool broken_;
+};
+
+std::shared_ptr<MockReq>
+MakeReq(int64_t cost, const std::string& name,
+        std::chrono::system_clock::time_point deadline = std::chrono::system_clock::time_point::max(),
+        bool broken = false) {
+    auto context = std::make_shared<milvus::server::Context>(name);
+    milvus::server::ConnectionContextPtr connection = std::make_shared<MockConnectionContext>(deadline, broken);
+    context->SetConnectionContext(connection);
+    return std::make_shared<MockReq>(context, cost, name);
+}
+
+// a scheduler of its own, the tests don't stop the global one
+class MockScheduler : public milvus::server::ReqScheduler {
+ public:
+    MockScheduler() = default;
+
+    ~MockScheduler() override = default;
+};
+
+// counts the callback invocations of a request
+struct CallbackCounter {
+    std::atomic<int64_t> count_{0};
+    milvus::Status status_;
+    std::promise<std::thread::id> thread_;
+
+    milvus::server::ReqCallback
+    Callback() {
+        return [this](const milvus::Status& status) {
+            status_ = status;
+            if (count_++ == 0) {
+                thread_.set_value(std::this_thread::get_id());
+            }
+        };
+    }
+};
+
+class ReqQueueTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        threshold_ = milvus::config.engine.batch_lane_cost_threshold.value;
+        weight_ = milvus::config.engine.latency_lane_weight.value;
+        max_wait_ = milvus::config.engine.max_queue_wait.value;
+
+        milvus::config.engine.batch_lane_cost_threshold.value = 100;
+        milvus::config.engine.latency_lane_weight.value = 2;
+        milvus::config.engine.max_queue_wait.value = 0;
+    }
+
+    void
+    TearDown() override {
+        // a request blocks in its destructor until it is done
+        for (auto& req : reqs_) {
+            req->Done();
+        }
+        milvus::config.engine.batch_lane_cost_threshold.value = threshold_;
+        milvus::config.engine.latency_lane_weight.value = weight_;
+        milvus::config.engine.max_queue_wait.value = max_wait_;
+    }
+
+    std::shared_ptr<MockReq>
+    Req(int64_t cost, const std::string& name,
+        std::chrono::system_clock::time_point deadline = std::chrono::system_clock::time_point::max(),
+        bool broken = false) {
+        auto req = MakeReq(cost, name, deadline, broken);
+        reqs_.push_back(req);
+        return req;
+    }
+
+    // execute one request of the given cost in the given microseconds, so that the queue knows its cost rate
+    void
+    FeedCostRate(milvus::server::ReqQueue& queue, int64_t cost, int64_t execute_us) {
+        auto req = Req(cost, "rate");
+        ASSERT_TRUE(queue.PutReq(req).ok());
+        auto taken = queue.TakeReq();
+        ASSERT_EQ(taken, req);
+        queue.ReqDone(taken, execute_us);
+    }
+
+ private:
+    int64_t threshold_ = 0;
+    int64_t weight_ = 0;
+    int64_t max_wait_ = 0;
+    std::vector<BaseReqPtr> reqs_;
+};
+
+}  // namespace
+
+TEST_F(ReqQueueTest, WeightedRoundRobinTest) {
+    milvus::server::ReqQueue queue("test");
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_TRUE(queue.PutReq(Req(1, "L")).ok());
+    }
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(queue.PutReq(Req(1000, "B")).ok());
+    }
+
+    // one batch request for every latency_lane_weight latency requests
+    std::string order;
+    for (int i = 0; i < 9; ++i) {
+        auto req = std::static_pointer_cast<MockReq>(queue.TakeReq());
+        ASSERT_NE(req, nullptr);
+        order += req->name();
+    }
+    ASSERT_EQ(order, "LLBLLBLLB");
+
+    // the batch lane is not starved, and is served alone once the latency lane is empty
+    ASSERT_TRUE(queue.PutReq(Req(1000, "B")).ok());
+    ASSERT_TRUE(queue.PutReq(Req(1000, "B")).ok());
+    ASSERT_EQ(std::static_pointer_cast<MockReq>(queue.TakeReq())->name(), "B");
+    ASSERT_EQ(std::static_pointer_cast<MockReq>(queue.TakeReq())->name(), "B");
+}
+
+TEST_F(ReqQueueTest, CostAdmissionTest) {
+    milvus::config.engine.max_queue_wait.value = 1;
+    milvus::server::ReqQueue queue("test");
+
+    // the cost rate is not known yet, everything is admitted
+    ASSERT_TRUE(queue.PutReq(Req(100000, "B")).ok());
+    ASSERT_TRUE(queue.PutReq(Req(100000, "B")).ok());
+    queue.TakeReq();
+    queue.TakeReq();
+
+    // 1 cost unit per microsecond
+    FeedCostRate(queue, 1000, 1000);
+
+    // nothing ahead, admitted
+    ASSERT_TRUE(queue.PutReq(Req(10000, "B")).ok());
+
+    // 10000 cost units ahead is 10ms, more than engine.max_queue_wait
+    auto status = queue.PutReq(Req(10000, "B"));
+    ASSERT_FALSE(status.ok());
+    ASSERT_EQ(status.code(), milvus::SERVER_REQUEST_REJECTED);
+
+    // the latency lane does not wait for the batch lane
+    ASSERT_TRUE(queue.PutReq(Req(1, "L")).ok());
+
+    // room again once the queued cost is taken
+    queue.TakeReq();
+    queue.TakeReq();
+    ASSERT_TRUE(queue.PutReq(Req(10000, "B")).ok());
+}
+
+TEST_F(ReqQueueTest, DeadlineRejectionTest) {
+    milvus::server::ReqQueue queue("test");
+    FeedCostRate(queue, 1000, 1000);
+    ASSERT_TRUE(queue.PutReq(Req(10000, "B")).ok());
+
+    // the estimated wait of 10ms passes the client deadline
+    auto now = std::chrono::system_clock::now();
+    auto status = queue.PutReq(Req(10000, "B", now + std::chrono::milliseconds(1)));
+    ASSERT_FALSE(status.ok());
+    ASSERT_EQ(status.code(), milvus::SERVER_REQUEST_REJECTED);
+
+    ASSERT_TRUE(queue.PutReq(Req(10000, "B", now + std::chrono::hours(1))).ok());
+}
+
+TEST_F(ReqQueueTest, DequeueDropTest) {
+    milvus::server::ReqQueue queue("test");
+
+    auto expired = Req(1, "expired", std::chrono::system_clock::now() + std::chrono::milliseconds(50));
+    auto broken = Req(1, "broken", std::chrono::system_clock::time_point::max(), true);
+    auto alive = Req(1, "alive");
+    ASSERT_TRUE(queue.PutReq(expired).ok());
+    ASSERT_TRUE(queue.PutReq(broken).ok());
+    ASSERT_TRUE(queue.PutReq(alive).ok());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // requests nobody waits for are finished with an error instead of being handed to the executor
+    ASSERT_EQ(queue.TakeReq(), alive);
+    ASSERT_EQ(expired->WaitToFinish().code(), milvus::SERVER_REQUEST_REJECTED);
+    ASSERT_EQ(broken->WaitToFinish().code(), milvus::SERVER_REQUEST_REJECTED);
+
+    // a stopped queue returns null once drained
+    queue.Stop();
+    ASSERT_EQ(queue.TakeReq(), nullptr);
+    ASSERT_FALSE(queue.PutReq(Req(1, "late")).ok());
+}
+
+TEST_F(ReqQueueTest, AsyncFullTest) {
+    milvus::server::ReqQueue queue("test");
+
+    // capacity of a lane
+    for (int i = 0; i < 32; ++i) {
+        ASSERT_TRUE(queue.PutReq(Req(1, "L")).ok());
+    }
+
+    // an async request is rejected instead of waiting for room
+    auto async_req = Req(1, "async");
+    async_req->SetCallback([](const milvus::Status& status) {});
+    auto status = queue.PutReq(async_req);
+    ASSERT_EQ(status.code(), milvus::SERVER_REQUEST_REJECTED);
+
+    // a sync request waits for room
+    auto sync_req = Req(1, "sync");
+    auto put = std::async(std::launch::async, [&]() { return queue.PutReq(sync_req); });
+    ASSERT_EQ(put.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+    queue.TakeReq();
+    ASSERT_TRUE(put.get().ok());
+}
+
+TEST(BaseReqTest, CallbackTest) {
+    auto req = MakeReq(1, "req");
+    CallbackCounter counter;
+    req->SetCallback(counter.Callback());
+    ASSERT_TRUE(req->async());
+
+    // invoked once by the first Done()
+    req->Execute();
+    ASSERT_EQ(counter.count_, 1);
+    ASSERT_TRUE(counter.status_.ok());
+    req->Done();
+    ASSERT_EQ(counter.count_, 1);
+}
+
+TEST(BaseReqTest, PreExecuteFailTest) {
+    MockScheduler scheduler;
+    auto req = MakeReq(1, "req");
+    req->SetPreStatus(milvus::Status(milvus::SERVER_INVALID_ARGUMENT, "invalid"));
+    CallbackCounter counter;
+    req->SetCallback(counter.Callback());
+
+    // PreExecute() and the scheduler both call Done(), the callback still runs once
+    auto status = scheduler.ExecuteReq(req);
+    ASSERT_EQ(status.code(), milvus::SERVER_INVALID_ARGUMENT);
+    ASSERT_EQ(counter.count_, 1);
+    ASSERT_EQ(counter.status_.code(), milvus::SERVER_INVALID_ARGUMENT);
+}
+
+TEST(BaseReqTest, PutFailTest) {
+    MockScheduler scheduler;
+    scheduler.Stop();
+
+    auto req = MakeReq(1, "req");
+    CallbackCounter counter;
+    req->SetCallback(counter.Callback());
+
+    auto status = scheduler.ExecuteReq(req);
+    ASSERT_EQ(status.code(), milvus::SERVER_REQUEST_REJECTED);
+    ASSERT_EQ(counter.count_, 1);
+    ASSERT_EQ(counter.status_.code(), milvus::SERVER_REQUEST_REJECTED);
+}
+
+TEST(BaseReqTest, AsyncExecuteTest) {
+    MockScheduler scheduler;
+
+    std::vector<std::shared_ptr<MockReq>> reqs;
+    std::vector<std::unique_ptr<CallbackCounter>> counters;
+    for (int i = 0; i < 10; ++i) {
+        reqs.push_back(MakeReq(1, "req"));
+        counters.emplace_back(std::make_unique<CallbackCounter>());
+        reqs.back()->SetCallback(counters.back()->Callback());
+
+        // returns before the request is executed
+        ASSERT_TRUE(scheduler.ExecuteReq(reqs.back()).ok());
+    }
+
+    // the callbacks run on the scheduler thread, once for each request
+    for (size_t i = 0; i < reqs.size(); ++i) {
+        ASSERT_TRUE(reqs[i]->WaitToFinish().ok());
+        ASSERT_NE(counters[i]->thread_.get_future().get(), std::this_thread::get_id());
+        ASSERT_EQ(counters[i]->count_, 1);
+        ASSERT_TRUE(counters[i]->status_.ok());
+    }
+
+    // no request is queued after the scheduler is stopped
+    scheduler.Stop();
+    auto late = MakeReq(1, "late");
+    CallbackCounter late_counter;
+    late->SetCallback(late_counter.Callback());
+    ASSERT_FALSE(scheduler.ExecuteReq(late).ok());
+    ASSERT_EQ(late_counter.count_, 1);
+}
+
+TEST(GrpcAsyncTest, WaitForCallsTest) {
+    milvus::server::grpc::GrpcAsyncRequestHandler handler;
+    handler.WaitForCalls();
+
+    // the server waits for pending calls before it shuts the completion queues down
+    handler.BeginCall();
+    handler.BeginCall();
+    auto wait = std::async(std::launch::async, [&]() { handler.WaitForCalls(); });
+    handler.EndCall();
+    ASSERT_EQ(wait.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+    handler.EndCall();
+    ASSERT_EQ(wait.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
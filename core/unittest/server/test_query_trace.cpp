@@ -0,0 +1,151 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/ServerConfig.h"
+#include "easyloggingpp/easylogging++.h"
+#include "server/context/QueryTrace.h"
+
+namespace {
+
+using milvus::server::QueryStage;
+using milvus::server::QueryTrace;
+
+// collects the slow query logs
+class SlowQueryLogCallback : public el::LogDispatchCallback {
+ public:
+    std::vector<std::string>
+    Messages() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+ protected:
+    void
+    handle(const el::LogDispatchData* data) override {
+        auto& message = data->logMessage()->message();
+        if (message.find("[slow query]") != std::string::npos) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            messages_.push_back(message);
+        }
+    }
+
+ private:
+    std::mutex mutex_;
+    std::vector<std::string> messages_;
+};
+
+const char* SLOW_QUERY_CALLBACK = "SlowQueryLogCallback";
+
+}  // namespace
+
+TEST(QueryTraceTest, StageTest) {
+    QueryTrace trace;
+    for (int32_t i = 0; i < milvus::server::QUERY_STAGE_NUM; ++i) {
+        ASSERT_EQ(trace.StageUs(static_cast<QueryStage>(i)), 0);
+    }
+
+    // a stage ended on several threads is counted once
+    trace.BeginStage(QueryStage::DISPATCH);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() { trace.EndStage(QueryStage::DISPATCH); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    auto dispatch_us = trace.StageUs(QueryStage::DISPATCH);
+    ASSERT_GE(dispatch_us, 10000);
+    ASSERT_LT(dispatch_us, 2 * 10000 + trace.ElapsedUs());
+    trace.EndStage(QueryStage::DISPATCH);
+    ASSERT_EQ(trace.StageUs(QueryStage::DISPATCH), dispatch_us);
+
+    // a stage which is not begun is not counted
+    trace.EndStage(QueryStage::QUEUE_WAIT);
+    ASSERT_EQ(trace.StageUs(QueryStage::QUEUE_WAIT), 0);
+
+    // segment stages are summed up
+    trace.AddStage(QueryStage::VECTOR_SEARCH, 100);
+    trace.AddStage(QueryStage::VECTOR_SEARCH, 200);
+    ASSERT_EQ(trace.StageUs(QueryStage::VECTOR_SEARCH), 300);
+    trace.AddSegmentLoad(1, 30);
+    trace.AddSegmentLoad(2, 50);
+    trace.AddSegmentLoad(3, 10);
+    ASSERT_EQ(trace.StageUs(QueryStage::SEGMENT_LOAD), 90);
+
+    auto loads = trace.SlowestSegmentLoads(2);
+    ASSERT_EQ(loads.size(), 2);
+    ASSERT_EQ(loads[0].first, 2);
+    ASSERT_EQ(loads[0].second, 50);
+    ASSERT_EQ(loads[1].first, 1);
+    ASSERT_EQ(loads[1].second, 30);
+    ASSERT_EQ(trace.SlowestSegmentLoads(10).size(), 3);
+
+    std::string expected = "queue_wait=0us, dispatch=" + std::to_string(dispatch_us) +
+                           "us, segment_load=90us, scalar_filter=0us, vector_search=300us, reduce=0us, field_fetch=0us";
+    ASSERT_EQ(trace.Breakdown(), expected);
+}
+
+TEST(QueryTraceTest, SlowQueryTest) {
+    auto metric_enable = milvus::config.metric.enable.value;
+    auto slow_query_enable = milvus::config.logs.slow_query.enable.value;
+    auto slow_query_threshold = milvus::config.logs.slow_query.threshold.value;
+
+    // no trace at all unless metric or slow query log is enabled
+    milvus::config.metric.enable.value = false;
+    milvus::config.logs.slow_query.enable.value = false;
+    ASSERT_EQ(QueryTrace::Create(), nullptr);
+
+    milvus::config.logs.slow_query.enable.value = true;
+    milvus::config.logs.slow_query.threshold.value = 20;
+    el::Helpers::installLogDispatchCallback<SlowQueryLogCallback>(SLOW_QUERY_CALLBACK);
+    auto callback = el::Helpers::logDispatchCallback<SlowQueryLogCallback>(SLOW_QUERY_CALLBACK);
+
+    // faster than the threshold
+    auto trace = QueryTrace::Create();
+    ASSERT_NE(trace, nullptr);
+    trace->Finish("fast_req", "c1");
+    ASSERT_TRUE(callback->Messages().empty());
+
+    // slower than the threshold, logged with the stage breakdown and the slowest segments
+    trace = QueryTrace::Create();
+    trace->AddSegmentLoad(7, 12345);
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    trace->Finish("slow_req", "c1");
+    auto messages = callback->Messages();
+    ASSERT_EQ(messages.size(), 1);
+    ASSERT_NE(messages[0].find("[slow_req]"), std::string::npos);
+    ASSERT_NE(messages[0].find("collection: c1"), std::string::npos);
+    ASSERT_NE(messages[0].find(trace->Breakdown()), std::string::npos);
+    ASSERT_NE(messages[0].find("slowest segment loads: [7=12345us]"), std::string::npos);
+
+    // nothing is logged when the slow query log is disabled
+    milvus::config.metric.enable.value = true;
+    milvus::config.logs.slow_query.enable.value = false;
+    trace = QueryTrace::Create();
+    ASSERT_NE(trace, nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    trace->Finish("slow_req_2", "c1");
+    ASSERT_EQ(callback->Messages().size(), 1);
+
+    el::Helpers::uninstallLogDispatchCallback<SlowQueryLogCallback>(SLOW_QUERY_CALLBACK);
+    milvus::config.metric.enable.value = metric_enable;
+    milvus::config.logs.slow_query.enable.value = slow_query_enable;
+    milvus::config.logs.slow_query.threshold.value = slow_query_threshold;
+}